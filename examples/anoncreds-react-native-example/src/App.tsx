@@ -1,5 +1,8 @@
 import { anoncreds } from '@hyperledger/anoncreds-react-native'
-import { StyleSheet, Text, View } from 'react-native'
+import { useState } from 'react'
+import { Button, ScrollView, StyleSheet, Text, View } from 'react-native'
+
+import { type GetObjectTiming, benchmarkGetObject } from './benchmarkGetObject'
 
 const styles = StyleSheet.create({
   container: {
@@ -8,10 +11,35 @@ const styles = StyleSheet.create({
     alignItems: 'center',
     justifyContent: 'center',
   },
+  results: {
+    flexGrow: 0,
+    maxHeight: '60%',
+  },
 })
 
-export const App = () => (
-  <View style={styles.container}>
-    <Text>Anoncreds version: {anoncreds.version()}</Text>
-  </View>
-)
+const formatTiming = ({ type, length, parse, getObject, same }: GetObjectTiming) =>
+  `${type} (${length} B): ${parse.toFixed(3)} ms parse, ${getObject.toFixed(3)} ms getObject${same ? '' : ', DIFFERENT'}`
+
+export const App = () => {
+  const [results, setResults] = useState<string[]>([])
+
+  const runBenchmark = () => {
+    try {
+      setResults(benchmarkGetObject().map(formatTiming))
+    } catch (error) {
+      setResults([String(error)])
+    }
+  }
+
+  return (
+    <View style={styles.container}>
+      <Text>Anoncreds version: {anoncreds.version()}</Text>
+      <Button title="Benchmark getObject" onPress={runBenchmark} />
+      <ScrollView style={styles.results}>
+        {results.map((result) => (
+          <Text key={result}>{result}</Text>
+        ))}
+      </ScrollView>
+    </View>
+  )
+}
@@ -0,0 +1,208 @@
+import {
+  Credential,
+  CredentialDefinition,
+  CredentialOffer,
+  CredentialRequest,
+  CredentialRevocationConfig,
+  CredentialRevocationState,
+  LinkSecret,
+  Presentation,
+  PresentationRequest,
+  RevocationRegistryDefinition,
+  RevocationStatusList,
+  Schema,
+  W3cCredential,
+  W3cPresentation,
+  anoncreds,
+} from '@hyperledger/anoncreds-react-native'
+import type { AnoncredsObject } from '@hyperledger/anoncreds-react-native'
+
+export type GetObjectTiming = {
+  type: string
+  // Length of the JSON of the object
+  length: number
+  // Milliseconds per call of `JSON.parse(getJson())` and of `getObject()`
+  parse: number
+  getObject: number
+  // Whether both give the same value
+  same: boolean
+}
+
+const runs = 200
+
+const time = (run: () => unknown) => {
+  const start = performance.now()
+  for (let i = 0; i < runs; i++) run()
+  return (performance.now() - start) / runs
+}
+
+// An object of every type, from one issuance and presentation of a revocable credential
+const createObjects = (tailsDirectoryPath?: string): Record<string, AnoncredsObject> => {
+  const schema = Schema.create({
+    name: 'schema-1',
+    issuerId: 'mock:uri',
+    version: '1',
+    attributeNames: ['name', 'age', 'sex', 'height'],
+  })
+
+  const { credentialDefinition, keyCorrectnessProof, credentialDefinitionPrivate } = CredentialDefinition.create({
+    schemaId: 'mock:uri',
+    issuerId: 'mock:uri',
+    schema,
+    signatureType: 'CL',
+    supportRevocation: true,
+    tag: 'TAG',
+  })
+
+  const { revocationRegistryDefinition, revocationRegistryDefinitionPrivate } = RevocationRegistryDefinition.create({
+    credentialDefinitionId: 'mock:uri',
+    credentialDefinition,
+    issuerId: 'mock:uri',
+    tag: 'some_tag',
+    revocationRegistryType: 'CL_ACCUM',
+    maximumCredentialNumber: 10,
+    tailsDirectoryPath,
+  })
+
+  const revocationStatusList = RevocationStatusList.create({
+    credentialDefinition,
+    revocationRegistryDefinitionId: 'mock:uri',
+    revocationRegistryDefinition,
+    revocationRegistryDefinitionPrivate,
+    issuerId: 'mock:uri',
+    issuanceByDefault: true,
+    timestamp: 12,
+  })
+
+  const credentialOffer = CredentialOffer.create({
+    schemaId: 'mock:uri',
+    credentialDefinitionId: 'mock:uri',
+    keyCorrectnessProof,
+  })
+
+  const linkSecret = LinkSecret.create()
+  const { credentialRequestMetadata, credentialRequest } = CredentialRequest.create({
+    entropy: 'entropy',
+    credentialDefinition,
+    linkSecret,
+    linkSecretId: 'link secret id',
+    credentialOffer,
+  })
+
+  const revocationConfiguration = new CredentialRevocationConfig({
+    registryDefinition: revocationRegistryDefinition,
+    registryDefinitionPrivate: revocationRegistryDefinitionPrivate,
+    statusList: revocationStatusList,
+    registryIndex: 9,
+  })
+  const attributeRawValues = { name: 'Alex', height: '175', age: '28', sex: 'male' }
+
+  const issuedCredential = Credential.create({
+    credentialDefinition,
+    credentialDefinitionPrivate,
+    credentialOffer,
+    credentialRequest,
+    attributeRawValues,
+    revocationConfiguration,
+  })
+
+  const issuedW3cCredential = W3cCredential.create({
+    credentialDefinition,
+    credentialDefinitionPrivate,
+    credentialOffer,
+    credentialRequest,
+    attributeRawValues,
+    revocationConfiguration,
+  })
+
+  const processOptions = { credentialDefinition, credentialRequestMetadata, linkSecret, revocationRegistryDefinition }
+  const credential = issuedCredential.process(processOptions)
+  const w3cCredential = issuedW3cCredential.process(processOptions)
+  issuedCredential.handle.clear()
+  issuedW3cCredential.handle.clear()
+
+  const revocationState = CredentialRevocationState.create({
+    revocationRegistryDefinition,
+    revocationStatusList,
+    revocationRegistryIndex: credential.revocationRegistryIndex ?? 0,
+    tailsPath: revocationRegistryDefinition.getTailsLocation(),
+  })
+
+  const presentationRequest = PresentationRequest.fromJson({
+    nonce: anoncreds.generateNonce(),
+    name: 'pres_req_1',
+    version: '0.1',
+    requested_attributes: {
+      attr1_referent: { name: 'name', issuer: 'mock:uri' },
+      attr2_referent: { names: ['sex', 'height'] },
+    },
+    requested_predicates: {
+      predicate1_referent: { name: 'age', p_type: '>=', p_value: 18 },
+    },
+    non_revoked: { from: 13, to: 200 },
+  })
+
+  const presentationOptions = {
+    presentationRequest,
+    credentialDefinitions: { 'mock:uri': credentialDefinition },
+    credentialsProve: [
+      { entryIndex: 0, isPredicate: false, referent: 'attr1_referent', reveal: true },
+      { entryIndex: 0, isPredicate: false, referent: 'attr2_referent', reveal: true },
+      { entryIndex: 0, isPredicate: true, referent: 'predicate1_referent', reveal: true },
+    ],
+    linkSecret,
+    schemas: { 'mock:uri': schema },
+  }
+  const presentation = Presentation.create({
+    ...presentationOptions,
+    credentials: [{ credential, revocationState, timestamp: 12 }],
+  })
+  const w3cPresentation = W3cPresentation.create({
+    ...presentationOptions,
+    credentials: [{ credential: w3cCredential, revocationState, timestamp: 12 }],
+  })
+
+  return {
+    schema,
+    credentialDefinition,
+    credentialDefinitionPrivate,
+    keyCorrectnessProof,
+    revocationRegistryDefinition,
+    revocationRegistryDefinitionPrivate,
+    revocationStatusList,
+    credentialOffer,
+    credentialRequest,
+    credentialRequestMetadata,
+    credential,
+    w3cCredential,
+    revocationState,
+    presentationRequest,
+    presentation,
+    w3cPresentation,
+  }
+}
+
+/**
+ * Compares `getObject` with `JSON.parse(getJson())` for an object of every type. `tailsDirectoryPath` must be
+ * writable, the default temporary directory of `libanoncreds` is not on Android.
+ */
+export const benchmarkGetObject = (tailsDirectoryPath?: string): GetObjectTiming[] => {
+  const { getObject } = anoncreds
+  if (!getObject) throw new Error('The registered anoncreds library has no `getObject`')
+
+  const objects = createObjects(tailsDirectoryPath)
+  const timings = Object.entries(objects).map(([type, object]) => {
+    const objectHandle = object.handle
+    const json = anoncreds.getJson({ objectHandle })
+    return {
+      type,
+      length: json.length,
+      parse: time(() => JSON.parse(anoncreds.getJson({ objectHandle }))),
+      getObject: time(() => getObject.call(anoncreds, { objectHandle })),
+      same: JSON.stringify(getObject.call(anoncreds, { objectHandle })) === JSON.stringify(JSON.parse(json)),
+    }
+  })
+
+  for (const object of Object.values(objects)) object.handle.clear()
+  return timings
+}
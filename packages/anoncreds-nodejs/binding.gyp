@@ -0,0 +1,45 @@
+{
+  "variables": {
+    "anoncreds_library_dir%": "<(module_root_dir)/native",
+    "anoncreds_include_dir%": "<(module_root_dir)/../anoncreds-react-native/cpp/include"
+  },
+  "targets": [
+    {
+      "target_name": "anoncreds_napi",
+      "sources": ["cpp/addon.cpp", "cpp/anoncreds.cpp", "cpp/binding.cpp"],
+      "include_dirs": ["<(anoncreds_include_dir)"],
+      "cflags_cc!": ["-fno-exceptions", "-std=gnu++17"],
+      "cflags_cc": ["-std=c++20"],
+      "libraries": ["-L<(anoncreds_library_dir)", "-lanoncreds"],
+      "conditions": [
+        [
+          "OS=='linux'",
+          {
+            "ldflags": ["-Wl,-rpath,'$$ORIGIN'"]
+          }
+        ],
+        [
+          "OS=='mac'",
+          {
+            "xcode_settings": {
+              "CLANG_CXX_LANGUAGE_STANDARD": "c++20",
+              "GCC_ENABLE_CPP_EXCEPTIONS": "YES",
+              "OTHER_LDFLAGS": ["-Wl,-rpath,@loader_path"]
+            }
+          }
+        ]
+      ]
+    },
+    {
+      "target_name": "copy_anoncreds_napi",
+      "type": "none",
+      "dependencies": ["anoncreds_napi"],
+      "copies": [
+        {
+          "destination": "<(anoncreds_library_dir)",
+          "files": ["<(PRODUCT_DIR)/anoncreds_napi.node"]
+        }
+      ]
+    }
+  ]
+}
@@ -0,0 +1,8 @@
+#include <node_api.h>
+
+#include "anoncreds.h"
+
+NAPI_MODULE_INIT() {
+  anoncreds::registerBindings(env, exports);
+  return exports;
+}
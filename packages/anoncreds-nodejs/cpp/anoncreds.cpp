@@ -0,0 +1,69 @@
+#include "anoncreds.h"
+#include "binding.h"
+
+namespace anoncreds {
+
+void registerBindings(napi_env env, napi_value exports) {
+  using anoncredsBinding::define;
+
+  // The functions of `NativeBackend` in `src/library/NativeBackend.ts`. The
+  // strings and buffers they return are freed natively, so the `*_free`
+  // functions other than `anoncreds_object_free` are left out.
+  try {
+    anoncredsBinding::defineErrorConstructor(env, exports);
+#define ANONCREDS_BINDING(name) define<name>(env, exports, #name)
+    ANONCREDS_BINDING(anoncreds_create_credential);
+    ANONCREDS_BINDING(anoncreds_create_credential_definition);
+    ANONCREDS_BINDING(anoncreds_create_credential_offer);
+    ANONCREDS_BINDING(anoncreds_create_credential_request);
+    ANONCREDS_BINDING(anoncreds_create_link_secret);
+    ANONCREDS_BINDING(anoncreds_create_or_update_revocation_state);
+    ANONCREDS_BINDING(anoncreds_create_presentation);
+    ANONCREDS_BINDING(anoncreds_create_revocation_registry_def);
+    ANONCREDS_BINDING(anoncreds_create_revocation_status_list);
+    ANONCREDS_BINDING(anoncreds_create_schema);
+    ANONCREDS_BINDING(anoncreds_create_w3c_credential);
+    ANONCREDS_BINDING(anoncreds_create_w3c_presentation);
+    ANONCREDS_BINDING(anoncreds_credential_definition_from_json);
+    ANONCREDS_BINDING(anoncreds_credential_definition_private_from_json);
+    ANONCREDS_BINDING(anoncreds_credential_from_json);
+    ANONCREDS_BINDING(anoncreds_credential_from_w3c);
+    ANONCREDS_BINDING(anoncreds_credential_get_attribute);
+    ANONCREDS_BINDING(anoncreds_credential_offer_from_json);
+    ANONCREDS_BINDING(anoncreds_credential_request_from_json);
+    ANONCREDS_BINDING(anoncreds_credential_request_metadata_from_json);
+    ANONCREDS_BINDING(anoncreds_credential_to_w3c);
+    ANONCREDS_BINDING(anoncreds_encode_credential_attributes);
+    ANONCREDS_BINDING(anoncreds_generate_nonce);
+    ANONCREDS_BINDING(anoncreds_get_current_error);
+    ANONCREDS_BINDING(anoncreds_key_correctness_proof_from_json);
+    ANONCREDS_BINDING(anoncreds_object_free);
+    ANONCREDS_BINDING(anoncreds_object_get_json);
+    ANONCREDS_BINDING(anoncreds_object_get_type_name);
+    ANONCREDS_BINDING(anoncreds_presentation_from_json);
+    ANONCREDS_BINDING(anoncreds_presentation_request_from_json);
+    ANONCREDS_BINDING(anoncreds_process_credential);
+    ANONCREDS_BINDING(anoncreds_process_w3c_credential);
+    ANONCREDS_BINDING(anoncreds_revocation_registry_definition_from_json);
+    ANONCREDS_BINDING(anoncreds_revocation_registry_definition_get_attribute);
+    ANONCREDS_BINDING(anoncreds_revocation_registry_definition_private_from_json);
+    ANONCREDS_BINDING(anoncreds_revocation_registry_from_json);
+    ANONCREDS_BINDING(anoncreds_revocation_state_from_json);
+    ANONCREDS_BINDING(anoncreds_revocation_status_list_from_json);
+    ANONCREDS_BINDING(anoncreds_schema_from_json);
+    ANONCREDS_BINDING(anoncreds_set_default_logger);
+    ANONCREDS_BINDING(anoncreds_update_revocation_status_list);
+    ANONCREDS_BINDING(anoncreds_update_revocation_status_list_timestamp_only);
+    ANONCREDS_BINDING(anoncreds_verify_presentation);
+    ANONCREDS_BINDING(anoncreds_verify_w3c_presentation);
+    ANONCREDS_BINDING(anoncreds_version);
+    ANONCREDS_BINDING(anoncreds_w3c_credential_from_json);
+    ANONCREDS_BINDING(anoncreds_w3c_credential_get_integrity_proof_details);
+    ANONCREDS_BINDING(anoncreds_w3c_credential_proof_get_attribute);
+    ANONCREDS_BINDING(anoncreds_w3c_presentation_from_json);
+#undef ANONCREDS_BINDING
+  } catch (const anoncredsBinding::PendingException &) {
+  }
+}
+
+} // namespace anoncreds
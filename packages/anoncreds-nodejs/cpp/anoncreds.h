@@ -0,0 +1,13 @@
+#pragma once
+
+#include <node_api.h>
+
+namespace anoncreds {
+
+// Defines a binding on `exports` for every function of `libanoncreds.h` that
+// `NativeBackend` describes, under the name of the function, and
+// `setErrorConstructor`. Every binding also has an `async` variant, see
+// `binding.h`.
+void registerBindings(napi_env env, napi_value exports);
+
+} // namespace anoncreds
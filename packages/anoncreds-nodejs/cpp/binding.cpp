@@ -0,0 +1,360 @@
+#include <cmath>
+
+#include "binding.h"
+
+namespace anoncredsBinding {
+
+namespace {
+
+// The state of the addon in one environment
+struct Instance {
+  napi_ref errorConstructor = nullptr;
+};
+
+Instance &instanceOf(napi_env env) {
+  void *data = nullptr;
+  check(env, napi_get_instance_data(env, &data));
+  if (data != nullptr)
+    return *static_cast<Instance *>(data);
+
+  auto instance = new Instance();
+  auto status = napi_set_instance_data(
+      env, instance,
+      [](napi_env env, void *data, void *) {
+        auto instance = static_cast<Instance *>(data);
+        if (instance->errorConstructor != nullptr)
+          napi_delete_reference(env, instance->errorConstructor);
+        delete instance;
+      },
+      nullptr);
+  if (status != napi_ok) {
+    delete instance;
+    check(env, status);
+  }
+  return *instance;
+}
+
+napi_value setErrorConstructor(napi_env env, napi_callback_info info) {
+  try {
+    napi_value constructor;
+    size_t argc = 1;
+    check(env,
+          napi_get_cb_info(env, info, &argc, &constructor, nullptr, nullptr));
+    if (argc < 1 || typeOf(env, constructor) != napi_function)
+      throw ArgumentError("Argument 0 is not a function");
+
+    auto &instance = instanceOf(env);
+    if (instance.errorConstructor != nullptr)
+      check(env, napi_delete_reference(env, instance.errorConstructor));
+    instance.errorConstructor = nullptr;
+    check(env, napi_create_reference(env, constructor, 1,
+                                     &instance.errorConstructor));
+  } catch (const ArgumentError &e) {
+    throwTypeError(env, e.what());
+  } catch (const PendingException &) {
+  }
+  return nullptr;
+}
+
+} // namespace
+
+void throwTypeError(napi_env env, const char *message) {
+  bool isPending = false;
+  napi_is_exception_pending(env, &isPending);
+  if (!isPending)
+    napi_throw_type_error(env, nullptr, message);
+}
+
+void check(napi_env env, napi_status status) {
+  if (status == napi_ok)
+    return;
+
+  bool isPending = false;
+  napi_is_exception_pending(env, &isPending);
+  if (!isPending) {
+    const napi_extended_error_info *info = nullptr;
+    napi_get_last_error_info(env, &info);
+    napi_throw_error(env, nullptr,
+                     info != nullptr && info->error_message != nullptr
+                         ? info->error_message
+                         : "Unknown napi error");
+  }
+
+  throw PendingException();
+}
+
+napi_valuetype typeOf(napi_env env, napi_value value) {
+  napi_valuetype type;
+  check(env, napi_typeof(env, value, &type));
+  return type;
+}
+
+bool isAbsent(napi_env env, napi_value value) {
+  auto type = typeOf(env, value);
+  return type == napi_null || type == napi_undefined;
+}
+
+napi_value propertyOf(napi_env env, napi_value object, const char *name) {
+  napi_value value;
+  check(env, napi_get_named_property(env, object, name, &value));
+  return value;
+}
+
+int64_t integerOf(napi_env env, napi_value value) {
+  switch (typeOf(env, value)) {
+  case napi_number: {
+    double number;
+    check(env, napi_get_value_double(env, value, &number));
+    // 2^63 is the first double above the `int64_t` range
+    if (!std::isfinite(number) || std::trunc(number) != number ||
+        number < -0x1p63 || number >= 0x1p63)
+      throw ArgumentError("is not an integer");
+    return int64_t(number);
+  }
+  case napi_bigint: {
+    int64_t number;
+    bool lossless;
+    check(env, napi_get_value_bigint_int64(env, value, &number, &lossless));
+    if (!lossless)
+      throw ArgumentError("is out of range");
+    return number;
+  }
+  case napi_boolean: {
+    bool flag;
+    check(env, napi_get_value_bool(env, value, &flag));
+    return flag ? 1 : 0;
+  }
+  default:
+    throw ArgumentError("is not a number");
+  }
+}
+
+ObjectHandle handleOf(napi_env env, napi_value value) {
+  switch (typeOf(env, value)) {
+  case napi_null:
+  case napi_undefined:
+    return 0;
+  case napi_object: {
+    auto handle = propertyOf(env, value, "handle");
+    auto type = typeOf(env, handle);
+    if (type != napi_number && type != napi_bigint)
+      throw ArgumentError("is not an ObjectHandle");
+    return ObjectHandle(integerOf(env, handle));
+  }
+  default:
+    return ObjectHandle(integerOf(env, value));
+  }
+}
+
+std::string stringOf(napi_env env, napi_value value) {
+  if (typeOf(env, value) != napi_string)
+    throw ArgumentError("is not a string");
+
+  size_t length;
+  check(env, napi_get_value_string_utf8(env, value, nullptr, 0, &length));
+  std::string string(length, '\0');
+  check(env, napi_get_value_string_utf8(env, value, string.data(),
+                                        length + 1, &length));
+  return string;
+}
+
+std::vector<napi_value> elementsOf(napi_env env, napi_value value) {
+  std::vector<napi_value> elements;
+  if (isAbsent(env, value))
+    return elements;
+
+  bool isArray;
+  check(env, napi_is_array(env, value, &isArray));
+  if (!isArray)
+    throw ArgumentError("is not an array");
+
+  uint32_t length;
+  check(env, napi_get_array_length(env, value, &length));
+  elements.resize(length);
+  for (uint32_t i = 0; i < length; i++)
+    check(env, napi_get_element(env, value, i, &elements[i]));
+  return elements;
+}
+
+std::string bytesOf(napi_env env, napi_value value) {
+  if (typeOf(env, value) == napi_string)
+    return stringOf(env, value);
+
+  bool isTypedArray = false;
+  if (typeOf(env, value) == napi_object)
+    check(env, napi_is_typedarray(env, value, &isTypedArray));
+  if (!isTypedArray)
+    throw ArgumentError("is not a string or a typed array");
+
+  // `Buffer` is a `Uint8Array`. The length is counted in elements.
+  napi_typedarray_type type;
+  size_t count;
+  void *data;
+  napi_value arrayBuffer;
+  size_t offset;
+  check(env, napi_get_typedarray_info(env, value, &type, &count, &data,
+                                      &arrayBuffer, &offset));
+  size_t elementSize = 1;
+  switch (type) {
+  case napi_int16_array:
+  case napi_uint16_array:
+    elementSize = 2;
+    break;
+  case napi_int32_array:
+  case napi_uint32_array:
+  case napi_float32_array:
+    elementSize = 4;
+    break;
+  case napi_float64_array:
+  case napi_bigint64_array:
+  case napi_biguint64_array:
+    elementSize = 8;
+    break;
+  default:
+    break;
+  }
+  return count == 0 ? std::string()
+                    : std::string(static_cast<const char *>(data),
+                                  count * elementSize);
+}
+
+std::string currentError() {
+  const char *out = nullptr;
+  anoncreds_get_current_error(&out);
+  if (out == nullptr)
+    return std::string();
+
+  std::string error(out);
+  anoncreds_string_free(const_cast<char *>(out));
+  return error;
+}
+
+napi_value createString(napi_env env, const char *data, size_t length) {
+  napi_value out;
+  check(env, napi_create_string_utf8(env, data, length, &out));
+  return out;
+}
+
+napi_value errorOf(napi_env env, ErrorCode code, const std::string &json) {
+  napi_value object;
+  if (!json.empty()) {
+    napi_value global;
+    check(env, napi_get_global(env, &global));
+    auto parse = propertyOf(env, propertyOf(env, global, "JSON"), "parse");
+    auto text = createString(env, json.data(), json.size());
+    check(env, napi_call_function(env, global, parse, 1, &text, &object));
+  } else {
+    check(env, napi_create_object(env, &object));
+    napi_value value;
+    check(env, napi_create_int64(env, int64_t(code), &value));
+    check(env, napi_set_named_property(env, object, "code", value));
+    check(env, napi_set_named_property(
+                   env, object, "message",
+                   createString(env, "Unknown error", NAPI_AUTO_LENGTH)));
+  }
+
+  auto &instance = instanceOf(env);
+  napi_value error;
+  if (instance.errorConstructor != nullptr) {
+    napi_value constructor;
+    check(env, napi_get_reference_value(env, instance.errorConstructor,
+                                        &constructor));
+    check(env, napi_new_instance(env, constructor, 1, &object, &error));
+    return error;
+  }
+
+  // Without a constructor, a plain `Error` with the fields of the JSON
+  check(env, napi_create_error(env, nullptr,
+                               propertyOf(env, object, "message"), &error));
+  for (auto name : {"code", "extra"})
+    check(env, napi_set_named_property(env, error, name,
+                                       propertyOf(env, object, name)));
+  return error;
+}
+
+void Argument<FfiList_FfiCredentialEntry>::read(napi_env env, napi_value js) {
+  for (auto element : elementsOf(env, js)) {
+    if (typeOf(env, element) != napi_object)
+      throw ArgumentError("is not an array of NativeCredentialEntry");
+    auto timestamp = propertyOf(env, element, "timestamp");
+    items.push_back(FfiCredentialEntry{
+        .credential = handleOf(env, propertyOf(env, element, "credential")),
+        .timestamp = isAbsent(env, timestamp)
+                         ? -1
+                         : integerOf<int32_t>(env, timestamp),
+        .rev_state =
+            handleOf(env, propertyOf(env, element, "revocationState"))});
+  }
+}
+
+void Argument<FfiList_FfiCredentialProve>::read(napi_env env, napi_value js) {
+  for (auto element : elementsOf(env, js)) {
+    if (typeOf(env, element) != napi_object)
+      throw ArgumentError("is not an array of NativeCredentialProve");
+    referents.push_back(stringOf(env, propertyOf(env, element, "referent")));
+    items.push_back(FfiCredentialProve{
+        .entry_idx =
+            integerOf<int64_t>(env, propertyOf(env, element, "entryIndex")),
+        .referent = nullptr,
+        .is_predicate =
+            integerOf<int8_t>(env, propertyOf(env, element, "isPredicate")),
+        .reveal = integerOf<int8_t>(env, propertyOf(env, element, "reveal"))});
+  }
+}
+
+void Argument<FfiList_FfiNonrevokedIntervalOverride>::read(napi_env env,
+                                                           napi_value js) {
+  for (auto element : elementsOf(env, js)) {
+    if (typeOf(env, element) != napi_object)
+      throw ArgumentError(
+          "is not an array of NativeNonRevokedIntervalOverride");
+    revocationRegistryDefinitionIds.push_back(stringOf(
+        env, propertyOf(env, element, "revocationRegistryDefinitionId")));
+    items.push_back(FfiNonrevokedIntervalOverride{
+        .rev_reg_def_id = nullptr,
+        .requested_from_ts = integerOf<int32_t>(
+            env, propertyOf(env, element, "requestedFromTimestamp")),
+        .override_rev_status_list_ts = integerOf<int32_t>(
+            env, propertyOf(env, element,
+                            "overrideRevocationStatusListTimestamp"))});
+  }
+}
+
+void Argument<const FfiCredRevInfo *>::read(napi_env env, napi_value js) {
+  if (isAbsent(env, js))
+    return;
+  if (typeOf(env, js) != napi_object)
+    throw ArgumentError("is not a NativeCredentialRevocationConfig");
+
+  value = FfiCredRevInfo{
+      .reg_def = handleOf(env, propertyOf(env, js,
+                                          "revocationRegistryDefinition")),
+      .reg_def_private = handleOf(
+          env, propertyOf(env, js, "revocationRegistryDefinitionPrivate")),
+      .status_list =
+          handleOf(env, propertyOf(env, js, "revocationStatusList")),
+      .reg_idx =
+          integerOf<int64_t>(env, propertyOf(env, js, "registryIndex"))};
+}
+
+void define(napi_env env, napi_value exports, const char *name,
+            napi_callback sync, napi_callback async) {
+  napi_value function;
+  check(env, napi_create_function(env, name, NAPI_AUTO_LENGTH, sync, nullptr,
+                                  &function));
+  napi_value asyncFunction;
+  check(env, napi_create_function(env, name, NAPI_AUTO_LENGTH, async, nullptr,
+                                  &asyncFunction));
+  check(env, napi_set_named_property(env, function, "async", asyncFunction));
+  check(env, napi_set_named_property(env, exports, name, function));
+}
+
+void defineErrorConstructor(napi_env env, napi_value exports) {
+  napi_value function;
+  check(env, napi_create_function(env, "setErrorConstructor", NAPI_AUTO_LENGTH,
+                                  setErrorConstructor, nullptr, &function));
+  check(env,
+        napi_set_named_property(env, exports, "setErrorConstructor", function));
+}
+
+} // namespace anoncredsBinding
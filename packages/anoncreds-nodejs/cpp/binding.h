@@ -0,0 +1,562 @@
+#pragma once
+
+#include <node_api.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "libanoncreds.h"
+
+// Exposes the functions of `libanoncreds.h` to JS with plain values, like the
+// bindings of `@hyperledger/anoncreds-react-native`:
+//
+//   const schema = anoncreds_create_schema(name, version, issuerId, names)
+//   const [credentialDefinition, credentialDefinitionPrivate, proof] =
+//     await anoncreds_create_credential_definition.async(...)
+//
+// The inputs are passed in FFI parameter order, without the outputs. The JS
+// conversion of every parameter is derived from its FFI type at compile time,
+// so a binding is nothing more than `Function<anoncreds_create_schema>`:
+//
+//   ObjectHandle              a number, or an `ObjectHandle`
+//   integers                  an integer number, a boolean or a bigint
+//   FfiStr                    a string, or null for absent strings
+//   ByteBuffer                a string, a `Buffer` or a typed array
+//   FfiStrList and the other  an array, or null for an empty list. Structs
+//   lists                     are objects with the fields of the matching
+//                             `Native*` type of `@hyperledger/anoncreds-shared`
+//   const FfiCredRevInfo *    a `NativeCredentialRevocationConfig`, or null
+//
+// No JS value is ever read as a pointer or as raw struct memory: every input
+// is copied into memory the call owns, so the `async` variant does not keep
+// JS values alive while it runs.
+//
+// Non-const pointer parameters are outputs. A call returns its only output, or
+// an array of them, with handles as numbers, `int8_t` results as booleans and
+// strings and `ByteBuffer`s as strings, which are freed natively. A failed call
+// throws the error of `anoncreds_get_current_error`, read right after the call
+// on the thread that made it, constructed with the class passed to
+// `setErrorConstructor`.
+//
+// `fn.async(...inputs)` runs the call on the libuv thread pool and returns a
+// promise of the same result.
+namespace anoncredsBinding {
+
+// Thrown when an argument can not be converted, turned into a JS `TypeError`
+class ArgumentError : public std::runtime_error {
+public:
+  using std::runtime_error::runtime_error;
+};
+
+// Thrown when a napi call failed. The JS exception is already pending.
+class PendingException {};
+
+// Throws `PendingException` when `status` is not `napi_ok`, making sure a JS
+// exception is pending
+void check(napi_env env, napi_status status);
+
+// Throws `message` as a JS `TypeError`, unless a JS exception is already
+// pending
+void throwTypeError(napi_env env, const char *message);
+
+napi_valuetype typeOf(napi_env env, napi_value value);
+
+// `null` or `undefined`
+bool isAbsent(napi_env env, napi_value value);
+
+napi_value propertyOf(napi_env env, napi_value object, const char *name);
+
+// An integer number, a boolean or a bigint that fits in an `int64_t`
+int64_t integerOf(napi_env env, napi_value value);
+
+// An integer of type `T`, out of range values are rejected
+template <typename T> T integerOf(napi_env env, napi_value value) {
+  auto number = integerOf(env, value);
+  if constexpr (sizeof(T) < sizeof(int64_t)) {
+    if (number < int64_t(std::numeric_limits<T>::min()) ||
+        number > int64_t(std::numeric_limits<T>::max()))
+      throw ArgumentError("is out of range");
+  }
+  return T(number);
+}
+
+// A number, or an object with a numeric `handle`, like `ObjectHandle`. Absent
+// handles are 0, which is never a valid handle.
+ObjectHandle handleOf(napi_env env, napi_value value);
+
+std::string stringOf(napi_env env, napi_value value);
+
+// The elements of an array, none when the array is absent
+std::vector<napi_value> elementsOf(napi_env env, napi_value value);
+
+// The bytes of a string, a `Buffer` or a typed array
+std::string bytesOf(napi_env env, napi_value value);
+
+// Reads `anoncreds_get_current_error` into a string
+std::string currentError();
+
+// The error of a call that failed with `code`, from the JSON of
+// `anoncreds_get_current_error`
+napi_value errorOf(napi_env env, ErrorCode code, const std::string &json);
+
+napi_value createString(napi_env env, const char *data, size_t length);
+
+template <typename T, typename = void> struct Argument;
+
+template <> struct Argument<ObjectHandle> {
+  ObjectHandle value = 0;
+
+  void read(napi_env env, napi_value js) { value = handleOf(env, js); }
+
+  ObjectHandle get() const { return value; }
+};
+
+// `ErrorCode` and the other integers, absent integers are 0
+template <typename T>
+struct Argument<T, std::enable_if_t<(std::is_integral_v<T> ||
+                                     std::is_enum_v<T>) &&
+                                    !std::is_same_v<T, ObjectHandle>>> {
+  T value = T(0);
+
+  void read(napi_env env, napi_value js) {
+    if (isAbsent(env, js))
+      return;
+    if constexpr (std::is_enum_v<T>)
+      value = T(integerOf<std::underlying_type_t<T>>(env, js));
+    else
+      value = integerOf<T>(env, js);
+  }
+
+  T get() const { return value; }
+};
+
+// Absent strings are passed as `nullptr`
+template <> struct Argument<FfiStr> {
+  std::optional<std::string> value;
+
+  void read(napi_env env, napi_value js) {
+    if (!isAbsent(env, js))
+      value = stringOf(env, js);
+  }
+
+  FfiStr get() const { return value ? value->c_str() : nullptr; }
+};
+
+template <> struct Argument<ByteBuffer> {
+  std::string bytes;
+
+  void read(napi_env env, napi_value js) { bytes = bytesOf(env, js); }
+
+  ByteBuffer get() {
+    return ByteBuffer{.len = int64_t(bytes.size()),
+                      .data = reinterpret_cast<uint8_t *>(bytes.data())};
+  }
+};
+
+template <> struct Argument<FfiStrList> {
+  std::vector<std::string> items;
+  std::vector<FfiStr> pointers;
+
+  void read(napi_env env, napi_value js) {
+    for (auto element : elementsOf(env, js))
+      items.push_back(stringOf(env, element));
+  }
+
+  FfiStrList get() {
+    pointers.clear();
+    for (auto &item : items)
+      pointers.push_back(item.c_str());
+    return FfiStrList{.count = pointers.size(), .data = pointers.data()};
+  }
+};
+
+template <> struct Argument<FfiList_ObjectHandle> {
+  std::vector<ObjectHandle> items;
+
+  void read(napi_env env, napi_value js) {
+    for (auto element : elementsOf(env, js))
+      items.push_back(handleOf(env, element));
+  }
+
+  FfiList_ObjectHandle get() const {
+    return FfiList_ObjectHandle{.count = items.size(), .data = items.data()};
+  }
+};
+
+template <> struct Argument<FfiList_i32> {
+  std::vector<int32_t> items;
+
+  void read(napi_env env, napi_value js) {
+    for (auto element : elementsOf(env, js))
+      items.push_back(integerOf<int32_t>(env, element));
+  }
+
+  FfiList_i32 get() const {
+    return FfiList_i32{.count = items.size(), .data = items.data()};
+  }
+};
+
+// `NativeCredentialEntry`, an absent timestamp is -1
+template <> struct Argument<FfiList_FfiCredentialEntry> {
+  std::vector<FfiCredentialEntry> items;
+
+  void read(napi_env env, napi_value js);
+
+  FfiList_FfiCredentialEntry get() const {
+    return FfiList_FfiCredentialEntry{.count = items.size(),
+                                      .data = items.data()};
+  }
+};
+
+// `NativeCredentialProve`
+template <> struct Argument<FfiList_FfiCredentialProve> {
+  std::vector<std::string> referents;
+  std::vector<FfiCredentialProve> items;
+
+  void read(napi_env env, napi_value js);
+
+  FfiList_FfiCredentialProve get() {
+    for (size_t i = 0; i < items.size(); i++)
+      items[i].referent = referents[i].c_str();
+    return FfiList_FfiCredentialProve{.count = items.size(),
+                                      .data = items.data()};
+  }
+};
+
+// `NativeNonRevokedIntervalOverride`
+template <> struct Argument<FfiList_FfiNonrevokedIntervalOverride> {
+  std::vector<std::string> revocationRegistryDefinitionIds;
+  std::vector<FfiNonrevokedIntervalOverride> items;
+
+  void read(napi_env env, napi_value js);
+
+  FfiList_FfiNonrevokedIntervalOverride get() {
+    for (size_t i = 0; i < items.size(); i++)
+      items[i].rev_reg_def_id = revocationRegistryDefinitionIds[i].c_str();
+    return FfiList_FfiNonrevokedIntervalOverride{.count = items.size(),
+                                                 .data = items.data()};
+  }
+};
+
+// `NativeCredentialRevocationConfig`, passed as `nullptr` when absent
+template <> struct Argument<const FfiCredRevInfo *> {
+  std::optional<FfiCredRevInfo> value;
+
+  void read(napi_env env, napi_value js);
+
+  const FfiCredRevInfo *get() const { return value ? &*value : nullptr; }
+};
+
+template <typename T>
+constexpr bool isOutput =
+    std::is_pointer_v<T> && !std::is_const_v<std::remove_pointer_t<T>>;
+
+// An output parameter. Whatever the library allocated for it is freed when the
+// call is destroyed, whether or not it was converted.
+template <typename T> struct Output;
+
+template <> struct Output<ObjectHandle> {
+  ObjectHandle value = 0;
+
+  ObjectHandle *get() { return &value; }
+
+  napi_value convert(napi_env env) {
+    napi_value out;
+    check(env, napi_create_int64(env, int64_t(value), &out));
+    return out;
+  }
+};
+
+template <> struct Output<int8_t> {
+  int8_t value = 0;
+
+  int8_t *get() { return &value; }
+
+  napi_value convert(napi_env env) {
+    napi_value out;
+    check(env, napi_get_boolean(env, value != 0, &out));
+    return out;
+  }
+};
+
+template <> struct Output<const char *> {
+  const char *value = nullptr;
+
+  Output() = default;
+  Output(const Output &) = delete;
+  Output &operator=(const Output &) = delete;
+  ~Output() {
+    if (value != nullptr)
+      anoncreds_string_free(const_cast<char *>(value));
+  }
+
+  const char **get() { return &value; }
+
+  napi_value convert(napi_env env) {
+    if (value == nullptr) {
+      napi_value out;
+      check(env, napi_get_null(env, &out));
+      return out;
+    }
+    return createString(env, value, NAPI_AUTO_LENGTH);
+  }
+};
+
+template <> struct Output<ByteBuffer> {
+  ByteBuffer value{};
+
+  Output() = default;
+  Output(const Output &) = delete;
+  Output &operator=(const Output &) = delete;
+  ~Output() {
+    if (value.data != nullptr)
+      anoncreds_buffer_free(value);
+  }
+
+  ByteBuffer *get() { return &value; }
+
+  napi_value convert(napi_env env) {
+    return createString(env, reinterpret_cast<const char *>(value.data),
+                        size_t(value.len));
+  }
+};
+
+template <typename T>
+using Parameter =
+    std::conditional_t<isOutput<T>, Output<std::remove_pointer_t<T>>,
+                       Argument<T>>;
+
+template <auto fn> struct Function;
+
+template <typename Return, typename... Params, Return (*fn)(Params...)>
+struct Function<fn> {
+  static constexpr size_t inputs = (size_t(!isOutput<Params>) + ... + 0);
+  static constexpr size_t outputs = sizeof...(Params) - inputs;
+
+  // The JS argument of every parameter, the outputs have none
+  static constexpr auto argumentIndices = [] {
+    std::array<size_t, sizeof...(Params) + 1> indices{};
+    size_t index = 0;
+    size_t i = 0;
+    ((indices[i++] = isOutput<Params> ? 0 : index++), ...);
+    return indices;
+  }();
+
+  // A decoded call, which owns everything its parameters point to
+  struct Call {
+    std::tuple<Parameter<Params>...> parameters;
+    std::conditional_t<std::is_void_v<Return>, std::monostate, Return>
+        result{};
+    // The error JSON of a failed call, read on the thread that made it
+    std::string error;
+
+    napi_deferred deferred = nullptr;
+    napi_async_work work = nullptr;
+
+    void read(napi_env env, const napi_value *argv) {
+      read(env, argv, std::index_sequence_for<Params...>());
+    }
+
+    template <size_t... I>
+    void read([[maybe_unused]] napi_env env,
+              [[maybe_unused]] const napi_value *argv,
+              std::index_sequence<I...>) {
+      (readParameter<I>(env, argv), ...);
+    }
+
+    template <size_t I>
+    void readParameter(napi_env env, const napi_value *argv) {
+      using Param = std::tuple_element_t<I, std::tuple<Params...>>;
+      if constexpr (!isOutput<Param>) {
+        constexpr auto index = argumentIndices[I];
+        try {
+          std::get<I>(parameters).read(env, argv[index]);
+        } catch (const ArgumentError &e) {
+          throw ArgumentError("Argument " + std::to_string(index) + " " +
+                              e.what());
+        }
+      }
+    }
+
+    void run() {
+      auto call = [](Parameter<Params> &...parameters) {
+        return fn(parameters.get()...);
+      };
+      if constexpr (std::is_void_v<Return>) {
+        std::apply(call, parameters);
+      } else {
+        result = std::apply(call, parameters);
+        if constexpr (std::is_same_v<Return, ErrorCode>) {
+          if (result != ErrorCode::Success)
+            error = currentError();
+        }
+      }
+    }
+
+    bool failed() const {
+      if constexpr (std::is_same_v<Return, ErrorCode>)
+        return result != ErrorCode::Success;
+      else
+        return false;
+    }
+
+    // The outputs of a successful call, or the return value of a function
+    // without outputs
+    napi_value value(napi_env env) {
+      napi_value out;
+      if constexpr (outputs == 0) {
+        if constexpr (std::is_pointer_v<Return>) {
+          if (result != nullptr)
+            return createString(env, result, NAPI_AUTO_LENGTH);
+          check(env, napi_get_null(env, &out));
+        } else {
+          check(env, napi_get_undefined(env, &out));
+        }
+      } else if constexpr (outputs == 1) {
+        out = convertOutputs(env, std::index_sequence_for<Params...>())[0];
+      } else {
+        auto values =
+            convertOutputs(env, std::index_sequence_for<Params...>());
+        check(env, napi_create_array_with_length(env, outputs, &out));
+        for (size_t i = 0; i < outputs; i++)
+          check(env, napi_set_element(env, out, uint32_t(i), values[i]));
+      }
+      return out;
+    }
+
+    template <size_t... I>
+    std::vector<napi_value> convertOutputs(napi_env env,
+                                           std::index_sequence<I...>) {
+      std::vector<napi_value> values;
+      (
+          [&] {
+            using Param = std::tuple_element_t<I, std::tuple<Params...>>;
+            if constexpr (isOutput<Param>)
+              values.push_back(std::get<I>(parameters).convert(env));
+          }(),
+          ...);
+      return values;
+    }
+
+    napi_value failure(napi_env env) {
+      if constexpr (std::is_same_v<Return, ErrorCode>)
+        return errorOf(env, result, error);
+      else
+        return nullptr;
+    }
+  };
+
+  static std::unique_ptr<Call> decode(napi_env env, napi_callback_info info) {
+    std::array<napi_value, inputs + 1> argv{};
+    size_t argc = inputs;
+    check(env,
+          napi_get_cb_info(env, info, &argc, argv.data(), nullptr, nullptr));
+    // Missing arguments are `undefined`
+    for (auto i = argc; i < inputs; i++)
+      check(env, napi_get_undefined(env, &argv[i]));
+
+    auto call = std::make_unique<Call>();
+    call->read(env, argv.data());
+    return call;
+  }
+
+  static napi_value sync(napi_env env, napi_callback_info info) {
+    try {
+      auto call = decode(env, info);
+      call->run();
+      if (call->failed()) {
+        napi_throw(env, call->failure(env));
+        return nullptr;
+      }
+      return call->value(env);
+    } catch (const ArgumentError &e) {
+      throwTypeError(env, e.what());
+    } catch (const PendingException &) {
+    }
+    return nullptr;
+  }
+
+  static void execute(napi_env, void *data) {
+    static_cast<Call *>(data)->run();
+  }
+
+  static void complete(napi_env env, napi_status status, void *data) {
+    std::unique_ptr<Call> call(static_cast<Call *>(data));
+    napi_delete_async_work(env, call->work);
+
+    try {
+      if (status != napi_ok) {
+        napi_value message;
+        check(env, napi_create_string_utf8(env, "Async call was cancelled",
+                                           NAPI_AUTO_LENGTH, &message));
+        napi_value error;
+        check(env, napi_create_error(env, nullptr, message, &error));
+        check(env, napi_reject_deferred(env, call->deferred, error));
+      } else if (call->failed()) {
+        check(env,
+              napi_reject_deferred(env, call->deferred, call->failure(env)));
+      } else {
+        check(env,
+              napi_resolve_deferred(env, call->deferred, call->value(env)));
+      }
+    } catch (const PendingException &) {
+      // Converting the result threw, reject with that instead
+      napi_value error;
+      if (napi_get_and_clear_last_exception(env, &error) == napi_ok)
+        napi_reject_deferred(env, call->deferred, error);
+    }
+  }
+
+  // `fn.async(...inputs)`. Invalid arguments throw, like they do for the
+  // synchronous call.
+  static napi_value async(napi_env env, napi_callback_info info) {
+    try {
+      auto call = decode(env, info);
+
+      napi_value promise;
+      check(env, napi_create_promise(env, &call->deferred, &promise));
+      napi_value resourceName;
+      check(env, napi_create_string_utf8(env, "anoncreds", NAPI_AUTO_LENGTH,
+                                         &resourceName));
+      check(env, napi_create_async_work(env, nullptr, resourceName, execute,
+                                        complete, call.get(), &call->work));
+      auto status = napi_queue_async_work(env, call->work);
+      if (status != napi_ok) {
+        napi_delete_async_work(env, call->work);
+        check(env, status);
+      }
+      call.release();
+      return promise;
+    } catch (const ArgumentError &e) {
+      throwTypeError(env, e.what());
+    } catch (const PendingException &) {
+    }
+    return nullptr;
+  }
+};
+
+// Defines `name` on `exports` as a function with an `async` property
+void define(napi_env env, napi_value exports, const char *name,
+            napi_callback sync, napi_callback async);
+
+template <auto fn>
+void define(napi_env env, napi_value exports, const char *name) {
+  define(env, exports, name, Function<fn>::sync, Function<fn>::async);
+}
+
+// Defines `setErrorConstructor(constructor)`, which sets the class failed
+// calls throw. It is called with the parsed error JSON, `{ code, message }`.
+// Until it is set a plain `Error` with a `code` is thrown.
+void defineErrorConstructor(napi_env env, napi_value exports);
+
+} // namespace anoncredsBinding
@@ -1,69 +1,78 @@
 import type {
   Anoncreds,
-  AnoncredsErrorObject,
   NativeCredentialEntry,
   NativeCredentialProve,
   NativeCredentialRevocationConfig,
   NativeNonRevokedIntervalOverride,
 } from '@hyperledger/anoncreds-shared'
-import type { TypedArray } from 'ref-array-di'
-import type { StructObject } from 'ref-struct-di'
-
-import { TextDecoder, TextEncoder } from 'util'
-import { AnoncredsError, ByteBuffer, ObjectHandle } from '@hyperledger/anoncreds-shared'
-
-import {
-  CredRevInfoStruct,
-  CredentialEntryListStruct,
-  CredentialEntryStruct,
-  CredentialProveListStruct,
-  CredentialProveStruct,
-  NonRevokedIntervalOverrideListStruct,
-  NonRevokedIntervalOverrideStruct,
-  ObjectHandleArray,
-  ObjectHandleListStruct,
-  StringListStruct,
-  allocateByteBuffer,
-  allocateInt8Buffer,
-  allocatePointer,
-  allocateStringBuffer,
-  byteBufferToBuffer,
-  serializeArguments,
-} from './ffi'
+import type { NativeBackend } from './library'
+
+import { ObjectHandle } from '@hyperledger/anoncreds-shared'
+
 import { getNativeAnoncreds } from './library'
 
-function handleReturnPointer<Return>(returnValue: Buffer, cleanupCallback?: (buffer: Buffer) => void): Return {
-  if (returnValue.address() === 0) {
-    throw AnoncredsError.customError({ message: 'Unexpected null pointer' })
-  }
+type CreateCredentialDefinitionOptions = {
+  schemaId: string
+  schema: ObjectHandle
+  issuerId: string
+  tag: string
+  signatureType: string
+  supportRevocation: boolean
+}
 
-  const ret = returnValue.deref() as Return
-  if (cleanupCallback) cleanupCallback(returnValue)
+type CreateCredentialOptions = {
+  credentialDefinition: ObjectHandle
+  credentialDefinitionPrivate: ObjectHandle
+  credentialOffer: ObjectHandle
+  credentialRequest: ObjectHandle
+  attributeRawValues: Record<string, string>
+  attributeEncodedValues?: Record<string, string>
+  revocationConfiguration?: NativeCredentialRevocationConfig
+}
 
-  return ret
+type CreatePresentationOptions = {
+  presentationRequest: ObjectHandle
+  credentials: NativeCredentialEntry[]
+  credentialsProve: NativeCredentialProve[]
+  selfAttest: Record<string, string>
+  linkSecret: string
+  schemas: Record<string, ObjectHandle>
+  credentialDefinitions: Record<string, ObjectHandle>
 }
 
-export class NodeJSAnoncreds implements Anoncreds {
-  private handleError() {
-    const nativeError = allocateStringBuffer()
-    getNativeAnoncreds().anoncreds_get_current_error(nativeError)
-    const anoncredsErrorObject = JSON.parse(nativeError.deref() as string) as AnoncredsErrorObject
+type VerifyPresentationOptions = {
+  presentation: ObjectHandle
+  presentationRequest: ObjectHandle
+  schemas: ObjectHandle[]
+  schemaIds: string[]
+  credentialDefinitions: ObjectHandle[]
+  credentialDefinitionIds: string[]
+  revocationRegistryDefinitions?: ObjectHandle[]
+  revocationRegistryDefinitionIds?: string[]
+  revocationStatusLists?: ObjectHandle[]
+  nonRevokedIntervalOverrides?: NativeNonRevokedIntervalOverride[]
+}
 
-    if (anoncredsErrorObject.code === 0) return
+/**
+ * Anoncreds implementation on top of a `NativeBackend`, which is either the N-API addon built with `pnpm build:napi`
+ * or the `ffi-napi` library. By default the backend is picked by `getNativeAnoncreds`.
+ *
+ * Next to the synchronous `Anoncreds` methods it has `Async` variants of the expensive calls, which run on the libuv
+ * thread pool. Objects passed to an async call must not be freed before the returned promise settles.
+ */
+export class NodeJSAnoncreds implements Anoncreds {
+  private readonly backend?: NativeBackend
 
-    throw new AnoncredsError(anoncredsErrorObject)
+  public constructor(backend?: NativeBackend) {
+    this.backend = backend
   }
 
   public get nativeAnoncreds() {
-    return getNativeAnoncreds()
+    return this.backend ?? getNativeAnoncreds()
   }
 
   public generateNonce(): string {
-    const ret = allocateStringBuffer()
-    this.nativeAnoncreds.anoncreds_generate_nonce(ret)
-    this.handleError()
-
-    return handleReturnPointer<string>(ret)
+    return this.nativeAnoncreds.anoncreds_generate_nonce()
   }
 
   public createSchema(options: {
@@ -72,119 +81,74 @@ export class NodeJSAnoncreds implements Anoncreds {
     issuerId: string
     attributeNames: string[]
   }): ObjectHandle {
-    const { name, version, issuerId, attributeNames } = serializeArguments(options)
-
-    const ret = allocatePointer()
+    const { name, version, issuerId, attributeNames } = options
 
-    this.nativeAnoncreds.anoncreds_create_schema(name, version, issuerId, attributeNames, ret)
-    this.handleError()
-
-    return new ObjectHandle(handleReturnPointer<number>(ret))
+    return new ObjectHandle(this.nativeAnoncreds.anoncreds_create_schema(name, version, issuerId, attributeNames))
   }
 
   public revocationRegistryDefinitionGetAttribute(options: { objectHandle: ObjectHandle; name: string }) {
-    const { objectHandle, name } = serializeArguments(options)
-
-    const ret = allocateStringBuffer()
-    this.nativeAnoncreds.anoncreds_revocation_registry_definition_get_attribute(objectHandle, name, ret)
-    this.handleError()
-
-    return handleReturnPointer<string>(ret)
+    return this.nativeAnoncreds.anoncreds_revocation_registry_definition_get_attribute(
+      options.objectHandle,
+      options.name
+    )
   }
 
   public credentialGetAttribute(options: { objectHandle: ObjectHandle; name: string }) {
-    const { objectHandle, name } = serializeArguments(options)
+    return this.nativeAnoncreds.anoncreds_credential_get_attribute(options.objectHandle, options.name)
+  }
 
-    const ret = allocateStringBuffer()
-    this.nativeAnoncreds.anoncreds_credential_get_attribute(objectHandle, name, ret)
-    this.handleError()
+  public createCredentialDefinition(options: CreateCredentialDefinitionOptions) {
+    const method = this.nativeAnoncreds.anoncreds_create_credential_definition
+    return this.toCredentialDefinition(method(...this.createCredentialDefinitionArgs(options)))
+  }
 
-    return handleReturnPointer<string>(ret)
+  public async createCredentialDefinitionAsync(options: CreateCredentialDefinitionOptions) {
+    const method = this.nativeAnoncreds.anoncreds_create_credential_definition
+    return this.toCredentialDefinition(await method.async(...this.createCredentialDefinitionArgs(options)))
   }
 
-  public createCredentialDefinition(options: {
-    schemaId: string
-    schema: ObjectHandle
-    issuerId: string
-    tag: string
-    signatureType: string
-    supportRevocation: boolean
-  }): {
-    credentialDefinition: ObjectHandle
-    credentialDefinitionPrivate: ObjectHandle
-    keyCorrectnessProof: ObjectHandle
-  } {
-    const { schemaId, issuerId, schema, tag, signatureType, supportRevocation } = serializeArguments(options)
-
-    const credentialDefinitionPtr = allocatePointer()
-    const credentialDefinitionPrivatePtr = allocatePointer()
-    const keyCorrectnessProofPtr = allocatePointer()
-
-    this.nativeAnoncreds.anoncreds_create_credential_definition(
-      schemaId,
-      schema,
-      tag,
-      issuerId,
-      signatureType,
-      supportRevocation,
-      credentialDefinitionPtr,
-      credentialDefinitionPrivatePtr,
-      keyCorrectnessProofPtr
-    )
-    this.handleError()
+  private createCredentialDefinitionArgs(options: CreateCredentialDefinitionOptions) {
+    const { schemaId, schema, tag, issuerId, signatureType, supportRevocation } = options
+    return [schemaId, schema, tag, issuerId, signatureType, supportRevocation] as const
+  }
 
+  private toCredentialDefinition([credentialDefinition, credentialDefinitionPrivate, keyCorrectnessProof]: [
+    number,
+    number,
+    number,
+  ]) {
     return {
-      credentialDefinition: new ObjectHandle(handleReturnPointer<number>(credentialDefinitionPtr)),
-      credentialDefinitionPrivate: new ObjectHandle(handleReturnPointer<number>(credentialDefinitionPrivatePtr)),
-      keyCorrectnessProof: new ObjectHandle(handleReturnPointer<number>(keyCorrectnessProofPtr)),
+      credentialDefinition: new ObjectHandle(credentialDefinition),
+      credentialDefinitionPrivate: new ObjectHandle(credentialDefinitionPrivate),
+      keyCorrectnessProof: new ObjectHandle(keyCorrectnessProof),
     }
   }
 
-  public createCredential(options: {
-    credentialDefinition: ObjectHandle
-    credentialDefinitionPrivate: ObjectHandle
-    credentialOffer: ObjectHandle
-    credentialRequest: ObjectHandle
-    attributeRawValues: Record<string, string>
-    attributeEncodedValues?: Record<string, string>
-    revocationConfiguration?: NativeCredentialRevocationConfig
-  }): ObjectHandle {
-    const { credentialDefinition, credentialDefinitionPrivate, credentialOffer, credentialRequest } =
-      serializeArguments(options)
-
-    const attributeNames = this.convertAttributeNames(options.attributeRawValues)
-    const attributeRawValues = this.convertAttributeRawValues(options.attributeRawValues)
-    const attributeEncodedValues = this.convertAttributeEncodedValues(options.attributeEncodedValues)
-    const revocationConfiguration = this.convertRevocationConfiguration(options.revocationConfiguration)
-
-    const credentialPtr = allocatePointer()
-    this.nativeAnoncreds.anoncreds_create_credential(
-      credentialDefinition,
-      credentialDefinitionPrivate,
-      credentialOffer,
-      credentialRequest,
-      attributeNames,
-      attributeRawValues,
-      attributeEncodedValues as unknown as Buffer,
-      revocationConfiguration?.ref().address() ?? 0,
-      credentialPtr
-    )
-    this.handleError()
-
-    return new ObjectHandle(handleReturnPointer<number>(credentialPtr))
+  public createCredential(options: CreateCredentialOptions): ObjectHandle {
+    const method = this.nativeAnoncreds.anoncreds_create_credential
+    return new ObjectHandle(method(...this.createCredentialArgs(options)))
   }
 
-  public encodeCredentialAttributes(options: { attributeRawValues: string[] }): string[] {
-    const { attributeRawValues } = serializeArguments(options)
-
-    const ret = allocateStringBuffer()
-
-    this.nativeAnoncreds.anoncreds_encode_credential_attributes(attributeRawValues, ret)
-    this.handleError()
+  public async createCredentialAsync(options: CreateCredentialOptions): Promise<ObjectHandle> {
+    const method = this.nativeAnoncreds.anoncreds_create_credential
+    return new ObjectHandle(await method.async(...this.createCredentialArgs(options)))
+  }
 
-    const result = handleReturnPointer<string>(ret)
+  private createCredentialArgs(options: CreateCredentialOptions) {
+    return [
+      options.credentialDefinition,
+      options.credentialDefinitionPrivate,
+      options.credentialOffer,
+      options.credentialRequest,
+      Object.keys(options.attributeRawValues),
+      Object.values(options.attributeRawValues),
+      options.attributeEncodedValues ? Object.values(options.attributeEncodedValues) : undefined,
+      options.revocationConfiguration,
+    ] as const
+  }
 
-    return result.split(',')
+  public encodeCredentialAttributes(options: { attributeRawValues: string[] }): string[] {
+    return this.nativeAnoncreds.anoncreds_encode_credential_attributes(options.attributeRawValues).split(',')
   }
 
   public processCredential(options: {
@@ -194,21 +158,15 @@ export class NodeJSAnoncreds implements Anoncreds {
     credentialDefinition: ObjectHandle
     revocationRegistryDefinition?: ObjectHandle | undefined
   }): ObjectHandle {
-    const { credential, credentialRequestMetadata, linkSecret, credentialDefinition } = serializeArguments(options)
-
-    const ret = allocatePointer()
-
-    this.nativeAnoncreds.anoncreds_process_credential(
-      credential,
-      credentialRequestMetadata,
-      linkSecret,
-      credentialDefinition,
-      options.revocationRegistryDefinition?.handle ?? 0,
-      ret
+    const handle = this.nativeAnoncreds.anoncreds_process_credential(
+      options.credential,
+      options.credentialRequestMetadata,
+      options.linkSecret,
+      options.credentialDefinition,
+      options.revocationRegistryDefinition
     )
-    this.handleError()
 
-    return new ObjectHandle(handleReturnPointer<number>(ret))
+    return new ObjectHandle(handle)
   }
 
   public createCredentialOffer(options: {
@@ -216,13 +174,11 @@ export class NodeJSAnoncreds implements Anoncreds {
     credentialDefinitionId: string
     keyCorrectnessProof: ObjectHandle
   }): ObjectHandle {
-    const { schemaId, credentialDefinitionId, keyCorrectnessProof } = serializeArguments(options)
+    const { schemaId, credentialDefinitionId, keyCorrectnessProof } = options
 
-    const ret = allocatePointer()
-    this.nativeAnoncreds.anoncreds_create_credential_offer(schemaId, credentialDefinitionId, keyCorrectnessProof, ret)
-    this.handleError()
-
-    return new ObjectHandle(handleReturnPointer<number>(ret))
+    return new ObjectHandle(
+      this.nativeAnoncreds.anoncreds_create_credential_offer(schemaId, credentialDefinitionId, keyCorrectnessProof)
+    )
   }
 
   public createCredentialRequest(options: {
@@ -233,129 +189,71 @@ export class NodeJSAnoncreds implements Anoncreds {
     linkSecretId: string
     credentialOffer: ObjectHandle
   }): { credentialRequest: ObjectHandle; credentialRequestMetadata: ObjectHandle } {
-    const { entropy, proverDid, credentialDefinition, linkSecret, linkSecretId, credentialOffer } =
-      serializeArguments(options)
-
-    const credentialRequestPtr = allocatePointer()
-    const credentialRequestMetadataPtr = allocatePointer()
-
-    this.nativeAnoncreds.anoncreds_create_credential_request(
-      entropy,
-      proverDid,
-      credentialDefinition,
-      linkSecret,
-      linkSecretId,
-      credentialOffer,
-      credentialRequestPtr,
-      credentialRequestMetadataPtr
+    const [credentialRequest, credentialRequestMetadata] = this.nativeAnoncreds.anoncreds_create_credential_request(
+      options.entropy,
+      options.proverDid,
+      options.credentialDefinition,
+      options.linkSecret,
+      options.linkSecretId,
+      options.credentialOffer
     )
-    this.handleError()
 
     return {
-      credentialRequest: new ObjectHandle(handleReturnPointer<number>(credentialRequestPtr)),
-      credentialRequestMetadata: new ObjectHandle(handleReturnPointer<number>(credentialRequestMetadataPtr)),
+      credentialRequest: new ObjectHandle(credentialRequest),
+      credentialRequestMetadata: new ObjectHandle(credentialRequestMetadata),
     }
   }
 
   public createLinkSecret(): string {
-    const ret = allocateStringBuffer()
+    return this.nativeAnoncreds.anoncreds_create_link_secret()
+  }
 
-    this.nativeAnoncreds.anoncreds_create_link_secret(ret)
-    this.handleError()
+  public createPresentation(options: CreatePresentationOptions): ObjectHandle {
+    const method = this.nativeAnoncreds.anoncreds_create_presentation
+    return new ObjectHandle(method(...this.createPresentationArgs(options)))
+  }
 
-    return handleReturnPointer<string>(ret)
+  public async createPresentationAsync(options: CreatePresentationOptions): Promise<ObjectHandle> {
+    const method = this.nativeAnoncreds.anoncreds_create_presentation
+    return new ObjectHandle(await method.async(...this.createPresentationArgs(options)))
   }
 
-  public createPresentation(options: {
-    presentationRequest: ObjectHandle
-    credentials: NativeCredentialEntry[]
-    credentialsProve: NativeCredentialProve[]
-    selfAttest: Record<string, string>
-    linkSecret: string
-    schemas: Record<string, ObjectHandle>
-    credentialDefinitions: Record<string, ObjectHandle>
-  }): ObjectHandle {
-    const { presentationRequest, linkSecret } = serializeArguments(options)
-
-    const selfAttestNames = StringListStruct({
-      count: Object.keys(options.selfAttest).length,
-      data: Object.keys(options.selfAttest) as unknown as TypedArray<string>,
-    })
-
-    const selfAttestValues = StringListStruct({
-      count: Object.values(options.selfAttest).length,
-      data: Object.values(options.selfAttest) as unknown as TypedArray<string>,
-    })
-
-    const credentialEntryList = this.convertCredentialList(options.credentials)
-    const credentialProveList = this.convertCredentialProves(options.credentialsProve)
-    const { schemaIds, schemas } = this.convertSchemas(options.schemas)
-    const { credentialDefinitionIds, credentialDefinitions } = this.convertCredDefs(options.credentialDefinitions)
-
-    const ret = allocatePointer()
-
-    this.nativeAnoncreds.anoncreds_create_presentation(
-      presentationRequest,
-      credentialEntryList,
-      credentialProveList,
-      selfAttestNames as unknown as Buffer,
-      selfAttestValues as unknown as Buffer,
-      linkSecret,
-      schemas,
-      schemaIds,
-      credentialDefinitions,
-      credentialDefinitionIds,
-      ret
-    )
-    this.handleError()
+  private createPresentationArgs(options: CreatePresentationOptions) {
+    return [
+      options.presentationRequest,
+      options.credentials,
+      options.credentialsProve,
+      Object.keys(options.selfAttest),
+      Object.values(options.selfAttest),
+      options.linkSecret,
+      Object.values(options.schemas),
+      Object.keys(options.schemas),
+      Object.values(options.credentialDefinitions),
+      Object.keys(options.credentialDefinitions),
+    ] as const
+  }
 
-    return new ObjectHandle(handleReturnPointer<number>(ret))
+  public verifyPresentation(options: VerifyPresentationOptions): boolean {
+    return this.nativeAnoncreds.anoncreds_verify_presentation(...this.verifyPresentationArgs(options))
   }
 
-  public verifyPresentation(options: {
-    presentation: ObjectHandle
-    presentationRequest: ObjectHandle
-    schemas: ObjectHandle[]
-    schemaIds: string[]
-    credentialDefinitions: ObjectHandle[]
-    credentialDefinitionIds: string[]
-    revocationRegistryDefinitions?: ObjectHandle[]
-    revocationRegistryDefinitionIds?: string[]
-    revocationStatusLists?: ObjectHandle[]
-    nonRevokedIntervalOverrides?: NativeNonRevokedIntervalOverride[]
-  }): boolean {
-    const {
-      presentation,
-      presentationRequest,
-      schemas,
-      credentialDefinitions,
-      revocationRegistryDefinitions,
-      revocationStatusLists,
-      revocationRegistryDefinitionIds,
-      schemaIds,
-      credentialDefinitionIds,
-    } = serializeArguments(options)
-
-    const nonRevokedIntervalOverrideList = this.convertNonRevokedIntervalOverrides(options.nonRevokedIntervalOverrides)
-
-    const ret = allocateInt8Buffer()
-
-    this.nativeAnoncreds.anoncreds_verify_presentation(
-      presentation,
-      presentationRequest,
-      schemas,
-      schemaIds,
-      credentialDefinitions,
-      credentialDefinitionIds,
-      revocationRegistryDefinitions,
-      revocationRegistryDefinitionIds,
-      revocationStatusLists,
-      nonRevokedIntervalOverrideList,
-      ret
-    )
-    this.handleError()
+  public verifyPresentationAsync(options: VerifyPresentationOptions): Promise<boolean> {
+    return this.nativeAnoncreds.anoncreds_verify_presentation.async(...this.verifyPresentationArgs(options))
+  }
 
-    return Boolean(handleReturnPointer<number>(ret))
+  private verifyPresentationArgs(options: VerifyPresentationOptions) {
+    return [
+      options.presentation,
+      options.presentationRequest,
+      options.schemas,
+      options.schemaIds,
+      options.credentialDefinitions,
+      options.credentialDefinitionIds,
+      options.revocationRegistryDefinitions,
+      options.revocationRegistryDefinitionIds,
+      options.revocationStatusLists,
+      options.nonRevokedIntervalOverrides,
+    ] as const
   }
 
   public createRevocationStatusList(options: {
@@ -367,48 +265,29 @@ export class NodeJSAnoncreds implements Anoncreds {
     issuanceByDefault: boolean
     timestamp?: number
   }): ObjectHandle {
-    const {
-      credentialDefinition,
-      revocationRegistryDefinitionId,
-      revocationRegistryDefinition,
-      revocationRegistryDefinitionPrivate,
-      issuerId,
-      issuanceByDefault,
-      timestamp,
-    } = serializeArguments(options)
-
-    const ret = allocatePointer()
-
-    this.nativeAnoncreds.anoncreds_create_revocation_status_list(
-      credentialDefinition,
-      revocationRegistryDefinitionId,
-      revocationRegistryDefinition,
-      revocationRegistryDefinitionPrivate,
-      issuerId,
-      issuanceByDefault,
-      timestamp ?? -1,
-      ret
+    const handle = this.nativeAnoncreds.anoncreds_create_revocation_status_list(
+      options.credentialDefinition,
+      options.revocationRegistryDefinitionId,
+      options.revocationRegistryDefinition,
+      options.revocationRegistryDefinitionPrivate,
+      options.issuerId,
+      options.issuanceByDefault,
+      options.timestamp ?? -1
     )
-    this.handleError()
 
-    return new ObjectHandle(handleReturnPointer<number>(ret))
+    return new ObjectHandle(handle)
   }
 
   public updateRevocationStatusListTimestampOnly(options: {
     timestamp: number
     currentRevocationStatusList: ObjectHandle
   }): ObjectHandle {
-    const { currentRevocationStatusList, timestamp } = serializeArguments(options)
-    const ret = allocatePointer()
-
-    this.nativeAnoncreds.anoncreds_update_revocation_status_list_timestamp_only(
-      timestamp,
-      currentRevocationStatusList,
-      ret
+    const handle = this.nativeAnoncreds.anoncreds_update_revocation_status_list_timestamp_only(
+      options.timestamp,
+      options.currentRevocationStatusList
     )
-    this.handleError()
 
-    return new ObjectHandle(handleReturnPointer<number>(ret))
+    return new ObjectHandle(handle)
   }
 
   public updateRevocationStatusList(options: {
@@ -420,30 +299,17 @@ export class NodeJSAnoncreds implements Anoncreds {
     revoked?: number[]
     timestamp?: number
   }): ObjectHandle {
-    const {
-      credentialDefinition,
-      revocationRegistryDefinition,
-      revocationRegistryDefinitionPrivate,
-      currentRevocationStatusList,
-      issued,
-      revoked,
-      timestamp,
-    } = serializeArguments(options)
-    const ret = allocatePointer()
-
-    this.nativeAnoncreds.anoncreds_update_revocation_status_list(
-      credentialDefinition,
-      revocationRegistryDefinition,
-      revocationRegistryDefinitionPrivate,
-      currentRevocationStatusList,
-      issued,
-      revoked,
-      timestamp ?? -1,
-      ret
+    const handle = this.nativeAnoncreds.anoncreds_update_revocation_status_list(
+      options.credentialDefinition,
+      options.revocationRegistryDefinition,
+      options.revocationRegistryDefinitionPrivate,
+      options.currentRevocationStatusList,
+      options.issued,
+      options.revoked,
+      options.timestamp ?? -1
     )
-    this.handleError()
 
-    return new ObjectHandle(handleReturnPointer<number>(ret))
+    return new ObjectHandle(handle)
   }
 
   public createRevocationRegistryDefinition(options: {
@@ -455,37 +321,20 @@ export class NodeJSAnoncreds implements Anoncreds {
     maximumCredentialNumber: number
     tailsDirectoryPath?: string
   }) {
-    const {
-      credentialDefinition,
-      credentialDefinitionId,
-      tag,
-      revocationRegistryType,
-      issuerId,
-      maximumCredentialNumber,
-      tailsDirectoryPath,
-    } = serializeArguments(options)
-
-    const revocationRegistryDefinitionPtr = allocatePointer()
-    const revocationRegistryDefinitionPrivate = allocatePointer()
-
-    this.nativeAnoncreds.anoncreds_create_revocation_registry_def(
-      credentialDefinition,
-      credentialDefinitionId,
-      issuerId,
-      tag,
-      revocationRegistryType,
-      maximumCredentialNumber,
-      tailsDirectoryPath,
-      revocationRegistryDefinitionPtr,
-      revocationRegistryDefinitionPrivate
-    )
-    this.handleError()
+    const [revocationRegistryDefinition, revocationRegistryDefinitionPrivate] =
+      this.nativeAnoncreds.anoncreds_create_revocation_registry_def(
+        options.credentialDefinition,
+        options.credentialDefinitionId,
+        options.issuerId,
+        options.tag,
+        options.revocationRegistryType,
+        options.maximumCredentialNumber,
+        options.tailsDirectoryPath
+      )
 
     return {
-      revocationRegistryDefinition: new ObjectHandle(handleReturnPointer<number>(revocationRegistryDefinitionPtr)),
-      revocationRegistryDefinitionPrivate: new ObjectHandle(
-        handleReturnPointer<number>(revocationRegistryDefinitionPrivate)
-      ),
+      revocationRegistryDefinition: new ObjectHandle(revocationRegistryDefinition),
+      revocationRegistryDefinitionPrivate: new ObjectHandle(revocationRegistryDefinitionPrivate),
     }
   }
 
@@ -497,25 +346,16 @@ export class NodeJSAnoncreds implements Anoncreds {
     oldRevocationState?: ObjectHandle
     oldRevocationStatusList?: ObjectHandle
   }): ObjectHandle {
-    const { revocationRegistryDefinition, revocationStatusList, revocationRegistryIndex, tailsPath } =
-      serializeArguments(options)
-
-    const oldRevocationState = options.oldRevocationState ?? new ObjectHandle(0)
-    const oldRevocationStatusList = options.oldRevocationStatusList ?? new ObjectHandle(0)
-    const ret = allocatePointer()
-
-    this.nativeAnoncreds.anoncreds_create_or_update_revocation_state(
-      revocationRegistryDefinition,
-      revocationStatusList,
-      revocationRegistryIndex,
-      tailsPath,
-      oldRevocationState.handle,
-      oldRevocationStatusList.handle,
-      ret
+    const handle = this.nativeAnoncreds.anoncreds_create_or_update_revocation_state(
+      options.revocationRegistryDefinition,
+      options.revocationStatusList,
+      options.revocationRegistryIndex,
+      options.tailsPath,
+      options.oldRevocationState,
+      options.oldRevocationStatusList
     )
-    this.handleError()
 
-    return new ObjectHandle(handleReturnPointer<number>(ret))
+    return new ObjectHandle(handle)
   }
 
   public createW3cCredential(options: {
@@ -527,28 +367,18 @@ export class NodeJSAnoncreds implements Anoncreds {
     revocationConfiguration?: NativeCredentialRevocationConfig
     w3cVersion?: string
   }): ObjectHandle {
-    const { credentialDefinition, credentialDefinitionPrivate, credentialOffer, credentialRequest, w3cVersion } =
-      serializeArguments(options)
-
-    const attributeNames = this.convertAttributeNames(options.attributeRawValues)
-    const attributeRawValues = this.convertAttributeRawValues(options.attributeRawValues)
-    const revocationConfiguration = this.convertRevocationConfiguration(options.revocationConfiguration)
-
-    const credentialPtr = allocatePointer()
-    this.nativeAnoncreds.anoncreds_create_w3c_credential(
-      credentialDefinition,
-      credentialDefinitionPrivate,
-      credentialOffer,
-      credentialRequest,
-      attributeNames,
-      attributeRawValues,
-      revocationConfiguration?.ref().address() ?? 0,
-      w3cVersion,
-      credentialPtr
+    const handle = this.nativeAnoncreds.anoncreds_create_w3c_credential(
+      options.credentialDefinition,
+      options.credentialDefinitionPrivate,
+      options.credentialOffer,
+      options.credentialRequest,
+      Object.keys(options.attributeRawValues),
+      Object.values(options.attributeRawValues),
+      options.revocationConfiguration,
+      options.w3cVersion
     )
-    this.handleError()
 
-    return new ObjectHandle(handleReturnPointer<number>(credentialPtr))
+    return new ObjectHandle(handle)
   }
 
   public processW3cCredential(options: {
@@ -558,21 +388,15 @@ export class NodeJSAnoncreds implements Anoncreds {
     credentialDefinition: ObjectHandle
     revocationRegistryDefinition?: ObjectHandle | undefined
   }): ObjectHandle {
-    const { credential, credentialRequestMetadata, linkSecret, credentialDefinition } = serializeArguments(options)
-
-    const ret = allocatePointer()
-
-    this.nativeAnoncreds.anoncreds_process_w3c_credential(
-      credential,
-      credentialRequestMetadata,
-      linkSecret,
-      credentialDefinition,
-      options.revocationRegistryDefinition?.handle ?? 0,
-      ret
+    const handle = this.nativeAnoncreds.anoncreds_process_w3c_credential(
+      options.credential,
+      options.credentialRequestMetadata,
+      options.linkSecret,
+      options.credentialDefinition,
+      options.revocationRegistryDefinition
     )
-    this.handleError()
 
-    return new ObjectHandle(handleReturnPointer<number>(ret))
+    return new ObjectHandle(handle)
   }
 
   public createW3cPresentation(options: {
@@ -584,118 +408,43 @@ export class NodeJSAnoncreds implements Anoncreds {
     credentialDefinitions: Record<string, ObjectHandle>
     w3cVersion?: string
   }): ObjectHandle {
-    const { presentationRequest, linkSecret, w3cVersion } = serializeArguments(options)
-
-    const credentialEntryList = this.convertCredentialList(options.credentials)
-    const credentialProveList = this.convertCredentialProves(options.credentialsProve)
-    const { schemaIds, schemas } = this.convertSchemas(options.schemas)
-    const { credentialDefinitionIds, credentialDefinitions } = this.convertCredDefs(options.credentialDefinitions)
-
-    const ret = allocatePointer()
-
-    this.nativeAnoncreds.anoncreds_create_w3c_presentation(
-      presentationRequest,
-      credentialEntryList,
-      credentialProveList,
-      linkSecret,
-      schemas,
-      schemaIds,
-      credentialDefinitions,
-      credentialDefinitionIds,
-      w3cVersion,
-      ret
+    const handle = this.nativeAnoncreds.anoncreds_create_w3c_presentation(
+      options.presentationRequest,
+      options.credentials,
+      options.credentialsProve,
+      options.linkSecret,
+      Object.values(options.schemas),
+      Object.keys(options.schemas),
+      Object.values(options.credentialDefinitions),
+      Object.keys(options.credentialDefinitions),
+      options.w3cVersion
     )
-    this.handleError()
 
-    return new ObjectHandle(handleReturnPointer<number>(ret))
+    return new ObjectHandle(handle)
   }
 
-  public verifyW3cPresentation(options: {
-    presentation: ObjectHandle
-    presentationRequest: ObjectHandle
-    schemas: ObjectHandle[]
-    schemaIds: string[]
-    credentialDefinitions: ObjectHandle[]
-    credentialDefinitionIds: string[]
-    revocationRegistryDefinitions?: ObjectHandle[]
-    revocationRegistryDefinitionIds?: string[]
-    revocationStatusLists?: ObjectHandle[]
-    nonRevokedIntervalOverrides?: NativeNonRevokedIntervalOverride[]
-  }): boolean {
-    const {
-      presentation,
-      presentationRequest,
-      schemas,
-      credentialDefinitions,
-      revocationRegistryDefinitions,
-      revocationStatusLists,
-      revocationRegistryDefinitionIds,
-      schemaIds,
-      credentialDefinitionIds,
-    } = serializeArguments(options)
-
-    const nonRevokedIntervalOverrideList = this.convertNonRevokedIntervalOverrides(options.nonRevokedIntervalOverrides)
-
-    const ret = allocateInt8Buffer()
-
-    this.nativeAnoncreds.anoncreds_verify_w3c_presentation(
-      presentation,
-      presentationRequest,
-      schemas,
-      schemaIds,
-      credentialDefinitions,
-      credentialDefinitionIds,
-      revocationRegistryDefinitions,
-      revocationRegistryDefinitionIds,
-      revocationStatusLists,
-      nonRevokedIntervalOverrideList,
-      ret
-    )
-    this.handleError()
-
-    return Boolean(handleReturnPointer<number>(ret))
+  public verifyW3cPresentation(options: VerifyPresentationOptions): boolean {
+    return this.nativeAnoncreds.anoncreds_verify_w3c_presentation(...this.verifyPresentationArgs(options))
   }
 
   public credentialToW3c(options: { objectHandle: ObjectHandle; issuerId: string; w3cVersion?: string }): ObjectHandle {
-    const { objectHandle, issuerId, w3cVersion } = serializeArguments(options)
-
-    const ret = allocatePointer()
-
-    this.nativeAnoncreds.anoncreds_credential_to_w3c(objectHandle, issuerId, w3cVersion, ret)
-    this.handleError()
+    const { objectHandle, issuerId, w3cVersion } = options
 
-    return new ObjectHandle(handleReturnPointer<number>(ret))
+    return new ObjectHandle(this.nativeAnoncreds.anoncreds_credential_to_w3c(objectHandle, issuerId, w3cVersion))
   }
 
   public credentialFromW3c(options: { objectHandle: ObjectHandle }): ObjectHandle {
-    const { objectHandle } = serializeArguments(options)
-
-    const ret = allocatePointer()
-
-    this.nativeAnoncreds.anoncreds_credential_from_w3c(objectHandle, ret)
-    this.handleError()
-
-    return new ObjectHandle(handleReturnPointer<number>(ret))
+    return new ObjectHandle(this.nativeAnoncreds.anoncreds_credential_from_w3c(options.objectHandle))
   }
 
   public w3cCredentialGetIntegrityProofDetails(options: { objectHandle: ObjectHandle }) {
-    const { objectHandle } = serializeArguments(options)
-
-    const ret = allocatePointer()
-    this.nativeAnoncreds.anoncreds_w3c_credential_get_integrity_proof_details(objectHandle, ret)
-    this.handleError()
-
-    return new ObjectHandle(handleReturnPointer<number>(ret))
+    return new ObjectHandle(
+      this.nativeAnoncreds.anoncreds_w3c_credential_get_integrity_proof_details(options.objectHandle)
+    )
   }
 
   public w3cCredentialProofGetAttribute(options: { objectHandle: ObjectHandle; name: string }) {
-    const { objectHandle, name } = serializeArguments(options)
-
-    const ret = allocateStringBuffer()
-    this.nativeAnoncreds.anoncreds_w3c_credential_proof_get_attribute(objectHandle, name, ret)
-    this.handleError()
-
-    return handleReturnPointer<string>(ret)
+    return this.nativeAnoncreds.anoncreds_w3c_credential_proof_get_attribute(options.objectHandle, options.name)
   }
 
   public w3cCredentialFromJson(options: { json: string }): ObjectHandle {
@@ -712,27 +461,15 @@ export class NodeJSAnoncreds implements Anoncreds {
 
   public setDefaultLogger(): void {
     this.nativeAnoncreds.anoncreds_set_default_logger()
-    this.handleError()
   }
 
   // This should be called when a function returns a non-zero code
   public getCurrentError(): string {
-    const ret = allocateStringBuffer()
-    this.nativeAnoncreds.anoncreds_get_current_error(ret)
-    this.handleError()
-
-    return handleReturnPointer<string>(ret)
+    return this.nativeAnoncreds.anoncreds_get_current_error()
   }
 
-  private objectFromJson(method: (byteBuffer: Buffer, ret: Buffer) => unknown, options: { json: string }) {
-    const ret = allocatePointer()
-
-    const byteBuffer = ByteBuffer.fromUint8Array(new TextEncoder().encode(options.json))
-    this.handleError()
-
-    method(byteBuffer as unknown as Buffer, ret)
-
-    return new ObjectHandle(handleReturnPointer<number>(ret))
+  private objectFromJson(method: (json: string) => number, options: { json: string }) {
+    return new ObjectHandle(method(options.json))
   }
 
   public presentationRequestFromJson(options: { json: string }) {
@@ -796,171 +533,14 @@ export class NodeJSAnoncreds implements Anoncreds {
   }
 
   public getJson(options: { objectHandle: ObjectHandle }) {
-    const ret = allocateByteBuffer()
-
-    const { objectHandle } = serializeArguments(options)
-    this.nativeAnoncreds.anoncreds_object_get_json(objectHandle, ret)
-    this.handleError()
-
-    const returnValue = handleReturnPointer<{ data: Buffer; len: number }>(ret)
-    const jsonAsArray = new Uint8Array(byteBufferToBuffer(returnValue))
-
-    const output = new TextDecoder().decode(jsonAsArray)
-
-    this.nativeAnoncreds.anoncreds_buffer_free(returnValue.data)
-
-    return output
+    return this.nativeAnoncreds.anoncreds_object_get_json(options.objectHandle)
   }
 
   public getTypeName(options: { objectHandle: ObjectHandle }) {
-    const { objectHandle } = serializeArguments(options)
-
-    const ret = allocateStringBuffer()
-
-    this.nativeAnoncreds.anoncreds_object_get_type_name(objectHandle, ret)
-    this.handleError()
-
-    return handleReturnPointer<string>(ret)
+    return this.nativeAnoncreds.anoncreds_object_get_type_name(options.objectHandle)
   }
 
   public objectFree(options: { objectHandle: ObjectHandle }) {
-    this.nativeAnoncreds.anoncreds_object_free(options.objectHandle.handle)
-    this.handleError()
-  }
-
-  private convertCredentialList(credentials: NativeCredentialEntry[]) {
-    const credentialEntries = credentials.map((value) =>
-      CredentialEntryStruct({
-        credential: value.credential.handle,
-        timestamp: value.timestamp ?? -1,
-        rev_state: value.revocationState?.handle ?? 0,
-      })
-    )
-
-    return CredentialEntryListStruct({
-      count: credentialEntries.length,
-      data: credentialEntries as unknown as TypedArray<
-        StructObject<{
-          credential: number
-          timestamp: number
-          rev_state: number
-        }>
-      >,
-    }) as unknown as Buffer
-  }
-
-  private convertCredentialProves(credentialsProve: NativeCredentialProve[]) {
-    const credentialProves = credentialsProve.map((value) => {
-      const { entryIndex: entry_idx, isPredicate: is_predicate, reveal, referent } = serializeArguments(value)
-      return CredentialProveStruct({ entry_idx, referent, is_predicate, reveal })
-    })
-
-    return CredentialProveListStruct({
-      count: credentialProves.length,
-      data: credentialProves as unknown as TypedArray<
-        StructObject<{
-          entry_idx: string | number
-          referent: string
-          is_predicate: number
-          reveal: number
-        }>
-      >,
-    }) as unknown as Buffer
-  }
-
-  private convertSchemas(schemas: Record<string, ObjectHandle>) {
-    const schemaKeys = Object.keys(schemas)
-    const schemaIds = StringListStruct({
-      count: schemaKeys.length,
-      data: schemaKeys as unknown as TypedArray<string>,
-    }) as unknown as Buffer
-
-    const schemaValues = Object.values(schemas)
-    const schemasList = ObjectHandleListStruct({
-      count: schemaValues.length,
-      data: ObjectHandleArray(schemaValues.map((o) => o.handle)),
-    }) as unknown as Buffer
-    return {
-      schemaIds,
-      schemas: schemasList,
-    }
-  }
-
-  private convertCredDefs(credentialDefinitions: Record<string, ObjectHandle>) {
-    const credentialDefinitionKeys = Object.keys(credentialDefinitions)
-    const credentialDefinitionIds = StringListStruct({
-      count: credentialDefinitionKeys.length,
-      data: credentialDefinitionKeys as unknown as TypedArray<string>,
-    }) as unknown as Buffer
-
-    const credentialDefinitionValues = Object.values(credentialDefinitions)
-    const credentialDefinitionsList = ObjectHandleListStruct({
-      count: credentialDefinitionValues.length,
-      data: ObjectHandleArray(credentialDefinitionValues.map((o) => o.handle)),
-    }) as unknown as Buffer
-    return {
-      credentialDefinitionIds,
-      credentialDefinitions: credentialDefinitionsList,
-    }
-  }
-
-  private convertNonRevokedIntervalOverrides(nonRevokedIntervalOverrides?: NativeNonRevokedIntervalOverride[]) {
-    const nativeNonRevokedIntervalOverrides = nonRevokedIntervalOverrides?.map((value) => {
-      const { requestedFromTimestamp, revocationRegistryDefinitionId, overrideRevocationStatusListTimestamp } =
-        serializeArguments(value)
-      return NonRevokedIntervalOverrideStruct({
-        rev_reg_def_id: revocationRegistryDefinitionId,
-        requested_from_ts: requestedFromTimestamp,
-        override_rev_status_list_ts: overrideRevocationStatusListTimestamp,
-      })
-    })
-
-    return NonRevokedIntervalOverrideListStruct({
-      count: nonRevokedIntervalOverrides?.length ?? 0,
-      data: nativeNonRevokedIntervalOverrides as unknown as TypedArray<
-        StructObject<{
-          rev_reg_def_id: string
-          requested_from_ts: number
-          override_rev_status_list_ts: number
-        }>
-      >,
-    }) as unknown as Buffer
-  }
-
-  private convertAttributeNames(attributeRawValues: Record<string, string>) {
-    return StringListStruct({
-      count: Object.keys(attributeRawValues).length,
-      data: Object.keys(attributeRawValues) as unknown as TypedArray<string>,
-    }) as unknown as Buffer
-  }
-
-  private convertAttributeRawValues(attributeRawValues: Record<string, string>) {
-    return StringListStruct({
-      count: Object.keys(attributeRawValues).length,
-      data: Object.values(attributeRawValues) as unknown as TypedArray<string>,
-    }) as unknown as Buffer
-  }
-
-  private convertAttributeEncodedValues(attributeEncodedValues?: Record<string, string>) {
-    return attributeEncodedValues
-      ? StringListStruct({
-          count: Object.keys(attributeEncodedValues).length,
-          data: Object.values(attributeEncodedValues) as unknown as TypedArray<string>,
-        })
-      : undefined
-  }
-
-  private convertRevocationConfiguration(revocationConfiguration?: NativeCredentialRevocationConfig) {
-    if (revocationConfiguration) {
-      const { revocationRegistryDefinition, revocationRegistryDefinitionPrivate, revocationStatusList, registryIndex } =
-        serializeArguments(revocationConfiguration)
-
-      return CredRevInfoStruct({
-        reg_def: revocationRegistryDefinition,
-        reg_def_private: revocationRegistryDefinitionPrivate,
-        status_list: revocationStatusList,
-        reg_idx: registryIndex,
-      })
-    }
+    this.nativeAnoncreds.anoncreds_object_free(options.objectHandle)
   }
 }
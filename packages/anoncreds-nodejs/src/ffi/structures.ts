@@ -52,6 +52,8 @@ export const CredRevInfoStruct = CStruct({
   reg_idx: FFI_INT64,
 })
 
+export const CredRevInfoStructPtr = ref.refType(CredRevInfoStruct)
+
 export const CredentialEntryStruct = CStruct({
   credential: FFI_ISIZE,
   timestamp: FFI_INT64,
@@ -2,7 +2,9 @@ import { registerAnoncreds } from '@hyperledger/anoncreds-shared'
 
 import { NodeJSAnoncreds } from './NodeJSAnoncreds'
 
+// Calls the N-API addon when it has been built, and ffi-napi otherwise
 export const anoncredsNodeJS = new NodeJSAnoncreds()
 registerAnoncreds({ lib: anoncredsNodeJS })
 
+export { NodeJSAnoncreds }
 export * from '@hyperledger/anoncreds-shared'
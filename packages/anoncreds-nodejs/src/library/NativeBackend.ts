@@ -0,0 +1,251 @@
+import type {
+  NativeCredentialEntry,
+  NativeCredentialProve,
+  NativeCredentialRevocationConfig,
+  NativeNonRevokedIntervalOverride,
+  ObjectHandle,
+} from '@hyperledger/anoncreds-shared'
+
+// An object handle. Absent handles are passed as 0.
+type Handle = ObjectHandle | number | undefined
+
+// JSON, as a string or as its UTF-8 bytes
+type Json = string | Uint8Array
+
+// A function of `libanoncreds` called with plain values: the inputs in FFI parameter order, without the outputs.
+// Absent strings are passed as null and absent lists as empty lists. It returns its only output, or a tuple of them,
+// and throws an `AnoncredsError` when the call fails. `method.async(...args)` runs the call on the libuv thread pool.
+export type NativeFunction<Args extends unknown[], Return> = ((...args: Args) => Return) & {
+  async(...args: Args): Promise<Return>
+}
+
+type FromJson = NativeFunction<[json: Json], number>
+type GetAttribute = NativeFunction<[handle: Handle, name: string], string>
+
+/**
+ * The functions of `libanoncreds` used by `NodeJSAnoncreds`. Both backends implement it: the N-API addon natively, and
+ * `createFfiBackend` on top of the `ffi-napi` library.
+ */
+export type NativeBackend = {
+  anoncreds_create_credential: NativeFunction<
+    [
+      credentialDefinition: Handle,
+      credentialDefinitionPrivate: Handle,
+      credentialOffer: Handle,
+      credentialRequest: Handle,
+      attributeNames: string[],
+      attributeRawValues: string[],
+      attributeEncodedValues: string[] | undefined,
+      revocationConfiguration: NativeCredentialRevocationConfig | undefined,
+    ],
+    number
+  >
+  anoncreds_create_credential_definition: NativeFunction<
+    [
+      schemaId: string,
+      schema: Handle,
+      tag: string,
+      issuerId: string,
+      signatureType: string,
+      supportRevocation: boolean,
+    ],
+    [credentialDefinition: number, credentialDefinitionPrivate: number, keyCorrectnessProof: number]
+  >
+  anoncreds_create_credential_offer: NativeFunction<
+    [schemaId: string, credentialDefinitionId: string, keyCorrectnessProof: Handle],
+    number
+  >
+  anoncreds_create_credential_request: NativeFunction<
+    [
+      entropy: string | undefined,
+      proverDid: string | undefined,
+      credentialDefinition: Handle,
+      linkSecret: string,
+      linkSecretId: string,
+      credentialOffer: Handle,
+    ],
+    [credentialRequest: number, credentialRequestMetadata: number]
+  >
+  anoncreds_create_link_secret: NativeFunction<[], string>
+  anoncreds_create_or_update_revocation_state: NativeFunction<
+    [
+      revocationRegistryDefinition: Handle,
+      revocationStatusList: Handle,
+      revocationRegistryIndex: number,
+      tailsPath: string,
+      oldRevocationState: Handle,
+      oldRevocationStatusList: Handle,
+    ],
+    number
+  >
+  anoncreds_create_presentation: NativeFunction<
+    [
+      presentationRequest: Handle,
+      credentials: NativeCredentialEntry[],
+      credentialsProve: NativeCredentialProve[],
+      selfAttestNames: string[],
+      selfAttestValues: string[],
+      linkSecret: string,
+      schemas: Handle[],
+      schemaIds: string[],
+      credentialDefinitions: Handle[],
+      credentialDefinitionIds: string[],
+    ],
+    number
+  >
+  anoncreds_create_revocation_registry_def: NativeFunction<
+    [
+      credentialDefinition: Handle,
+      credentialDefinitionId: string,
+      issuerId: string,
+      tag: string,
+      revocationRegistryType: string,
+      maximumCredentialNumber: number,
+      tailsDirectoryPath: string | undefined,
+    ],
+    [revocationRegistryDefinition: number, revocationRegistryDefinitionPrivate: number]
+  >
+  anoncreds_create_revocation_status_list: NativeFunction<
+    [
+      credentialDefinition: Handle,
+      revocationRegistryDefinitionId: string,
+      revocationRegistryDefinition: Handle,
+      revocationRegistryDefinitionPrivate: Handle,
+      issuerId: string,
+      issuanceByDefault: boolean,
+      timestamp: number,
+    ],
+    number
+  >
+  anoncreds_create_schema: NativeFunction<
+    [name: string, version: string, issuerId: string, attributeNames: string[]],
+    number
+  >
+  anoncreds_create_w3c_credential: NativeFunction<
+    [
+      credentialDefinition: Handle,
+      credentialDefinitionPrivate: Handle,
+      credentialOffer: Handle,
+      credentialRequest: Handle,
+      attributeNames: string[],
+      attributeRawValues: string[],
+      revocationConfiguration: NativeCredentialRevocationConfig | undefined,
+      w3cVersion: string | undefined,
+    ],
+    number
+  >
+  anoncreds_create_w3c_presentation: NativeFunction<
+    [
+      presentationRequest: Handle,
+      credentials: NativeCredentialEntry[],
+      credentialsProve: NativeCredentialProve[],
+      linkSecret: string,
+      schemas: Handle[],
+      schemaIds: string[],
+      credentialDefinitions: Handle[],
+      credentialDefinitionIds: string[],
+      w3cVersion: string | undefined,
+    ],
+    number
+  >
+  anoncreds_credential_definition_from_json: FromJson
+  anoncreds_credential_definition_private_from_json: FromJson
+  anoncreds_credential_from_json: FromJson
+  anoncreds_credential_from_w3c: NativeFunction<[credential: Handle], number>
+  anoncreds_credential_get_attribute: GetAttribute
+  anoncreds_credential_offer_from_json: FromJson
+  anoncreds_credential_request_from_json: FromJson
+  anoncreds_credential_request_metadata_from_json: FromJson
+  anoncreds_credential_to_w3c: NativeFunction<
+    [credential: Handle, issuerId: string, w3cVersion: string | undefined],
+    number
+  >
+  anoncreds_encode_credential_attributes: NativeFunction<[attributeRawValues: string[]], string>
+  anoncreds_generate_nonce: NativeFunction<[], string>
+  anoncreds_get_current_error: NativeFunction<[], string>
+  anoncreds_key_correctness_proof_from_json: FromJson
+  anoncreds_object_free: NativeFunction<[handle: Handle], void>
+  anoncreds_object_get_json: NativeFunction<[handle: Handle], string>
+  anoncreds_object_get_type_name: NativeFunction<[handle: Handle], string>
+  anoncreds_presentation_from_json: FromJson
+  anoncreds_presentation_request_from_json: FromJson
+  anoncreds_process_credential: NativeFunction<
+    [
+      credential: Handle,
+      credentialRequestMetadata: Handle,
+      linkSecret: string,
+      credentialDefinition: Handle,
+      revocationRegistryDefinition: Handle,
+    ],
+    number
+  >
+  anoncreds_process_w3c_credential: NativeFunction<
+    [
+      credential: Handle,
+      credentialRequestMetadata: Handle,
+      linkSecret: string,
+      credentialDefinition: Handle,
+      revocationRegistryDefinition: Handle,
+    ],
+    number
+  >
+  anoncreds_revocation_registry_definition_from_json: FromJson
+  anoncreds_revocation_registry_definition_get_attribute: GetAttribute
+  anoncreds_revocation_registry_definition_private_from_json: FromJson
+  anoncreds_revocation_registry_from_json: FromJson
+  anoncreds_revocation_state_from_json: FromJson
+  anoncreds_revocation_status_list_from_json: FromJson
+  anoncreds_schema_from_json: FromJson
+  anoncreds_set_default_logger: NativeFunction<[], void>
+  anoncreds_update_revocation_status_list: NativeFunction<
+    [
+      credentialDefinition: Handle,
+      revocationRegistryDefinition: Handle,
+      revocationRegistryDefinitionPrivate: Handle,
+      currentRevocationStatusList: Handle,
+      issued: number[] | undefined,
+      revoked: number[] | undefined,
+      timestamp: number,
+    ],
+    number
+  >
+  anoncreds_update_revocation_status_list_timestamp_only: NativeFunction<
+    [timestamp: number, currentRevocationStatusList: Handle],
+    number
+  >
+  anoncreds_verify_presentation: NativeFunction<
+    [
+      presentation: Handle,
+      presentationRequest: Handle,
+      schemas: Handle[],
+      schemaIds: string[],
+      credentialDefinitions: Handle[],
+      credentialDefinitionIds: string[],
+      revocationRegistryDefinitions: Handle[] | undefined,
+      revocationRegistryDefinitionIds: string[] | undefined,
+      revocationStatusLists: Handle[] | undefined,
+      nonRevokedIntervalOverrides: NativeNonRevokedIntervalOverride[] | undefined,
+    ],
+    boolean
+  >
+  anoncreds_verify_w3c_presentation: NativeFunction<
+    [
+      presentation: Handle,
+      presentationRequest: Handle,
+      schemas: Handle[],
+      schemaIds: string[],
+      credentialDefinitions: Handle[],
+      credentialDefinitionIds: string[],
+      revocationRegistryDefinitions: Handle[] | undefined,
+      revocationRegistryDefinitionIds: string[] | undefined,
+      revocationStatusLists: Handle[] | undefined,
+      nonRevokedIntervalOverrides: NativeNonRevokedIntervalOverride[] | undefined,
+    ],
+    boolean
+  >
+  anoncreds_version: NativeFunction<[], string>
+  anoncreds_w3c_credential_from_json: FromJson
+  anoncreds_w3c_credential_get_integrity_proof_details: NativeFunction<[credential: Handle], number>
+  anoncreds_w3c_credential_proof_get_attribute: GetAttribute
+  anoncreds_w3c_presentation_from_json: FromJson
+}
@@ -20,12 +20,23 @@ type StringTypeArrayToTypes<List extends (keyof StringTypeMapping)[]> = {
   [Item in keyof List]: List[Item] extends keyof StringTypeMapping ? StringTypeMapping[List[Item]] : Buffer
 }
 
+// `error` is only set when the call could not be made
+export type NativeCallback<Return> = (error: Error | null, result: Return) => void
+
+// A function of the `ffi-napi` library, which can also be called on the libuv thread pool with
+// `method.async(...args, callback)`
+// biome-ignore lint/suspicious/noExplicitAny:
+type NativeMethod<Args extends any[], Return> = ((...args: Args) => Return) & {
+  async(...args: [...Args, NativeCallback<Return>]): void
+}
+
 // biome-ignore lint/suspicious/noExplicitAny:
 type TypedMethods<Base extends Record<string | number | symbol, [any, any[]]>> = {
-  [Property in keyof Base]: (
+  [Property in keyof Base]: NativeMethod<
     // biome-ignore lint/suspicious/noExplicitAny:
-    ...args: StringTypeArrayToTypes<Base[Property][1]> extends any[] ? StringTypeArrayToTypes<Base[Property][1]> : []
-  ) => StringTypeMapping[Base[Property][0]]
+    StringTypeArrayToTypes<Base[Property][1]> extends any[] ? StringTypeArrayToTypes<Base[Property][1]> : [],
+    StringTypeMapping[Base[Property][0]]
+  >
 }
 type Mutable<T> = {
   -readonly [K in keyof T]: Mutable<T[K]>
@@ -2,6 +2,7 @@ import {
   ByteBufferStruct,
   ByteBufferStructPtr,
   CredentialEntryListStruct,
+  CredRevInfoStructPtr,
   CredentialProveListStruct,
   FFI_ERRORCODE,
   FFI_INT8,
@@ -31,7 +32,7 @@ export const nativeBindings = {
       StringListStruct,
       StringListStruct,
       StringListStruct,
-      FFI_OBJECT_HANDLE,
+      CredRevInfoStructPtr,
       FFI_OBJECT_HANDLE_PTR,
     ],
   ],
@@ -66,7 +67,7 @@ export const nativeBindings = {
       FFI_OBJECT_HANDLE_PTR,
     ],
   ],
-  anoncreds_create_link_secret: [FFI_ERRORCODE, [FFI_OBJECT_HANDLE_PTR]],
+  anoncreds_create_link_secret: [FFI_ERRORCODE, [FFI_STRING_PTR]],
   anoncreds_create_or_update_revocation_state: [
     FFI_ERRORCODE,
     [
@@ -121,7 +122,7 @@ export const nativeBindings = {
   anoncreds_string_free: [FFI_VOID, [FFI_STRING_PTR]],
   anoncreds_object_get_json: [FFI_ERRORCODE, [FFI_OBJECT_HANDLE, ByteBufferStructPtr]],
   anoncreds_object_get_type_name: [FFI_ERRORCODE, [FFI_OBJECT_HANDLE, FFI_STRING_PTR]],
-  anoncreds_presentation_request_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
+  anoncreds_presentation_request_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
   anoncreds_process_credential: [
     FFI_ERRORCODE,
     [FFI_OBJECT_HANDLE, FFI_OBJECT_HANDLE, FFI_STRING, FFI_OBJECT_HANDLE, FFI_OBJECT_HANDLE, FFI_OBJECT_HANDLE_PTR],
@@ -178,20 +179,23 @@ export const nativeBindings = {
     ],
   ],
   anoncreds_version: [FFI_STRING, []],
-  anoncreds_credential_request_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
-  anoncreds_credential_request_metadata_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
-  anoncreds_presentation_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
-  anoncreds_credential_offer_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
-  anoncreds_revocation_registry_definition_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
-  anoncreds_revocation_registry_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
-  anoncreds_revocation_status_list_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
-  anoncreds_revocation_state_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
-  anoncreds_credential_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
-  anoncreds_credential_definition_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
-  anoncreds_credential_definition_private_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
-  anoncreds_revocation_registry_definition_private_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
-  anoncreds_key_correctness_proof_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
-  anoncreds_schema_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
+  anoncreds_credential_request_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
+  anoncreds_credential_request_metadata_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
+  anoncreds_presentation_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
+  anoncreds_credential_offer_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
+  anoncreds_revocation_registry_definition_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
+  anoncreds_revocation_registry_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
+  anoncreds_revocation_status_list_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
+  anoncreds_revocation_state_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
+  anoncreds_credential_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
+  anoncreds_credential_definition_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
+  anoncreds_credential_definition_private_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
+  anoncreds_revocation_registry_definition_private_from_json: [
+    FFI_ERRORCODE,
+    [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR],
+  ],
+  anoncreds_key_correctness_proof_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
+  anoncreds_schema_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
   anoncreds_create_w3c_credential: [
     FFI_ERRORCODE,
     [
@@ -201,7 +205,7 @@ export const nativeBindings = {
       FFI_OBJECT_HANDLE,
       StringListStruct,
       StringListStruct,
-      FFI_OBJECT_HANDLE,
+      CredRevInfoStructPtr,
       FFI_STRING,
       FFI_OBJECT_HANDLE_PTR,
     ],
@@ -245,6 +249,6 @@ export const nativeBindings = {
   anoncreds_credential_from_w3c: [FFI_ERRORCODE, [FFI_OBJECT_HANDLE, FFI_OBJECT_HANDLE_PTR]],
   anoncreds_w3c_credential_get_integrity_proof_details: [FFI_ERRORCODE, [FFI_OBJECT_HANDLE, FFI_OBJECT_HANDLE_PTR]],
   anoncreds_w3c_credential_proof_get_attribute: [FFI_ERRORCODE, [FFI_OBJECT_HANDLE, FFI_STRING, FFI_STRING_PTR]],
-  anoncreds_w3c_presentation_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
-  anoncreds_w3c_credential_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_STRING_PTR]],
+  anoncreds_w3c_presentation_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
+  anoncreds_w3c_credential_from_json: [FFI_ERRORCODE, [ByteBufferStruct, FFI_OBJECT_HANDLE_PTR]],
 } as const
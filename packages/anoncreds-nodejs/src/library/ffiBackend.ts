@@ -0,0 +1,241 @@
+import type {
+  AnoncredsErrorObject,
+  NativeCredentialEntry,
+  NativeCredentialProve,
+  NativeCredentialRevocationConfig,
+  NativeNonRevokedIntervalOverride,
+  ObjectHandle,
+} from '@hyperledger/anoncreds-shared'
+import type { TypedArray } from 'ref-array-di'
+import type { StructObject } from 'ref-struct-di'
+import type { NativeBackend } from './NativeBackend'
+import type { NativeMethods } from './NativeBindingInterface'
+
+import { TextDecoder, TextEncoder } from 'util'
+import { NULL, alloc } from '@2060.io/ref-napi'
+import { AnoncredsError, ByteBuffer } from '@hyperledger/anoncreds-shared'
+
+import {
+  ByteBufferStruct,
+  ByteBufferStructPtr,
+  CredRevInfoStruct,
+  CredRevInfoStructPtr,
+  CredentialEntryListStruct,
+  CredentialEntryStruct,
+  CredentialProveListStruct,
+  CredentialProveStruct,
+  FFI_ERRORCODE,
+  FFI_INT8,
+  FFI_INT8_PTR,
+  FFI_INT64,
+  FFI_OBJECT_HANDLE,
+  FFI_OBJECT_HANDLE_PTR,
+  FFI_STRING,
+  FFI_STRING_PTR,
+  I32ListStruct,
+  Int32List,
+  NonRevokedIntervalOverrideListStruct,
+  NonRevokedIntervalOverrideStruct,
+  ObjectHandleArray,
+  ObjectHandleListStruct,
+  StringListStruct,
+  byteBufferToBuffer,
+} from '../ffi'
+
+import { nativeBindings } from './bindings'
+
+type BindingName = keyof typeof nativeBindings
+type FfiType = (typeof nativeBindings)[BindingName][1][number]
+
+// An output parameter, allocated before the call and read once it succeeded
+type Output = { buffer: Buffer; read: () => unknown }
+
+// biome-ignore lint/suspicious/noExplicitAny:
+type FfiMethod = ((...args: any[]) => unknown) & { async(...args: any[]): void }
+
+const handleOf = (handle: unknown) =>
+  typeof handle === 'object' && handle !== null ? (handle as ObjectHandle).handle : ((handle as number) ?? 0)
+
+const listOf = <T>(list: unknown) => (list ?? []) as T[]
+
+// Converts a plain value of `NativeBackend` to the `ffi-napi` argument of `type`
+const toFfi = (type: FfiType, value: unknown): unknown => {
+  switch (type) {
+    case FFI_STRING:
+      return value ?? NULL
+    case FFI_OBJECT_HANDLE:
+      return handleOf(value)
+    case FFI_INT8:
+    case FFI_INT64:
+      return Number(value ?? 0)
+    case ByteBufferStruct: {
+      const bytes = typeof value === 'string' ? new TextEncoder().encode(value) : (value as Uint8Array)
+      return ByteBuffer.fromUint8Array(bytes)
+    }
+    case StringListStruct: {
+      const strings = listOf<string>(value)
+      return StringListStruct({ count: strings.length, data: strings as unknown as TypedArray<string> })
+    }
+    case ObjectHandleListStruct: {
+      const handles = listOf(value).map(handleOf)
+      return ObjectHandleListStruct({ count: handles.length, data: ObjectHandleArray(handles) })
+    }
+    case I32ListStruct: {
+      const numbers = listOf<number>(value)
+      return I32ListStruct({ count: numbers.length, data: Int32List(numbers) })
+    }
+    case CredentialEntryListStruct: {
+      const entries = listOf<NativeCredentialEntry>(value).map((entry) =>
+        CredentialEntryStruct({
+          credential: entry.credential.handle,
+          timestamp: entry.timestamp ?? -1,
+          rev_state: entry.revocationState?.handle ?? 0,
+        })
+      )
+      return CredentialEntryListStruct({
+        count: entries.length,
+        data: entries as unknown as TypedArray<
+          StructObject<{ credential: number; timestamp: number; rev_state: number }>
+        >,
+      })
+    }
+    case CredentialProveListStruct: {
+      const proves = listOf<NativeCredentialProve>(value).map((prove) =>
+        CredentialProveStruct({
+          entry_idx: prove.entryIndex,
+          referent: prove.referent,
+          is_predicate: Number(prove.isPredicate),
+          reveal: Number(prove.reveal),
+        })
+      )
+      return CredentialProveListStruct({
+        count: proves.length,
+        data: proves as unknown as TypedArray<
+          StructObject<{ entry_idx: number; referent: string; is_predicate: number; reveal: number }>
+        >,
+      })
+    }
+    case NonRevokedIntervalOverrideListStruct: {
+      const overrides = listOf<NativeNonRevokedIntervalOverride>(value).map((override) =>
+        NonRevokedIntervalOverrideStruct({
+          rev_reg_def_id: override.revocationRegistryDefinitionId,
+          requested_from_ts: override.requestedFromTimestamp,
+          override_rev_status_list_ts: override.overrideRevocationStatusListTimestamp,
+        })
+      )
+      return NonRevokedIntervalOverrideListStruct({
+        count: overrides.length,
+        data: overrides as unknown as TypedArray<
+          StructObject<{ rev_reg_def_id: string; requested_from_ts: number; override_rev_status_list_ts: number }>
+        >,
+      })
+    }
+    case CredRevInfoStructPtr: {
+      if (!value) return NULL
+      const config = value as NativeCredentialRevocationConfig
+      return CredRevInfoStruct({
+        reg_def: config.revocationRegistryDefinition.handle,
+        reg_def_private: config.revocationRegistryDefinitionPrivate.handle,
+        status_list: config.revocationStatusList?.handle ?? 0,
+        reg_idx: config.registryIndex,
+      }).ref()
+    }
+    default:
+      throw new Error(`Unsupported ffi argument type ${String(type)}`)
+  }
+}
+
+// The output of `type`, or undefined when `type` is an input
+const outputOf = (library: NativeMethods, type: FfiType): Output | undefined => {
+  switch (type) {
+    case FFI_OBJECT_HANDLE_PTR: {
+      const buffer = alloc(FFI_OBJECT_HANDLE)
+      return { buffer, read: () => buffer.deref() as number }
+    }
+    case FFI_STRING_PTR: {
+      const buffer = alloc(FFI_STRING)
+      return { buffer, read: () => buffer.deref() as string }
+    }
+    case FFI_INT8_PTR: {
+      const buffer = alloc(FFI_INT8)
+      return { buffer, read: () => Boolean(buffer.deref()) }
+    }
+    case ByteBufferStructPtr: {
+      const buffer = alloc(ByteBufferStruct)
+      return {
+        buffer,
+        read: () => {
+          const byteBuffer = buffer.deref() as { data: Buffer; len: number }
+          const output = new TextDecoder().decode(new Uint8Array(byteBufferToBuffer(byteBuffer)))
+          library.anoncreds_buffer_free(byteBuffer as unknown as Buffer)
+          return output
+        },
+      }
+    }
+    default:
+      return undefined
+  }
+}
+
+const currentError = (library: NativeMethods) => {
+  const error = alloc(FFI_STRING)
+  library.anoncreds_get_current_error(error)
+  return new AnoncredsError(JSON.parse(error.deref() as string) as AnoncredsErrorObject)
+}
+
+const createFunction = (library: NativeMethods, name: BindingName) => {
+  const [returnType, types] = nativeBindings[name]
+  const method = library[name] as unknown as FfiMethod
+
+  const prepare = (args: unknown[]) => {
+    const outputs: Output[] = []
+    let index = 0
+    const ffiArgs = (types as readonly FfiType[]).map((type) => {
+      const output = outputOf(library, type)
+      if (!output) return toFfi(type, args[index++])
+      outputs.push(output)
+      return output.buffer
+    })
+    return { ffiArgs, outputs }
+  }
+
+  const result = (returnValue: unknown, outputs: Output[]) => {
+    if (returnType !== FFI_ERRORCODE) return returnValue
+    if (returnValue !== 0) throw currentError(library)
+    if (outputs.length === 0) return undefined
+    return outputs.length === 1 ? outputs[0].read() : outputs.map((output) => output.read())
+  }
+
+  const call = (...args: unknown[]) => {
+    const { ffiArgs, outputs } = prepare(args)
+    return result(method(...ffiArgs), outputs)
+  }
+
+  // `prepared` keeps the arguments alive until the call completed
+  call.async = (...args: unknown[]) =>
+    new Promise((resolve, reject) => {
+      const prepared = prepare(args)
+      method.async(...prepared.ffiArgs, (error: Error | null, returnValue: unknown) => {
+        if (error) return reject(error)
+        try {
+          resolve(result(returnValue, prepared.outputs))
+        } catch (e) {
+          reject(e)
+        }
+      })
+    })
+
+  return call
+}
+
+/**
+ * Implements `NativeBackend` on top of the `ffi-napi` library, converting the plain values to the structs and output
+ * pointers of `nativeBindings`.
+ *
+ * The error of a failed async call is read from `anoncreds_get_current_error` on the JS thread, after the call
+ * completed on the libuv thread pool, so it is only reliable for synchronous calls.
+ */
+export const createFfiBackend = (library: NativeMethods) =>
+  Object.fromEntries(
+    (Object.keys(nativeBindings) as BindingName[]).map((name) => [name, createFunction(library, name)])
+  ) as unknown as NativeBackend
@@ -1,3 +1,5 @@
+export * from './NativeBackend'
 export * from './NativeBindingInterface'
 export * from './bindings'
+export * from './ffiBackend'
 export * from './register'
@@ -1,14 +1,19 @@
+import type { NativeBackend } from './NativeBackend'
 import type { NativeMethods } from './NativeBindingInterface'
 
 import fs from 'fs'
 import os from 'os'
 import path from 'path'
 import { Library } from '@2060.io/ffi-napi'
+import { AnoncredsError } from '@hyperledger/anoncreds-shared'
 
 import { nativeBindings } from './bindings'
+import { createFfiBackend } from './ffiBackend'
 
 const LIBNAME = 'anoncreds'
 const ENV_VAR = 'LIB_ANONCREDS_PATH'
+const NAPI_ADDON = 'anoncreds_napi.node'
+const BACKEND_ENV_VAR = 'ANONCREDS_NODEJS_BACKEND'
 
 type Platform = 'darwin' | 'linux' | 'win32'
 
@@ -69,8 +74,39 @@ const getLibrary = () => {
   return Library(validLibraryPath, nativeBindings)
 }
 
-let nativeAnoncreds: NativeMethods | undefined
-export const getNativeAnoncreds = () => {
-  if (!nativeAnoncreds) nativeAnoncreds = getLibrary() as unknown as NativeMethods
-  return nativeAnoncreds
+let ffiAnoncreds: NativeBackend | undefined
+export const getFfiAnoncreds = () => {
+  if (!ffiAnoncreds) ffiAnoncreds = createFfiBackend(getLibrary() as unknown as NativeMethods)
+  return ffiAnoncreds
 }
+
+// The N-API addon is optional, it is only available after running `pnpm build:napi`.
+// It is copied next to the library, so it can resolve the library relative to itself.
+const getNapiAddon = () => {
+  if (process.env[BACKEND_ENV_VAR] === 'ffi') return undefined
+
+  const addonPaths = [path.join(__dirname, '../../native', NAPI_ADDON)]
+  const pathFromEnvironment = process.env[ENV_VAR]
+  if (pathFromEnvironment) addonPaths.unshift(path.join(pathFromEnvironment, NAPI_ADDON))
+
+  const addonPath = addonPaths.find(doesPathExist)
+  if (!addonPath) {
+    if (process.env[BACKEND_ENV_VAR] === 'napi')
+      throw new Error(`Could not find ${NAPI_ADDON} with these paths: ${addonPaths.join(' ')}`)
+    return undefined
+  }
+
+  // The addon implements `NativeBackend` natively, failed calls throw an `AnoncredsError`
+  const addon = require(addonPath) as NativeBackend & { setErrorConstructor(constructor: typeof AnoncredsError): void }
+  addon.setErrorConstructor(AnoncredsError)
+  return addon as NativeBackend
+}
+
+let napiAnoncreds: NativeBackend | null | undefined
+export const getNapiAnoncreds = () => {
+  if (napiAnoncreds === undefined) napiAnoncreds = getNapiAddon() ?? null
+  return napiAnoncreds ?? undefined
+}
+
+// The N-API addon when it has been built, `ANONCREDS_NODEJS_BACKEND=ffi` forces ffi-napi
+export const getNativeAnoncreds = () => getNapiAnoncreds() ?? getFfiAnoncreds()
@@ -0,0 +1,138 @@
+import { deepStrictEqual, ok, rejects, strictEqual, throws } from 'node:assert'
+import { before, describe, test } from 'node:test'
+import { AnoncredsError, ObjectHandle, registerAnoncreds } from '@hyperledger/anoncreds-shared'
+
+import { NodeJSAnoncreds } from '../src/NodeJSAnoncreds'
+import { getFfiAnoncreds, getNapiAnoncreds } from '../src/library'
+
+const napiAnoncreds = getNapiAnoncreds()
+
+// The addon is only there after `pnpm build:napi`
+describe('N-API backend', { skip: !napiAnoncreds && 'N-API addon is not built' }, () => {
+  let napi: NodeJSAnoncreds
+  let ffi: NodeJSAnoncreds
+
+  before(() => {
+    napi = new NodeJSAnoncreds(napiAnoncreds)
+    ffi = new NodeJSAnoncreds(getFfiAnoncreds())
+    registerAnoncreds({ lib: napi, force: true })
+  })
+
+  test('version matches the ffi backend', () => {
+    strictEqual(napi.version(), ffi.version())
+  })
+
+  test('objects are interchangeable with the ffi backend', () => {
+    const schema = napi.createSchema({
+      name: 'schema-1',
+      issuerId: 'mock:uri',
+      version: '1',
+      attributeNames: ['attr-1', 'attr-2'],
+    })
+
+    deepStrictEqual(JSON.parse(ffi.getJson({ objectHandle: schema })), {
+      name: 'schema-1',
+      version: '1',
+      issuerId: 'mock:uri',
+      attrNames: ['attr-1', 'attr-2'],
+    })
+    strictEqual(napi.getTypeName({ objectHandle: schema }), 'Schema')
+
+    napi.objectFree({ objectHandle: schema })
+  })
+
+  test('errors are thrown as AnoncredsError', () => {
+    throws(() => napi.schemaFromJson({ json: '{}' }), AnoncredsError)
+    throws(() => napi.getJson({ objectHandle: new ObjectHandle(-1) }), AnoncredsError)
+  })
+
+  test('create and verify presentation with async calls', async () => {
+    const schema = napi.createSchema({
+      name: 'schema-1',
+      issuerId: 'mock:uri',
+      version: '1',
+      attributeNames: ['name', 'age'],
+    })
+
+    const { credentialDefinition, credentialDefinitionPrivate, keyCorrectnessProof } =
+      await napi.createCredentialDefinitionAsync({
+        schemaId: 'mock:uri',
+        issuerId: 'mock:uri',
+        schema,
+        signatureType: 'CL',
+        supportRevocation: false,
+        tag: 'TAG',
+      })
+
+    const credentialOffer = napi.createCredentialOffer({
+      schemaId: 'mock:uri',
+      credentialDefinitionId: 'mock:uri',
+      keyCorrectnessProof,
+    })
+
+    const linkSecret = napi.createLinkSecret()
+
+    const { credentialRequest, credentialRequestMetadata } = napi.createCredentialRequest({
+      entropy: 'entropy',
+      credentialDefinition,
+      linkSecret,
+      linkSecretId: 'link secret id',
+      credentialOffer,
+    })
+
+    const credential = await napi.createCredentialAsync({
+      credentialDefinition,
+      credentialDefinitionPrivate,
+      credentialOffer,
+      credentialRequest,
+      attributeRawValues: { name: 'Alex', age: '28' },
+    })
+
+    const credentialReceived = napi.processCredential({
+      credential,
+      credentialRequestMetadata,
+      linkSecret,
+      credentialDefinition,
+    })
+
+    strictEqual(napi.credentialGetAttribute({ objectHandle: credentialReceived, name: 'schema_id' }), 'mock:uri')
+
+    const presentationRequest = napi.presentationRequestFromJson({
+      json: JSON.stringify({
+        nonce: napi.generateNonce(),
+        name: 'pres_req_1',
+        version: '0.1',
+        requested_attributes: { attr1_referent: { name: 'name' } },
+        requested_predicates: { predicate1_referent: { name: 'age', p_type: '>=', p_value: 18 } },
+      }),
+    })
+
+    const presentation = await napi.createPresentationAsync({
+      presentationRequest,
+      credentials: [{ credential: credentialReceived }],
+      credentialsProve: [
+        { entryIndex: 0, isPredicate: false, referent: 'attr1_referent', reveal: true },
+        { entryIndex: 0, isPredicate: true, referent: 'predicate1_referent', reveal: true },
+      ],
+      selfAttest: {},
+      linkSecret,
+      schemas: { 'mock:uri': schema },
+      credentialDefinitions: { 'mock:uri': credentialDefinition },
+    })
+
+    const verifyOptions = {
+      presentation,
+      presentationRequest,
+      schemas: [schema],
+      schemaIds: ['mock:uri'],
+      credentialDefinitions: [credentialDefinition],
+      credentialDefinitionIds: ['mock:uri'],
+    }
+
+    ok(await napi.verifyPresentationAsync(verifyOptions))
+    ok(await ffi.verifyPresentationAsync(verifyOptions))
+    strictEqual(napi.verifyPresentation(verifyOptions), ffi.verifyPresentation(verifyOptions))
+
+    await rejects(napi.verifyPresentationAsync({ ...verifyOptions, schemaIds: ['other:uri'] }), AnoncredsError)
+  })
+})
@@ -2,136 +2,184 @@
 #include <vector>
 
 #include "HostObject.h"
+#include "callRecorder.h"
+#include "handleRegistry.h"
+#include "library.h"
 
 AnoncredsTurboModuleHostObject::AnoncredsTurboModuleHostObject(
-    jsi::Runtime &rt) {
-  return;
+    jsi::Runtime &rt, std::shared_ptr<react::CallInvoker> invoker)
+    : invoker(std::move(invoker)) {}
+
+AnoncredsTurboModuleHostObject::~AnoncredsTurboModuleHostObject() {
+  anoncredsHandleRegistry::releaseOwner(this);
 }
 
-FunctionMap AnoncredsTurboModuleHostObject::functionMapping(jsi::Runtime &rt) {
-  FunctionMap fMap;
-
-  fMap.insert(std::make_tuple("version", &anoncreds::version));
-  fMap.insert(std::make_tuple("getCurrentError", &anoncreds::getCurrentError));
-  fMap.insert(
-      std::make_tuple("createCredential", &anoncreds::createCredential));
-  fMap.insert(std::make_tuple("createCredentialDefinition",
-                              &anoncreds::createCredentialDefinition));
-  fMap.insert(std::make_tuple("createCredentialOffer",
-                              &anoncreds::createCredentialOffer));
-  fMap.insert(std::make_tuple("createCredentialRequest",
-                              &anoncreds::createCredentialRequest));
-  fMap.insert(
-      std::make_tuple("createLinkSecret", &anoncreds::createLinkSecret));
-  fMap.insert(std::make_tuple("createOrUpdateRevocationState",
-                              &anoncreds::createOrUpdateRevocationState));
-  fMap.insert(
-      std::make_tuple("createPresentation", &anoncreds::createPresentation));
-  fMap.insert(std::make_tuple("createRevocationRegistryDefinition",
-                              &anoncreds::createRevocationRegistryDefinition));
-  fMap.insert(std::make_tuple("createSchema", &anoncreds::createSchema));
-  fMap.insert(std::make_tuple("credentialGetAttribute",
-                              &anoncreds::credentialGetAttribute));
-  fMap.insert(std::make_tuple("encodeCredentialAttributes",
-                              &anoncreds::encodeCredentialAttributes));
-  fMap.insert(std::make_tuple("generateNonce", &anoncreds::generateNonce));
-  fMap.insert(std::make_tuple("getJson", &anoncreds::getJson));
-  fMap.insert(std::make_tuple("getTypeName", &anoncreds::getTypeName));
-  fMap.insert(
-      std::make_tuple("processCredential", &anoncreds::processCredential));
-  fMap.insert(
-      std::make_tuple("revocationRegistryDefinitionGetAttribute",
-                      &anoncreds::revocationRegistryDefinitionGetAttribute));
-  fMap.insert(
-      std::make_tuple("setDefaultLogger", &anoncreds::setDefaultLogger));
-  fMap.insert(
-      std::make_tuple("verifyPresentation", &anoncreds::verifyPresentation));
-fMap.insert(std::make_tuple("createRevocationStatusList",
-                              &anoncreds::createRevocationStatusList));
-  fMap.insert(std::make_tuple("updateRevocationStatusList",
-                              &anoncreds::updateRevocationStatusList));
-  fMap.insert(std::make_tuple("objectFree", &anoncreds::objectFree));
-
-  fMap.insert(std::make_tuple("credentialDefinitionFromJson",
-                              &anoncreds::credentialDefinitionFromJson));
-  fMap.insert(
-      std::make_tuple("revocationRegistryDefinitionFromJson",
-                      &anoncreds::revocationRegistryDefinitionFromJson));
-  fMap.insert(
-      std::make_tuple("revocationRegistryFromJson",
-                      &anoncreds::revocationRegistryDefinitionFromJson));
-  fMap.insert(
-      std::make_tuple("revocationStatusListFromJson",
-                      &anoncreds::revocationStatusListFromJson));
-  fMap.insert(std::make_tuple("presentationFromJson",
-                              &anoncreds::presentationFromJson));
-  fMap.insert(std::make_tuple("presentationRequestFromJson",
-                              &anoncreds::presentationRequestFromJson));
-  fMap.insert(std::make_tuple("credentialOfferFromJson",
-                              &anoncreds::credentialOfferFromJson));
-  fMap.insert(std::make_tuple("schemaFromJson", &anoncreds::schemaFromJson));
-  fMap.insert(std::make_tuple("credentialRequestFromJson",
-                              &anoncreds::credentialRequestFromJson));
-  fMap.insert(std::make_tuple("credentialRequestMetadataFromJson",
-                              &anoncreds::credentialRequestMetadataFromJson));
-  fMap.insert(
-      std::make_tuple("credentialFromJson", &anoncreds::credentialFromJson));
-  fMap.insert(
-      std::make_tuple("revocationRegistryDefinitionPrivateFromJson",
-                      &anoncreds::revocationRegistryDefinitionPrivateFromJson));
-  fMap.insert(std::make_tuple("revocationStateFromJson",
-                              &anoncreds::revocationStateFromJson));
-  fMap.insert(std::make_tuple("credentialDefinitionFromJson",
-                              &anoncreds::credentialDefinitionFromJson));
-  fMap.insert(std::make_tuple("credentialDefinitionPrivateFromJson",
-                              &anoncreds::credentialDefinitionPrivateFromJson));
-  fMap.insert(std::make_tuple("keyCorrectnessProofFromJson",
-                              &anoncreds::keyCorrectnessProofFromJson));
-  fMap.insert(
-      std::make_tuple("createW3cCredential", &anoncreds::createW3cCredential));
-  fMap.insert(
-      std::make_tuple("createW3cPresentation", &anoncreds::createW3cPresentation));
-  fMap.insert(std::make_tuple("w3cCredentialGetIntegrityProofDetails",
-                              &anoncreds::w3cCredentialGetIntegrityProofDetails));
-  fMap.insert(std::make_tuple("w3cCredentialProofGetAttribute",
-                              &anoncreds::w3cCredentialProofGetAttribute));
-  fMap.insert(
-      std::make_tuple("processW3cCredential", &anoncreds::processW3cCredential));
-  fMap.insert(
-      std::make_tuple("verifyW3cPresentation", &anoncreds::verifyW3cPresentation));
-  fMap.insert(std::make_tuple("w3cPresentationFromJson",
-                              &anoncreds::w3cPresentationFromJson));
-  fMap.insert(
-      std::make_tuple("w3cCredentialFromJson", &anoncreds::w3cCredentialFromJson));
-  fMap.insert(
-      std::make_tuple("credentialToW3c",
-                      &anoncreds::credentialToW3c));
-  fMap.insert(
-      std::make_tuple("credentialFromW3c",
-                      &anoncreds::credentialFromW3c));
+// Built once, on first access from any runtime
+const FunctionMap &AnoncredsTurboModuleHostObject::functionMapping() {
+  static const FunctionMap fMap = [] {
+    FunctionMap fMap;
+    auto add = [&fMap](const char *name, Cb cb) {
+      fMap.emplace(name, anoncredsBinding::BindingEntry{name, cb});
+    };
+
+    add("version", &anoncreds::version);
+    add("getCurrentError", &anoncreds::getCurrentError);
+    add("objectFree", &anoncreds::objectFree);
+    add("getObject", &anoncreds::getObject);
+    add("project", &anoncreds::project);
+    add("startRecording", &anoncreds::startRecording);
+    add("stopRecording", &anoncreds::stopRecording);
+    add("getLiveHandleStatistics", &anoncreds::getLiveHandleStatistics);
+    add("getLiveHandles", &anoncreds::getLiveHandles);
+    add("beginScope", &anoncreds::beginScope);
+    add("endScope", &anoncreds::endScope);
+    add("credentialGetAttributes", &anoncreds::credentialGetAttributes);
+    add("w3cCredentialProofGetAttributes",
+        &anoncreds::w3cCredentialProofGetAttributes);
+    add("revocationRegistryDefinitionGetAttributes",
+        &anoncreds::revocationRegistryDefinitionGetAttributes);
+    add("issueCredentialFromJson", &anoncreds::issueCredentialFromJson);
+    add("issueW3cCredentialFromJson", &anoncreds::issueW3cCredentialFromJson);
+    add("encodeAttributes", &anoncreds::encodeAttributes);
+    add("batchFromJson", &anoncreds::batchFromJson);
+    add("exportToFile", &anoncreds::exportToFile);
+    add("importFromFile", &anoncreds::importFromFile);
+    add("toCbor", &anoncreds::toCbor);
+    add("fromCbor", &anoncreds::fromCbor);
+    add("snapshot", &anoncreds::snapshot);
+    add("restore", &anoncreds::restore);
+    add("receiveCredential", &anoncreds::receiveCredential);
+    add("solvePresentation", &anoncreds::solvePresentation);
+    add("credentialStoreAdd", &anoncreds::credentialStoreAdd);
+    add("credentialStoreRemove", &anoncreds::credentialStoreRemove);
+    add("credentialStoreQuery", &anoncreds::credentialStoreQuery);
+    add("credentialStoreSave", &anoncreds::credentialStoreSave);
+    add("credentialStoreLoad", &anoncreds::credentialStoreLoad);
+    add("credentialStoreClear", &anoncreds::credentialStoreClear);
+    add("verifyPresentationFromJson", &anoncreds::verifyPresentationFromJson);
+    add("verifyPresentationWithDetails",
+        &anoncreds::verifyPresentationWithDetails);
+    add("clearDefinitionCache", &anoncreds::clearDefinitionCache);
+    add("execute", &anoncreds::execute);
+    add("cancelJob", &anoncreds::cancelJob);
+    add("configureScheduler", &anoncreds::configureScheduler);
+    add("getSchedulerMetrics", &anoncreds::getSchedulerMetrics);
+
+    for (auto &binding : anoncreds::generatedBindings)
+      fMap.emplace(binding.name, binding);
 
+    return fMap;
+  }();
   return fMap;
 }
 
-jsi::Function AnoncredsTurboModuleHostObject::call(jsi::Runtime &rt,
-                                                   const char *name, Cb cb) {
+jsi::Function AnoncredsTurboModuleHostObject::call(
+    jsi::Runtime &rt, const anoncredsBinding::BindingEntry &binding) {
   return jsi::Function::createFromHostFunction(
-      rt, jsi::PropNameID::forAscii(rt, name), 1,
-      [this, cb](jsi::Runtime &rt, const jsi::Value &thisValue,
-                 const jsi::Value *arguments, size_t count) -> jsi::Value {
+      rt, jsi::PropNameID::forAscii(rt, binding.name), 1,
+      [weak = weak_from_this(), binding](
+          jsi::Runtime &rt, const jsi::Value &thisValue,
+          const jsi::Value *arguments, size_t count) -> jsi::Value {
+        auto self = weak.lock();
+        if (!self)
+          throw jsi::JSError(rt, "The anoncreds module was released");
+        auto &propNames = self->propNames;
+
+        // Installing the module is kept cheap, libanoncreds and the
+        // `PropNameID`s are only loaded once a binding is called
+        if (!anoncredsLibrary::isLoaded()) {
+          try {
+            anoncredsLibrary::load();
+          } catch (const std::runtime_error &e) {
+            throw jsi::JSError(rt, e.what());
+          }
+        }
+        if (!propNames)
+          propNames.emplace(rt);
+        anoncredsPropNames::Registry::Scope scope(*propNames);
+        anoncredsHandleRegistry::ScopeOwner owner(self.get());
+        anoncredsHandleRegistry::Site site(binding.name);
+        anoncredsTurboModuleUtility::InvokerScope invokerScope(self->invoker);
+        anoncredsTurboModuleUtility::ReturnConventionScope convention(
+            self->returnConvention());
+
+        if (binding.callPositional &&
+            anoncredsBinding::isPositional(rt, arguments, count)) {
+          if (!anoncredsCallRecorder::isRecording())
+            return binding.callPositional(rt, arguments, count);
+          jsi::Value options = binding.toOptions(rt, arguments, count);
+          return self->record(rt, binding, options);
+        }
+
         const jsi::Value *val = &arguments[0];
         anoncredsTurboModuleUtility::assertValueIsObject(rt, val);
-        return (*cb)(rt, val->getObject(rt));
+        if (anoncredsCallRecorder::isRecording())
+          return self->record(rt, binding, *val);
+        return binding.call(rt, val->getObject(rt));
       });
 };
 
+anoncredsTurboModuleUtility::ReturnConvention
+AnoncredsTurboModuleHostObject::returnConvention() const {
+  return {.throwing = throwing};
+}
+
+jsi::Value
+AnoncredsTurboModuleHostObject::record(jsi::Runtime &rt,
+                                       const anoncredsBinding::BindingEntry &binding,
+                                       const jsi::Value &options) {
+  // Traces always hold return objects, so they replay the same whichever
+  // convention was used when recording
+  jsi::Value result;
+  {
+    anoncredsTurboModuleUtility::ReturnConventionScope convention(
+        anoncredsTurboModuleUtility::ReturnConvention{});
+    result = anoncredsCallRecorder::recordCall(rt, binding.name, binding.call,
+                                               options);
+  }
+  return anoncredsTurboModuleUtility::fromReturnObject(rt, std::move(result));
+}
+
+jsi::Function
+AnoncredsTurboModuleHostObject::setReturnConvention(jsi::Runtime &rt) {
+  return jsi::Function::createFromHostFunction(
+      rt, jsi::PropNameID::forAscii(rt, "setReturnConvention"), 1,
+      [weak = weak_from_this()](jsi::Runtime &rt, const jsi::Value &thisValue,
+                                const jsi::Value *arguments,
+                                size_t count) -> jsi::Value {
+        auto self = weak.lock();
+        if (!self)
+          throw jsi::JSError(rt, "The anoncreds module was released");
+        anoncredsTurboModuleUtility::assertValueIsObject(rt, &arguments[0]);
+        auto options = arguments[0].getObject(rt);
+
+        auto errorConstructor = options.getProperty(rt, "errorConstructor");
+        if (!errorConstructor.isUndefined() &&
+            !(errorConstructor.isObject() &&
+              errorConstructor.getObject(rt).isFunction(rt)))
+          throw jsi::JSError(rt, anoncredsTurboModuleUtility::errorPrefix +
+                                     "errorConstructor" +
+                                     anoncredsTurboModuleUtility::errorInfix +
+                                     "function");
+
+        self->throwing = anoncredsTurboModuleUtility::jsiToValue<uint8_t>(
+                             rt, options, "throwing") != 0;
+        anoncredsTurboModuleUtility::setErrorConstructor(rt, errorConstructor);
+
+        return anoncredsTurboModuleUtility::createReturnValue(
+            rt, ErrorCode::Success, nullptr);
+      });
+}
+
 std::vector<jsi::PropNameID>
 AnoncredsTurboModuleHostObject::getPropertyNames(jsi::Runtime &rt) {
-  auto fMap = AnoncredsTurboModuleHostObject::functionMapping(rt);
+  auto &fMap = functionMapping();
   std::vector<jsi::PropNameID> result;
-  for (FunctionMap::iterator it = fMap.begin(); it != fMap.end(); ++it) {
-    result.push_back(jsi::PropNameID::forUtf8(rt, it->first));
-  }
+  result.reserve(fMap.size() + 1);
+  for (auto &entry : fMap)
+    result.push_back(
+        jsi::PropNameID::forAscii(rt, entry.first.data(), entry.first.size()));
+  result.push_back(jsi::PropNameID::forAscii(rt, "setReturnConvention"));
 
   return result;
 }
@@ -140,12 +188,14 @@ jsi::Value
 AnoncredsTurboModuleHostObject::get(jsi::Runtime &rt,
                                     const jsi::PropNameID &propNameId) {
   auto propName = propNameId.utf8(rt);
-  auto fMap = AnoncredsTurboModuleHostObject::functionMapping(rt);
-  for (FunctionMap::iterator it = fMap.begin(); it != fMap.end(); ++it) {
-    if (it->first == propName) {
-      return AnoncredsTurboModuleHostObject::call(rt, it->first, it->second);
-    }
-  }
+
+  auto &fMap = functionMapping();
+  auto binding = fMap.find(propName);
+  if (binding != fMap.end())
+    return call(rt, binding->second);
+
+  if (propName == "setReturnConvention")
+    return setReturnConvention(rt);
 
   /*
    * https://overreacted.io/why-do-react-elements-have-typeof-property/
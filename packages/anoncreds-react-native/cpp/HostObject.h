@@ -2,21 +2,49 @@
 
 #include <jsi/jsi.h>
 
-#include <map>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
 
 #include "anoncreds.h"
+#include "propNameRegistry.h"
 #include "turboModuleUtility.h"
 
 using namespace facebook;
 
 typedef jsi::Value (*Cb)(jsi::Runtime &rt, jsi::Object options);
-typedef std::map<const char *, Cb> FunctionMap;
+typedef std::unordered_map<std::string_view, anoncredsBinding::BindingEntry>
+    FunctionMap;
 
-class JSI_EXPORT AnoncredsTurboModuleHostObject : public jsi::HostObject {
+// Holds no `jsi::Function`: the host functions are created on every `get` and
+// only keep a weak reference to the module, so nothing created in the runtime
+// outlives it when it is torn down
+class JSI_EXPORT AnoncredsTurboModuleHostObject
+    : public jsi::HostObject,
+      public std::enable_shared_from_this<AnoncredsTurboModuleHostObject> {
 public:
-  AnoncredsTurboModuleHostObject(jsi::Runtime &rt);
-  jsi::Function call(jsi::Runtime &rt, const char *name, Cb cb);
-  FunctionMap functionMapping(jsi::Runtime &rt);
+  AnoncredsTurboModuleHostObject(
+      jsi::Runtime &rt, std::shared_ptr<react::CallInvoker> invoker);
+  ~AnoncredsTurboModuleHostObject() override;
+  jsi::Function call(jsi::Runtime &rt,
+                     const anoncredsBinding::BindingEntry &binding);
+  static const FunctionMap &functionMapping();
+
+private:
+  // Schedules callbacks on the thread of the runtime the module is installed
+  // into, null when it was installed without one
+  std::shared_ptr<react::CallInvoker> invoker;
+  std::optional<anoncredsPropNames::Registry> propNames;
+
+  // Set through `setReturnConvention`, see `ReturnConvention`
+  bool throwing = false;
+
+  anoncredsTurboModuleUtility::ReturnConvention returnConvention() const;
+  jsi::Value record(jsi::Runtime &rt,
+                    const anoncredsBinding::BindingEntry &binding,
+                    const jsi::Value &options);
+  jsi::Function setReturnConvention(jsi::Runtime &rt);
 
 public:
   jsi::Value get(jsi::Runtime &rt, const jsi::PropNameID &name) override;
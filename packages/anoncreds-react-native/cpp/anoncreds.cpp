@@ -1,879 +1,1291 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
 #include "anoncreds.h"
+#include "attributeEncoder.h"
+#include "callRecorder.h"
+#include "cbor.h"
+#include "commandBuffer.h"
+#include "credentialStore.h"
+#include "definitionCache.h"
+#include "handleRegistry.h"
 #include "include/libanoncreds.h"
+#include "json.h"
+#include "library.h"
+#include "objectBuilder.h"
+#include "objectFile.h"
+#include "parsers.h"
+#include "presentationDetails.h"
+#include "presentationSolver.h"
+#include "projection.h"
+#include "scheduler.h"
+#include "snapshot.h"
+#include "workerPool.h"
 
 using namespace anoncredsTurboModuleUtility;
 
 namespace anoncreds {
 
-// ===== GENERAL =====
-
-jsi::Value version(jsi::Runtime &rt, jsi::Object options) {
-  return jsi::String::createFromAscii(rt, anoncreds_version());
-};
-
-jsi::Value getCurrentError(jsi::Runtime &rt, jsi::Object options) {
-  const char *out;
-
-  anoncreds_get_current_error(&out);
-
-  return jsi::String::createFromAscii(rt, out);
-};
-
-jsi::Value getJson(jsi::Runtime &rt, jsi::Object options) {
-  auto handle = jsiToValue<ObjectHandle>(rt, options, "objectHandle");
-
-  ByteBuffer out;
-
-  ErrorCode code = anoncreds_object_get_json(handle, &out);
+namespace {
 
-  return createReturnValue(rt, code, &out);
-};
+// Decodes the option `Kind::key` of `options`
+template <typename Kind>
+Kind option(jsi::Runtime &rt, const jsi::Object &options) {
+  return Kind(rt, anoncredsBinding::property<Kind::key>(rt, options));
+}
 
-jsi::Value getTypeName(jsi::Runtime &rt, jsi::Object options) {
-  auto handle = jsiToValue<ObjectHandle>(rt, options, "objectHandle");
+// An object that never reaches JS, freed when it goes out of scope
+class OwnedHandle {
+public:
+  OwnedHandle() = default;
+  ~OwnedHandle() {
+    if (handle != 0)
+      anoncredsLibrary::anoncreds_object_free(handle);
+  }
 
-  const char *out;
+  OwnedHandle(const OwnedHandle &) = delete;
+  OwnedHandle &operator=(const OwnedHandle &) = delete;
+  OwnedHandle(OwnedHandle &&other) noexcept : handle(other.handle) { other.handle = 0; }
 
-  ErrorCode code = anoncreds_object_get_type_name(handle, &out);
+  ObjectHandle *out() { return &handle; }
+  operator ObjectHandle() const { return handle; }
 
-  return createReturnValue(rt, code, &out);
+private:
+  ObjectHandle handle = 0;
 };
 
-jsi::Value setDefaultLogger(jsi::Runtime &rt, jsi::Object options) {
-  anoncreds_set_default_logger();
-  return createReturnValue(rt, ErrorCode::Success, nullptr);
-};
+// Objects passed as JSON or as handles, keyed by their id:
+// `Record<string, string | number>`. JSON is resolved through the definition
+// cache, so it is only parsed the first time an id is seen, and pinned for
+// the lifetime of the call.
+template <anoncredsBinding::Key K, anoncredsDefinitionCache::Kind kind,
+          bool optional = false>
+struct Definitions {
+  static constexpr auto key = K;
+  std::vector<std::string> ids;
+  std::vector<std::string> json;
+  std::vector<ObjectHandle> handles;
+  std::vector<anoncredsDefinitionCache::Pin> pins;
+  std::vector<FfiStr> pointers;
+
+  Definitions(jsi::Runtime &rt, const jsi::Value &v) {
+    if (optional && anoncredsBinding::isAbsent(v))
+      return;
+    if (!v.isObject() || v.getObject(rt).isArray(rt))
+      anoncredsBinding::throwTypeError<key>(rt,
+                                            "Record<string, string | number>");
+
+    auto object = v.getObject(rt);
+    auto names = object.getPropertyNames(rt);
+    for (size_t i = 0; i < names.length(rt); i++) {
+      ids.push_back(names.getValueAtIndex(rt, i).getString(rt).utf8(rt));
+      auto value = object.getProperty(rt, ids.back().c_str());
+      if (value.isString()) {
+        json.push_back(value.getString(rt).utf8(rt));
+        handles.push_back(0);
+      } else {
+        json.emplace_back();
+        handles.push_back(anoncredsBinding::decodeHandle<key>(
+            rt, value, "Record<string, string | number>"));
+      }
+    }
+  }
 
-jsi::Value objectFree(jsi::Runtime &rt, jsi::Object options) {
-  auto handle = jsiToValue<ObjectHandle>(rt, options, "objectHandle");
+  // Parses or looks up the objects passed as JSON
+  ErrorCode resolve() {
+    for (size_t i = 0; i < ids.size(); i++) {
+      if (handles[i] != 0)
+        continue;
+      anoncredsDefinitionCache::Pin pin;
+      auto code = anoncredsDefinitionCache::resolve(kind, ids[i], json[i],
+                                                    &pin);
+      if (code != ErrorCode::Success)
+        return code;
+      handles[i] = pin->handle;
+      pins.push_back(std::move(pin));
+    }
+    return ErrorCode::Success;
+  }
 
-  anoncreds_object_free(handle);
+  FfiList_ObjectHandle objects() const {
+    return FfiList_ObjectHandle{.count = handles.size(),
+                                .data = handles.data()};
+  }
 
-  return createReturnValue(rt, ErrorCode::Success, nullptr);
+  FfiStrList idList() {
+    pointers.clear();
+    for (auto &id : ids)
+      pointers.push_back(id.c_str());
+    return FfiStrList{.count = pointers.size(), .data = pointers.data()};
+  }
 };
 
-// ===== META =====
+// A definition passed as JSON or as a handle, `string | number`. JSON is
+// resolved through the definition cache under an id that is only known once
+// other inputs have been parsed, and pinned for the lifetime of the call.
+template <anoncredsBinding::Key K, anoncredsDefinitionCache::Kind kind,
+          bool optional = false>
+struct Definition {
+  static constexpr auto key = K;
+  std::string json;
+  ObjectHandle value = 0;
+  anoncredsDefinitionCache::Pin pin;
+
+  Definition(jsi::Runtime &rt, const jsi::Value &v) {
+    if (optional && anoncredsBinding::isAbsent(v))
+      return;
+    if (v.isString())
+      json = v.getString(rt).utf8(rt);
+    else
+      value = anoncredsBinding::decodeHandle<key>(rt, v, "string | number");
+  }
 
-jsi::Value createLinkSecret(jsi::Runtime &rt, jsi::Object options) {
-  const char *out;
+  bool isAbsent() const { return value == 0 && json.empty(); }
 
-  ErrorCode code = anoncreds_create_link_secret(&out);
+  ErrorCode resolve(const std::string &id) {
+    if (value != 0 || json.empty())
+      return ErrorCode::Success;
+    auto code = anoncredsDefinitionCache::resolve(kind, id, json, &pin);
+    if (code == ErrorCode::Success)
+      value = pin->handle;
+    return code;
+  }
 
-  return createReturnValue(rt, code, &out);
+  ObjectHandle ffi() const { return value; }
 };
 
-jsi::Value generateNonce(jsi::Runtime &rt, jsi::Object options) {
-  const char *out;
+// Revocation status lists passed as JSON or as handles. They change with every
+// revocation, so the ones passed as JSON are parsed for the call and freed.
+template <anoncredsBinding::Key K> struct StatusLists {
+  static constexpr auto key = K;
+  std::vector<std::string> json;
+  std::vector<ObjectHandle> handles;
+  std::vector<OwnedHandle> parsed;
+
+  StatusLists(jsi::Runtime &rt, const jsi::Value &v) {
+    auto array = anoncredsBinding::asArray<key>(
+        rt, v, "Array<string | number>", true);
+    auto length = array ? array->length(rt) : 0;
+    for (size_t i = 0; i < length; i++) {
+      auto element = array->getValueAtIndex(rt, i);
+      if (element.isString()) {
+        json.push_back(element.getString(rt).utf8(rt));
+        handles.push_back(0);
+      } else {
+        json.emplace_back();
+        handles.push_back(anoncredsBinding::decodeHandle<key>(
+            rt, element, "Array<string | number>"));
+      }
+    }
+  }
 
-  ErrorCode code = anoncreds_generate_nonce(&out);
+  ErrorCode resolve() {
+    for (size_t i = 0; i < handles.size(); i++) {
+      if (handles[i] != 0)
+        continue;
+      auto &list = parsed.emplace_back();
+      auto code = anoncredsLibrary::anoncreds_revocation_status_list_from_json(
+          ByteBuffer{.len = int64_t(json[i].size()),
+                     .data = (uint8_t *)json[i].data()},
+          list.out());
+      if (code != ErrorCode::Success)
+        return code;
+      handles[i] = list;
+    }
+    return ErrorCode::Success;
+  }
 
-  return createReturnValue(rt, code, &out);
+  FfiList_ObjectHandle ffi() const {
+    return FfiList_ObjectHandle{.count = handles.size(),
+                                .data = handles.data()};
+  }
 };
 
-// ===== Anoncreds Objects =====
-
-jsi::Value createSchema(jsi::Runtime &rt, jsi::Object options) {
-  auto name = jsiToValue<std::string>(rt, options, "name");
-  auto version = jsiToValue<std::string>(rt, options, "version");
-  auto issuerId = jsiToValue<std::string>(rt, options, "issuerId");
-  auto attributeNames = jsiToValue<FfiStrList>(rt, options, "attributeNames");
-
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_create_schema(
-      name.c_str(), version.c_str(), issuerId.c_str(), attributeNames, &out);
+const anoncredsParsers::Parser *findParser(jsi::Runtime &rt,
+                                           const std::string &type) {
+  auto parser = anoncredsParsers::find(type);
+  if (parser == nullptr)
+    throw jsi::JSError(rt, "Value `type` is not the type of an object that "
+                           "can be parsed from JSON");
+  return parser;
+}
 
-  return createReturnValue(rt, code, &out);
+// An entry of `batchFromJson`, `{ type, json }` or `[type, json]`
+struct BatchEntry {
+  const anoncredsParsers::Parser *parser;
+  std::string json;
+  ObjectHandle handle = 0;
+  ErrorCode code = ErrorCode::Success;
 };
 
-jsi::Value createCredentialDefinition(jsi::Runtime &rt, jsi::Object options) {
-  auto schemaId = jsiToValue<std::string>(rt, options, "schemaId");
-  auto schema = jsiToValue<ObjectHandle>(rt, options, "schema");
-  auto tag = jsiToValue<std::string>(rt, options, "tag");
-  auto issuerId = jsiToValue<std::string>(rt, options, "issuerId");
-  auto signatureType = jsiToValue<std::string>(rt, options, "signatureType");
-  auto supportRevocation = jsiToValue<int8_t>(rt, options, "supportRevocation");
-
-  CredentialDefinitionReturn out;
+std::vector<BatchEntry> batchEntries(jsi::Runtime &rt, const jsi::Value &v) {
+  using namespace anoncredsBinding;
+  std::vector<BatchEntry> entries;
+  forEachStruct<"entries">(
+      rt, v, "Array<BatchFromJsonEntry>", false, [&](Fields &fields) {
+        auto parser = findParser(rt, fields.get<Str<"type">>(0).value);
+        entries.push_back(BatchEntry{
+            .parser = parser,
+            .json = std::move(fields.get<Json<"json">>(1).value)});
+      });
+  return entries;
+}
 
-  ErrorCode code = anoncreds_create_credential_definition(
-      schemaId.c_str(), schema, tag.c_str(), issuerId.c_str(),
-      signatureType.c_str(), supportRevocation, &out.credentialDefinition,
-      &out.credentialDefinitionPrivate, &out.keyCorrectnessProof);
+// Parses the entries on the worker pool
+void parseBatch(std::vector<BatchEntry> &entries) {
+  anoncredsWorkerPool::parallelFor(entries.size(), [&](size_t i) {
+    auto &entry = entries[i];
+    entry.code = entry.parser->parse(
+        ByteBuffer{.len = int64_t(entry.json.size()),
+                   .data = (uint8_t *)entry.json.data()},
+        &entry.handle);
+  });
+}
 
-  return createReturnValue(rt, code, &out);
-};
+// Parses the credential offer and request, issues a credential with `create`
+// and returns its JSON. None of the intermediate objects reach JS.
+template <typename Create>
+jsi::Value issueFromJson(jsi::Runtime &rt, const jsi::Object &options,
+                         Create create) {
+  auto offerJson = option<anoncredsBinding::Json<"credentialOffer">>(rt, options);
+  auto requestJson =
+      option<anoncredsBinding::Json<"credentialRequest">>(rt, options);
+
+  OwnedHandle offer, request, credential;
+  auto code = anoncredsLibrary::anoncreds_credential_offer_from_json(
+      offerJson.ffi(), offer.out());
+  if (code == ErrorCode::Success)
+    code = anoncredsLibrary::anoncreds_credential_request_from_json(
+        requestJson.ffi(), request.out());
+  if (code == ErrorCode::Success)
+    code = create(offer, request, credential.out());
+  if (code != ErrorCode::Success)
+    return returnValue(rt, code, jsi::Value::undefined());
+
+  ByteBuffer json{};
+  code = anoncredsLibrary::anoncreds_object_get_json(credential, &json);
+  return createReturnValue(rt, code, &json);
+}
 
-// ===== AnonCreds Objects from JSON =====
+// Reads the attributes `names` of every object of `objectHandles` with `get`,
+// as one array per name with an element per object. Attributes that are not
+// set, or can not be read, are null.
+jsi::Value getAttributes(jsi::Runtime &rt, const jsi::Object &options,
+                         ErrorCode (*get)(ObjectHandle, FfiStr,
+                                          const char **)) {
+  using namespace anoncredsBinding;
+  auto handles = option<HandleList<"objectHandles">>(rt, options);
+  auto names = option<StrList<"names">>(rt, options);
+
+  auto result = jsi::Object(rt);
+  for (auto &name : names.items) {
+    auto column = jsi::Array(rt, handles.items.size());
+    for (size_t i = 0; i < handles.items.size(); i++) {
+      const char *value = nullptr;
+      auto code = get(handles.items[i], name.c_str(), &value);
+      if (code == ErrorCode::Success && value != nullptr) {
+        column.setValueAtIndex(rt, i, jsi::String::createFromUtf8(rt, value));
+        anoncredsLibrary::anoncreds_string_free((char *)value);
+      } else {
+        column.setValueAtIndex(rt, i, jsi::Value::null());
+      }
+    }
+    result.setProperty(rt, name.c_str(), std::move(column));
+  }
+  return returnValue(rt, ErrorCode::Success, std::move(result));
+}
 
-ByteBuffer stringToByteBuffer(std::string str) {
-  ByteBuffer b;
-  size_t len = str.size();
-  uint8_t *c = new uint8_t[len + 1];
-  std::copy(str.begin(), str.end(), c);
-  c[len] = '\0';
-  b.data = c;
-  b.len = len;
+// The priority class of a job, from the optional `priority` option
+anoncredsScheduler::Priority jobPriority(jsi::Runtime &rt,
+                                         jsi::Object &options) {
+  auto priority = jsiToValue<std::string>(rt, options, "priority", true);
+  if (priority.empty() || priority == "normal")
+    return anoncredsScheduler::Priority::Normal;
+  if (priority == "userBlocking")
+    return anoncredsScheduler::Priority::UserBlocking;
+  if (priority == "background")
+    return anoncredsScheduler::Priority::Background;
+  throw jsi::JSError(rt, errorPrefix + "priority" + errorInfix +
+                             "'userBlocking' | 'normal' | 'background'");
+}
 
-  return b;
+// The error a job that did not run to its end is reported with, an `Error`
+// with `reason` set to `canceled` or `expired`
+jsi::Value jobError(jsi::Runtime &rt, anoncredsScheduler::Outcome outcome) {
+  auto expired = outcome == anoncredsScheduler::Outcome::Expired;
+  auto error = jsi::JSError(rt, expired ? "The job was dropped as its "
+                                          "deadline passed before it started"
+                                        : "The job was canceled")
+                   .value()
+                   .getObject(rt);
+  error.setProperty(rt, "reason", expired ? "expired" : "canceled");
+  return error;
 }
 
-jsi::Value revocationRegistryDefinitionFromJson(jsi::Runtime &rt,
-                                                jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
+jsi::Value functionOf(jsi::Runtime &rt, const jsi::Value &object,
+                      const char *name) {
+  if (!object.isObject())
+    return jsi::Value::undefined();
+  auto value = object.getObject(rt).getProperty(rt, name);
+  if (!value.isObject() || !value.getObject(rt).isFunction(rt))
+    return jsi::Value::undefined();
+  return value;
+}
 
-  ObjectHandle out;
+// Reports an error thrown by a callback as an uncaught error, through
+// `ErrorUtils.reportError` in React Native, or else by rethrowing it from a
+// `setTimeout` callback. Nothing may throw out of `invokeAsync`.
+void reportCallbackError(jsi::Runtime &rt, jsi::Value error) {
+  try {
+    auto global = jsi::Value(rt, rt.global());
+    auto reportError =
+        functionOf(rt, global.getObject(rt).getProperty(rt, "ErrorUtils"),
+                   "reportError");
+    if (!reportError.isUndefined()) {
+      reportError.getObject(rt).getFunction(rt).call(rt, error);
+      return;
+    }
+
+    auto setTimeout = functionOf(rt, global, "setTimeout");
+    if (setTimeout.isUndefined())
+      return;
+    auto thrown = std::make_shared<jsi::Value>(std::move(error));
+    auto rethrow = jsi::Function::createFromHostFunction(
+        rt, jsi::PropNameID::forAscii(rt, "rethrow"), 0,
+        [thrown](jsi::Runtime &rt, const jsi::Value &, const jsi::Value *,
+                 size_t) -> jsi::Value {
+          throw jsi::JSError(rt, jsi::Value(rt, *thrown));
+        });
+    setTimeout.getObject(rt).getFunction(rt).call(rt, rethrow, 0);
+  } catch (const std::exception &) {
+    // There is nowhere left to report it
+  }
+}
 
-  ErrorCode code = anoncreds_revocation_registry_definition_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
+} // namespace
 
-  // Free memory
-  delete[] json.data;
+// ===== GENERAL =====
 
-  return returnValue;
+jsi::Value version(jsi::Runtime &rt, jsi::Object options) {
+  return jsi::String::createFromAscii(rt, anoncredsLibrary::anoncreds_version());
 };
 
-jsi::Value revocationRegistryFromJson(jsi::Runtime &rt, jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
-
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_revocation_registry_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
+jsi::Value getCurrentError(jsi::Runtime &rt, jsi::Object options) {
+  const char *out;
 
-  // Free memory
-  delete[] json.data;
+  anoncredsLibrary::anoncreds_get_current_error(&out);
 
-  return returnValue;
+  return jsi::String::createFromAscii(rt, out);
 };
 
-jsi::Value revocationStatusListFromJson(jsi::Runtime &rt,
-                                                jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
-
-  ObjectHandle out;
+jsi::Value objectFree(jsi::Runtime &rt, jsi::Object options) {
+  auto handle = jsiToValue<ObjectHandle>(rt, options, "objectHandle");
 
-  ErrorCode code = anoncreds_revocation_status_list_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
+  // A restored object that was never used was never parsed either
+  if (anoncredsSnapshot::isRestored(handle)) {
+    handle = anoncredsSnapshot::release(handle);
+    if (handle == 0)
+      return createReturnValue(rt, ErrorCode::Success, nullptr);
+  }
 
-  // Free memory
-  delete[] json.data;
+  anoncredsLibrary::anoncreds_object_free(handle);
+  anoncredsHandleRegistry::untrack(handle);
 
-  return returnValue;
+  return createReturnValue(rt, ErrorCode::Success, nullptr);
 };
 
-
-jsi::Value presentationFromJson(jsi::Runtime &rt, jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
-
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_presentation_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
-
-  // Free memory
-  delete[] json.data;
-
-  return returnValue;
+jsi::Value getObject(jsi::Runtime &rt, jsi::Object options) {
+  auto handle = restoredObject(
+      rt, jsiToValue<ObjectHandle>(rt, options, "objectHandle"));
+
+  ByteBuffer json{};
+  auto code = anoncredsLibrary::anoncreds_object_get_json(handle, &json);
+  if (code != ErrorCode::Success)
+    return returnValue(rt, code, jsi::Value::null());
+
+  jsi::Value object;
+  try {
+    object = anoncredsObjectBuilder::build(rt, (const char *)json.data,
+                                           size_t(json.len));
+  } catch (const std::invalid_argument &e) {
+    anoncredsLibrary::anoncreds_buffer_free(json);
+    throw jsi::JSError(rt, std::string("Unable to read object: ") + e.what());
+  } catch (...) {
+    anoncredsLibrary::anoncreds_buffer_free(json);
+    throw;
+  }
+  anoncredsLibrary::anoncreds_buffer_free(json);
+  return returnValue(rt, code, std::move(object));
 };
 
-jsi::Value presentationRequestFromJson(jsi::Runtime &rt, jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
-
-  ObjectHandle out;
+jsi::Value project(jsi::Runtime &rt, jsi::Object options) {
+  using namespace anoncredsBinding;
+  auto handle = option<Handle<"objectHandle">>(rt, options);
+  auto paths = option<StrList<"paths">>(rt, options);
 
-  ErrorCode code = anoncreds_presentation_request_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
-
-  // Free memory
-  delete[] json.data;
+  std::shared_ptr<const anoncredsProjection::Projection> projection;
+  try {
+    projection = anoncredsProjection::compile(paths.items);
+  } catch (const std::invalid_argument &e) {
+    throw jsi::JSError(rt, e.what());
+  }
 
-  return returnValue;
+  ByteBuffer json{};
+  auto code = anoncredsLibrary::anoncreds_object_get_json(handle.value, &json);
+  if (code != ErrorCode::Success)
+    return returnValue(rt, code, jsi::Value::null());
+
+  // Paths that select nothing are left `undefined`
+  auto values = jsi::Array(rt, paths.items.size());
+  try {
+    std::vector<std::string_view> selected;
+    if (!anoncredsProjection::evaluate(
+            *projection, {(const char *)json.data, size_t(json.len)},
+            selected))
+      throw std::invalid_argument("Invalid JSON");
+    for (size_t i = 0; i < selected.size(); i++)
+      if (selected[i].data() != nullptr)
+        values.setValueAtIndex(
+            rt, i,
+            anoncredsObjectBuilder::build(rt, selected[i].data(),
+                                          selected[i].size()));
+  } catch (const std::invalid_argument &e) {
+    anoncredsLibrary::anoncreds_buffer_free(json);
+    throw jsi::JSError(rt, std::string("Unable to read object: ") + e.what());
+  } catch (...) {
+    anoncredsLibrary::anoncreds_buffer_free(json);
+    throw;
+  }
+  anoncredsLibrary::anoncreds_buffer_free(json);
+  return returnValue(rt, code, std::move(values));
 };
 
-jsi::Value credentialOfferFromJson(jsi::Runtime &rt, jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
-
-  ObjectHandle out;
+// ===== RECORDING =====
 
-  ErrorCode code = anoncreds_credential_offer_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
+jsi::Value startRecording(jsi::Runtime &rt, jsi::Object options) {
+  auto path = jsiToValue<std::string>(rt, options, "path");
 
-  // Free memory
-  delete[] json.data;
+  try {
+    anoncredsCallRecorder::start(path);
+  } catch (const std::runtime_error &e) {
+    throw jsi::JSError(rt, e.what());
+  }
 
-  return returnValue;
+  return createReturnValue(rt, ErrorCode::Success, nullptr);
 };
 
-jsi::Value schemaFromJson(jsi::Runtime &rt, jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
+jsi::Value stopRecording(jsi::Runtime &rt, jsi::Object options) {
+  anoncredsCallRecorder::stop();
 
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_schema_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
-
-  // Free memory
-  delete[] json.data;
-
-  return returnValue;
+  return createReturnValue(rt, ErrorCode::Success, nullptr);
 };
 
-jsi::Value credentialRequestFromJson(jsi::Runtime &rt, jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
+// ===== LIVE HANDLES =====
 
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_credential_request_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
-
-  // Free memory
-  delete[] json.data;
+jsi::Value getLiveHandleStatistics(jsi::Runtime &rt, jsi::Object options) {
+  auto value = jsi::Object(rt);
+  for (auto &statistics : anoncredsHandleRegistry::statistics()) {
+    auto entry = jsi::Object(rt);
+    entry.setProperty(rt, "count", double(statistics.count));
+    entry.setProperty(rt, "bytes", double(statistics.bytes));
+    value.setProperty(rt, statistics.type.c_str(), entry);
+  }
 
-  return returnValue;
+  return returnValue(rt, ErrorCode::Success, std::move(value));
 };
 
-jsi::Value credentialRequestMetadataFromJson(jsi::Runtime &rt,
-                                             jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
-
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_credential_request_metadata_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
-
-  // Free memory
-  delete[] json.data;
+jsi::Value getLiveHandles(jsi::Runtime &rt, jsi::Object options) {
+  auto olderThan = jsiToValue<int64_t>(rt, options, "olderThan", true);
+
+  auto handles = anoncredsHandleRegistry::olderThan(olderThan);
+  auto value = jsi::Array(rt, handles.size());
+  for (size_t i = 0; i < handles.size(); i++) {
+    auto entry = jsi::Object(rt);
+    entry.setProperty(rt, "handle", double(handles[i].handle));
+    entry.setProperty(rt, "type",
+                      jsi::String::createFromUtf8(rt, handles[i].type));
+    entry.setProperty(rt, "site",
+                      jsi::String::createFromAscii(rt, handles[i].site));
+    entry.setProperty(rt, "createdAt", double(handles[i].createdAt));
+    entry.setProperty(rt, "bytes", double(handles[i].bytes));
+    value.setValueAtIndex(rt, i, entry);
+  }
 
-  return returnValue;
+  return returnValue(rt, ErrorCode::Success, std::move(value));
 };
 
-jsi::Value credentialFromJson(jsi::Runtime &rt, jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
-
-  ObjectHandle out;
+// ===== HANDLE SCOPES =====
 
-  ErrorCode code = anoncreds_credential_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
+jsi::Value beginScope(jsi::Runtime &rt, jsi::Object options) {
+  auto scope = anoncredsHandleRegistry::openScope();
 
-  // Free memory
-  delete[] json.data;
-
-  return returnValue;
+  return returnValue(rt, ErrorCode::Success, double(scope));
 };
 
-jsi::Value revocationRegistryDefinitionPrivateFromJson(jsi::Runtime &rt,
-                                                       jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
-
-  ObjectHandle out;
+jsi::Value endScope(jsi::Runtime &rt, jsi::Object options) {
+  auto scope = jsiToValue<int64_t>(rt, options, "scope");
+  auto keep = anoncredsBinding::HandleList<"keep", true>(
+      rt, options.getProperty(rt, "keep"));
 
-  ErrorCode code =
-      anoncreds_revocation_registry_definition_private_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
+  std::vector<ObjectHandle> handles;
+  try {
+    handles = anoncredsHandleRegistry::closeScope(scope, keep.items);
+  } catch (const std::invalid_argument &e) {
+    throw jsi::JSError(rt, e.what());
+  }
 
-  // Free memory
-  delete[] json.data;
+  for (auto handle : handles)
+    anoncredsLibrary::anoncreds_object_free(handle);
 
-  return returnValue;
+  return createReturnValue(rt, ErrorCode::Success, nullptr);
 };
 
-jsi::Value revocationStateFromJson(jsi::Runtime &rt, jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
+// ===== ATTRIBUTES =====
 
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_revocation_state_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
-
-  // Free memory
-  delete[] json.data;
-
-  return returnValue;
+jsi::Value credentialGetAttributes(jsi::Runtime &rt, jsi::Object options) {
+  return getAttributes(rt, options,
+                       anoncredsLibrary::anoncreds_credential_get_attribute);
 };
 
-jsi::Value credentialDefinitionFromJson(jsi::Runtime &rt, jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
-
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_credential_definition_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
-
-  // Free memory
-  delete[] json.data;
-
-  return returnValue;
+jsi::Value w3cCredentialProofGetAttributes(jsi::Runtime &rt,
+                                           jsi::Object options) {
+  return getAttributes(
+      rt, options,
+      anoncredsLibrary::anoncreds_w3c_credential_proof_get_attribute);
 };
 
-jsi::Value credentialDefinitionPrivateFromJson(jsi::Runtime &rt,
-                                               jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
-
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_credential_definition_private_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
-
-  // Free memory
-  delete[] json.data;
-
-  return returnValue;
+jsi::Value revocationRegistryDefinitionGetAttributes(jsi::Runtime &rt,
+                                                     jsi::Object options) {
+  return getAttributes(
+      rt, options,
+      anoncredsLibrary::anoncreds_revocation_registry_definition_get_attribute);
 };
 
-jsi::Value keyCorrectnessProofFromJson(jsi::Runtime &rt, jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
-
-  ObjectHandle out;
+// ===== ISSUANCE =====
 
-  ErrorCode code = anoncreds_key_correctness_proof_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
-
-  // Free memory
-  delete[] json.data;
-
-  return returnValue;
+jsi::Value issueCredentialFromJson(jsi::Runtime &rt, jsi::Object options) {
+  using namespace anoncredsBinding;
+  auto credentialDefinition = option<Handle<"credentialDefinition">>(rt, options);
+  auto credentialDefinitionPrivate =
+      option<Handle<"credentialDefinitionPrivate">>(rt, options);
+  auto attributeNames = option<StrList<"attributeNames">>(rt, options);
+  auto attributeRawValues = option<StrList<"attributeRawValues">>(rt, options);
+  auto attributeEncodedValues =
+      option<StrList<"attributeEncodedValues", true>>(rt, options);
+  auto revocationConfiguration =
+      option<CredRevInfo<"revocationConfiguration">>(rt, options);
+
+  return issueFromJson(rt, options, [&](ObjectHandle offer,
+                                        ObjectHandle request,
+                                        ObjectHandle *credential) {
+    return anoncredsLibrary::anoncreds_create_credential(
+        credentialDefinition.ffi(), credentialDefinitionPrivate.ffi(), offer,
+        request, attributeNames.ffi(), attributeRawValues.ffi(),
+        attributeEncodedValues.ffi(), revocationConfiguration.ffi(),
+        credential);
+  });
 };
 
-// ===== PROOFS =====
-
-jsi::Value createPresentation(jsi::Runtime &rt, jsi::Object options) {
-  auto presentationRequest =
-      jsiToValue<ObjectHandle>(rt, options, "presentationRequest");
-  auto credentials =
-      jsiToValue<FfiList_FfiCredentialEntry>(rt, options, "credentials");
-  auto credentialsProve =
-      jsiToValue<FfiList_FfiCredentialProve>(rt, options, "credentialsProve");
-  auto selfAttestedNames =
-      jsiToValue<FfiStrList>(rt, options, "selfAttestNames");
-  auto selfAttestedValues =
-      jsiToValue<FfiStrList>(rt, options, "selfAttestValues");
-  auto linkSecret = jsiToValue<std::string>(rt, options, "linkSecret");
-  auto schemas = jsiToValue<FfiList_ObjectHandle>(rt, options, "schemas");
-  auto schemaIds = jsiToValue<FfiList_FfiStr>(rt, options, "schemaIds");
-  auto credentialDefinitions =
-      jsiToValue<FfiList_ObjectHandle>(rt, options, "credentialDefinitions");
-  auto credentialDefinitionIds =
-      jsiToValue<FfiList_FfiStr>(rt, options, "credentialDefinitionIds");
-
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_create_presentation(
-      presentationRequest, credentials, credentialsProve, selfAttestedNames,
-      selfAttestedValues, linkSecret.c_str(), schemas, schemaIds,
-      credentialDefinitions, credentialDefinitionIds, &out);
-
-  auto returnValue = createReturnValue(rt, code, &out);
+jsi::Value issueW3cCredentialFromJson(jsi::Runtime &rt, jsi::Object options) {
+  using namespace anoncredsBinding;
+  auto credentialDefinition = option<Handle<"credentialDefinition">>(rt, options);
+  auto credentialDefinitionPrivate =
+      option<Handle<"credentialDefinitionPrivate">>(rt, options);
+  auto attributeNames = option<StrList<"attributeNames">>(rt, options);
+  auto attributeRawValues = option<StrList<"attributeRawValues">>(rt, options);
+  auto revocationConfiguration =
+      option<CredRevInfo<"revocationConfiguration">>(rt, options);
+  auto w3cVersion = option<OptionalStr<"w3cVersion">>(rt, options);
+
+  return issueFromJson(rt, options, [&](ObjectHandle offer,
+                                        ObjectHandle request,
+                                        ObjectHandle *credential) {
+    return anoncredsLibrary::anoncreds_create_w3c_credential(
+        credentialDefinition.ffi(), credentialDefinitionPrivate.ffi(), offer,
+        request, attributeNames.ffi(), attributeRawValues.ffi(),
+        revocationConfiguration.ffi(), w3cVersion.ffi(), credential);
+  });
+};
 
-  // Free memory
-  delete[] credentials.data;
-  for (int i = 0; i < credentialsProve.count; i++) {
-    delete[] credentialsProve.data[i].referent;
-  }
-  for (int i = 0; i < schemaIds.count; i++) {
-    delete[] schemaIds.data[i];
-  }
-  delete[] schemas.data;
-  for (int i = 0; i < credentialDefinitionIds.count; i++) {
-    delete[] credentialDefinitionIds.data[i];
-  }
-  delete[] credentialDefinitions.data;
-  for (int i = 0; i < selfAttestedNames.count; i++) {
-    delete[] selfAttestedNames.data[i];
-  }
-  for (int i = 0; i < selfAttestedValues.count; i++) {
-    delete[] selfAttestedValues.data[i];
+jsi::Value encodeAttributes(jsi::Runtime &rt, jsi::Object options) {
+  auto values = options.getProperty(rt, "values");
+  if (values.isObject() && values.getObject(rt).isArray(rt)) {
+    auto raw = anoncredsBinding::StrList<"values">(rt, values);
+    std::vector<std::string> encoded;
+    anoncredsAttributeEncoder::encodeAll(raw.items, encoded);
+
+    auto value = jsi::Array(rt, encoded.size());
+    for (size_t i = 0; i < encoded.size(); i++)
+      value.setValueAtIndex(rt, i,
+                            jsi::String::createFromAscii(rt, encoded[i]));
+    return returnValue(rt, ErrorCode::Success, std::move(value));
   }
 
-  return returnValue;
+  auto bytes = jsiToValue<ByteSpan>(rt, options, "values");
+  std::vector<uint8_t> encoded;
+  if (!anoncredsAttributeEncoder::encodePacked(bytes.data, bytes.size,
+                                               encoded))
+    throw jsi::JSError(rt, "Value `values` is not packed attribute values");
+  return createReturnValue(rt, ErrorCode::Success, &encoded);
 };
 
-jsi::Value verifyPresentation(jsi::Runtime &rt, jsi::Object options) {
-  auto presentation = jsiToValue<ObjectHandle>(rt, options, "presentation");
-  auto presentationRequest =
-      jsiToValue<ObjectHandle>(rt, options, "presentationRequest");
-  auto schemas = jsiToValue<FfiList_ObjectHandle>(rt, options, "schemas");
-  auto schemaIds = jsiToValue<FfiList_FfiStr>(rt, options, "schemaIds");
-  auto credentialDefinitions =
-      jsiToValue<FfiList_ObjectHandle>(rt, options, "credentialDefinitions");
-  auto credentialDefinitionIds =
-      jsiToValue<FfiList_FfiStr>(rt, options, "credentialDefinitionIds");
-  auto revocationRegistryDefinitions = jsiToValue<FfiList_ObjectHandle>(
-      rt, options, "revocationRegistryDefinitions", true);
-  auto revocationRegistryDefinitionIds = jsiToValue<FfiList_FfiStr>(
-      rt, options, "revocationRegistryDefinitionIds", true);
-  auto revocationStatusLists = jsiToValue<FfiList_ObjectHandle>(
-      rt, options, "revocationStatusLists", true);
-  auto nonRevokedIntervalOverrides =
-      jsiToValue<FfiList_FfiNonrevokedIntervalOverride>(
-          rt, options, "nonRevokedIntervalOverrides", true);
-
-  int8_t out;
-
-  ErrorCode code = anoncreds_verify_presentation(
-      presentation, presentationRequest, schemas, schemaIds,
-      credentialDefinitions, credentialDefinitionIds,
-      revocationRegistryDefinitions, revocationRegistryDefinitionIds,
-      revocationStatusLists, nonRevokedIntervalOverrides, &out);
-
-  auto returnValue = createReturnValue(rt, code, &out);
-
-  // Free memory
-  for (int i = 0; i < schemaIds.count; i++) {
-    delete[] schemaIds.data[i];
+// ===== PARSING =====
+
+jsi::Value batchFromJson(jsi::Runtime &rt, jsi::Object options) {
+  auto entries = batchEntries(rt, options.getProperty(rt, "entries"));
+
+  // Resolve the functions before the workers race to do it
+  anoncredsLibrary::load();
+  parseBatch(entries);
+
+  auto handles = jsi::Array(rt, entries.size());
+  auto errorCodes = jsi::Array(rt, entries.size());
+  for (size_t i = 0; i < entries.size(); i++) {
+    auto &entry = entries[i];
+    if (entry.code == ErrorCode::Success) {
+      anoncredsHandleRegistry::Site site(entry.parser->binding);
+      anoncredsHandleRegistry::track(entry.handle);
+    }
+    handles.setValueAtIndex(rt, i,
+                            entry.code == ErrorCode::Success
+                                ? jsi::Value(rt, int(entry.handle))
+                                : jsi::Value::null());
+    errorCodes.setValueAtIndex(rt, i, jsi::Value(rt, int(entry.code)));
   }
-  delete[] schemas.data;
-  for (int i = 0; i < credentialDefinitionIds.count; i++) {
-    delete[] credentialDefinitionIds.data[i];
-  }
-  delete[] credentialDefinitions.data;
 
-  return returnValue;
+  auto result = jsi::Object(rt);
+  result.setProperty(rt, "handles", std::move(handles));
+  result.setProperty(rt, "errorCodes", std::move(errorCodes));
+  return returnValue(rt, ErrorCode::Success, std::move(result));
 };
 
-// ===== CREDENTIALS =====
-
-jsi::Value createCredential(jsi::Runtime &rt, jsi::Object options) {
-  auto credentialDefinition =
-      jsiToValue<ObjectHandle>(rt, options, "credentialDefinition");
-  auto credentialDefinitionPrivate =
-      jsiToValue<ObjectHandle>(rt, options, "credentialDefinitionPrivate");
-  auto credentialOffer =
-      jsiToValue<ObjectHandle>(rt, options, "credentialOffer");
-  auto credentialRequest =
-      jsiToValue<ObjectHandle>(rt, options, "credentialRequest");
-  auto attributeNames = jsiToValue<FfiStrList>(rt, options, "attributeNames");
-  auto attributeRawValues =
-      jsiToValue<FfiStrList>(rt, options, "attributeRawValues");
-  auto attributeEncodedValues =
-      jsiToValue<FfiStrList>(rt, options, "attributeEncodedValues", true);
-  auto revocation =
-      jsiToValue<FfiCredRevInfo>(rt, options, "revocationConfiguration", true);
-
-  ObjectHandle out;
+jsi::Value exportToFile(jsi::Runtime &rt, jsi::Object options) {
+  auto handle = restoredObject(
+      rt, jsiToValue<ObjectHandle>(rt, options, "objectHandle"));
+  auto path = jsiToValue<std::string>(rt, options, "path");
 
-  ErrorCode code = anoncreds_create_credential(
-      credentialDefinition, credentialDefinitionPrivate, credentialOffer,
-      credentialRequest, attributeNames, attributeRawValues,
-      attributeEncodedValues, revocation.reg_def ? &revocation : 0, &out);
+  ErrorCode code;
+  try {
+    code = anoncredsObjectFile::exportJson(handle, path);
+  } catch (const std::runtime_error &e) {
+    throw jsi::JSError(rt, e.what());
+  }
 
-  return createReturnValue(rt, code, &out);
+  return createReturnValue(rt, code, nullptr);
 };
 
-jsi::Value createCredentialOffer(jsi::Runtime &rt, jsi::Object options) {
-  auto schemaId = jsiToValue<std::string>(rt, options, "schemaId");
-  auto credentialDefinitionId =
-      jsiToValue<std::string>(rt, options, "credentialDefinitionId");
-  auto keyCorrectnessProof =
-      jsiToValue<ObjectHandle>(rt, options, "keyCorrectnessProof");
-
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_create_credential_offer(
-      schemaId.c_str(), credentialDefinitionId.c_str(), keyCorrectnessProof,
-      &out);
+jsi::Value importFromFile(jsi::Runtime &rt, jsi::Object options) {
+  auto parser =
+      findParser(rt, jsiToValue<std::string>(rt, options, "type"));
+  auto path = jsiToValue<std::string>(rt, options, "path");
+
+  ObjectHandle handle = 0;
+  ErrorCode code;
+  try {
+    code = anoncredsObjectFile::importJson(parser->parse, path, &handle);
+  } catch (const std::runtime_error &e) {
+    throw jsi::JSError(rt, e.what());
+  }
+  if (code == ErrorCode::Success)
+    anoncredsHandleRegistry::track(handle);
 
-  return createReturnValue(rt, code, &out);
+  return createReturnValue(rt, code, &handle);
 };
 
-jsi::Value createCredentialRequest(jsi::Runtime &rt, jsi::Object options) {
-  auto entropy = jsiToValue<std::string>(rt, options, "entropy", true);
-  auto proverDid = jsiToValue<std::string>(rt, options, "proverDid", true);
-  auto credentialDefinition =
-      jsiToValue<ObjectHandle>(rt, options, "credentialDefinition");
-  auto linkSecret = jsiToValue<std::string>(rt, options, "linkSecret");
-  auto linkSecretId = jsiToValue<std::string>(rt, options, "linkSecretId");
-  auto credentialOffer =
-      jsiToValue<ObjectHandle>(rt, options, "credentialOffer");
-
-  CredentialRequestReturn out;
+// ===== STORAGE ENCODING =====
 
-  ErrorCode code = anoncreds_create_credential_request(
-      entropy.length() ? entropy.c_str() : nullptr,
-      proverDid.length() ? proverDid.c_str() : nullptr, credentialDefinition,
-      linkSecret.c_str(), linkSecretId.c_str(), credentialOffer,
-      &out.credentialRequest, &out.credentialRequestMetadata);
+jsi::Value toCbor(jsi::Runtime &rt, jsi::Object options) {
+  auto handle = restoredObject(
+      rt, jsiToValue<ObjectHandle>(rt, options, "objectHandle"));
 
-  return createReturnValue(rt, code, &out);
-};
-
-jsi::Value credentialGetAttribute(jsi::Runtime &rt, jsi::Object options) {
-  auto handle = jsiToValue<ObjectHandle>(rt, options, "objectHandle");
-  auto name = jsiToValue<std::string>(rt, options, "name");
+  ByteBuffer json{};
+  auto code = anoncredsLibrary::anoncreds_object_get_json(handle, &json);
+  if (code != ErrorCode::Success)
+    return createReturnValue(rt, code, (std::vector<uint8_t> *)nullptr);
 
-  const char *out;
-
-  ErrorCode code =
-      anoncreds_credential_get_attribute(handle, name.c_str(), &out);
+  anoncredsJson::Value document;
+  auto parsed =
+      anoncredsJson::parse((const char *)json.data, json.len, document);
+  anoncredsLibrary::anoncreds_buffer_free(json);
+  if (!parsed)
+    throw jsi::JSError(rt, "Unable to encode object: invalid JSON");
 
-  return createReturnValue(rt, code, &out);
+  std::vector<uint8_t> cbor;
+  anoncredsCbor::encode(document, cbor);
+  return createReturnValue(rt, code, &cbor);
 };
 
-jsi::Value encodeCredentialAttributes(jsi::Runtime &rt, jsi::Object options) {
-  auto attributeRawValues =
-      jsiToValue<FfiList_FfiStr>(rt, options, "attributeRawValues");
-
-  const char *out;
-
-  ErrorCode code =
-      anoncreds_encode_credential_attributes(attributeRawValues, &out);
-
-  return createReturnValue(rt, code, &out);
+jsi::Value fromCbor(jsi::Runtime &rt, jsi::Object options) {
+  auto parser = findParser(rt, jsiToValue<std::string>(rt, options, "type"));
+  auto bytes = jsiToValue<ByteSpan>(rt, options, "bytes");
+
+  anoncredsJson::Value document;
+  std::string error;
+  if (!anoncredsCbor::decode(bytes.data, bytes.size, document, &error))
+    throw jsi::JSError(rt, "Value `bytes` is not an encoded object: " + error);
+
+  std::string json;
+  anoncredsJson::serialize(document, json);
+  ObjectHandle handle = 0;
+  auto code = parser->parse(
+      ByteBuffer{.len = int64_t(json.size()), .data = (uint8_t *)json.data()},
+      &handle);
+  if (code == ErrorCode::Success)
+    anoncredsHandleRegistry::track(handle);
+
+  return createReturnValue(rt, code, &handle);
 };
 
-jsi::Value processCredential(jsi::Runtime &rt, jsi::Object options) {
-  auto credential = jsiToValue<ObjectHandle>(rt, options, "credential");
-  auto credentialRequestMetadata =
-      jsiToValue<ObjectHandle>(rt, options, "credentialRequestMetadata");
-  auto linkSecret = jsiToValue<std::string>(rt, options, "linkSecret");
-  auto credentialDefinition =
-      jsiToValue<ObjectHandle>(rt, options, "credentialDefinition");
-  auto revocationRegistryDefinition = jsiToValue<ObjectHandle>(
-      rt, options, "revocationRegistryDefinition", true);
+// ===== SNAPSHOTS =====
 
-  ObjectHandle out;
+jsi::Value snapshot(jsi::Runtime &rt, jsi::Object options) {
+  auto handles = anoncredsBinding::HandleList<"objectHandles">(
+      rt, options.getProperty(rt, "objectHandles"));
+  auto path = jsiToValue<std::string>(rt, options, "path");
 
-  ErrorCode code = anoncreds_process_credential(
-      credential, credentialRequestMetadata, linkSecret.c_str(), credentialDefinition,
-      revocationRegistryDefinition, &out);
+  ErrorCode code;
+  try {
+    code = anoncredsSnapshot::write(handles.items, path);
+  } catch (const std::runtime_error &e) {
+    throw jsi::JSError(rt, e.what());
+  }
 
-  return createReturnValue(rt, code, &out);
+  return createReturnValue(rt, code, nullptr);
 };
 
-// ===== REVOCATION =====
+jsi::Value restore(jsi::Runtime &rt, jsi::Object options) {
+  auto path = jsiToValue<std::string>(rt, options, "path");
 
-jsi::Value createOrUpdateRevocationState(jsi::Runtime &rt,
-                                         jsi::Object options) {
-  auto revocationRegistryDefinition =
-      jsiToValue<ObjectHandle>(rt, options, "revocationRegistryDefinition");
-  auto revocationStatusList =
-      jsiToValue<ObjectHandle>(rt, options, "revocationStatusList");
-  auto revocationRegistryIndex =
-      jsiToValue<int64_t>(rt, options, "revocationRegistryIndex");
-  auto tailsPath = jsiToValue<std::string>(rt, options, "tailsPath");
-  auto oldRevocationState =
-      jsiToValue<ObjectHandle>(rt, options, "oldRevocationState", true);
-  auto oldRevocationStatusList =
-      jsiToValue<ObjectHandle>(rt, options, "oldRevocationStatusList", true);
-
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_create_or_update_revocation_state(
-      revocationRegistryDefinition, revocationStatusList,
-      revocationRegistryIndex, tailsPath.c_str(), oldRevocationState,
-      oldRevocationStatusList, &out);
+  std::vector<ObjectHandle> handles;
+  try {
+    handles = anoncredsSnapshot::restore(path);
+  } catch (const std::runtime_error &e) {
+    throw jsi::JSError(rt, e.what());
+  }
 
-  return createReturnValue(rt, code, &out);
+  auto value = jsi::Array(rt, handles.size());
+  for (size_t i = 0; i < handles.size(); i++)
+    value.setValueAtIndex(rt, i, double(handles[i]));
+  return returnValue(rt, ErrorCode::Success, std::move(value));
 };
 
-jsi::Value createRevocationStatusList(jsi::Runtime &rt, jsi::Object options) {
-  auto credentialDefinition =
-      jsiToValue<ObjectHandle>(rt, options, "credentialDefinition");
-  auto revocationRegistryDefinitionId =
-      jsiToValue<std::string>(rt, options, "revocationRegistryDefinitionId");
-  auto revocationRegistryDefinition =
-      jsiToValue<ObjectHandle>(rt, options, "revocationRegistryDefinition");
-  auto revocationRegistryDefinitionPrivate =
-      jsiToValue<ObjectHandle>(rt, options, "revocationRegistryDefinitionPrivate");      
-  auto issuerId = jsiToValue<std::string>(rt, options, "issuerId");      
-  auto timestamp = jsiToValue<int64_t>(rt, options, "timestamp");
-  auto issuanceByDefault = jsiToValue<int8_t>(rt, options, "issuanceByDefault");
-
-  ObjectHandle out;
+// ===== HOLDER =====
 
-  ErrorCode code = anoncreds_create_revocation_status_list(
-      credentialDefinition, revocationRegistryDefinitionId.c_str(), 
-      revocationRegistryDefinition, revocationRegistryDefinitionPrivate,
-      issuerId.c_str(), timestamp, issuanceByDefault, &out);
-
-  return createReturnValue(rt, code, &out);
-}
-
-jsi::Value updateRevocationStatusList(jsi::Runtime &rt, jsi::Object options) {
+jsi::Value receiveCredential(jsi::Runtime &rt, jsi::Object options) {
+  using namespace anoncredsBinding;
+  using Kind = anoncredsDefinitionCache::Kind;
+  auto credentialJson = option<Json<"credential">>(rt, options);
+  auto credentialRequestMetadataJson =
+      option<Json<"credentialRequestMetadata">>(rt, options);
+  auto linkSecret = option<Str<"linkSecret">>(rt, options);
   auto credentialDefinition =
-      jsiToValue<ObjectHandle>(rt, options, "credentialDefinition");
+      option<Definition<"credentialDefinition", Kind::CredentialDefinition>>(
+          rt, options);
   auto revocationRegistryDefinition =
-      jsiToValue<ObjectHandle>(rt, options, "revocationRegistryDefinition");
-  auto revocationRegistryDefinitionPrivate =
-      jsiToValue<ObjectHandle>(rt, options, "revocationRegistryDefinitionPrivate");      
-  auto revocationStatusList =
-      jsiToValue<ObjectHandle>(rt, options, "revocationStatusList");
-  auto issued = jsiToValue<FfiList_i32>(rt, options, "issued");
-  auto revoked = jsiToValue<FfiList_i32>(rt, options, "revoked");
-  auto timestamp = jsiToValue<int64_t>(rt, options, "timestamp");
-
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_update_revocation_status_list(
-    credentialDefinition, revocationRegistryDefinition, 
-    revocationRegistryDefinitionPrivate, revocationStatusList,
-    issued, revoked, timestamp, &out);
-
-  return createReturnValue(rt, code, &out);
-}
-
-jsi::Value updateRevocationStatusListTimestampOnly(jsi::Runtime &rt,
-                                                   jsi::Object options) {
-  auto timestamp = jsiToValue<int64_t>(rt, options, "timestamp");
-  auto revocationStatusList =
-      jsiToValue<ObjectHandle>(rt, options, "revocationStatusList");
-
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_update_revocation_status_list_timestamp_only(
-      timestamp, revocationStatusList, &out);
+      option<Definition<"revocationRegistryDefinition",
+                        Kind::RevocationRegistryDefinition, true>>(rt, options);
+
+  OwnedHandle credential, credentialRequestMetadata, processed;
+  std::optional<std::string> credentialDefinitionId, revocationRegistryId;
+  auto code = anoncredsLibrary::anoncreds_credential_from_json(
+      credentialJson.ffi(), credential.out());
+  if (code == ErrorCode::Success)
+    code = anoncredsLibrary::anoncreds_credential_request_metadata_from_json(
+        credentialRequestMetadataJson.ffi(), credentialRequestMetadata.out());
+
+  // Definitions passed as JSON are cached under the ids of the credential
+  if (code == ErrorCode::Success)
+    code = anoncredsCredentialStore::credentialAttribute(
+        credential, "cred_def_id", credentialDefinitionId);
+  if (code == ErrorCode::Success)
+    code = credentialDefinition.resolve(credentialDefinitionId.value_or(""));
+  if (code == ErrorCode::Success && !revocationRegistryDefinition.isAbsent())
+    code = anoncredsCredentialStore::credentialAttribute(
+        credential, "rev_reg_id", revocationRegistryId);
+  if (code == ErrorCode::Success)
+    code = revocationRegistryDefinition.resolve(
+        revocationRegistryId.value_or(""));
+
+  if (code == ErrorCode::Success)
+    code = anoncredsLibrary::anoncreds_process_credential(
+        credential, credentialRequestMetadata, linkSecret.ffi(),
+        credentialDefinition.ffi(), revocationRegistryDefinition.ffi(),
+        processed.out());
+
+  std::string json;
+  if (code == ErrorCode::Success) {
+    ByteBuffer buffer{};
+    code = anoncredsLibrary::anoncreds_object_get_json(processed, &buffer);
+    if (code == ErrorCode::Success) {
+      json.assign((const char *)buffer.data, buffer.len);
+      anoncredsLibrary::anoncreds_buffer_free(buffer);
+    }
+  }
 
-  return createReturnValue(rt, code, &out);
-}
+  // The attributes a wallet indexes a credential by
+  static const char *const metadata[] = {"schema_id", "cred_def_id",
+                                         "rev_reg_id", "rev_reg_index"};
+  std::vector<std::optional<std::string>> metadataValues(std::size(metadata));
+  for (size_t i = 0; code == ErrorCode::Success && i < std::size(metadata); i++)
+    code = anoncredsCredentialStore::credentialAttribute(
+        processed, metadata[i], metadataValues[i]);
+  if (code != ErrorCode::Success)
+    return returnValue(rt, code, jsi::Value::undefined());
+
+  // Raw values, from `values.<name>.raw` of the credential JSON. They are kept
+  // apart from the ids, as a credential attribute can have the name of one.
+  auto values = jsi::Object(rt);
+  anoncredsJson::Value document;
+  if (anoncredsJson::parse(json.data(), json.size(), document)) {
+    if (auto members = document.get("values"); members && members->isObject())
+      for (auto &[name, value] : members->members)
+        if (auto raw = value.get("raw"); raw && raw->isString())
+          values.setProperty(rt, name.c_str(),
+                             jsi::String::createFromUtf8(rt, raw->text));
+  }
+  auto attributes = jsi::Object(rt);
+  for (size_t i = 0; i < std::size(metadata); i++)
+    attributes.setProperty(
+        rt, metadata[i],
+        metadataValues[i]
+            ? jsi::Value(jsi::String::createFromUtf8(rt, *metadataValues[i]))
+            : jsi::Value::null());
+  attributes.setProperty(rt, "values", std::move(values));
+
+  auto result = jsi::Object(rt);
+  result.setProperty(rt, "credential",
+                     jsi::String::createFromUtf8(
+                         rt, (const uint8_t *)json.data(), json.size()));
+  result.setProperty(rt, "attributes", std::move(attributes));
+  return returnValue(rt, ErrorCode::Success, std::move(result));
+};
 
-jsi::Value createRevocationRegistryDefinition(jsi::Runtime &rt,
-                                              jsi::Object options) {
-  auto credentialDefinition =
-      jsiToValue<ObjectHandle>(rt, options, "credentialDefinition");
-  auto credentialDefinitionId =
-      jsiToValue<std::string>(rt, options, "credentialDefinitionId");
-  auto issuerId = jsiToValue<std::string>(rt, options, "issuerId");
-  auto tag = jsiToValue<std::string>(rt, options, "tag");
-  auto revocationRegistryType =
-      jsiToValue<std::string>(rt, options, "revocationRegistryType");
-  auto maxCredNum = jsiToValue<int64_t>(rt, options, "maximumCredentialNumber");
-  auto tailsDirPath =
-      jsiToValue<std::string>(rt, options, "tailsDirectoryPath", true);
-
-  RevocationRegistryDefinitionReturn out;
-
-  ErrorCode code = anoncreds_create_revocation_registry_def(
-      credentialDefinition, credentialDefinitionId.c_str(), issuerId.c_str(),
-      tag.c_str(), revocationRegistryType.c_str(), maxCredNum,
-      tailsDirPath.length() > 0 ? tailsDirPath.c_str() : nullptr,
-      &out.revocationRegistryDefinition,
-      &out.revocationRegistryDefinitionPrivate);
+jsi::Value solvePresentation(jsi::Runtime &rt, jsi::Object options) {
+  using namespace anoncredsBinding;
+  auto presentationRequest =
+      option<Handle<"presentationRequest">>(rt, options);
+  auto credentials = option<CredentialEntryList<"credentials">>(rt, options);
+
+  anoncredsPresentationSolver::Solution solution;
+  ErrorCode code;
+  try {
+    code = anoncredsPresentationSolver::solve(presentationRequest.value,
+                                              credentials.items, solution);
+  } catch (const std::invalid_argument &e) {
+    throw jsi::JSError(rt, e.what());
+  }
+  if (code != ErrorCode::Success)
+    return returnValue(rt, code, jsi::Value::undefined());
+
+  // In the positional form `createPresentation` takes them in
+  auto entries = jsi::Array(rt, solution.credentials.size());
+  for (size_t i = 0; i < solution.credentials.size(); i++) {
+    auto &entry = solution.credentials[i];
+    entries.setValueAtIndex(
+        rt, i,
+        jsi::Array::createWithElements(rt, double(entry.credential),
+                                       double(entry.timestamp),
+                                       double(entry.rev_state)));
+  }
+  auto proves = jsi::Array(rt, solution.credentialsProve.size());
+  for (size_t i = 0; i < solution.credentialsProve.size(); i++) {
+    auto &prove = solution.credentialsProve[i];
+    proves.setValueAtIndex(
+        rt, i,
+        jsi::Array::createWithElements(
+            rt, double(prove.entryIndex),
+            jsi::String::createFromUtf8(rt, prove.referent),
+            prove.isPredicate, prove.reveal));
+  }
+  auto unsatisfied = jsi::Array(rt, solution.unsatisfied.size());
+  for (size_t i = 0; i < solution.unsatisfied.size(); i++) {
+    auto &referent = solution.unsatisfied[i];
+    auto value = jsi::Object(rt);
+    value.setProperty(rt, "referent",
+                      jsi::String::createFromUtf8(rt, referent.referent));
+    value.setProperty(rt, "isPredicate", referent.isPredicate);
+    value.setProperty(rt, "reason",
+                      jsi::String::createFromUtf8(rt, referent.reason));
+    unsatisfied.setValueAtIndex(rt, i, std::move(value));
+  }
 
-  return createReturnValue(rt, code, &out);
+  auto result = jsi::Object(rt);
+  result.setProperty(rt, "credentials", std::move(entries));
+  result.setProperty(rt, "credentialsProve", std::move(proves));
+  result.setProperty(rt, "unsatisfied", std::move(unsatisfied));
+  return returnValue(rt, ErrorCode::Success, std::move(result));
 };
 
-jsi::Value revocationRegistryDefinitionGetAttribute(jsi::Runtime &rt,
-                                                    jsi::Object options) {
-  auto handle = jsiToValue<ObjectHandle>(rt, options, "objectHandle");
-  auto name = jsiToValue<std::string>(rt, options, "name");
-
-  const char *out;
+// ===== CREDENTIAL STORE =====
+
+jsi::Value credentialStoreAdd(jsi::Runtime &rt, jsi::Object options) {
+  using namespace anoncredsBinding;
+  auto id = option<Str<"id">>(rt, options);
+  auto credential = option<Handle<"credential">>(rt, options);
+
+  // Optional `Record<string, string>` of tags to add
+  anoncredsCredentialStore::Tags tags;
+  auto value = options.getProperty(rt, "tags");
+  if (!isAbsent(value)) {
+    if (!value.isObject() || value.getObject(rt).isArray(rt))
+      throwTypeError<"tags">(rt, "Record<string, string>");
+    auto object = value.getObject(rt);
+    auto names = object.getPropertyNames(rt);
+    for (size_t i = 0; i < names.length(rt); i++) {
+      auto name = names.getValueAtIndex(rt, i).getString(rt).utf8(rt);
+      auto tag = object.getProperty(rt, name.c_str());
+      if (!tag.isString())
+        throwTypeError<"tags">(rt, "Record<string, string>");
+      tags.emplace_back(std::move(name), tag.getString(rt).utf8(rt));
+    }
+  }
 
-  ErrorCode code = anoncreds_revocation_registry_definition_get_attribute(
-      handle, name.c_str(), &out);
+  auto code = anoncredsCredentialStore::add(id.value, credential.value, tags);
+  return createReturnValue(rt, code, nullptr);
+};
 
-  return createReturnValue(rt, code, &out);
+jsi::Value credentialStoreRemove(jsi::Runtime &rt, jsi::Object options) {
+  auto id = jsiToValue<std::string>(rt, options, "id");
+  return returnValue(rt, ErrorCode::Success,
+                     jsi::Value(anoncredsCredentialStore::remove(id)));
 };
 
-jsi::Value w3cPresentationFromJson(jsi::Runtime &rt, jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
+jsi::Value credentialStoreQuery(jsi::Runtime &rt, jsi::Object options) {
+  using namespace anoncredsBinding;
+  auto restrictionsJson = option<Json<"restrictions">>(rt, options);
+  auto attributes = option<StrList<"attributes", true>>(rt, options);
+
+  anoncredsJson::Value restrictions;
+  std::string error;
+  if (!anoncredsJson::parse(restrictionsJson.value.data(),
+                            restrictionsJson.value.size(), restrictions,
+                            &error))
+    throw jsi::JSError(rt, "Value `restrictions` is not valid JSON: " + error);
+
+  std::vector<std::string> ids;
+  try {
+    ids = anoncredsCredentialStore::query(restrictions, attributes.items);
+  } catch (const std::invalid_argument &e) {
+    throw jsi::JSError(rt, e.what());
+  }
 
-  ObjectHandle out;
+  auto value = jsi::Array(rt, ids.size());
+  for (size_t i = 0; i < ids.size(); i++)
+    value.setValueAtIndex(rt, i, jsi::String::createFromUtf8(rt, ids[i]));
+  return returnValue(rt, ErrorCode::Success, std::move(value));
+};
 
-  ErrorCode code = anoncreds_w3c_presentation_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
+jsi::Value credentialStoreSave(jsi::Runtime &rt, jsi::Object options) {
+  auto path = jsiToValue<std::string>(rt, options, "path");
 
-  // Free memory
-  delete[] json.data;
+  try {
+    anoncredsCredentialStore::save(path);
+  } catch (const std::runtime_error &e) {
+    throw jsi::JSError(rt, e.what());
+  }
 
-  return returnValue;
+  return createReturnValue(rt, ErrorCode::Success, nullptr);
 };
 
-jsi::Value w3cCredentialFromJson(jsi::Runtime &rt, jsi::Object options) {
-  auto json = jsiToValue<ByteBuffer>(rt, options, "json");
-
-  ObjectHandle out;
+jsi::Value credentialStoreLoad(jsi::Runtime &rt, jsi::Object options) {
+  auto path = jsiToValue<std::string>(rt, options, "path");
 
-  ErrorCode code = anoncreds_w3c_credential_from_json(json, &out);
-  auto returnValue = createReturnValue(rt, code, &out);
-
-  // Free memory
-  delete[] json.data;
+  try {
+    anoncredsCredentialStore::load(path);
+  } catch (const std::runtime_error &e) {
+    throw jsi::JSError(rt, e.what());
+  }
 
-  return returnValue;
+  return returnValue(rt, ErrorCode::Success,
+                     double(anoncredsCredentialStore::size()));
 };
 
-jsi::Value createW3cPresentation(jsi::Runtime &rt, jsi::Object options) {
-  auto presentationRequest =
-      jsiToValue<ObjectHandle>(rt, options, "presentationRequest");
-  auto credentials =
-      jsiToValue<FfiList_FfiCredentialEntry>(rt, options, "credentials");
-  auto credentialsProve =
-      jsiToValue<FfiList_FfiCredentialProve>(rt, options, "credentialsProve");
-  auto linkSecret = jsiToValue<std::string>(rt, options, "linkSecret");
-  auto schemas = jsiToValue<FfiList_ObjectHandle>(rt, options, "schemas");
-  auto schemaIds = jsiToValue<FfiList_FfiStr>(rt, options, "schemaIds");
-  auto credentialDefinitions =
-      jsiToValue<FfiList_ObjectHandle>(rt, options, "credentialDefinitions");
-  auto credentialDefinitionIds =
-      jsiToValue<FfiList_FfiStr>(rt, options, "credentialDefinitionIds");
-  auto w3cVersion =
-      jsiToValue<std::string>(rt, options, "w3cVersion", true);
-
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_create_w3c_presentation(
-      presentationRequest, credentials, credentialsProve, linkSecret.c_str(),
-      schemas, schemaIds, credentialDefinitions, credentialDefinitionIds,
-      w3cVersion.length() ? w3cVersion.c_str() : nullptr, &out);
+jsi::Value credentialStoreClear(jsi::Runtime &rt, jsi::Object options) {
+  anoncredsCredentialStore::clear();
+  return createReturnValue(rt, ErrorCode::Success, nullptr);
+};
 
-  auto returnValue = createReturnValue(rt, code, &out);
+// ===== VERIFICATION =====
 
-  // Free memory
-  delete[] credentials.data;
-  for (int i = 0; i < credentialsProve.count; i++) {
-    delete[] credentialsProve.data[i].referent;
-  }
-  for (int i = 0; i < schemaIds.count; i++) {
-    delete[] schemaIds.data[i];
-  }
-  delete[] schemas.data;
-  for (int i = 0; i < credentialDefinitionIds.count; i++) {
-    delete[] credentialDefinitionIds.data[i];
-  }
-  delete[] credentialDefinitions.data;
+jsi::Value verifyPresentationFromJson(jsi::Runtime &rt, jsi::Object options) {
+  using namespace anoncredsBinding;
+  using Kind = anoncredsDefinitionCache::Kind;
+  auto presentationJson = option<Json<"presentation">>(rt, options);
+  auto presentationRequestJson =
+      option<Json<"presentationRequest">>(rt, options);
+  auto schemas = option<Definitions<"schemas", Kind::Schema>>(rt, options);
+  auto credentialDefinitions =
+      option<Definitions<"credentialDefinitions", Kind::CredentialDefinition>>(
+          rt, options);
+  auto revocationRegistryDefinitions =
+      option<Definitions<"revocationRegistryDefinitions",
+                         Kind::RevocationRegistryDefinition, true>>(rt,
+                                                                    options);
+  auto revocationStatusLists =
+      option<StatusLists<"revocationStatusLists">>(rt, options);
+  auto nonRevokedIntervalOverrides =
+      option<NonRevokedIntervalOverrideList<"nonRevokedIntervalOverrides", true>>(
+          rt, options);
+  auto w3c = option<I8<"w3c", true>>(rt, options);
+
+  auto parse = w3c.value ? anoncredsLibrary::anoncreds_w3c_presentation_from_json
+                         : anoncredsLibrary::anoncreds_presentation_from_json;
+  auto verify = w3c.value
+                    ? anoncredsLibrary::anoncreds_verify_w3c_presentation
+                    : anoncredsLibrary::anoncreds_verify_presentation;
+
+  OwnedHandle presentation, presentationRequest;
+  auto code = parse(presentationJson.ffi(), presentation.out());
+  if (code == ErrorCode::Success)
+    code = anoncredsLibrary::anoncreds_presentation_request_from_json(
+        presentationRequestJson.ffi(), presentationRequest.out());
+  if (code == ErrorCode::Success)
+    code = schemas.resolve();
+  if (code == ErrorCode::Success)
+    code = credentialDefinitions.resolve();
+  if (code == ErrorCode::Success)
+    code = revocationRegistryDefinitions.resolve();
+  if (code == ErrorCode::Success)
+    code = revocationStatusLists.resolve();
+
+  int8_t out = 0;
+  if (code == ErrorCode::Success)
+    code = verify(presentation, presentationRequest, schemas.objects(),
+                  schemas.idList(), credentialDefinitions.objects(),
+                  credentialDefinitions.idList(),
+                  revocationRegistryDefinitions.objects(),
+                  revocationRegistryDefinitions.idList(),
+                  revocationStatusLists.ffi(),
+                  nonRevokedIntervalOverrides.ffi(), &out);
 
-  return returnValue;
+  return createReturnValue(rt, code, &out);
 };
 
-jsi::Value verifyW3cPresentation(jsi::Runtime &rt, jsi::Object options) {
-  auto presentation = jsiToValue<ObjectHandle>(rt, options, "presentation");
-  auto presentationRequest =
-      jsiToValue<ObjectHandle>(rt, options, "presentationRequest");
-  auto schemas = jsiToValue<FfiList_ObjectHandle>(rt, options, "schemas");
-  auto schemaIds = jsiToValue<FfiList_FfiStr>(rt, options, "schemaIds");
+jsi::Value verifyPresentationWithDetails(jsi::Runtime &rt,
+                                         jsi::Object options) {
+  using namespace anoncredsBinding;
+  auto presentation = option<Handle<"presentation">>(rt, options);
+  auto presentationRequest = option<Handle<"presentationRequest">>(rt, options);
+  auto schemas = option<HandleList<"schemas">>(rt, options);
+  auto schemaIds = option<StrList<"schemaIds">>(rt, options);
   auto credentialDefinitions =
-      jsiToValue<FfiList_ObjectHandle>(rt, options, "credentialDefinitions");
+      option<HandleList<"credentialDefinitions">>(rt, options);
   auto credentialDefinitionIds =
-      jsiToValue<FfiList_FfiStr>(rt, options, "credentialDefinitionIds");
-  auto revocationRegistryDefinitions = jsiToValue<FfiList_ObjectHandle>(
-      rt, options, "revocationRegistryDefinitions", true);
-  auto revocationRegistryDefinitionIds = jsiToValue<FfiList_FfiStr>(
-      rt, options, "revocationRegistryDefinitionIds", true);
-  auto revocationStatusLists = jsiToValue<FfiList_ObjectHandle>(
-      rt, options, "revocationStatusLists", true);
+      option<StrList<"credentialDefinitionIds">>(rt, options);
+  auto revocationRegistryDefinitions =
+      option<HandleList<"revocationRegistryDefinitions", true>>(rt, options);
+  auto revocationRegistryDefinitionIds =
+      option<StrList<"revocationRegistryDefinitionIds", true>>(rt, options);
+  auto revocationStatusLists =
+      option<HandleList<"revocationStatusLists", true>>(rt, options);
   auto nonRevokedIntervalOverrides =
-      jsiToValue<FfiList_FfiNonrevokedIntervalOverride>(
-          rt, options, "nonRevokedIntervalOverrides", true);
-
-  int8_t out;
-
-  ErrorCode code = anoncreds_verify_w3c_presentation(
-      presentation, presentationRequest, schemas, schemaIds,
-      credentialDefinitions, credentialDefinitionIds,
-      revocationRegistryDefinitions, revocationRegistryDefinitionIds,
-      revocationStatusLists, nonRevokedIntervalOverrides, &out);
-
-  auto returnValue = createReturnValue(rt, code, &out);
-
-  // Free memory
-  for (int i = 0; i < schemaIds.count; i++) {
-    delete[] schemaIds.data[i];
-  }
-  delete[] schemas.data;
-  for (int i = 0; i < credentialDefinitionIds.count; i++) {
-    delete[] credentialDefinitionIds.data[i];
+      option<NonRevokedIntervalOverrideList<"nonRevokedIntervalOverrides", true>>(
+          rt, options);
+
+  int8_t verified = 0;
+  auto code = anoncredsLibrary::anoncreds_verify_presentation(
+      presentation.value, presentationRequest.value, schemas.ffi(),
+      schemaIds.ffi(), credentialDefinitions.ffi(),
+      credentialDefinitionIds.ffi(), revocationRegistryDefinitions.ffi(),
+      revocationRegistryDefinitionIds.ffi(), revocationStatusLists.ffi(),
+      nonRevokedIntervalOverrides.ffi(), &verified);
+  anoncredsPresentationDetails::Details details;
+  if (code == ErrorCode::Success && verified)
+    code = anoncredsPresentationDetails::read(presentation.value, details);
+  if (code != ErrorCode::Success)
+    return returnValue(rt, code, jsi::Value::null());
+
+  auto result = jsi::Object(rt);
+  result.setProperty(rt, "verified", bool(verified));
+  if (!verified)
+    return returnValue(rt, code, std::move(result));
+
+  auto values = [&](const anoncredsPresentationDetails::Values &entries) {
+    auto object = jsi::Object(rt);
+    for (auto &[name, value] : entries)
+      object.setProperty(rt, name.c_str(),
+                         jsi::String::createFromUtf8(rt, value));
+    return object;
+  };
+  result.setProperty(rt, "revealedAttributes",
+                     values(details.revealedAttributes));
+  auto groups = jsi::Object(rt);
+  for (auto &[referent, group] : details.revealedAttributeGroups)
+    groups.setProperty(rt, referent.c_str(), values(group));
+  result.setProperty(rt, "revealedAttributeGroups", std::move(groups));
+  result.setProperty(rt, "selfAttestedAttributes",
+                     values(details.selfAttestedAttributes));
+
+  auto predicates = jsi::Array(rt, details.predicates.size());
+  for (size_t i = 0; i < details.predicates.size(); i++)
+    predicates.setValueAtIndex(
+        rt, i, jsi::String::createFromUtf8(rt, details.predicates[i]));
+  result.setProperty(rt, "predicates", std::move(predicates));
+
+  auto identifiers = jsi::Array(rt, details.identifiers.size());
+  for (size_t i = 0; i < details.identifiers.size(); i++) {
+    auto &identifier = details.identifiers[i];
+    auto object = jsi::Object(rt);
+    object.setProperty(rt, "schemaId",
+                       jsi::String::createFromUtf8(rt, identifier.schemaId));
+    object.setProperty(
+        rt, "credentialDefinitionId",
+        jsi::String::createFromUtf8(rt, identifier.credentialDefinitionId));
+    object.setProperty(
+        rt, "revocationRegistryId",
+        identifier.revocationRegistryId
+            ? jsi::Value(jsi::String::createFromUtf8(
+                  rt, *identifier.revocationRegistryId))
+            : jsi::Value::null());
+    object.setProperty(rt, "timestamp",
+                       identifier.timestamp
+                           ? jsi::Value(double(*identifier.timestamp))
+                           : jsi::Value::null());
+    identifiers.setValueAtIndex(rt, i, std::move(object));
   }
-  delete[] credentialDefinitions.data;
-
-  return returnValue;
-};
-
-jsi::Value createW3cCredential(jsi::Runtime &rt, jsi::Object options) {
-  auto credentialDefinition =
-      jsiToValue<ObjectHandle>(rt, options, "credentialDefinition");
-  auto credentialDefinitionPrivate =
-      jsiToValue<ObjectHandle>(rt, options, "credentialDefinitionPrivate");
-  auto credentialOffer =
-      jsiToValue<ObjectHandle>(rt, options, "credentialOffer");
-  auto credentialRequest =
-      jsiToValue<ObjectHandle>(rt, options, "credentialRequest");
-  auto attributeNames = jsiToValue<FfiStrList>(rt, options, "attributeNames");
-  auto attributeRawValues =
-      jsiToValue<FfiStrList>(rt, options, "attributeRawValues");
-  auto revocation =
-      jsiToValue<FfiCredRevInfo>(rt, options, "revocationConfiguration", true);
-  auto w3cVersion =
-      jsiToValue<std::string>(rt, options, "w3cVersion", true);
-
-  ObjectHandle out;
-
-  ErrorCode code = anoncreds_create_w3c_credential(
-      credentialDefinition, credentialDefinitionPrivate, credentialOffer,
-      credentialRequest, attributeNames, attributeRawValues,
-      revocation.reg_def ? &revocation : 0,
-      w3cVersion.length() ? w3cVersion.c_str() : nullptr, &out);
-
-  return createReturnValue(rt, code, &out);
+  result.setProperty(rt, "identifiers", std::move(identifiers));
+  return returnValue(rt, code, std::move(result));
 };
 
-jsi::Value w3cCredentialGetIntegrityProofDetails(jsi::Runtime &rt, jsi::Object options) {
-  auto handle = jsiToValue<ObjectHandle>(rt, options, "objectHandle");
-
-  ObjectHandle out;
-
-  ErrorCode code =
-      anoncreds_w3c_credential_get_integrity_proof_details(handle, &out);
-
-  return createReturnValue(rt, code, &out);
+jsi::Value clearDefinitionCache(jsi::Runtime &rt, jsi::Object options) {
+  anoncredsDefinitionCache::clear();
+  return createReturnValue(rt, ErrorCode::Success, nullptr);
 };
 
-jsi::Value w3cCredentialProofGetAttribute(jsi::Runtime &rt, jsi::Object options) {
-  auto handle = jsiToValue<ObjectHandle>(rt, options, "objectHandle");
-  auto name = jsiToValue<std::string>(rt, options, "name");
+// ===== COMMAND BUFFERS =====
 
-  const char *out;
+jsi::Value execute(jsi::Runtime &rt, jsi::Object options) {
+  auto buffer = anoncredsCommandBuffer::prepare(
+      rt, options.getProperty(rt, "commands"),
+      options.getProperty(rt, "outputs"));
 
-  ErrorCode code =
-      anoncreds_w3c_credential_proof_get_attribute(handle, name.c_str(), &out);
+  auto callback = options.getProperty(rt, "callback");
+  if (callback.isUndefined()) {
+    anoncredsCommandBuffer::run(*buffer);
+    return anoncredsCommandBuffer::result(rt, *buffer);
+  }
 
-  return createReturnValue(rt, code, &out);
+  if (!callback.isObject() || !callback.getObject(rt).isFunction(rt))
+    throw jsi::JSError(rt, errorPrefix + "callback" + errorInfix + "function");
+
+  // The callback is called as `callback(error, results)` on the thread of the
+  // calling runtime once the buffer has run on a worker of the scheduler, or
+  // was dropped by it
+  auto invoker = activeInvoker();
+  if (!invoker)
+    throw jsi::JSError(rt, "`callback` is not supported in a runtime that was "
+                           "installed without a call invoker");
+  auto priority = jobPriority(rt, options);
+  auto deadline = jsiToValue<int64_t>(rt, options, "deadline", true);
+  auto function = callback.getObject(rt).getFunction(rt);
+  auto state = std::make_shared<State>(&function);
+  state->rt = &rt;
+  std::shared_ptr<anoncredsCommandBuffer::Buffer> shared = std::move(buffer);
+
+  anoncredsScheduler::Job job{.priority = priority};
+  if (deadline > 0)
+    job.deadline = anoncredsScheduler::Clock::now() +
+                   std::chrono::milliseconds(deadline);
+  // The callback is moved along, so that it is released on the thread of its
+  // runtime
+  job.run = [invoker, state, shared](
+                anoncredsScheduler::Outcome outcome,
+                const std::atomic<bool> &canceled) mutable {
+    if (outcome == anoncredsScheduler::Outcome::Started)
+      anoncredsCommandBuffer::run(*shared, &canceled);
+    invoker->invokeAsync([state = std::move(state), shared = std::move(shared),
+                          outcome] {
+      auto &rt = *state->rt;
+      ReturnConventionScope convention(ReturnConvention{.throwing = true});
+
+      jsi::Value error = jsi::Value::null();
+      jsi::Value results;
+      if (outcome != anoncredsScheduler::Outcome::Started)
+        error = jobError(rt, outcome);
+      else if (shared->canceled)
+        error = jobError(rt, anoncredsScheduler::Outcome::Canceled);
+      else {
+        try {
+          results = anoncredsCommandBuffer::result(rt, *shared);
+        } catch (const jsi::JSError &e) {
+          error = jsi::Value(rt, e.value());
+        } catch (const std::exception &e) {
+          error = jsi::Value(rt, jsi::JSError(rt, e.what()).value());
+        }
+      }
+
+      try {
+        state->cb.call(rt, error, results);
+      } catch (const jsi::JSError &e) {
+        reportCallbackError(rt, jsi::Value(rt, e.value()));
+      } catch (const std::exception &e) {
+        reportCallbackError(
+            rt, jsi::Value(rt, jsi::JSError(rt, e.what()).value()));
+      }
+    });
+  };
+
+  auto id = anoncredsScheduler::submit(std::move(job));
+  if (id == 0)
+    throw jsi::JSError(rt, "The job queue is full");
+
+  return returnValue(rt, ErrorCode::Success, double(id));
 };
 
-jsi::Value processW3cCredential(jsi::Runtime &rt, jsi::Object options) {
-  auto credential = jsiToValue<ObjectHandle>(rt, options, "credential");
-  auto credentialRequestMetadata =
-      jsiToValue<ObjectHandle>(rt, options, "credentialRequestMetadata");
-  auto linkSecret = jsiToValue<std::string>(rt, options, "linkSecret");
-  auto credentialDefinition =
-      jsiToValue<ObjectHandle>(rt, options, "credentialDefinition");
-  auto revocationRegistryDefinition = jsiToValue<ObjectHandle>(
-      rt, options, "revocationRegistryDefinition", true);
+// ===== SCHEDULER =====
 
-  ObjectHandle out;
+jsi::Value cancelJob(jsi::Runtime &rt, jsi::Object options) {
+  auto job = jsiToValue<int64_t>(rt, options, "job");
 
-  ErrorCode code = anoncreds_process_w3c_credential(
-      credential, credentialRequestMetadata, linkSecret.c_str(), credentialDefinition,
-      revocationRegistryDefinition, &out);
+  auto canceled = anoncredsScheduler::cancel(uint64_t(job));
 
-  return createReturnValue(rt, code, &out);
+  return returnValue(rt, ErrorCode::Success, canceled);
 };
 
-jsi::Value credentialToW3c(jsi::Runtime &rt, jsi::Object options) {
-  auto credential = jsiToValue<ObjectHandle>(rt, options, "objectHandle");
-  auto issuerId =
-      jsiToValue<std::string>(rt, options, "issuerId");
-  auto w3cVersion =
-      jsiToValue<std::string>(rt, options, "w3cVersion", true);
-
-  ObjectHandle out;
+jsi::Value configureScheduler(jsi::Runtime &rt, jsi::Object options) {
+  auto maxQueued = jsiToValue<int64_t>(rt, options, "maxQueued");
+  if (maxQueued < 1)
+    throw jsi::JSError(rt, "Value `maxQueued` must be at least 1");
 
-  ErrorCode code = anoncreds_credential_to_w3c(
-      credential, issuerId.c_str(),
-      w3cVersion.length() ? w3cVersion.c_str() : nullptr, &out);
+  anoncredsScheduler::setMaxQueued(size_t(maxQueued));
 
-  return createReturnValue(rt, code, &out);
+  return createReturnValue(rt, ErrorCode::Success, nullptr);
 };
 
-jsi::Value credentialFromW3c(jsi::Runtime &rt, jsi::Object options) {
-  auto credential = jsiToValue<ObjectHandle>(rt, options, "objectHandle");
-
-  ObjectHandle out;
+jsi::Value getSchedulerMetrics(jsi::Runtime &rt, jsi::Object options) {
+  auto reset = jsiToValue<int8_t>(rt, options, "reset", true);
+
+  auto metrics = anoncredsScheduler::metrics(reset != 0);
+  static const char *names[] = {"userBlocking", "normal", "background"};
+  auto classes = jsi::Object(rt);
+  for (size_t i = 0; i < anoncredsScheduler::priorities; i++) {
+    auto &counters = metrics.classes[i];
+    auto entry = jsi::Object(rt);
+    entry.setProperty(rt, "queued", double(counters.queued));
+    entry.setProperty(rt, "submitted", double(counters.submitted));
+    entry.setProperty(rt, "rejected", double(counters.rejected));
+    entry.setProperty(rt, "expired", double(counters.expired));
+    entry.setProperty(rt, "canceled", double(counters.canceled));
+    entry.setProperty(rt, "failed", double(counters.failed));
+    entry.setProperty(rt, "completed", double(counters.completed));
+    entry.setProperty(rt, "averageWaitMs", counters.averageWaitMs);
+    entry.setProperty(rt, "maxWaitMs", counters.maxWaitMs);
+    classes.setProperty(rt, names[i], std::move(entry));
+  }
 
-  ErrorCode code = anoncreds_credential_from_w3c(
-      credential, &out);
+  auto value = jsi::Object(rt);
+  value.setProperty(rt, "classes", std::move(classes));
+  value.setProperty(rt, "running", double(metrics.running));
+  value.setProperty(rt, "workers", double(metrics.workers));
+  value.setProperty(rt, "maxQueued", double(metrics.maxQueued));
 
-  return createReturnValue(rt, code, &out);
+  return returnValue(rt, ErrorCode::Success, std::move(value));
 };
 
 } // namespace anoncreds
@@ -2,98 +2,84 @@
 
 #include <jsi/jsi.h>
 
+#include "generatedBindings.h"
 #include "include/libanoncreds.h"
 #include "turboModuleUtility.h"
 
 using namespace facebook;
 
+// Bindings that do not map onto a single `ErrorCode anoncreds_*` call. All
+// others are generated into `generatedBindings.h`.
 namespace anoncreds {
 
-struct CredentialDefinitionReturn {
-  ObjectHandle credentialDefinition;
-  ObjectHandle credentialDefinitionPrivate;
-  ObjectHandle keyCorrectnessProof;
-};
-
-struct CredentialRequestReturn {
-  ObjectHandle credentialRequest;
-  ObjectHandle credentialRequestMetadata;
-};
-
-struct RevocationRegistryDefinitionReturn {
-  ObjectHandle revocationRegistryDefinition;
-  ObjectHandle revocationRegistryDefinitionPrivate;
-};
-
 // General
 jsi::Value version(jsi::Runtime &rt, jsi::Object options);
 jsi::Value getCurrentError(jsi::Runtime &rt, jsi::Object options);
-jsi::Value getJson(jsi::Runtime &rt, jsi::Object options);
-jsi::Value getTypeName(jsi::Runtime &rt, jsi::Object options);
-jsi::Value setDefaultLogger(jsi::Runtime &rt, jsi::Object options);
 jsi::Value objectFree(jsi::Runtime &rt, jsi::Object options);
-
-// Meta
-jsi::Value createLinkSecret(jsi::Runtime &rt, jsi::Object options);
-jsi::Value generateNonce(jsi::Runtime &rt, jsi::Object options);
-
-// Anoncreds Objects
-jsi::Value createSchema(jsi::Runtime &rt, jsi::Object options);
-jsi::Value createCredentialDefinition(jsi::Runtime &rt, jsi::Object options);
-
-// Anoncreds Objects from JSON
-jsi::Value revocationRegistryDefinitionFromJson(jsi::Runtime &rt,
-                                                jsi::Object options);
-jsi::Value revocationRegistryFromJson(jsi::Runtime &rt, jsi::Object options);
-jsi::Value revocationStatusListFromJson(jsi::Runtime &rt, jsi::Object options);
-jsi::Value presentationFromJson(jsi::Runtime &rt, jsi::Object options);
-jsi::Value presentationRequestFromJson(jsi::Runtime &rt, jsi::Object options);
-jsi::Value credentialOfferFromJson(jsi::Runtime &rt, jsi::Object options);
-jsi::Value schemaFromJson(jsi::Runtime &rt, jsi::Object options);
-jsi::Value credentialRequestFromJson(jsi::Runtime &rt, jsi::Object options);
-jsi::Value credentialRequestMetadataFromJson(jsi::Runtime &rt,
-                                             jsi::Object options);
-jsi::Value credentialFromJson(jsi::Runtime &rt, jsi::Object options);
-jsi::Value revocationRegistryDefinitionPrivateFromJson(jsi::Runtime &rt,
-                                                       jsi::Object options);
-jsi::Value revocationStateFromJson(jsi::Runtime &rt, jsi::Object options);
-jsi::Value credentialDefinitionFromJson(jsi::Runtime &rt, jsi::Object options);
-jsi::Value credentialDefinitionPrivateFromJson(jsi::Runtime &rt,
-                                               jsi::Object options);
-jsi::Value keyCorrectnessProofFromJson(jsi::Runtime &rt, jsi::Object options);
-jsi::Value w3cCredentialFromJson(jsi::Runtime &rt, jsi::Object options);
-jsi::Value w3cPresentationFromJson(jsi::Runtime &rt, jsi::Object options);
-
-// Proofs
-jsi::Value createPresentation(jsi::Runtime &rt, jsi::Object options);
-jsi::Value verifyPresentation(jsi::Runtime &rt, jsi::Object options);
-jsi::Value createW3cPresentation(jsi::Runtime &rt, jsi::Object options);
-jsi::Value verifyW3cPresentation(jsi::Runtime &rt, jsi::Object options);
-
-// Credentials
-jsi::Value createCredential(jsi::Runtime &rt, jsi::Object options);
-jsi::Value createCredentialOffer(jsi::Runtime &rt, jsi::Object options);
-jsi::Value createCredentialRequest(jsi::Runtime &rt, jsi::Object options);
-jsi::Value credentialGetAttribute(jsi::Runtime &rt, jsi::Object options);
-jsi::Value encodeCredentialAttributes(jsi::Runtime &rt, jsi::Object options);
-jsi::Value processCredential(jsi::Runtime &rt, jsi::Object options);
-
-jsi::Value createW3cCredential(jsi::Runtime &rt, jsi::Object options);
-jsi::Value w3cCredentialGetIntegrityProofDetails(jsi::Runtime &rt, jsi::Object options);
-jsi::Value w3cCredentialProofGetAttribute(jsi::Runtime &rt, jsi::Object options);
-jsi::Value processW3cCredential(jsi::Runtime &rt, jsi::Object options);
-jsi::Value credentialToW3c(jsi::Runtime &rt, jsi::Object options);
-jsi::Value credentialFromW3c(jsi::Runtime &rt, jsi::Object options);
-
-// Revocation
-jsi::Value createOrUpdateRevocationState(jsi::Runtime &rt, jsi::Object options);
-jsi::Value createRevocationStatusList(jsi::Runtime &rt, jsi::Object options);
-jsi::Value updateRevocationStatusList(jsi::Runtime &rt, jsi::Object options);
-jsi::Value updateRevocationStatusListTimestampOnly(jsi::Runtime &rt,
-                                                   jsi::Object options);
-jsi::Value createRevocationRegistryDefinition(jsi::Runtime &rt,
-                                              jsi::Object options);
-jsi::Value revocationRegistryDefinitionGetAttribute(jsi::Runtime &rt,
-                                                    jsi::Object options);
+jsi::Value getObject(jsi::Runtime &rt, jsi::Object options);
+jsi::Value project(jsi::Runtime &rt, jsi::Object options);
+
+// Recording
+jsi::Value startRecording(jsi::Runtime &rt, jsi::Object options);
+jsi::Value stopRecording(jsi::Runtime &rt, jsi::Object options);
+
+// Live handles
+jsi::Value getLiveHandleStatistics(jsi::Runtime &rt, jsi::Object options);
+jsi::Value getLiveHandles(jsi::Runtime &rt, jsi::Object options);
+
+// Handle scopes
+jsi::Value beginScope(jsi::Runtime &rt, jsi::Object options);
+jsi::Value endScope(jsi::Runtime &rt, jsi::Object options);
+
+// Attributes
+jsi::Value credentialGetAttributes(jsi::Runtime &rt, jsi::Object options);
+jsi::Value w3cCredentialProofGetAttributes(jsi::Runtime &rt,
+                                           jsi::Object options);
+jsi::Value revocationRegistryDefinitionGetAttributes(jsi::Runtime &rt,
+                                                     jsi::Object options);
+
+// Issuance
+jsi::Value issueCredentialFromJson(jsi::Runtime &rt, jsi::Object options);
+jsi::Value issueW3cCredentialFromJson(jsi::Runtime &rt, jsi::Object options);
+jsi::Value encodeAttributes(jsi::Runtime &rt, jsi::Object options);
+
+// Parsing
+jsi::Value batchFromJson(jsi::Runtime &rt, jsi::Object options);
+jsi::Value exportToFile(jsi::Runtime &rt, jsi::Object options);
+jsi::Value importFromFile(jsi::Runtime &rt, jsi::Object options);
+
+// Storage encoding
+jsi::Value toCbor(jsi::Runtime &rt, jsi::Object options);
+jsi::Value fromCbor(jsi::Runtime &rt, jsi::Object options);
+
+// Snapshots
+jsi::Value snapshot(jsi::Runtime &rt, jsi::Object options);
+jsi::Value restore(jsi::Runtime &rt, jsi::Object options);
+
+// Holder
+jsi::Value receiveCredential(jsi::Runtime &rt, jsi::Object options);
+jsi::Value solvePresentation(jsi::Runtime &rt, jsi::Object options);
+
+// Credential store
+jsi::Value credentialStoreAdd(jsi::Runtime &rt, jsi::Object options);
+jsi::Value credentialStoreRemove(jsi::Runtime &rt, jsi::Object options);
+jsi::Value credentialStoreQuery(jsi::Runtime &rt, jsi::Object options);
+jsi::Value credentialStoreSave(jsi::Runtime &rt, jsi::Object options);
+jsi::Value credentialStoreLoad(jsi::Runtime &rt, jsi::Object options);
+jsi::Value credentialStoreClear(jsi::Runtime &rt, jsi::Object options);
+
+// Verification
+jsi::Value verifyPresentationFromJson(jsi::Runtime &rt, jsi::Object options);
+jsi::Value verifyPresentationWithDetails(jsi::Runtime &rt,
+                                         jsi::Object options);
+jsi::Value clearDefinitionCache(jsi::Runtime &rt, jsi::Object options);
+
+// Command buffers
+jsi::Value execute(jsi::Runtime &rt, jsi::Object options);
+
+// Scheduler
+jsi::Value cancelJob(jsi::Runtime &rt, jsi::Object options);
+jsi::Value configureScheduler(jsi::Runtime &rt, jsi::Object options);
+jsi::Value getSchedulerMetrics(jsi::Runtime &rt, jsi::Object options);
 
 } // namespace anoncreds
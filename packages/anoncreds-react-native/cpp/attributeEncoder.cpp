@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "attributeEncoder.h"
+#include "workerPool.h"
+
+namespace anoncredsAttributeEncoder {
+
+namespace {
+
+// Longest encoded value, the 78 digits of 2^256 - 1
+constexpr size_t maxEncoded = 78;
+
+// Values encoded by a worker at a time
+constexpr size_t chunk = 256;
+
+// ===== SHA-256 =====
+
+constexpr uint32_t k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+constexpr uint32_t rotr(uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+void compress(uint32_t state[8], const uint8_t block[64]) {
+  uint32_t w[64];
+  for (int i = 0; i < 16; i++)
+    w[i] = uint32_t(block[4 * i]) << 24 | uint32_t(block[4 * i + 1]) << 16 |
+           uint32_t(block[4 * i + 2]) << 8 | uint32_t(block[4 * i + 3]);
+  for (int i = 16; i < 64; i++) {
+    auto s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    auto s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  auto a = state[0], b = state[1], c = state[2], d = state[3];
+  auto e = state[4], f = state[5], g = state[6], h = state[7];
+  for (int i = 0; i < 64; i++) {
+    auto t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) +
+              ((e & f) ^ (~e & g)) + k[i] + w[i];
+    auto t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) +
+              ((a & b) ^ (a & c) ^ (b & c));
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+// The digest as eight big endian words, most significant first
+std::array<uint32_t, 8> sha256(std::string_view data) {
+  uint32_t state[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                       0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+  auto bytes = (const uint8_t *)data.data();
+  auto length = data.size();
+  for (; length >= 64; bytes += 64, length -= 64)
+    compress(state, bytes);
+
+  // Padding: 0x80, zeros and the bit length, in one or two blocks
+  uint8_t tail[128] = {};
+  std::memcpy(tail, bytes, length);
+  tail[length] = 0x80;
+  auto blocks = length < 56 ? 1 : 2;
+  auto bits = uint64_t(data.size()) * 8;
+  for (int i = 0; i < 8; i++)
+    tail[64 * blocks - 1 - i] = uint8_t(bits >> (8 * i));
+  for (int i = 0; i < blocks; i++)
+    compress(state, tail + 64 * i);
+
+  std::array<uint32_t, 8> digest;
+  std::copy(std::begin(state), std::end(state), digest.begin());
+  return digest;
+}
+
+// ===== ENCODING =====
+
+// Writes the 256-bit `value` in decimal at the end of `out`, which must hold
+// `maxEncoded` characters, and returns the number of digits
+size_t decimal(std::array<uint32_t, 8> value, char *out) {
+  auto end = out + maxEncoded;
+  auto cur = end;
+  size_t top = 0;
+  while (top < value.size() && value[top] == 0)
+    top++;
+
+  // Divide by 10^9 until nothing is left, nine digits per division
+  while (top < value.size()) {
+    uint64_t remainder = 0;
+    for (auto i = top; i < value.size(); i++) {
+      auto current = remainder << 32 | value[i];
+      value[i] = uint32_t(current / 1000000000);
+      remainder = current % 1000000000;
+    }
+    while (top < value.size() && value[top] == 0)
+      top++;
+
+    auto digits = 0;
+    for (; remainder > 0 || (top < value.size() && digits < 9); digits++) {
+      *--cur = char('0' + remainder % 10);
+      remainder /= 10;
+    }
+  }
+  if (cur == end)
+    *--cur = '0';
+
+  auto length = size_t(end - cur);
+  std::memmove(out, cur, length);
+  return length;
+}
+
+// Writes `raw` back when it parses as a 32-bit signed integer, the way Rust
+// parses `i32`: an optional sign followed by at least one digit
+bool integer(std::string_view raw, char *out, size_t &length) {
+  auto negative = !raw.empty() && raw.front() == '-';
+  if (!raw.empty() && (raw.front() == '-' || raw.front() == '+'))
+    raw.remove_prefix(1);
+  if (raw.empty())
+    return false;
+
+  int64_t value = 0;
+  for (auto c : raw) {
+    if (c < '0' || c > '9')
+      return false;
+    value = value * 10 + (c - '0');
+    if (value > int64_t(INT32_MAX) + 1)
+      return false;
+  }
+  if (negative)
+    value = -value;
+  if (value > INT32_MAX)
+    return false;
+
+  auto text = std::to_string(value);
+  std::memcpy(out, text.data(), text.size());
+  length = text.size();
+  return true;
+}
+
+// Encodes `raw` into `out`, which must hold `maxEncoded` characters
+size_t encodeInto(std::string_view raw, char *out) {
+  size_t length;
+  if (integer(raw, out, length))
+    return length;
+  return decimal(sha256(raw), out);
+}
+
+// Calls `work(begin, end)` for chunks of `count` items on the worker pool
+template <typename Work> void parallel(size_t count, Work work) {
+  anoncredsWorkerPool::parallelFor((count + chunk - 1) / chunk, [&](size_t i) {
+    work(i * chunk, std::min((i + 1) * chunk, count));
+  });
+}
+
+uint32_t readLength(const uint8_t *data) {
+  return uint32_t(data[0]) | uint32_t(data[1]) << 8 | uint32_t(data[2]) << 16 |
+         uint32_t(data[3]) << 24;
+}
+
+} // namespace
+
+std::string encode(std::string_view raw) {
+  char out[maxEncoded];
+  return std::string(out, encodeInto(raw, out));
+}
+
+void encodeAll(const std::vector<std::string> &raw,
+               std::vector<std::string> &encoded) {
+  encoded.resize(raw.size());
+  parallel(raw.size(), [&](size_t begin, size_t end) {
+    for (auto i = begin; i < end; i++)
+      encoded[i] = encode(raw[i]);
+  });
+}
+
+bool encodePacked(const uint8_t *data, size_t size, std::vector<uint8_t> &out) {
+  // Offsets of the values, checked before any work is done
+  std::vector<std::string_view> values;
+  for (size_t offset = 0; offset < size;) {
+    if (size - offset < 4)
+      return false;
+    auto length = readLength(data + offset);
+    offset += 4;
+    if (size - offset < length)
+      return false;
+    values.emplace_back((const char *)data + offset, length);
+    offset += length;
+  }
+
+  // Every value is encoded into a slot of its own, then the slots are packed
+  std::vector<char> slots(values.size() * maxEncoded);
+  std::vector<uint8_t> lengths(values.size());
+  parallel(values.size(), [&](size_t begin, size_t end) {
+    for (auto i = begin; i < end; i++)
+      lengths[i] = uint8_t(encodeInto(values[i], &slots[i * maxEncoded]));
+  });
+
+  size_t total = 0;
+  for (auto length : lengths)
+    total += 4 + length;
+  out.reserve(out.size() + total);
+  for (size_t i = 0; i < values.size(); i++) {
+    for (int b = 0; b < 4; b++)
+      out.push_back(uint8_t(lengths[i] >> (8 * b)));
+    out.insert(out.end(), &slots[i * maxEncoded],
+               &slots[i * maxEncoded] + lengths[i]);
+  }
+  return true;
+}
+
+} // namespace anoncredsAttributeEncoder
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Encodes raw credential attribute values natively, with the output of
+// `anoncreds_encode_credential_attributes`: a value that parses as a 32-bit
+// signed integer is written back in canonical form, any other value is
+// replaced by the SHA-256 digest of its UTF-8 bytes, read as a big endian
+// integer and written in decimal.
+//
+// Values are encoded on up to one worker thread per core. Packed values are
+// `{ length:u32 value:bytes }`, integers little endian, one after the other.
+namespace anoncredsAttributeEncoder {
+
+// Encodes one raw value
+std::string encode(std::string_view raw);
+
+// Encodes every value of `raw` into `encoded`, in order
+void encodeAll(const std::vector<std::string> &raw,
+               std::vector<std::string> &encoded);
+
+// Encodes the packed values of `data` into packed values appended to `out`.
+// Returns false, leaving `out` unchanged, when `data` is not packed values.
+bool encodePacked(const uint8_t *data, size_t size, std::vector<uint8_t> &out);
+
+} // namespace anoncredsAttributeEncoder
@@ -0,0 +1,831 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "handleRegistry.h"
+#include "include/libanoncreds.h"
+#include "key.h"
+#include "library.h"
+#include "propNameRegistry.h"
+#include "snapshot.h"
+#include "turboModuleUtility.h"
+
+using namespace facebook;
+
+// Compile-time descriptors for the bindings in `generatedBindings.h`.
+//
+// A binding is described by the FFI function it calls and one argument kind
+// per FFI parameter, in parameter order:
+//
+//   using createSchema =
+//       Binding<anoncreds_create_schema, Str<"name">, Str<"version">,
+//               Str<"issuerId">, StrList<"attributeNames">, Out<ObjectHandle>>;
+//
+// Every input kind decodes its value in its constructor and owns whatever the
+// FFI value points into, so nothing has to be freed by hand once the call
+// returns or a later argument throws.
+//
+// Bindings accept their inputs in one of two ways:
+//
+//   _anoncreds.createSchema({ name, version, issuerId, attributeNames })
+//   _anoncreds.createSchema(name, version, issuerId, attributeNames)
+//
+// A single argument that is an object but not an array is an options object,
+// anything else is a list of positional arguments in FFI parameter order,
+// without the outputs. The positional form skips the property lookups and is
+// meant for hot paths. Elements of struct lists and the revocation
+// configuration can likewise be passed as objects or as arrays in FFI field
+// order.
+namespace anoncredsBinding {
+
+using anoncredsTurboModuleUtility::errorInfix;
+using anoncredsTurboModuleUtility::errorPrefix;
+
+template <Key key>
+inline const size_t propNameSlot =
+    anoncredsPropNames::Registry::reserve(key.value);
+
+// Reads `key` through the `PropNameID` registry of the calling runtime. Falls
+// back to a C string lookup when called outside of the turbo module, e.g. by
+// the replay tool.
+template <Key key>
+jsi::Value property(jsi::Runtime &rt, const jsi::Object &object) {
+  if (auto registry = anoncredsPropNames::Registry::active())
+    return object.getProperty(rt, registry->get(rt, propNameSlot<key>));
+  return object.getProperty(rt, key.value);
+}
+
+inline bool isAbsent(const jsi::Value &value) {
+  return value.isNull() || value.isUndefined();
+}
+
+template <Key key>
+[[noreturn]] void throwTypeError(jsi::Runtime &rt, const char *type) {
+  throw jsi::JSError(rt, errorPrefix + key.value + errorInfix + type);
+}
+
+// Empty when an optional array is absent
+template <Key key>
+std::optional<jsi::Array> asArray(jsi::Runtime &rt, const jsi::Value &value,
+                                  const char *type, bool optional) {
+  if (optional && isAbsent(value))
+    return std::nullopt;
+  if (!value.isObject() || !value.getObject(rt).isArray(rt))
+    throwTypeError<key>(rt, type);
+  return value.getObject(rt).getArray(rt);
+}
+
+// ===== REFERENCES =====
+
+// Output of an earlier command in a command buffer, passed where a handle is
+// expected as `{ slot, output? }`. `output` names one of the handles of a
+// multi-output binding.
+struct Reference {
+  size_t slot;
+  std::string output;
+};
+
+// The references of a command buffer. While a buffer is decoded they are
+// turned into placeholder handles, taken from the top of the handle range,
+// that are resolved once the command they belong to runs.
+class References {
+public:
+  // Decodes a reference made by the command in slot `slot`
+  ObjectHandle add(jsi::Runtime &rt, size_t slot, const jsi::Object &object) {
+    auto target = object.getProperty(rt, "slot");
+    if (!target.isNumber() || target.getNumber() < 0 ||
+        size_t(target.getNumber()) >= slot)
+      throw jsi::JSError(rt, "Value `slot` is not the slot of an earlier "
+                             "command in the buffer");
+    auto output = object.getProperty(rt, "output");
+    if (!isAbsent(output) && !output.isString())
+      throw jsi::JSError(rt, errorPrefix + "output" + errorInfix + "string");
+
+    items.push_back(Reference{
+        .slot = size_t(target.getNumber()),
+        .output = output.isString() ? output.getString(rt).utf8(rt) : ""});
+    return std::numeric_limits<ObjectHandle>::max() - (items.size() - 1);
+  }
+
+  // The reference `handle` is a placeholder for, if any
+  const Reference *find(ObjectHandle handle) const {
+    auto index = std::numeric_limits<ObjectHandle>::max() - handle;
+    return index < items.size() ? &items[index] : nullptr;
+  }
+
+  const std::vector<Reference> &all() const { return items; }
+
+  static References *active() { return activeReferences; }
+
+  // Decodes references into `references`, on behalf of the command in `slot`,
+  // for the lifetime of the scope. Outside of a scope references are rejected
+  // as values of the wrong type.
+  class Scope {
+  public:
+    Scope(References &references, size_t slot)
+        : previous(activeReferences), previousSlot(activeSlot) {
+      activeReferences = &references;
+      activeSlot = slot;
+    }
+    ~Scope() {
+      activeReferences = previous;
+      activeSlot = previousSlot;
+    }
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+  private:
+    References *previous;
+    size_t previousSlot;
+  };
+
+  static size_t slot() { return activeSlot; }
+
+private:
+  std::vector<Reference> items;
+
+  static inline thread_local References *activeReferences = nullptr;
+  static inline thread_local size_t activeSlot = 0;
+};
+
+// Decodes a handle, or a reference when decoding a command buffer
+template <Key key>
+ObjectHandle decodeHandle(jsi::Runtime &rt, const jsi::Value &v,
+                          const char *type) {
+  if (v.isNumber()) {
+    auto handle = ObjectHandle(v.getNumber());
+    return anoncredsSnapshot::isRestored(handle)
+               ? anoncredsTurboModuleUtility::restoredObject(rt, handle)
+               : handle;
+  }
+  if (v.isObject() && References::active())
+    return References::active()->add(rt, References::slot(), v.getObject(rt));
+  throwTypeError<key>(rt, type);
+}
+
+// Fields of a struct passed either as an object or as an array in field order
+class Fields {
+public:
+  Fields(jsi::Runtime &rt, jsi::Object object) : rt(rt) {
+    if (object.isArray(rt))
+      array = object.getArray(rt);
+    else
+      this->object = std::move(object);
+  }
+
+  // Decodes the field `key` at `index` as `Kind`
+  template <typename Kind> Kind get(size_t index) {
+    if (object)
+      return Kind(rt, property<Kind::key>(rt, *object));
+    return Kind(rt, index < array->length(rt)
+                        ? array->getValueAtIndex(rt, index)
+                        : jsi::Value::undefined());
+  }
+
+private:
+  jsi::Runtime &rt;
+  std::optional<jsi::Object> object;
+  std::optional<jsi::Array> array;
+};
+
+// ===== INPUTS =====
+
+template <Key K> struct Str {
+  static constexpr auto key = K;
+  std::string value;
+
+  Str(jsi::Runtime &rt, const jsi::Value &v) {
+    if (!v.isString())
+      throwTypeError<key>(rt, "string");
+    value = v.getString(rt).utf8(rt);
+  }
+
+  FfiStr ffi() const { return value.c_str(); }
+};
+
+// Passed as `nullptr` when absent or empty
+template <Key K> struct OptionalStr {
+  static constexpr auto key = K;
+  std::optional<std::string> value;
+
+  OptionalStr(jsi::Runtime &rt, const jsi::Value &v) {
+    if (isAbsent(v))
+      return;
+    if (!v.isString())
+      throwTypeError<key>(rt, "string");
+    value = v.getString(rt).utf8(rt);
+  }
+
+  FfiStr ffi() const {
+    return value && !value->empty() ? value->c_str() : nullptr;
+  }
+};
+
+// Numbers, booleans are accepted as 0 or 1. An absent optional number is
+// passed as `fallback`.
+template <typename T, Key K, bool optional = false, T fallback = 0>
+struct Number {
+  static constexpr auto key = K;
+  T value = fallback;
+
+  Number(jsi::Runtime &rt, const jsi::Value &v) {
+    if (optional && isAbsent(v))
+      return;
+    if (v.isNumber())
+      value = T(v.getNumber());
+    else if (v.isBool())
+      value = v.getBool() ? 1 : 0;
+    else
+      throwTypeError<key>(rt, "number");
+  }
+
+  T ffi() const { return value; }
+};
+
+template <Key key, bool optional = false>
+using I8 = Number<int8_t, key, optional>;
+template <Key key, bool optional = false, int32_t fallback = 0>
+using I32 = Number<int32_t, key, optional, fallback>;
+template <Key key, bool optional = false, int64_t fallback = 0>
+using I64 = Number<int64_t, key, optional, fallback>;
+
+// An absent optional handle is passed as 0, which is never a valid handle
+template <Key K, bool optional = false> struct Handle {
+  static constexpr auto key = K;
+  ObjectHandle value = 0;
+
+  Handle(jsi::Runtime &rt, const jsi::Value &v) {
+    if (optional && isAbsent(v))
+      return;
+    value = decodeHandle<key>(rt, v, "ObjectHandle.handle");
+  }
+
+  template <typename F> void resolve(F &resolve) { value = resolve(value); }
+
+  ObjectHandle ffi() const { return value; }
+};
+
+template <Key K> struct Json {
+  static constexpr auto key = K;
+  std::string value;
+
+  Json(jsi::Runtime &rt, const jsi::Value &v) {
+    if (!v.isString())
+      throwTypeError<key>(rt, "string");
+    value = v.getString(rt).utf8(rt);
+  }
+
+  ByteBuffer ffi() {
+    return ByteBuffer{.len = int64_t(value.size()),
+                      .data = (uint8_t *)value.data()};
+  }
+};
+
+template <Key K, bool optional = false> struct StrList {
+  static constexpr auto key = K;
+  std::vector<std::string> items;
+  std::vector<FfiStr> pointers;
+
+  StrList(jsi::Runtime &rt, const jsi::Value &v) {
+    auto array = asArray<key>(rt, v, "Array<string>", optional);
+    auto length = array ? array->length(rt) : 0;
+    items.reserve(length);
+    for (size_t i = 0; i < length; i++) {
+      auto element = array->getValueAtIndex(rt, i);
+      if (!element.isString())
+        throwTypeError<key>(rt, "Array<string>");
+      items.push_back(element.getString(rt).utf8(rt));
+    }
+  }
+
+  FfiStrList ffi() {
+    pointers.clear();
+    for (auto &item : items)
+      pointers.push_back(item.c_str());
+    return FfiStrList{.count = pointers.size(), .data = pointers.data()};
+  }
+};
+
+template <Key K, bool optional = false> struct HandleList {
+  static constexpr auto key = K;
+  std::vector<ObjectHandle> items;
+
+  HandleList(jsi::Runtime &rt, const jsi::Value &v) {
+    auto array = asArray<key>(rt, v, "Array<number>", optional);
+    auto length = array ? array->length(rt) : 0;
+    items.reserve(length);
+    for (size_t i = 0; i < length; i++) {
+      auto element = array->getValueAtIndex(rt, i);
+      items.push_back(decodeHandle<key>(rt, element, "Array<number>"));
+    }
+  }
+
+  template <typename F> void resolve(F &resolve) {
+    for (auto &item : items)
+      item = resolve(item);
+  }
+
+  FfiList_ObjectHandle ffi() const {
+    return FfiList_ObjectHandle{.count = items.size(), .data = items.data()};
+  }
+};
+
+template <Key K, bool optional = false> struct I32List {
+  static constexpr auto key = K;
+  std::vector<int32_t> items;
+
+  I32List(jsi::Runtime &rt, const jsi::Value &v) {
+    auto array = asArray<key>(rt, v, "Array<number>", optional);
+    auto length = array ? array->length(rt) : 0;
+    items.reserve(length);
+    for (size_t i = 0; i < length; i++) {
+      auto element = array->getValueAtIndex(rt, i);
+      if (!element.isNumber())
+        throwTypeError<key>(rt, "Array<number>");
+      items.push_back(int32_t(element.getNumber()));
+    }
+  }
+
+  FfiList_i32 ffi() const {
+    return FfiList_i32{.count = items.size(), .data = items.data()};
+  }
+};
+
+// Decodes the fields of every element of an array of structs with `decode`
+template <Key key, typename F>
+void forEachStruct(jsi::Runtime &rt, const jsi::Value &v, const char *type,
+                   bool optional, F decode) {
+  auto array = asArray<key>(rt, v, type, optional);
+  auto length = array ? array->length(rt) : 0;
+  for (size_t i = 0; i < length; i++) {
+    auto element = array->getValueAtIndex(rt, i);
+    if (!element.isObject())
+      throwTypeError<key>(rt, type);
+    Fields fields(rt, element.getObject(rt));
+    decode(fields);
+  }
+}
+
+template <Key K, bool optional = false> struct CredentialEntryList {
+  static constexpr auto key = K;
+  std::vector<FfiCredentialEntry> items;
+
+  CredentialEntryList(jsi::Runtime &rt, const jsi::Value &v) {
+    forEachStruct<key>(
+        rt, v, "Array<CredentialEntry>", optional, [&](Fields &entry) {
+          items.push_back(FfiCredentialEntry{
+              .credential = entry.get<Handle<"credential">>(0).value,
+              .timestamp = entry.get<I32<"timestamp", true, -1>>(1).value,
+              .rev_state =
+                  entry.get<Handle<"revocationState", true>>(2).value});
+        });
+  }
+
+  template <typename F> void resolve(F &resolve) {
+    for (auto &item : items) {
+      item.credential = resolve(item.credential);
+      item.rev_state = resolve(item.rev_state);
+    }
+  }
+
+  FfiList_FfiCredentialEntry ffi() const {
+    return FfiList_FfiCredentialEntry{.count = items.size(),
+                                      .data = items.data()};
+  }
+};
+
+template <Key K, bool optional = false> struct CredentialProveList {
+  static constexpr auto key = K;
+  std::vector<std::string> referents;
+  std::vector<FfiCredentialProve> items;
+
+  CredentialProveList(jsi::Runtime &rt, const jsi::Value &v) {
+    forEachStruct<key>(
+        rt, v, "Array<CredentialProve>", optional, [&](Fields &prove) {
+          items.push_back(FfiCredentialProve{
+              .entry_idx = prove.get<I64<"entryIndex">>(0).value,
+              .is_predicate = prove.get<I8<"isPredicate">>(2).value,
+              .reveal = prove.get<I8<"reveal">>(3).value});
+          referents.push_back(
+              std::move(prove.get<Str<"referent">>(1).value));
+        });
+  }
+
+  FfiList_FfiCredentialProve ffi() {
+    for (size_t i = 0; i < items.size(); i++)
+      items[i].referent = referents[i].c_str();
+    return FfiList_FfiCredentialProve{.count = items.size(),
+                                      .data = items.data()};
+  }
+};
+
+template <Key K, bool optional = false> struct NonRevokedIntervalOverrideList {
+  static constexpr auto key = K;
+  std::vector<std::string> revocationRegistryDefinitionIds;
+  std::vector<FfiNonrevokedIntervalOverride> items;
+
+  NonRevokedIntervalOverrideList(jsi::Runtime &rt, const jsi::Value &v) {
+    forEachStruct<key>(
+        rt, v, "Array<NonRevokedIntervalOverride>", optional,
+        [&](Fields &entry) {
+          revocationRegistryDefinitionIds.push_back(std::move(
+              entry.get<Str<"revocationRegistryDefinitionId">>(0).value));
+          items.push_back(FfiNonrevokedIntervalOverride{
+              .requested_from_ts =
+                  entry.get<I32<"requestedFromTimestamp">>(1).value,
+              .override_rev_status_list_ts =
+                  entry.get<I32<"overrideRevocationStatusListTimestamp">>(2)
+                      .value});
+        });
+  }
+
+  FfiList_FfiNonrevokedIntervalOverride ffi() {
+    for (size_t i = 0; i < items.size(); i++)
+      items[i].rev_reg_def_id = revocationRegistryDefinitionIds[i].c_str();
+    return FfiList_FfiNonrevokedIntervalOverride{.count = items.size(),
+                                                 .data = items.data()};
+  }
+};
+
+// Passed as `nullptr` when absent
+template <Key K> struct CredRevInfo {
+  static constexpr auto key = K;
+  std::optional<FfiCredRevInfo> value;
+
+  CredRevInfo(jsi::Runtime &rt, const jsi::Value &v) {
+    if (isAbsent(v))
+      return;
+    if (!v.isObject())
+      throwTypeError<key>(rt, "CredentialRevocationConfig");
+    Fields config(rt, v.getObject(rt));
+    value = FfiCredRevInfo{
+        .reg_def = config.get<Handle<"revocationRegistryDefinition">>(0).value,
+        .reg_def_private =
+            config.get<Handle<"revocationRegistryDefinitionPrivate">>(1).value,
+        .status_list =
+            config.get<Handle<"revocationStatusList", true>>(2).value,
+        .reg_idx = config.get<I64<"registryIndex">>(3).value};
+  }
+
+  template <typename F> void resolve(F &resolve) {
+    if (!value)
+      return;
+    value->reg_def = resolve(value->reg_def);
+    value->reg_def_private = resolve(value->reg_def_private);
+    value->status_list = resolve(value->status_list);
+  }
+
+  const FfiCredRevInfo *ffi() const { return value ? &*value : nullptr; }
+};
+
+// ===== OUTPUTS =====
+
+// An output parameter. A binding with a single output returns it as `value`,
+// a binding with several returns them as an object keyed by `key`.
+template <typename T, Key K = ""> struct Out {
+  static constexpr auto key = K;
+  T value{};
+
+  T *ffi() { return &value; }
+};
+
+template <typename T> struct IsOut : std::false_type {};
+template <typename T, Key key> struct IsOut<Out<T, key>> : std::true_type {};
+
+template <typename Argument>
+void setSingleOutput(jsi::Runtime &rt, ErrorCode code, Argument &argument,
+                     jsi::Value &result) {
+  if constexpr (IsOut<Argument>::value)
+    result = anoncredsTurboModuleUtility::createReturnValue(rt, code,
+                                                            &argument.value);
+}
+
+template <typename Argument>
+void setNamedOutput(jsi::Runtime &rt, Argument &argument, jsi::Object &value) {}
+
+template <typename T, Key key>
+void setNamedOutput(jsi::Runtime &rt, Out<T, key> &argument,
+                    jsi::Object &value) {
+  static_assert(!key.empty(), "Outputs of multi-output bindings need a key");
+  static_assert(std::is_same_v<T, ObjectHandle>,
+                "Multi-output bindings can only return handles");
+  value.setProperty(rt, key.value, int(argument.value));
+}
+
+// Records the handles a binding returns in the live-handle registry
+template <typename Argument> void trackOutput(Argument &argument) {}
+
+template <Key key> void trackOutput(Out<ObjectHandle, key> &argument) {
+  anoncredsHandleRegistry::track(argument.value);
+}
+
+// Frees an output that is never handed to JS
+template <typename Argument> void freeOutput(Argument &argument) {}
+
+template <Key key> void freeOutput(Out<ObjectHandle, key> &argument) {
+  if (argument.value != 0)
+    anoncredsLibrary::anoncreds_object_free(argument.value);
+}
+
+template <Key key> void freeOutput(Out<const char *, key> &argument) {
+  if (argument.value != nullptr)
+    anoncredsLibrary::anoncreds_string_free((char *)argument.value);
+}
+
+template <Key key> void freeOutput(Out<ByteBuffer, key> &argument) {
+  anoncredsLibrary::anoncreds_buffer_free(argument.value);
+}
+
+// The handle `argument` returns as `output`, "" for a single output
+template <typename Argument>
+std::optional<ObjectHandle> handleOutput(Argument &argument,
+                                         std::string_view output) {
+  return std::nullopt;
+}
+
+template <Key key>
+std::optional<ObjectHandle> handleOutput(Out<ObjectHandle, key> &argument,
+                                         std::string_view output) {
+  if (output != key.value)
+    return std::nullopt;
+  return argument.value;
+}
+
+// Replaces the placeholders of references among the handles of `argument`
+template <typename Argument, typename F>
+void resolveHandles(Argument &argument, F &resolve) {
+  if constexpr (requires { argument.resolve(resolve); })
+    argument.resolve(resolve);
+}
+
+// ===== COMMANDS =====
+
+// A binding call decoded ahead of time, to be run later and possibly on
+// another thread. See `commandBuffer.h`.
+class Command {
+public:
+  using Resolve = std::function<ObjectHandle(ObjectHandle)>;
+
+  virtual ~Command() = default;
+
+  // Calls the FFI function, with every handle passed through `resolve` first
+  virtual ErrorCode run(const Resolve &resolve) = 0;
+
+  // The handle output named `output`, "" for a single output. Empty when the
+  // binding has no such output, 0 until the command has run.
+  virtual std::optional<ObjectHandle> handle(std::string_view output) = 0;
+
+  // The outputs of a successful run as the binding returns them, handed over
+  // to JS. Outputs that are never returned are freed with the command.
+  virtual jsi::Value result(jsi::Runtime &rt) = 0;
+};
+
+// ===== BINDING =====
+
+// Whether the arguments of a call are positional rather than an options object
+inline bool isPositional(jsi::Runtime &rt, const jsi::Value *arguments,
+                         size_t count) {
+  return count != 1 || !arguments[0].isObject() ||
+         arguments[0].getObject(rt).isArray(rt);
+}
+
+template <auto fn, typename... Arguments> struct Binding {
+  static constexpr size_t outputs = (size_t(IsOut<Arguments>::value) + ... + 0);
+  static constexpr size_t inputs = sizeof...(Arguments) - outputs;
+
+  static jsi::Value call(jsi::Runtime &rt, jsi::Object options) {
+    // Braced initialisation decodes the arguments in order
+    std::tuple<Arguments...> arguments{fromOptions<Arguments>(rt, options)...};
+    return invoke(rt, arguments);
+  }
+
+  static jsi::Value callPositional(jsi::Runtime &rt,
+                                   const jsi::Value *arguments, size_t count) {
+    return callPositional(rt, arguments, count,
+                          std::index_sequence_for<Arguments...>{});
+  }
+
+  // Options object equivalent to a positional call, used by the recorder so
+  // that traces only ever contain options objects
+  static jsi::Object toOptions(jsi::Runtime &rt, const jsi::Value *arguments,
+                               size_t count) {
+    auto options = jsi::Object(rt);
+    toOptions(rt, arguments, count, options,
+              std::index_sequence_for<Arguments...>{});
+    return options;
+  }
+
+private:
+  // Position of the argument at `index` among the inputs
+  static constexpr size_t inputIndex(size_t index) {
+    constexpr bool isOut[] = {IsOut<Arguments>::value..., false};
+    size_t position = 0;
+    for (size_t i = 0; i < index; i++)
+      position += isOut[i] ? 0 : 1;
+    return position;
+  }
+
+  template <typename Argument>
+  static Argument fromOptions(jsi::Runtime &rt, jsi::Object &options) {
+    if constexpr (IsOut<Argument>::value)
+      return Argument{};
+    else
+      return Argument(rt, property<Argument::key>(rt, options));
+  }
+
+  template <typename Argument, size_t position>
+  static Argument fromPositional(jsi::Runtime &rt, const jsi::Value *arguments,
+                                 size_t count) {
+    if constexpr (IsOut<Argument>::value)
+      return Argument{};
+    else if (position < count)
+      return Argument(rt, arguments[position]);
+    else
+      return Argument(rt, jsi::Value::undefined());
+  }
+
+  template <size_t... I>
+  static std::tuple<Arguments...>
+  decodePositional(jsi::Runtime &rt, const jsi::Value *arguments, size_t count,
+                   std::index_sequence<I...>) {
+    if (count > inputs)
+      throw jsi::JSError(rt, "Expected at most " + std::to_string(inputs) +
+                                 " arguments, got " + std::to_string(count));
+    return std::tuple<Arguments...>{
+        fromPositional<Arguments, inputIndex(I)>(rt, arguments, count)...};
+  }
+
+  template <size_t... I>
+  static jsi::Value callPositional(jsi::Runtime &rt,
+                                   const jsi::Value *arguments, size_t count,
+                                   std::index_sequence<I...> sequence) {
+    auto decoded = decodePositional(rt, arguments, count, sequence);
+    return invoke(rt, decoded);
+  }
+
+  template <size_t... I>
+  static void toOptions(jsi::Runtime &rt, const jsi::Value *arguments,
+                        size_t count, jsi::Object &options,
+                        std::index_sequence<I...>) {
+    (
+        [&] {
+          using Argument = std::tuple_element_t<I, std::tuple<Arguments...>>;
+          if constexpr (!IsOut<Argument>::value) {
+            if (inputIndex(I) < count)
+              options.setProperty(rt, Argument::key.value,
+                                  jsi::Value(rt, arguments[inputIndex(I)]));
+          }
+        }(),
+        ...);
+  }
+
+  static ErrorCode run(std::tuple<Arguments...> &arguments) {
+    return std::apply(
+        [](Arguments &...argument) { return fn(argument.ffi()...); },
+        arguments);
+  }
+
+  static void track(std::tuple<Arguments...> &arguments) {
+    std::apply([](Arguments &...argument) { (trackOutput(argument), ...); },
+               arguments);
+  }
+
+  static jsi::Value invoke(jsi::Runtime &rt,
+                           std::tuple<Arguments...> &arguments) {
+    ErrorCode code = run(arguments);
+
+    if (code == ErrorCode::Success)
+      track(arguments);
+
+    return result(rt, code, arguments);
+  }
+
+  static jsi::Value result(jsi::Runtime &rt, ErrorCode code,
+                           std::tuple<Arguments...> &arguments) {
+    if constexpr (outputs == 0) {
+      return anoncredsTurboModuleUtility::createReturnValue(rt, code, nullptr);
+    } else if constexpr (outputs == 1) {
+      jsi::Value result;
+      std::apply(
+          [&](Arguments &...argument) {
+            (setSingleOutput(rt, code, argument, result), ...);
+          },
+          arguments);
+      return result;
+    } else {
+      if (code != ErrorCode::Success)
+        return anoncredsTurboModuleUtility::returnValue(
+            rt, code, jsi::Value::undefined());
+      auto value = jsi::Object(rt);
+      std::apply(
+          [&](Arguments &...argument) {
+            (setNamedOutput(rt, argument, value), ...);
+          },
+          arguments);
+      return anoncredsTurboModuleUtility::returnValue(rt, code,
+                                                      std::move(value));
+    }
+  }
+
+  class BoundCommand : public Command {
+  public:
+    explicit BoundCommand(std::tuple<Arguments...> arguments)
+        : arguments(std::move(arguments)) {}
+
+    ~BoundCommand() override {
+      if (ran && !returned)
+        std::apply([](Arguments &...argument) { (freeOutput(argument), ...); },
+                   arguments);
+    }
+
+    ErrorCode run(const Resolve &resolve) override {
+      std::apply(
+          [&](Arguments &...argument) {
+            (resolveHandles(argument, resolve), ...);
+          },
+          arguments);
+      auto code = Binding::run(arguments);
+      ran = code == ErrorCode::Success;
+      return code;
+    }
+
+    std::optional<ObjectHandle> handle(std::string_view output) override {
+      std::optional<ObjectHandle> found;
+      std::apply(
+          [&](Arguments &...argument) {
+            ((found = found ? found : handleOutput(argument, output)), ...);
+          },
+          arguments);
+      return found;
+    }
+
+    jsi::Value result(jsi::Runtime &rt) override {
+      returned = true;
+      track(arguments);
+      // Under the throwing convention a successful call returns the bare value
+      anoncredsTurboModuleUtility::ReturnConventionScope bare(
+          anoncredsTurboModuleUtility::ReturnConvention{.throwing = true});
+      return Binding::result(rt, ErrorCode::Success, arguments);
+    }
+
+  private:
+    std::tuple<Arguments...> arguments;
+    bool ran = false;
+    bool returned = false;
+  };
+
+public:
+  // Decodes a call for a command buffer, from an options object or an array
+  // of positional arguments
+  static std::unique_ptr<Command> prepare(jsi::Runtime &rt,
+                                          const jsi::Value &arguments) {
+    if (!arguments.isObject())
+      throw jsi::JSError(rt, errorPrefix + "arguments" + errorInfix +
+                                 "object | Array<unknown>");
+    auto object = arguments.getObject(rt);
+    if (!object.isArray(rt))
+      return std::make_unique<BoundCommand>(std::tuple<Arguments...>{
+          fromOptions<Arguments>(rt, object)...});
+
+    auto array = object.getArray(rt);
+    std::vector<jsi::Value> values;
+    values.reserve(array.length(rt));
+    for (size_t i = 0; i < array.length(rt); i++)
+      values.push_back(array.getValueAtIndex(rt, i));
+    return std::make_unique<BoundCommand>(
+        decodePositional(rt, values.data(), values.size(),
+                         std::index_sequence_for<Arguments...>{}));
+  }
+};
+
+struct BindingEntry {
+  const char *name;
+  jsi::Value (*call)(jsi::Runtime &rt, jsi::Object options);
+  // Only set for bindings that accept positional arguments
+  jsi::Value (*callPositional)(jsi::Runtime &rt, const jsi::Value *arguments,
+                               size_t count) = nullptr;
+  jsi::Object (*toOptions)(jsi::Runtime &rt, const jsi::Value *arguments,
+                           size_t count) = nullptr;
+  // Only set for bindings that can be used in a command buffer
+  std::unique_ptr<Command> (*prepare)(jsi::Runtime &rt,
+                                      const jsi::Value &arguments) = nullptr;
+};
+
+template <Key name, typename B> constexpr BindingEntry entry() {
+  return {name.value, &B::call, &B::callPositional, &B::toOptions,
+          &B::prepare};
+}
+
+} // namespace anoncredsBinding
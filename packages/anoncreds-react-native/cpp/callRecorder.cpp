@@ -0,0 +1,211 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+
+#include "callRecorder.h"
+#include "library.h"
+
+namespace anoncredsCallRecorder {
+
+namespace {
+
+std::atomic<bool> recording{false};
+std::mutex traceMutex;
+FILE *traceFile = nullptr;
+std::chrono::steady_clock::time_point traceStart;
+
+void writeVarint(std::string &out, uint64_t value) {
+  while (value >= 0x80) {
+    out += char((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  out += char(value);
+}
+
+void writeBytes(std::string &out, const std::string &bytes) {
+  writeVarint(out, bytes.size());
+  out += bytes;
+}
+
+std::string base64(const uint8_t *data, size_t size) {
+  static const char alphabet[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  out.reserve((size + 2) / 3 * 4);
+  for (size_t i = 0; i < size; i += 3) {
+    uint32_t chunk = uint32_t(data[i]) << 16;
+    if (i + 1 < size)
+      chunk |= uint32_t(data[i + 1]) << 8;
+    if (i + 2 < size)
+      chunk |= data[i + 2];
+    out += alphabet[(chunk >> 18) & 0x3F];
+    out += alphabet[(chunk >> 12) & 0x3F];
+    out += i + 1 < size ? alphabet[(chunk >> 6) & 0x3F] : '=';
+    out += i + 2 < size ? alphabet[chunk & 0x3F] : '=';
+  }
+  return out;
+}
+
+// `JSON.stringify` replacer that writes `redacted` in place of the strings
+// under `secret` and bytes as `{ "base64": ... }`
+jsi::Function replacer(jsi::Runtime &rt, const char *secret) {
+  return jsi::Function::createFromHostFunction(
+      rt, jsi::PropNameID::forAscii(rt, "replacer"), 2,
+      [secret](jsi::Runtime &rt, const jsi::Value &, const jsi::Value *args,
+               size_t count) -> jsi::Value {
+        if (count < 2)
+          return jsi::Value::undefined();
+        if (args[1].isString() && args[0].isString() &&
+            args[0].getString(rt).utf8(rt) == secret)
+          return jsi::String::createFromAscii(rt, redacted);
+
+        auto bytes = anoncredsTurboModuleUtility::bytesOf(rt, args[1]);
+        if (!bytes)
+          return jsi::Value(rt, args[1]);
+        auto out = jsi::Object(rt);
+        out.setProperty(rt, "base64",
+                        jsi::String::createFromAscii(
+                            rt, base64(bytes->data, bytes->size)));
+        return out;
+      });
+}
+
+std::string stringify(jsi::Runtime &rt, const jsi::Value &value,
+                      const char *secret) {
+  auto json = rt.global().getPropertyAsObject(rt, "JSON");
+  auto result = json.getPropertyAsFunction(rt, "stringify")
+                    .call(rt, value, replacer(rt, secret));
+
+  // `JSON.stringify(undefined)` returns undefined
+  if (!result.isString())
+    return "null";
+  return result.asString(rt).utf8(rt);
+}
+
+// `execute` is recorded as the names of its commands. Their arguments are
+// positional, so a link secret among them can not be told apart.
+std::string executeArguments(jsi::Runtime &rt, const jsi::Value &options) {
+  auto names = jsi::Array(rt, 0);
+  auto commands = options.isObject()
+                      ? options.getObject(rt).getProperty(rt, "commands")
+                      : jsi::Value::undefined();
+  if (commands.isObject() && commands.getObject(rt).isArray(rt)) {
+    auto array = commands.getObject(rt).getArray(rt);
+    names = jsi::Array(rt, array.length(rt));
+    for (size_t i = 0; i < array.length(rt); i++) {
+      auto command = array.getValueAtIndex(rt, i);
+      names.setValueAtIndex(
+          rt, i,
+          command.isObject() && command.getObject(rt).isArray(rt)
+              ? command.getObject(rt).getArray(rt).getValueAtIndex(rt, 0)
+              : jsi::Value::null());
+    }
+  }
+  auto out = jsi::Object(rt);
+  out.setProperty(rt, "commands", names);
+  return stringify(rt, out, "linkSecret");
+}
+
+uint64_t nanosecondsBetween(std::chrono::steady_clock::time_point from,
+                            std::chrono::steady_clock::time_point to) {
+  if (to < from)
+    return 0;
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from)
+      .count();
+}
+
+void append(uint8_t flags, const char *name, const std::string &arguments,
+            const std::string &result,
+            std::chrono::steady_clock::time_point begin,
+            std::chrono::steady_clock::time_point end) {
+  std::lock_guard<std::mutex> lock(traceMutex);
+  if (traceFile == nullptr)
+    return;
+
+  std::string record;
+  record.reserve(arguments.size() + result.size() + 64);
+  record += char(flags);
+  writeBytes(record, name);
+  writeBytes(record, arguments);
+  writeBytes(record, result);
+  writeVarint(record, nanosecondsBetween(traceStart, begin));
+  writeVarint(record, nanosecondsBetween(begin, end));
+
+  fwrite(record.data(), 1, record.size(), traceFile);
+}
+
+void closeTrace() {
+  if (traceFile == nullptr)
+    return;
+  fflush(traceFile);
+  fclose(traceFile);
+  traceFile = nullptr;
+}
+
+} // namespace
+
+bool isRecording() { return recording.load(std::memory_order_relaxed); }
+
+void start(const std::string &path) {
+  std::lock_guard<std::mutex> lock(traceMutex);
+  recording = false;
+  closeTrace();
+
+  traceFile = fopen(path.c_str(), "wb");
+  if (traceFile == nullptr)
+    throw std::runtime_error("Unable to open trace file: " + path);
+
+  auto startedAt = std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                       .count();
+
+  std::string header = "ACTR";
+  header += char(traceVersion);
+  for (int i = 0; i < 8; i++) {
+    header += char((uint64_t(startedAt) >> (8 * i)) & 0xFF);
+  }
+  writeBytes(header, anoncredsLibrary::anoncreds_version());
+  fwrite(header.data(), 1, header.size(), traceFile);
+
+  traceStart = std::chrono::steady_clock::now();
+  recording = true;
+}
+
+void stop() {
+  std::lock_guard<std::mutex> lock(traceMutex);
+  recording = false;
+  closeTrace();
+}
+
+jsi::Value recordCall(jsi::Runtime &rt, const char *name, Cb cb,
+                      const jsi::Value &options) {
+  auto view = std::string_view(name);
+
+  // Serialize the arguments up front so the timing only covers the binding
+  auto arguments = view == "execute" ? executeArguments(rt, options)
+                                     : stringify(rt, options, "linkSecret");
+
+  auto begin = std::chrono::steady_clock::now();
+  try {
+    auto result = (*cb)(rt, options.getObject(rt));
+    auto end = std::chrono::steady_clock::now();
+
+    // The results of `execute` can hold the output of `createLinkSecret`
+    append(0, name, arguments,
+           view == "execute"
+               ? "null"
+               : stringify(rt, result,
+                           view == "createLinkSecret" ? "value" : "linkSecret"),
+           begin, end);
+    return result;
+  } catch (const std::exception &e) {
+    auto end = std::chrono::steady_clock::now();
+    append(flagThrew, name, arguments, e.what(), begin, end);
+    throw;
+  }
+}
+
+} // namespace anoncredsCallRecorder
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <string>
+
+#include "HostObject.h"
+
+using namespace facebook;
+
+// Opt-in recorder for the calls that go through the turbo module dispatcher.
+//
+// A trace file starts with a header:
+//
+//   magic      4 bytes  "ACTR"
+//   version    1 byte   `traceVersion`
+//   startedAt  8 bytes  little endian, unix time in microseconds
+//   library    varint length + bytes, `anoncreds_version()` at record time
+//
+// followed by one record per call:
+//
+//   flags      1 byte   bit 0 is set when the binding threw
+//   name       varint length + bytes, name of the binding
+//   arguments  varint length + bytes, `JSON.stringify` of the options object
+//   result     varint length + bytes, `JSON.stringify` of the return value,
+//                                      or the error message when it threw
+//   start      varint, nanoseconds since the recording started
+//   duration   varint, nanoseconds spent inside the binding
+//
+// Varints are unsigned LEB128. Handles show up as plain numbers in the
+// arguments and results, which is enough for a replayer to rebuild the handle
+// graph of a session by mapping recorded handles onto the ones it creates.
+// `ArrayBuffer`s and their views are recorded as `{ "base64": ... }`.
+//
+// Link secrets are never written to a trace: every `linkSecret` argument and
+// the result of `createLinkSecret` are recorded as `redacted`, and a replayer
+// substitutes a link secret of its own. `execute` is recorded as the names of
+// its commands only, without their arguments or results.
+namespace anoncredsCallRecorder {
+
+static const uint8_t traceVersion = 1;
+static const uint8_t flagThrew = 1;
+static const char redacted[] = "[redacted]";
+
+// Cheap check used on every dispatch
+bool isRecording();
+
+// Starts writing a new trace to `path`, stopping any active recording first.
+// Throws `std::runtime_error` when the file can not be opened.
+void start(const std::string &path);
+
+// Flushes and closes the active trace, if any
+void stop();
+
+// Calls `cb` and appends a record for it to the active trace
+jsi::Value recordCall(jsi::Runtime &rt, const char *name, Cb cb,
+                      const jsi::Value &options);
+
+} // namespace anoncredsCallRecorder
@@ -0,0 +1,321 @@
+#include <algorithm>
+#include <limits>
+
+#include "cbor.h"
+
+namespace anoncredsCbor {
+
+namespace {
+
+using anoncredsJson::Value;
+
+static const int maxDepth = 128;
+
+enum Major : uint8_t {
+  Unsigned = 0,
+  Negative = 1,
+  Bytes = 2,
+  Text = 3,
+  Array = 4,
+  Map = 5,
+  Tag = 6,
+  Simple = 7,
+};
+
+enum SimpleValue : uint8_t {
+  False = 20,
+  True = 21,
+  Null = 22,
+};
+
+void writeHead(std::vector<uint8_t> &out, Major major, uint64_t argument) {
+  auto initial = uint8_t(major << 5);
+  if (argument < 24) {
+    out.push_back(initial | uint8_t(argument));
+    return;
+  }
+
+  int bytes = argument <= 0xFF ? 1 : argument <= 0xFFFF ? 2
+                                 : argument <= 0xFFFFFFFF ? 4
+                                                          : 8;
+  out.push_back(initial | uint8_t(bytes == 1   ? 24
+                                  : bytes == 2 ? 25
+                                  : bytes == 4 ? 26
+                                               : 27));
+  for (int i = bytes - 1; i >= 0; i--)
+    out.push_back(uint8_t(argument >> (8 * i)));
+}
+
+void writeText(std::vector<uint8_t> &out, const std::string &text) {
+  writeHead(out, Text, text.size());
+  out.insert(out.end(), text.begin(), text.end());
+}
+
+bool isDigits(const std::string &text, size_t from) {
+  return from < text.size() &&
+         std::all_of(text.begin() + from, text.end(),
+                     [](char c) { return c >= '0' && c <= '9'; }) &&
+         (text[from] != '0' || text.size() == from + 1);
+}
+
+// The value of a run of decimal digits, if it fits in 64 bits
+bool toUnsigned(const std::string &digits, size_t from, uint64_t &out) {
+  out = 0;
+  for (auto i = from; i < digits.size(); i++) {
+    auto digit = uint64_t(digits[i] - '0');
+    if (out > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+      return false;
+    out = out * 10 + digit;
+  }
+  return true;
+}
+
+std::vector<uint8_t> decimalToBytes(const std::string &digits) {
+  // Little endian while converting
+  std::vector<uint8_t> bytes;
+  for (char c : digits) {
+    uint32_t carry = uint32_t(c - '0');
+    for (auto &byte : bytes) {
+      auto value = uint32_t(byte) * 10 + carry;
+      byte = uint8_t(value);
+      carry = value >> 8;
+    }
+    for (; carry > 0; carry >>= 8)
+      bytes.push_back(uint8_t(carry));
+  }
+  std::reverse(bytes.begin(), bytes.end());
+  return bytes;
+}
+
+std::string bytesToDecimal(const uint8_t *bytes, size_t len) {
+  // Little endian limbs of 9 decimal digits
+  static const uint32_t limbBase = 1000000000;
+  std::vector<uint32_t> limbs;
+  for (size_t i = 0; i < len; i++) {
+    uint64_t carry = bytes[i];
+    for (auto &limb : limbs) {
+      auto value = uint64_t(limb) * 256 + carry;
+      limb = uint32_t(value % limbBase);
+      carry = value / limbBase;
+    }
+    for (; carry > 0; carry /= limbBase)
+      limbs.push_back(uint32_t(carry % limbBase));
+  }
+  if (limbs.empty())
+    return "0";
+
+  auto out = std::to_string(limbs.back());
+  for (auto limb = limbs.rbegin() + 1; limb != limbs.rend(); limb++) {
+    auto digits = std::to_string(*limb);
+    out.append(9 - digits.size(), '0');
+    out += digits;
+  }
+  return out;
+}
+
+void encodeNumber(const std::string &text, std::vector<uint8_t> &out) {
+  uint64_t value;
+  if (isDigits(text, 0) && toUnsigned(text, 0, value)) {
+    writeHead(out, Unsigned, value);
+  } else if (text.size() > 1 && text[0] == '-' && text != "-0" &&
+             isDigits(text, 1) && toUnsigned(text, 1, value)) {
+    writeHead(out, Negative, value - 1);
+  } else {
+    writeHead(out, Tag, numberTextTag);
+    writeText(out, text);
+  }
+}
+
+struct Decoder {
+  const uint8_t *cur;
+  const uint8_t *end;
+  std::string error;
+
+  bool fail(const char *message) {
+    if (error.empty())
+      error = message;
+    return false;
+  }
+
+  bool head(uint8_t &major, uint64_t &argument) {
+    if (cur == end)
+      return fail("Unexpected end of input");
+    major = *cur >> 5;
+    auto info = *cur++ & 0x1F;
+    if (info < 24) {
+      argument = info;
+      return true;
+    }
+    if (info > 27)
+      return fail("Indefinite lengths are not supported");
+
+    size_t bytes = size_t(1) << (info - 24);
+    if (size_t(end - cur) < bytes)
+      return fail("Unexpected end of input");
+    argument = 0;
+    for (size_t i = 0; i < bytes; i++)
+      argument = (argument << 8) | *cur++;
+    return true;
+  }
+
+  bool span(uint64_t length, const uint8_t *&data) {
+    if (uint64_t(end - cur) < length)
+      return fail("Unexpected end of input");
+    data = cur;
+    cur += length;
+    return true;
+  }
+
+  bool text(std::string &out) {
+    uint8_t major;
+    uint64_t length;
+    const uint8_t *data;
+    if (!head(major, length))
+      return false;
+    if (major != Text)
+      return fail("Expected a text string");
+    if (!span(length, data))
+      return false;
+    out.assign((const char *)data, length);
+    return true;
+  }
+
+  bool value(Value &out, int depth) {
+    if (depth > maxDepth)
+      return fail("Maximum nesting depth exceeded");
+
+    uint8_t major;
+    uint64_t argument;
+    if (!head(major, argument))
+      return false;
+
+    switch (major) {
+    case Unsigned:
+      out.type = Value::Type::Number;
+      out.text = std::to_string(argument);
+      return true;
+    case Negative:
+      out.type = Value::Type::Number;
+      out.text = argument == std::numeric_limits<uint64_t>::max()
+                     ? "-18446744073709551616"
+                     : "-" + std::to_string(argument + 1);
+      return true;
+    case Text: {
+      const uint8_t *data;
+      if (!span(argument, data))
+        return false;
+      out.type = Value::Type::String;
+      out.text.assign((const char *)data, argument);
+      return true;
+    }
+    case Array:
+      out.type = Value::Type::Array;
+      if (argument > uint64_t(end - cur))
+        return fail("Unexpected end of input");
+      out.items.resize(argument);
+      for (auto &item : out.items)
+        if (!value(item, depth + 1))
+          return false;
+      return true;
+    case Map:
+      out.type = Value::Type::Object;
+      if (argument > uint64_t(end - cur) / 2)
+        return fail("Unexpected end of input");
+      out.members.resize(argument);
+      for (auto &member : out.members)
+        if (!text(member.first) || !value(member.second, depth + 1))
+          return false;
+      return true;
+    case Tag:
+      return tagged(argument, out);
+    case Simple:
+      if (argument == False || argument == True) {
+        out.type = Value::Type::Bool;
+        out.boolean = argument == True;
+        return true;
+      }
+      if (argument == Null) {
+        out.type = Value::Type::Null;
+        return true;
+      }
+      return fail("Unsupported simple value");
+    default:
+      return fail("Unsupported major type");
+    }
+  }
+
+  bool tagged(uint64_t tag, Value &out) {
+    if (tag == numberTextTag) {
+      out.type = Value::Type::Number;
+      return text(out.text);
+    }
+    if (tag != bigIntegerStringTag)
+      return fail("Unsupported tag");
+
+    uint8_t major;
+    uint64_t length;
+    const uint8_t *data;
+    if (!head(major, length))
+      return false;
+    if (major != Bytes)
+      return fail("Expected a byte string");
+    if (!span(length, data))
+      return false;
+    out.type = Value::Type::String;
+    out.text = bytesToDecimal(data, length);
+    return true;
+  }
+};
+
+} // namespace
+
+void encode(const Value &value, std::vector<uint8_t> &out) {
+  switch (value.type) {
+  case Value::Type::Null:
+    out.push_back(uint8_t(Simple << 5) | Null);
+    break;
+  case Value::Type::Bool:
+    out.push_back(uint8_t(Simple << 5) | (value.boolean ? True : False));
+    break;
+  case Value::Type::Number:
+    encodeNumber(value.text, out);
+    break;
+  case Value::Type::String:
+    if (value.text.size() >= bigIntegerDigits && isDigits(value.text, 0)) {
+      auto bytes = decimalToBytes(value.text);
+      writeHead(out, Tag, bigIntegerStringTag);
+      writeHead(out, Bytes, bytes.size());
+      out.insert(out.end(), bytes.begin(), bytes.end());
+    } else {
+      writeText(out, value.text);
+    }
+    break;
+  case Value::Type::Array:
+    writeHead(out, Array, value.items.size());
+    for (auto &item : value.items)
+      encode(item, out);
+    break;
+  case Value::Type::Object:
+    writeHead(out, Map, value.members.size());
+    for (auto &[key, member] : value.members) {
+      writeText(out, key);
+      encode(member, out);
+    }
+    break;
+  }
+}
+
+bool decode(const uint8_t *data, size_t len, Value &out, std::string *error) {
+  Decoder decoder{data, data + len, {}};
+  out = Value();
+
+  bool ok = decoder.value(out, 0);
+  if (ok && decoder.cur != decoder.end)
+    ok = decoder.fail("Unexpected trailing bytes");
+
+  if (!ok && error != nullptr)
+    *error = decoder.error;
+  return ok;
+}
+
+} // namespace anoncredsCbor
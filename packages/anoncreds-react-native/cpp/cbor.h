@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "json.h"
+
+// Compact binary form of anoncreds JSON, for storage.
+//
+// Documents are encoded as CBOR (RFC 8949) with definite lengths, in the
+// order of the JSON members, so decoding and serializing with
+// `anoncredsJson::serialize` gives back the JSON that was encoded:
+//
+// - integers that fit in 64 bits are CBOR integers, other numbers are kept as
+//   their literal text under tag `numberTextTag`
+// - strings of at least `bigIntegerDigits` decimal digits without a leading
+//   zero, which is how anoncreds writes its big integers, are encoded as the
+//   big-endian bytes of their value under tag `bigIntegerStringTag`
+// - everything else maps to the CBOR type of the same name
+namespace anoncredsCbor {
+
+static const uint64_t bigIntegerStringTag = 0x4143;
+static const uint64_t numberTextTag = 0x4144;
+static const size_t bigIntegerDigits = 20;
+
+// Appends the CBOR encoding of `value` to `out`
+void encode(const anoncredsJson::Value &value, std::vector<uint8_t> &out);
+
+// Decodes `len` bytes of CBOR into `out`. Returns false and fills `error`
+// (when supplied) if the input is not a single document of this encoding.
+bool decode(const uint8_t *data, size_t len, anoncredsJson::Value &out,
+            std::string *error = nullptr);
+
+} // namespace anoncredsCbor
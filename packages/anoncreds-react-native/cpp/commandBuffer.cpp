@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+#include "commandBuffer.h"
+#include "generatedBindings.h"
+#include "handleRegistry.h"
+#include "library.h"
+
+namespace anoncredsCommandBuffer {
+
+using anoncredsTurboModuleUtility::errorInfix;
+using anoncredsTurboModuleUtility::errorPrefix;
+
+namespace {
+
+const anoncredsBinding::BindingEntry *findBinding(std::string_view name) {
+  static const auto bindings = [] {
+    std::unordered_map<std::string_view, const anoncredsBinding::BindingEntry *>
+        bindings;
+    for (auto &binding : anoncreds::generatedBindings)
+      bindings.emplace(binding.name, &binding);
+    return bindings;
+  }();
+
+  auto binding = bindings.find(name);
+  return binding == bindings.end() ? nullptr : binding->second;
+}
+
+std::optional<jsi::Array> asArray(jsi::Runtime &rt, const jsi::Value &value) {
+  if (!value.isObject() || !value.getObject(rt).isArray(rt))
+    return std::nullopt;
+  return value.getObject(rt).getArray(rt);
+}
+
+} // namespace
+
+std::unique_ptr<Buffer> prepare(jsi::Runtime &rt, const jsi::Value &commands,
+                                const jsi::Value &outputs) {
+  auto array = asArray(rt, commands);
+  if (!array)
+    throw jsi::JSError(rt, errorPrefix + "commands" + errorInfix +
+                               "Array<[string, unknown]>");
+
+  auto buffer = std::make_unique<Buffer>();
+  auto length = array->length(rt);
+  for (size_t slot = 0; slot < length; slot++) {
+    auto command = asArray(rt, array->getValueAtIndex(rt, slot));
+    auto name = command ? command->getValueAtIndex(rt, 0) : jsi::Value();
+    if (!name.isString())
+      throw jsi::JSError(rt, errorPrefix + "commands" + errorInfix +
+                                 "Array<[string, unknown]>");
+
+    auto binding = findBinding(name.getString(rt).utf8(rt));
+    if (binding == nullptr || binding->prepare == nullptr)
+      throw jsi::JSError(rt, "Binding `" + name.getString(rt).utf8(rt) +
+                                 "` cannot be used in a command buffer");
+
+    auto first = buffer->references.all().size();
+    {
+      anoncredsBinding::References::Scope scope(buffer->references, slot);
+      buffer->commands.push_back(
+          binding->prepare(rt, command->getValueAtIndex(rt, 1)));
+    }
+    buffer->names.push_back(binding->name);
+
+    for (auto i = first; i < buffer->references.all().size(); i++) {
+      auto &reference = buffer->references.all()[i];
+      if (!buffer->commands[reference.slot]->handle(reference.output))
+        throw jsi::JSError(
+            rt, "Command " + std::to_string(reference.slot) +
+                    " does not return a handle" +
+                    (reference.output.empty()
+                         ? ""
+                         : " named `" + reference.output + "`"));
+    }
+  }
+
+  if (outputs.isUndefined() || outputs.isNull()) {
+    if (length > 0)
+      buffer->outputs.push_back(length - 1);
+    return buffer;
+  }
+
+  auto slots = asArray(rt, outputs);
+  if (!slots)
+    throw jsi::JSError(rt,
+                       errorPrefix + "outputs" + errorInfix + "Array<number>");
+  for (size_t i = 0; i < slots->length(rt); i++) {
+    auto slot = slots->getValueAtIndex(rt, i);
+    // Every result is handed over once
+    if (!slot.isNumber() || slot.getNumber() < 0 ||
+        size_t(slot.getNumber()) >= length ||
+        std::find(buffer->outputs.begin(), buffer->outputs.end(),
+                  size_t(slot.getNumber())) != buffer->outputs.end())
+      throw jsi::JSError(rt, "Value `outputs` does not hold distinct slots of "
+                             "the buffer");
+    buffer->outputs.push_back(size_t(slot.getNumber()));
+  }
+  return buffer;
+}
+
+void run(Buffer &buffer, const std::atomic<bool> *canceled) {
+  anoncredsBinding::Command::Resolve resolve = [&](ObjectHandle handle) {
+    auto reference = buffer.references.find(handle);
+    if (reference == nullptr)
+      return handle;
+    return *buffer.commands[reference->slot]->handle(reference->output);
+  };
+
+  for (size_t slot = 0; slot < buffer.commands.size(); slot++) {
+    if (canceled != nullptr && *canceled) {
+      buffer.canceled = true;
+      return;
+    }
+    auto code = buffer.commands[slot]->run(resolve);
+    if (code == ErrorCode::Success)
+      continue;
+
+    buffer.failed = slot;
+    buffer.code = code;
+    const char *json = nullptr;
+    anoncredsLibrary::anoncreds_get_current_error(&json);
+    if (json != nullptr) {
+      buffer.error = json;
+      anoncredsLibrary::anoncreds_string_free((char *)json);
+    }
+    return;
+  }
+}
+
+jsi::Value result(jsi::Runtime &rt, Buffer &buffer) {
+  if (buffer.failed)
+    return anoncredsTurboModuleUtility::returnError(rt, buffer.code,
+                                                    buffer.error);
+
+  auto value = jsi::Array(rt, buffer.outputs.size());
+  for (size_t i = 0; i < buffer.outputs.size(); i++) {
+    auto slot = buffer.outputs[i];
+    anoncredsHandleRegistry::Site site(buffer.names[slot]);
+    value.setValueAtIndex(rt, i, buffer.commands[slot]->result(rt));
+  }
+
+  return anoncredsTurboModuleUtility::returnValue(rt, ErrorCode::Success,
+                                                  std::move(value));
+}
+
+} // namespace anoncredsCommandBuffer
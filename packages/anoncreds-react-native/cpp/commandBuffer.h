@@ -0,0 +1,57 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "binding.h"
+#include "include/libanoncreds.h"
+
+using namespace facebook;
+
+// Runs a sequence of binding calls in one crossing.
+//
+// A buffer is a list of commands, `[name, arguments]`, where `arguments` is
+// the options object or the positional arguments of the binding. A command
+// can use a handle returned by an earlier command by passing
+// `{ slot, output? }` instead, where `slot` is the index of that command.
+//
+// The buffer is decoded on the JS thread, after which the FFI calls only need
+// the decoded arguments and can run on any thread. Only the results of the
+// commands listed in `outputs` are handed to JS, every other object created
+// by the buffer is freed once it has run.
+namespace anoncredsCommandBuffer {
+
+struct Buffer {
+  std::vector<const char *> names;
+  std::vector<std::unique_ptr<anoncredsBinding::Command>> commands;
+  anoncredsBinding::References references;
+  // Slots of the commands whose results are returned
+  std::vector<size_t> outputs;
+
+  // Set by `run` when a command fails, with the error read right after it
+  std::optional<size_t> failed;
+  ErrorCode code = ErrorCode::Success;
+  std::string error;
+  // Set by `run` when it stopped as the buffer was canceled
+  bool canceled = false;
+};
+
+// Decodes `commands` and `outputs`. Must be called on the JS thread.
+std::unique_ptr<Buffer> prepare(jsi::Runtime &rt, const jsi::Value &commands,
+                                const jsi::Value &outputs);
+
+// Runs the commands in order, stopping at the first one that fails, or before
+// the next one once `canceled` is set. Does not touch the runtime, so it can be
+// called on any thread.
+void run(Buffer &buffer, const std::atomic<bool> *canceled = nullptr);
+
+// The results of the commands in `outputs`, in order, or the error, following
+// the active return convention. Must be called on the JS thread.
+jsi::Value result(jsi::Runtime &rt, Buffer &buffer);
+
+} // namespace anoncredsCommandBuffer
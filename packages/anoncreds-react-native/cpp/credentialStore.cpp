@@ -0,0 +1,443 @@
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include "credentialStore.h"
+#include "library.h"
+#include "objectFile.h"
+
+// File layout, integers are little endian:
+//
+//   "ACCS" version:u8
+//   count:u32 { length:u32 id:bytes tagCount:u32
+//               { length:u32 name:bytes length:u32 value:bytes } }
+namespace anoncredsCredentialStore {
+
+namespace {
+
+const char magic[] = "ACCS";
+const uint8_t version = 1;
+
+using anoncredsObjectFile::append;
+
+// A record may list a tag twice, it is indexed once
+void addSlot(Slots &slots, uint32_t slot) {
+  if (slots.empty() || slots.back() != slot)
+    slots.push_back(slot);
+}
+
+void dropSlot(Slots &slots, uint32_t slot) {
+  auto at = std::lower_bound(slots.begin(), slots.end(), slot);
+  if (at != slots.end() && *at == slot)
+    slots.erase(at);
+}
+
+void dropSlot(std::unordered_map<std::string, Slots> &map,
+              const std::string &key, uint32_t slot) {
+  auto entry = map.find(key);
+  if (entry == map.end())
+    return;
+  dropSlot(entry->second, slot);
+  if (entry->second.empty())
+    map.erase(entry);
+}
+
+const Slots &find(const std::unordered_map<std::string, Slots> &map,
+                  const std::string &key) {
+  static const Slots none;
+  auto entry = map.find(key);
+  return entry == map.end() ? none : entry->second;
+}
+
+std::string key(std::string_view name, std::string_view value) {
+  std::string key(name);
+  key += '\0';
+  key += value;
+  return key;
+}
+
+std::mutex storeMutex;
+Index index;
+
+Slots intersect(const Slots &a, const Slots &b) {
+  Slots out;
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                        std::back_inserter(out));
+  return out;
+}
+
+Slots unite(const Slots &a, const Slots &b) {
+  Slots out;
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                 std::back_inserter(out));
+  return out;
+}
+
+Slots subtract(const Slots &a, const Slots &b) {
+  Slots out;
+  std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                      std::back_inserter(out));
+  return out;
+}
+
+// `attr::<name>::marker` and `attr::<name>::value` with the name normalised
+std::string tagName(const std::string &name) {
+  static const std::string_view prefix = "attr::";
+  if (name.compare(0, prefix.size(), prefix) != 0)
+    return name;
+  auto end = name.rfind("::");
+  if (end < prefix.size())
+    return name;
+  return std::string(prefix) +
+         attributeName(std::string_view(name).substr(
+             prefix.size(), end - prefix.size())) +
+         name.substr(end);
+}
+
+[[noreturn]] void unsupported(const std::string &what) {
+  throw std::invalid_argument("Unsupported restriction: " + what);
+}
+
+const std::string &string(const anoncredsJson::Value &value,
+                          const std::string &name) {
+  if (!value.isString())
+    unsupported("value of `" + name + "` is not a string");
+  return value.text;
+}
+
+Slots evaluate(const Index &index, const anoncredsJson::Value &query);
+
+// Credentials whose tag `name` satisfies `condition`, a value or an operator
+Slots evaluateTag(const Index &index, const std::string &name,
+                  const anoncredsJson::Value &condition) {
+  auto tag = tagName(name);
+  if (!condition.isObject())
+    return find(index.values, key(tag, string(condition, name)));
+  if (condition.members.size() != 1)
+    unsupported("`" + name + "` must have one operator");
+
+  auto &[op, operand] = condition.members.front();
+  if (op == "$eq")
+    return find(index.values, key(tag, string(operand, name)));
+  if (op == "$neq")
+    return subtract(
+        find(index.names, tag),
+        find(index.values, key(tag, string(operand, name))));
+  if (op == "$in") {
+    if (!operand.isArray())
+      unsupported("`$in` of `" + name + "` is not an array");
+    Slots out;
+    for (auto &item : operand.items)
+      out = unite(out, find(index.values,
+                                  key(tag, string(item, name))));
+    return out;
+  }
+  unsupported("operator `" + op + "`");
+}
+
+Slots evaluateMember(const Index &index, const std::string &name,
+                     const anoncredsJson::Value &operand) {
+  if (name == "$and" || name == "$or") {
+    if (!operand.isArray())
+      unsupported("`" + name + "` is not an array");
+    auto isAnd = name == "$and";
+    Slots out = isAnd ? index.all : Slots{};
+    for (auto &item : operand.items)
+      out = isAnd ? intersect(out, evaluate(index, item))
+                  : unite(out, evaluate(index, item));
+    return out;
+  }
+  if (name == "$not")
+    return subtract(index.all, evaluate(index, operand));
+  if (name == "$exist") {
+    if (operand.isString())
+      return find(index.names, tagName(operand.text));
+    if (!operand.isArray())
+      unsupported("`$exist` is not a string or an array");
+    Slots out = index.all;
+    for (auto &item : operand.items)
+      out = intersect(out, find(index.names,
+                                      tagName(string(item, "$exist"))));
+    return out;
+  }
+  if (!name.empty() && name.front() == '$')
+    unsupported("operator `" + name + "`");
+  return evaluateTag(index, name, operand);
+}
+
+Slots evaluate(const Index &index, const anoncredsJson::Value &query) {
+  if (query.isArray()) {
+    Slots out;
+    for (auto &item : query.items)
+      out = unite(out, evaluate(index, item));
+    return out;
+  }
+  if (!query.isObject())
+    unsupported("not an object or an array");
+
+  Slots out = index.all;
+  for (auto &[name, operand] : query.members) {
+    if (out.empty())
+      break;
+    out = intersect(out, evaluateMember(index, name, operand));
+  }
+  return out;
+}
+
+// The parts of a legacy identifier `<did>:<marker>:...`, or none
+std::vector<std::string> legacyParts(const std::string &id,
+                                     const char *marker) {
+  std::vector<std::string> parts;
+  size_t start = 0;
+  for (auto end = id.find(':'); end != std::string::npos;
+       end = id.find(':', start)) {
+    parts.push_back(id.substr(start, end - start));
+    start = end + 1;
+  }
+  parts.push_back(id.substr(start));
+  if (parts.size() < 2 || parts[1] != marker || id.rfind("did:", 0) == 0)
+    return {};
+  return parts;
+}
+
+// Replaces tags of the same name, so every name has one value
+void merge(Tags &tags, const Tags &extra) {
+  for (auto &[name, value] : extra) {
+    auto tag = tagName(name);
+    auto existing =
+        std::find_if(tags.begin(), tags.end(),
+                     [&](const auto &entry) { return entry.first == tag; });
+    if (existing != tags.end())
+      existing->second = value;
+    else
+      tags.emplace_back(tag, value);
+  }
+}
+
+std::string readString(anoncredsObjectFile::Reader &reader) {
+  auto length = reader.read<uint32_t>();
+  return std::string((const char *)reader.take(length), length);
+}
+
+void appendString(std::string &out, const std::string &value) {
+  append<uint32_t>(out, value.size());
+  out += value;
+}
+
+} // namespace
+
+std::string attributeName(std::string_view name) {
+  std::string out;
+  for (auto c : name)
+    if (c != ' ')
+      out += char(std::tolower((unsigned char)c));
+  return out;
+}
+
+ErrorCode credentialAttribute(ObjectHandle credential, const char *name,
+                              std::optional<std::string> &out) {
+  const char *value = nullptr;
+  auto code = anoncredsLibrary::anoncreds_credential_get_attribute(
+      credential, name, &value);
+  if (code == ErrorCode::Success && value != nullptr) {
+    out = value;
+    anoncredsLibrary::anoncreds_string_free((char *)value);
+  }
+  return code;
+}
+
+ErrorCode readTags(ObjectHandle credential, Tags &tags) {
+  std::optional<std::string> schemaId, credentialDefinitionId,
+      revocationRegistryId;
+  auto code = credentialAttribute(credential, "schema_id", schemaId);
+  if (code == ErrorCode::Success)
+    code = credentialAttribute(credential, "cred_def_id",
+                               credentialDefinitionId);
+  if (code == ErrorCode::Success)
+    code = credentialAttribute(credential, "rev_reg_id", revocationRegistryId);
+  if (code != ErrorCode::Success)
+    return code;
+
+  if (schemaId) {
+    tags.emplace_back("schema_id", *schemaId);
+    // `<did>:2:<name>:<version>`
+    if (auto parts = legacyParts(*schemaId, "2"); parts.size() == 4) {
+      tags.emplace_back("schema_issuer_id", parts[0]);
+      tags.emplace_back("schema_issuer_did", parts[0]);
+      tags.emplace_back("schema_name", parts[2]);
+      tags.emplace_back("schema_version", parts[3]);
+    }
+  }
+  if (credentialDefinitionId) {
+    tags.emplace_back("cred_def_id", *credentialDefinitionId);
+    // `<did>:3:CL:<schema>:<tag>`
+    if (auto parts = legacyParts(*credentialDefinitionId, "3");
+        !parts.empty()) {
+      tags.emplace_back("issuer_id", parts[0]);
+      tags.emplace_back("issuer_did", parts[0]);
+    }
+  }
+  if (revocationRegistryId)
+    tags.emplace_back("rev_reg_id", *revocationRegistryId);
+
+  // Raw values, from `values.<name>.raw` of the credential JSON
+  ByteBuffer json{};
+  code = anoncredsLibrary::anoncreds_object_get_json(credential, &json);
+  if (code != ErrorCode::Success)
+    return code;
+  anoncredsJson::Value document;
+  auto parsed = anoncredsJson::parse((const char *)json.data,
+                                     size_t(json.len), document);
+  anoncredsLibrary::anoncreds_buffer_free(json);
+  if (!parsed)
+    return ErrorCode::Unexpected;
+
+  if (auto values = document.get("values"); values && values->isObject())
+    for (auto &[name, value] : values->members)
+      if (auto raw = value.get("raw"); raw && raw->isString()) {
+        auto attribute = "attr::" + attributeName(name);
+        tags.emplace_back(attribute + "::marker", "1");
+        tags.emplace_back(attribute + "::value", raw->text);
+      }
+  return ErrorCode::Success;
+}
+
+void Index::insert(Record record) {
+  auto slot = uint32_t(records.size());
+  for (auto &[name, value] : record.tags) {
+    addSlot(names[name], slot);
+    addSlot(values[key(name, value)], slot);
+  }
+  slots.insert_or_assign(record.id, slot);
+  all.push_back(slot);
+  records.push_back(std::move(record));
+}
+
+bool Index::erase(const std::string &id) {
+  auto slot = slots.find(id);
+  if (slot == slots.end())
+    return false;
+
+  auto &record = *records[slot->second];
+  for (auto &[name, value] : record.tags) {
+    dropSlot(names, name, slot->second);
+    dropSlot(values, key(name, value), slot->second);
+  }
+  dropSlot(all, slot->second);
+  records[slot->second].reset();
+  slots.erase(slot);
+  return true;
+}
+
+Slots Index::match(const anoncredsJson::Value &restrictions,
+                   const std::vector<std::string> &attributes) const {
+  auto unrestricted = restrictions.isNull() ||
+                      (restrictions.isArray() && restrictions.items.empty());
+  auto out = unrestricted ? all : evaluate(*this, restrictions);
+  for (auto &attribute : attributes)
+    out = intersect(
+        out, find(names, "attr::" + attributeName(attribute) + "::marker"));
+  return out;
+}
+
+const std::string *Index::tag(uint32_t slot, std::string_view name) const {
+  if (slot >= records.size() || !records[slot])
+    return nullptr;
+  for (auto &[tagName, value] : records[slot]->tags)
+    if (tagName == name)
+      return &value;
+  return nullptr;
+}
+
+ErrorCode add(const std::string &id, ObjectHandle credential,
+              const Tags &tags) {
+  Index::Record record{.id = id, .tags = {}};
+  auto code = readTags(credential, record.tags);
+  if (code != ErrorCode::Success)
+    return code;
+  merge(record.tags, tags);
+
+  std::lock_guard<std::mutex> lock(storeMutex);
+  index.erase(id);
+  index.insert(std::move(record));
+  return ErrorCode::Success;
+}
+
+bool remove(const std::string &id) {
+  std::lock_guard<std::mutex> lock(storeMutex);
+  return index.erase(id);
+}
+
+size_t size() {
+  std::lock_guard<std::mutex> lock(storeMutex);
+  return index.slots.size();
+}
+
+void clear() {
+  std::lock_guard<std::mutex> lock(storeMutex);
+  index = Index();
+}
+
+std::vector<std::string> query(const anoncredsJson::Value &restrictions,
+                               const std::vector<std::string> &attributes) {
+  std::lock_guard<std::mutex> lock(storeMutex);
+  auto slots = index.match(restrictions, attributes);
+
+  std::vector<std::string> ids;
+  ids.reserve(slots.size());
+  for (auto slot : slots)
+    ids.push_back(index.records[slot]->id);
+  return ids;
+}
+
+void save(const std::string &path) {
+  std::string out(magic, 4);
+  append<uint8_t>(out, version);
+  {
+    std::lock_guard<std::mutex> lock(storeMutex);
+    append<uint32_t>(out, index.all.size());
+    for (auto slot : index.all) {
+      auto &record = *index.records[slot];
+      appendString(out, record.id);
+      append<uint32_t>(out, record.tags.size());
+      for (auto &[name, value] : record.tags) {
+        appendString(out, name);
+        appendString(out, value);
+      }
+    }
+  }
+  anoncredsObjectFile::writeFile(path,
+                                 {{(const uint8_t *)out.data(), out.size()}});
+}
+
+void load(const std::string &path) {
+  anoncredsObjectFile::MappedFile file(path);
+  anoncredsObjectFile::Reader reader(file, path, "credential store");
+  if (std::memcmp(reader.take(4), magic, 4) != 0 ||
+      reader.read<uint8_t>() != version)
+    reader.invalid();
+
+  Index loaded;
+  for (auto count = reader.read<uint32_t>(); count > 0; count--) {
+    Index::Record record{.id = readString(reader), .tags = {}};
+    for (auto tags = reader.read<uint32_t>(); tags > 0; tags--) {
+      auto name = readString(reader);
+      record.tags.emplace_back(std::move(name), readString(reader));
+    }
+    loaded.erase(record.id);
+    loaded.insert(std::move(record));
+  }
+  if (!reader.atEnd())
+    reader.invalid();
+
+  std::lock_guard<std::mutex> lock(storeMutex);
+  index = std::move(loaded);
+}
+
+} // namespace anoncredsCredentialStore
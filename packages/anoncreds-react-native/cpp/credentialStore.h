@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "include/libanoncreds.h"
+#include "json.h"
+
+// An index of the credentials of a wallet, to find the credentials that can
+// answer a presentation request without reading every credential from JS.
+//
+// Credentials are added under an id chosen by the wallet, usually the id of
+// its record, and indexed by the tags a presentation request can restrict:
+// `schema_id`, `cred_def_id`, `rev_reg_id`, `issuer_id` / `issuer_did`,
+// `schema_issuer_id` / `schema_issuer_did`, `schema_name`, `schema_version`,
+// `attr::<name>::marker` and `attr::<name>::value`. The issuer and schema tags
+// are read from legacy identifiers, and can be given for other identifiers.
+// Attribute names are compared without spaces and case, as anoncreds does.
+//
+// The store only holds tags, not the credentials, and lives until it is
+// cleared. Failing to open, map or write a file, or a file that is not a
+// credential store, throws `std::runtime_error`.
+namespace anoncredsCredentialStore {
+
+using Tags = std::vector<std::pair<std::string, std::string>>;
+
+// Positions of credentials in `Index::records`, kept sorted
+using Slots = std::vector<uint32_t>;
+
+// Credentials by their tags. Slots are handed out in increasing order and not
+// reused, so every list of slots stays sorted by appending to it.
+struct Index {
+  struct Record {
+    std::string id;
+    Tags tags;
+  };
+
+  std::vector<std::optional<Record>> records;
+  std::unordered_map<std::string, uint32_t> slots;
+  // Credentials by tag name, and by tag name and value
+  std::unordered_map<std::string, Slots> names;
+  std::unordered_map<std::string, Slots> values;
+  Slots all;
+
+  // Adds `record` at the next slot. Its id must not be indexed.
+  void insert(Record record);
+
+  // Removes the credential `id`, returns whether it was indexed
+  bool erase(const std::string &id);
+
+  // Slots of the credentials that match `restrictions` and have every
+  // attribute of `attributes`, see `query`
+  Slots match(const anoncredsJson::Value &restrictions,
+              const std::vector<std::string> &attributes) const;
+
+  // The value of the tag `name` of the credential at `slot`, or nullptr
+  const std::string *tag(uint32_t slot, std::string_view name) const;
+};
+
+// Attribute names as anoncreds compares them, without spaces and lower case
+std::string attributeName(std::string_view name);
+
+// Reads the attribute `name` of `credential` into `out`, left empty when it is
+// not set
+ErrorCode credentialAttribute(ObjectHandle credential, const char *name,
+                              std::optional<std::string> &out);
+
+// Reads the tags of `credential`
+ErrorCode readTags(ObjectHandle credential, Tags &tags);
+
+// Indexes `credential` as `id`, replacing an earlier credential with that id.
+// `tags` are added to, or replace, the tags read from the credential.
+ErrorCode add(const std::string &id, ObjectHandle credential,
+              const Tags &tags);
+
+// Removes the credential `id`, returns whether it was indexed
+bool remove(const std::string &id);
+
+// Number of indexed credentials
+size_t size();
+
+// Removes every credential
+void clear();
+
+// Ids of the credentials that match `restrictions`, and have every attribute
+// of `attributes`, in the order they were added.
+//
+// `restrictions` is the `restrictions` of a requested attribute or predicate:
+// an object of tags and values that must all match, or an array of such
+// objects of which one must match. The operators `$and`, `$or`, `$not`,
+// `$exist`, `$eq`, `$neq` and `$in` are supported. `null` and an empty array
+// match every credential. Throws `std::invalid_argument` for other queries.
+std::vector<std::string> query(const anoncredsJson::Value &restrictions,
+                               const std::vector<std::string> &attributes);
+
+// Writes the index to `path`
+void save(const std::string &path);
+
+// Replaces the index with the one saved at `path`, read through a memory map
+void load(const std::string &path);
+
+} // namespace anoncredsCredentialStore
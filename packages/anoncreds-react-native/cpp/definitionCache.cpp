@@ -0,0 +1,101 @@
+#include <functional>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "definitionCache.h"
+#include "library.h"
+
+namespace anoncredsDefinitionCache {
+
+Object::~Object() { anoncredsLibrary::anoncreds_object_free(handle); }
+
+namespace {
+
+using Key = std::pair<Kind, std::string>;
+
+struct Entry {
+  Key key;
+  Pin object;
+  // Hash of the JSON the object was parsed from
+  size_t json;
+};
+
+std::mutex cacheMutex;
+// Most recently used first
+std::list<Entry> recent;
+std::map<Key, std::list<Entry>::iterator> entries;
+
+ErrorCode parse(Kind kind, const std::string &json, ObjectHandle *handle) {
+  auto buffer = ByteBuffer{.len = int64_t(json.size()),
+                           .data = (uint8_t *)json.data()};
+  switch (kind) {
+  case Kind::Schema:
+    return anoncredsLibrary::anoncreds_schema_from_json(buffer, handle);
+  case Kind::CredentialDefinition:
+    return anoncredsLibrary::anoncreds_credential_definition_from_json(buffer,
+                                                                       handle);
+  case Kind::RevocationRegistryDefinition:
+    return anoncredsLibrary::anoncreds_revocation_registry_definition_from_json(
+        buffer, handle);
+  }
+  return ErrorCode::Unexpected;
+}
+
+} // namespace
+
+ErrorCode resolve(Kind kind, const std::string &id, const std::string &json,
+                  Pin *object) {
+  auto hash = std::hash<std::string>{}(json);
+
+  // Objects dropped by the cache are released after the lock, they are freed
+  // right away unless a call pins them
+  std::vector<Pin> dropped;
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  auto key = std::make_pair(kind, id);
+  auto entry = entries.find(key);
+  if (entry != entries.end()) {
+    recent.splice(recent.begin(), recent, entry->second);
+    if (entry->second->json == hash) {
+      *object = entry->second->object;
+      return ErrorCode::Success;
+    }
+  }
+
+  ObjectHandle handle = 0;
+  auto code = parse(kind, json, &handle);
+  if (code != ErrorCode::Success)
+    return code;
+  *object = std::make_shared<const Object>(handle);
+
+  if (entry != entries.end()) {
+    dropped.push_back(std::exchange(entry->second->object, *object));
+    entry->second->json = hash;
+    return ErrorCode::Success;
+  }
+
+  recent.push_front(Entry{.key = key, .object = *object, .json = hash});
+  entries.emplace(std::move(key), recent.begin());
+  while (recent.size() > capacity) {
+    dropped.push_back(std::move(recent.back().object));
+    entries.erase(recent.back().key);
+    recent.pop_back();
+  }
+  return ErrorCode::Success;
+}
+
+size_t size() {
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  return entries.size();
+}
+
+void clear() {
+  std::list<Entry> dropped;
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  entries.clear();
+  dropped.swap(recent);
+}
+
+} // namespace anoncredsDefinitionCache
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "include/libanoncreds.h"
+
+// Objects parsed from JSON by the fused bindings, keyed by their ledger id.
+//
+// Schemas and definitions do not change once they are published, so the
+// handle parsed for an id is reused by later calls. An entry is parsed again
+// when the same id comes with different JSON. The cached objects are owned by
+// the cache and never reach JS.
+//
+// The cache holds up to `capacity` objects and evicts the least recently used
+// one beyond that. A call pins the objects it resolved, so one that is evicted,
+// parsed again or cleared while in use is only freed once the call is done.
+namespace anoncredsDefinitionCache {
+
+constexpr size_t capacity = 256;
+
+enum class Kind {
+  Schema,
+  CredentialDefinition,
+  RevocationRegistryDefinition,
+};
+
+// A cached object, freed when neither the cache nor a call holds it anymore
+struct Object {
+  ObjectHandle handle;
+
+  explicit Object(ObjectHandle handle) : handle(handle) {}
+  ~Object();
+
+  Object(const Object &) = delete;
+  Object &operator=(const Object &) = delete;
+};
+
+using Pin = std::shared_ptr<const Object>;
+
+// Sets `object` to the object `id` of `kind`, parsing `json` on first use
+ErrorCode resolve(Kind kind, const std::string &id, const std::string &json,
+                  Pin *object);
+
+// Number of cached objects
+size_t size();
+
+// Drops every cached object, the ones still pinned are freed once released
+void clear();
+
+} // namespace anoncredsDefinitionCache
@@ -0,0 +1,348 @@
+// Generated by tools/codegen/generate-bindings.js from include/libanoncreds.h
+// and tools/codegen/bindings.json. Do not edit by hand.
+
+#pragma once
+
+#include "binding.h"
+#include "include/libanoncreds.h"
+#include "library.h"
+
+namespace anoncreds {
+
+using namespace anoncredsBinding;
+
+using setDefaultLogger = Binding<anoncredsLibrary::anoncreds_set_default_logger>;
+
+using getJson = Binding<anoncredsLibrary::anoncreds_object_get_json,
+                        Handle<"objectHandle">,
+                        Out<ByteBuffer>>;
+
+using getTypeName = Binding<anoncredsLibrary::anoncreds_object_get_type_name,
+                            Handle<"objectHandle">,
+                            Out<const char *>>;
+
+using createLinkSecret = Binding<anoncredsLibrary::anoncreds_create_link_secret,
+                                 Out<const char *>>;
+
+using generateNonce = Binding<anoncredsLibrary::anoncreds_generate_nonce,
+                              Out<const char *>>;
+
+using createSchema = Binding<anoncredsLibrary::anoncreds_create_schema,
+                             Str<"name">,
+                             Str<"version">,
+                             Str<"issuerId">,
+                             StrList<"attributeNames">,
+                             Out<ObjectHandle>>;
+
+using createCredentialDefinition = Binding<anoncredsLibrary::anoncreds_create_credential_definition,
+                                           Str<"schemaId">,
+                                           Handle<"schema">,
+                                           Str<"tag">,
+                                           Str<"issuerId">,
+                                           Str<"signatureType">,
+                                           I8<"supportRevocation">,
+                                           Out<ObjectHandle, "credentialDefinition">,
+                                           Out<ObjectHandle, "credentialDefinitionPrivate">,
+                                           Out<ObjectHandle, "keyCorrectnessProof">>;
+
+using revocationRegistryDefinitionFromJson = Binding<anoncredsLibrary::anoncreds_revocation_registry_definition_from_json,
+                                                     Json<"json">,
+                                                     Out<ObjectHandle>>;
+
+using revocationRegistryFromJson = Binding<anoncredsLibrary::anoncreds_revocation_registry_from_json,
+                                           Json<"json">,
+                                           Out<ObjectHandle>>;
+
+using revocationStatusListFromJson = Binding<anoncredsLibrary::anoncreds_revocation_status_list_from_json,
+                                             Json<"json">,
+                                             Out<ObjectHandle>>;
+
+using presentationFromJson = Binding<anoncredsLibrary::anoncreds_presentation_from_json,
+                                     Json<"json">,
+                                     Out<ObjectHandle>>;
+
+using presentationRequestFromJson = Binding<anoncredsLibrary::anoncreds_presentation_request_from_json,
+                                            Json<"json">,
+                                            Out<ObjectHandle>>;
+
+using credentialOfferFromJson = Binding<anoncredsLibrary::anoncreds_credential_offer_from_json,
+                                        Json<"json">,
+                                        Out<ObjectHandle>>;
+
+using schemaFromJson = Binding<anoncredsLibrary::anoncreds_schema_from_json,
+                               Json<"json">,
+                               Out<ObjectHandle>>;
+
+using credentialRequestFromJson = Binding<anoncredsLibrary::anoncreds_credential_request_from_json,
+                                          Json<"json">,
+                                          Out<ObjectHandle>>;
+
+using credentialRequestMetadataFromJson = Binding<anoncredsLibrary::anoncreds_credential_request_metadata_from_json,
+                                                  Json<"json">,
+                                                  Out<ObjectHandle>>;
+
+using credentialFromJson = Binding<anoncredsLibrary::anoncreds_credential_from_json,
+                                   Json<"json">,
+                                   Out<ObjectHandle>>;
+
+using revocationRegistryDefinitionPrivateFromJson = Binding<anoncredsLibrary::anoncreds_revocation_registry_definition_private_from_json,
+                                                            Json<"json">,
+                                                            Out<ObjectHandle>>;
+
+using revocationStateFromJson = Binding<anoncredsLibrary::anoncreds_revocation_state_from_json,
+                                        Json<"json">,
+                                        Out<ObjectHandle>>;
+
+using credentialDefinitionFromJson = Binding<anoncredsLibrary::anoncreds_credential_definition_from_json,
+                                             Json<"json">,
+                                             Out<ObjectHandle>>;
+
+using credentialDefinitionPrivateFromJson = Binding<anoncredsLibrary::anoncreds_credential_definition_private_from_json,
+                                                    Json<"json">,
+                                                    Out<ObjectHandle>>;
+
+using keyCorrectnessProofFromJson = Binding<anoncredsLibrary::anoncreds_key_correctness_proof_from_json,
+                                            Json<"json">,
+                                            Out<ObjectHandle>>;
+
+using w3cCredentialFromJson = Binding<anoncredsLibrary::anoncreds_w3c_credential_from_json,
+                                      Json<"json">,
+                                      Out<ObjectHandle>>;
+
+using w3cPresentationFromJson = Binding<anoncredsLibrary::anoncreds_w3c_presentation_from_json,
+                                        Json<"json">,
+                                        Out<ObjectHandle>>;
+
+using createPresentation = Binding<anoncredsLibrary::anoncreds_create_presentation,
+                                   Handle<"presentationRequest">,
+                                   CredentialEntryList<"credentials">,
+                                   CredentialProveList<"credentialsProve">,
+                                   StrList<"selfAttestNames">,
+                                   StrList<"selfAttestValues">,
+                                   Str<"linkSecret">,
+                                   HandleList<"schemas">,
+                                   StrList<"schemaIds">,
+                                   HandleList<"credentialDefinitions">,
+                                   StrList<"credentialDefinitionIds">,
+                                   Out<ObjectHandle>>;
+
+using verifyPresentation = Binding<anoncredsLibrary::anoncreds_verify_presentation,
+                                   Handle<"presentation">,
+                                   Handle<"presentationRequest">,
+                                   HandleList<"schemas">,
+                                   StrList<"schemaIds">,
+                                   HandleList<"credentialDefinitions">,
+                                   StrList<"credentialDefinitionIds">,
+                                   HandleList<"revocationRegistryDefinitions", true>,
+                                   StrList<"revocationRegistryDefinitionIds", true>,
+                                   HandleList<"revocationStatusLists", true>,
+                                   NonRevokedIntervalOverrideList<"nonRevokedIntervalOverrides", true>,
+                                   Out<int8_t>>;
+
+using createW3cPresentation = Binding<anoncredsLibrary::anoncreds_create_w3c_presentation,
+                                      Handle<"presentationRequest">,
+                                      CredentialEntryList<"credentials">,
+                                      CredentialProveList<"credentialsProve">,
+                                      Str<"linkSecret">,
+                                      HandleList<"schemas">,
+                                      StrList<"schemaIds">,
+                                      HandleList<"credentialDefinitions">,
+                                      StrList<"credentialDefinitionIds">,
+                                      OptionalStr<"w3cVersion">,
+                                      Out<ObjectHandle>>;
+
+using verifyW3cPresentation = Binding<anoncredsLibrary::anoncreds_verify_w3c_presentation,
+                                      Handle<"presentation">,
+                                      Handle<"presentationRequest">,
+                                      HandleList<"schemas">,
+                                      StrList<"schemaIds">,
+                                      HandleList<"credentialDefinitions">,
+                                      StrList<"credentialDefinitionIds">,
+                                      HandleList<"revocationRegistryDefinitions", true>,
+                                      StrList<"revocationRegistryDefinitionIds", true>,
+                                      HandleList<"revocationStatusLists", true>,
+                                      NonRevokedIntervalOverrideList<"nonRevokedIntervalOverrides", true>,
+                                      Out<int8_t>>;
+
+using createCredential = Binding<anoncredsLibrary::anoncreds_create_credential,
+                                 Handle<"credentialDefinition">,
+                                 Handle<"credentialDefinitionPrivate">,
+                                 Handle<"credentialOffer">,
+                                 Handle<"credentialRequest">,
+                                 StrList<"attributeNames">,
+                                 StrList<"attributeRawValues">,
+                                 StrList<"attributeEncodedValues", true>,
+                                 CredRevInfo<"revocationConfiguration">,
+                                 Out<ObjectHandle>>;
+
+using createCredentialOffer = Binding<anoncredsLibrary::anoncreds_create_credential_offer,
+                                      Str<"schemaId">,
+                                      Str<"credentialDefinitionId">,
+                                      Handle<"keyCorrectnessProof">,
+                                      Out<ObjectHandle>>;
+
+using createCredentialRequest = Binding<anoncredsLibrary::anoncreds_create_credential_request,
+                                        OptionalStr<"entropy">,
+                                        OptionalStr<"proverDid">,
+                                        Handle<"credentialDefinition">,
+                                        Str<"linkSecret">,
+                                        Str<"linkSecretId">,
+                                        Handle<"credentialOffer">,
+                                        Out<ObjectHandle, "credentialRequest">,
+                                        Out<ObjectHandle, "credentialRequestMetadata">>;
+
+using credentialGetAttribute = Binding<anoncredsLibrary::anoncreds_credential_get_attribute,
+                                       Handle<"objectHandle">,
+                                       Str<"name">,
+                                       Out<const char *>>;
+
+using encodeCredentialAttributes = Binding<anoncredsLibrary::anoncreds_encode_credential_attributes,
+                                           StrList<"attributeRawValues">,
+                                           Out<const char *>>;
+
+using processCredential = Binding<anoncredsLibrary::anoncreds_process_credential,
+                                  Handle<"credential">,
+                                  Handle<"credentialRequestMetadata">,
+                                  Str<"linkSecret">,
+                                  Handle<"credentialDefinition">,
+                                  Handle<"revocationRegistryDefinition", true>,
+                                  Out<ObjectHandle>>;
+
+using createW3cCredential = Binding<anoncredsLibrary::anoncreds_create_w3c_credential,
+                                    Handle<"credentialDefinition">,
+                                    Handle<"credentialDefinitionPrivate">,
+                                    Handle<"credentialOffer">,
+                                    Handle<"credentialRequest">,
+                                    StrList<"attributeNames">,
+                                    StrList<"attributeRawValues">,
+                                    CredRevInfo<"revocationConfiguration">,
+                                    OptionalStr<"w3cVersion">,
+                                    Out<ObjectHandle>>;
+
+using w3cCredentialGetIntegrityProofDetails = Binding<anoncredsLibrary::anoncreds_w3c_credential_get_integrity_proof_details,
+                                                      Handle<"objectHandle">,
+                                                      Out<ObjectHandle>>;
+
+using w3cCredentialProofGetAttribute = Binding<anoncredsLibrary::anoncreds_w3c_credential_proof_get_attribute,
+                                               Handle<"objectHandle">,
+                                               Str<"name">,
+                                               Out<const char *>>;
+
+using processW3cCredential = Binding<anoncredsLibrary::anoncreds_process_w3c_credential,
+                                     Handle<"credential">,
+                                     Handle<"credentialRequestMetadata">,
+                                     Str<"linkSecret">,
+                                     Handle<"credentialDefinition">,
+                                     Handle<"revocationRegistryDefinition", true>,
+                                     Out<ObjectHandle>>;
+
+using credentialToW3c = Binding<anoncredsLibrary::anoncreds_credential_to_w3c,
+                                Handle<"objectHandle">,
+                                Str<"issuerId">,
+                                OptionalStr<"w3cVersion">,
+                                Out<ObjectHandle>>;
+
+using credentialFromW3c = Binding<anoncredsLibrary::anoncreds_credential_from_w3c,
+                                  Handle<"objectHandle">,
+                                  Out<ObjectHandle>>;
+
+using createOrUpdateRevocationState = Binding<anoncredsLibrary::anoncreds_create_or_update_revocation_state,
+                                              Handle<"revocationRegistryDefinition">,
+                                              Handle<"revocationStatusList">,
+                                              I64<"revocationRegistryIndex">,
+                                              Str<"tailsPath">,
+                                              Handle<"oldRevocationState", true>,
+                                              Handle<"oldRevocationStatusList", true>,
+                                              Out<ObjectHandle>>;
+
+using createRevocationStatusList = Binding<anoncredsLibrary::anoncreds_create_revocation_status_list,
+                                           Handle<"credentialDefinition">,
+                                           Str<"revocationRegistryDefinitionId">,
+                                           Handle<"revocationRegistryDefinition">,
+                                           Handle<"revocationRegistryDefinitionPrivate">,
+                                           Str<"issuerId">,
+                                           I8<"issuanceByDefault">,
+                                           I64<"timestamp", true, -1>,
+                                           Out<ObjectHandle>>;
+
+using updateRevocationStatusList = Binding<anoncredsLibrary::anoncreds_update_revocation_status_list,
+                                           Handle<"credentialDefinition">,
+                                           Handle<"revocationRegistryDefinition">,
+                                           Handle<"revocationRegistryDefinitionPrivate">,
+                                           Handle<"currentRevocationStatusList">,
+                                           I32List<"issued", true>,
+                                           I32List<"revoked", true>,
+                                           I64<"timestamp", true, -1>,
+                                           Out<ObjectHandle>>;
+
+using updateRevocationStatusListTimestampOnly = Binding<anoncredsLibrary::anoncreds_update_revocation_status_list_timestamp_only,
+                                                        I64<"timestamp">,
+                                                        Handle<"currentRevocationStatusList">,
+                                                        Out<ObjectHandle>>;
+
+using createRevocationRegistryDefinition = Binding<anoncredsLibrary::anoncreds_create_revocation_registry_def,
+                                                   Handle<"credentialDefinition">,
+                                                   Str<"credentialDefinitionId">,
+                                                   Str<"issuerId">,
+                                                   Str<"tag">,
+                                                   Str<"revocationRegistryType">,
+                                                   I64<"maximumCredentialNumber">,
+                                                   OptionalStr<"tailsDirectoryPath">,
+                                                   Out<ObjectHandle, "revocationRegistryDefinition">,
+                                                   Out<ObjectHandle, "revocationRegistryDefinitionPrivate">>;
+
+using revocationRegistryDefinitionGetAttribute = Binding<anoncredsLibrary::anoncreds_revocation_registry_definition_get_attribute,
+                                                         Handle<"objectHandle">,
+                                                         Str<"name">,
+                                                         Out<const char *>>;
+
+inline constexpr BindingEntry generatedBindings[] = {
+    entry<"setDefaultLogger", setDefaultLogger>(),
+    entry<"getJson", getJson>(),
+    entry<"getTypeName", getTypeName>(),
+    entry<"createLinkSecret", createLinkSecret>(),
+    entry<"generateNonce", generateNonce>(),
+    entry<"createSchema", createSchema>(),
+    entry<"createCredentialDefinition", createCredentialDefinition>(),
+    entry<"revocationRegistryDefinitionFromJson", revocationRegistryDefinitionFromJson>(),
+    entry<"revocationRegistryFromJson", revocationRegistryFromJson>(),
+    entry<"revocationStatusListFromJson", revocationStatusListFromJson>(),
+    entry<"presentationFromJson", presentationFromJson>(),
+    entry<"presentationRequestFromJson", presentationRequestFromJson>(),
+    entry<"credentialOfferFromJson", credentialOfferFromJson>(),
+    entry<"schemaFromJson", schemaFromJson>(),
+    entry<"credentialRequestFromJson", credentialRequestFromJson>(),
+    entry<"credentialRequestMetadataFromJson", credentialRequestMetadataFromJson>(),
+    entry<"credentialFromJson", credentialFromJson>(),
+    entry<"revocationRegistryDefinitionPrivateFromJson", revocationRegistryDefinitionPrivateFromJson>(),
+    entry<"revocationStateFromJson", revocationStateFromJson>(),
+    entry<"credentialDefinitionFromJson", credentialDefinitionFromJson>(),
+    entry<"credentialDefinitionPrivateFromJson", credentialDefinitionPrivateFromJson>(),
+    entry<"keyCorrectnessProofFromJson", keyCorrectnessProofFromJson>(),
+    entry<"w3cCredentialFromJson", w3cCredentialFromJson>(),
+    entry<"w3cPresentationFromJson", w3cPresentationFromJson>(),
+    entry<"createPresentation", createPresentation>(),
+    entry<"verifyPresentation", verifyPresentation>(),
+    entry<"createW3cPresentation", createW3cPresentation>(),
+    entry<"verifyW3cPresentation", verifyW3cPresentation>(),
+    entry<"createCredential", createCredential>(),
+    entry<"createCredentialOffer", createCredentialOffer>(),
+    entry<"createCredentialRequest", createCredentialRequest>(),
+    entry<"credentialGetAttribute", credentialGetAttribute>(),
+    entry<"encodeCredentialAttributes", encodeCredentialAttributes>(),
+    entry<"processCredential", processCredential>(),
+    entry<"createW3cCredential", createW3cCredential>(),
+    entry<"w3cCredentialGetIntegrityProofDetails", w3cCredentialGetIntegrityProofDetails>(),
+    entry<"w3cCredentialProofGetAttribute", w3cCredentialProofGetAttribute>(),
+    entry<"processW3cCredential", processW3cCredential>(),
+    entry<"credentialToW3c", credentialToW3c>(),
+    entry<"credentialFromW3c", credentialFromW3c>(),
+    entry<"createOrUpdateRevocationState", createOrUpdateRevocationState>(),
+    entry<"createRevocationStatusList", createRevocationStatusList>(),
+    entry<"updateRevocationStatusList", updateRevocationStatusList>(),
+    entry<"updateRevocationStatusListTimestampOnly", updateRevocationStatusListTimestampOnly>(),
+    entry<"createRevocationRegistryDefinition", createRevocationRegistryDefinition>(),
+    entry<"revocationRegistryDefinitionGetAttribute", revocationRegistryDefinitionGetAttribute>(),
+};
+
+} // namespace anoncreds
@@ -0,0 +1,58 @@
+// Generated by tools/codegen/generate-bindings.js from include/libanoncreds.h.
+// Do not edit by hand, included by library.h.
+
+namespace anoncredsLibrary {
+
+ANONCREDS_FUNCTION(anoncreds_buffer_free)
+ANONCREDS_FUNCTION(anoncreds_create_credential)
+ANONCREDS_FUNCTION(anoncreds_create_credential_definition)
+ANONCREDS_FUNCTION(anoncreds_create_credential_offer)
+ANONCREDS_FUNCTION(anoncreds_create_credential_request)
+ANONCREDS_FUNCTION(anoncreds_create_link_secret)
+ANONCREDS_FUNCTION(anoncreds_create_or_update_revocation_state)
+ANONCREDS_FUNCTION(anoncreds_create_presentation)
+ANONCREDS_FUNCTION(anoncreds_create_revocation_registry_def)
+ANONCREDS_FUNCTION(anoncreds_create_revocation_status_list)
+ANONCREDS_FUNCTION(anoncreds_create_schema)
+ANONCREDS_FUNCTION(anoncreds_create_w3c_credential)
+ANONCREDS_FUNCTION(anoncreds_create_w3c_presentation)
+ANONCREDS_FUNCTION(anoncreds_credential_definition_from_json)
+ANONCREDS_FUNCTION(anoncreds_credential_definition_private_from_json)
+ANONCREDS_FUNCTION(anoncreds_credential_from_json)
+ANONCREDS_FUNCTION(anoncreds_credential_from_w3c)
+ANONCREDS_FUNCTION(anoncreds_credential_get_attribute)
+ANONCREDS_FUNCTION(anoncreds_credential_offer_from_json)
+ANONCREDS_FUNCTION(anoncreds_credential_request_from_json)
+ANONCREDS_FUNCTION(anoncreds_credential_request_metadata_from_json)
+ANONCREDS_FUNCTION(anoncreds_credential_to_w3c)
+ANONCREDS_FUNCTION(anoncreds_encode_credential_attributes)
+ANONCREDS_FUNCTION(anoncreds_generate_nonce)
+ANONCREDS_FUNCTION(anoncreds_get_current_error)
+ANONCREDS_FUNCTION(anoncreds_key_correctness_proof_from_json)
+ANONCREDS_FUNCTION(anoncreds_object_free)
+ANONCREDS_FUNCTION(anoncreds_object_get_json)
+ANONCREDS_FUNCTION(anoncreds_object_get_type_name)
+ANONCREDS_FUNCTION(anoncreds_presentation_from_json)
+ANONCREDS_FUNCTION(anoncreds_presentation_request_from_json)
+ANONCREDS_FUNCTION(anoncreds_process_credential)
+ANONCREDS_FUNCTION(anoncreds_process_w3c_credential)
+ANONCREDS_FUNCTION(anoncreds_revocation_registry_definition_from_json)
+ANONCREDS_FUNCTION(anoncreds_revocation_registry_definition_get_attribute)
+ANONCREDS_FUNCTION(anoncreds_revocation_registry_definition_private_from_json)
+ANONCREDS_FUNCTION(anoncreds_revocation_registry_from_json)
+ANONCREDS_FUNCTION(anoncreds_revocation_state_from_json)
+ANONCREDS_FUNCTION(anoncreds_revocation_status_list_from_json)
+ANONCREDS_FUNCTION(anoncreds_schema_from_json)
+ANONCREDS_FUNCTION(anoncreds_set_default_logger)
+ANONCREDS_FUNCTION(anoncreds_string_free)
+ANONCREDS_FUNCTION(anoncreds_update_revocation_status_list)
+ANONCREDS_FUNCTION(anoncreds_update_revocation_status_list_timestamp_only)
+ANONCREDS_FUNCTION(anoncreds_verify_presentation)
+ANONCREDS_FUNCTION(anoncreds_verify_w3c_presentation)
+ANONCREDS_FUNCTION(anoncreds_version)
+ANONCREDS_FUNCTION(anoncreds_w3c_credential_from_json)
+ANONCREDS_FUNCTION(anoncreds_w3c_credential_get_integrity_proof_details)
+ANONCREDS_FUNCTION(anoncreds_w3c_credential_proof_get_attribute)
+ANONCREDS_FUNCTION(anoncreds_w3c_presentation_from_json)
+
+} // namespace anoncredsLibrary
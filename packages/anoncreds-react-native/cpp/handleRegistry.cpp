@@ -0,0 +1,289 @@
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "handleRegistry.h"
+#include "library.h"
+
+namespace anoncredsHandleRegistry {
+
+namespace {
+
+struct Entry {
+  const char *site;
+  int64_t createdAt;
+  // Scope the handle is in, 0 for none, and its index in `Scope::handles`
+  const void *owner;
+  uint64_t scope;
+  size_t index;
+  // Looked up on the first report
+  std::optional<std::string> type;
+  std::optional<uint64_t> bytes;
+};
+
+struct Scope {
+  uint64_t id;
+  std::vector<ObjectHandle> handles;
+};
+
+std::mutex registryMutex;
+std::unordered_map<ObjectHandle, Entry> entries;
+// Per owner, innermost scope last. Ids only grow, so every stack is sorted.
+std::unordered_map<const void *, std::vector<Scope>> scopesByOwner;
+uint64_t nextScopeId = 1;
+
+thread_local const char *currentSite = "unknown";
+thread_local const void *currentOwner = nullptr;
+
+// Scopes of the active owner. Called with `registryMutex` held.
+std::vector<Scope> &ownerScopes() { return scopesByOwner[currentOwner]; }
+
+// Called with `registryMutex` held
+Scope *findScope(const void *owner, uint64_t id) {
+  auto scopes = scopesByOwner.find(owner);
+  if (scopes == scopesByOwner.end())
+    return nullptr;
+  auto scope = std::lower_bound(
+      scopes->second.begin(), scopes->second.end(), id,
+      [](const Scope &scope, uint64_t id) { return scope.id < id; });
+  return scope != scopes->second.end() && scope->id == id ? &*scope : nullptr;
+}
+
+// Called with `registryMutex` held
+void addToScope(const void *owner, Scope &scope, ObjectHandle handle,
+                Entry &entry) {
+  entry.owner = owner;
+  entry.scope = scope.id;
+  entry.index = scope.handles.size();
+  scope.handles.push_back(handle);
+}
+
+// Takes the handle of `entry` out of its scope, by moving the last handle of
+// the scope into its place. Called with `registryMutex` held.
+void removeFromScope(Entry &entry) {
+  if (entry.scope == 0)
+    return;
+  auto scope = findScope(entry.owner, entry.scope);
+  entry.scope = 0;
+  if (scope == nullptr)
+    return;
+
+  auto last = scope->handles.back();
+  scope->handles[entry.index] = last;
+  scope->handles.pop_back();
+  if (entry.index < scope->handles.size())
+    entries.at(last).index = entry.index;
+}
+
+int64_t now() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+struct Description {
+  std::string type;
+  uint64_t bytes;
+};
+
+// Type and size of the object. `anoncreds_object_get_json` serializes the
+// whole object, so this is called without `registryMutex` held.
+Description describe(ObjectHandle handle) {
+  Description description{.type = "unknown", .bytes = 0};
+
+  const char *type = nullptr;
+  auto code = anoncredsLibrary::anoncreds_object_get_type_name(handle, &type);
+  if (code == ErrorCode::Success && type)
+    description.type = type;
+  if (type)
+    anoncredsLibrary::anoncreds_string_free((char *)type);
+
+  ByteBuffer json{};
+  code = anoncredsLibrary::anoncreds_object_get_json(handle, &json);
+  if (code == ErrorCode::Success) {
+    description.bytes = uint64_t(json.len);
+    anoncredsLibrary::anoncreds_buffer_free(json);
+  }
+  return description;
+}
+
+// Copies of the entries `select` accepts, all described. The entries not
+// described yet are copied, described without the lock and then cached.
+template <typename Select>
+std::vector<std::pair<ObjectHandle, Entry>> describedEntries(Select select) {
+  std::vector<std::pair<ObjectHandle, Entry>> selected;
+  {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (auto &[handle, entry] : entries)
+      if (select(entry))
+        selected.emplace_back(handle, entry);
+  }
+
+  std::vector<size_t> described;
+  for (size_t i = 0; i < selected.size(); i++) {
+    auto &[handle, entry] = selected[i];
+    if (entry.type && entry.bytes)
+      continue;
+    auto description = describe(handle);
+    entry.type = std::move(description.type);
+    entry.bytes = description.bytes;
+    described.push_back(i);
+  }
+
+  // Handles freed in the meantime are not cached, but still reported
+  std::lock_guard<std::mutex> lock(registryMutex);
+  for (auto i : described) {
+    auto &[handle, copy] = selected[i];
+    auto entry = entries.find(handle);
+    if (entry == entries.end())
+      continue;
+    entry->second.type = copy.type;
+    entry->second.bytes = copy.bytes;
+  }
+  return selected;
+}
+
+} // namespace
+
+void track(ObjectHandle handle, bool scoped) {
+  if (handle == 0)
+    return;
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+  auto existing = entries.find(handle);
+  if (existing != entries.end()) {
+    removeFromScope(existing->second);
+    entries.erase(existing);
+  }
+  auto &entry = entries
+                    .emplace(handle, Entry{.site = currentSite,
+                                           .createdAt = now(),
+                                           .owner = nullptr,
+                                           .scope = 0,
+                                           .index = 0,
+                                           .type = std::nullopt,
+                                           .bytes = std::nullopt})
+                    .first->second;
+  if (!scoped)
+    return;
+  auto owner = scopesByOwner.find(currentOwner);
+  if (owner != scopesByOwner.end() && !owner->second.empty())
+    addToScope(currentOwner, owner->second.back(), handle, entry);
+}
+
+void untrack(ObjectHandle handle) {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  auto entry = entries.find(handle);
+  if (entry == entries.end())
+    return;
+
+  // A handle freed by hand, possibly by another runtime than the one that
+  // created it, must not be freed again when its scope closes
+  removeFromScope(entry->second);
+  entries.erase(entry);
+}
+
+uint64_t openScope() {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  auto &scopes = ownerScopes();
+  scopes.push_back(Scope{.id = nextScopeId++, .handles = {}});
+  return scopes.back().id;
+}
+
+std::vector<ObjectHandle> closeScope(uint64_t id,
+                                     const std::vector<ObjectHandle> &keep) {
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  auto &scopes = ownerScopes();
+  auto scope = std::find_if(scopes.begin(), scopes.end(),
+                            [id](auto &scope) { return scope.id == id; });
+  if (scope == scopes.end())
+    throw std::invalid_argument("Scope `" + std::to_string(id) +
+                                "` is not open");
+
+  // Scopes left open inside this one were abandoned, e.g. by an exception,
+  // and are closed along with it
+  std::vector<ObjectHandle> closed;
+  for (auto it = scope; it != scopes.end(); ++it)
+    closed.insert(closed.end(), it->handles.begin(), it->handles.end());
+  scopes.erase(scope, scopes.end());
+
+  std::vector<ObjectHandle> released;
+  released.reserve(closed.size());
+  for (auto handle : closed) {
+    auto entry = entries.find(handle);
+    if (entry == entries.end())
+      continue;
+    if (std::find(keep.begin(), keep.end(), handle) != keep.end()) {
+      entry->second.scope = 0;
+      if (!scopes.empty())
+        addToScope(currentOwner, scopes.back(), handle, entry->second);
+      continue;
+    }
+    entries.erase(entry);
+    released.push_back(handle);
+  }
+  return released;
+}
+
+std::vector<TypeStatistics> statistics() {
+  std::map<std::string, TypeStatistics> byType;
+  for (auto &[handle, entry] : describedEntries([](auto &) { return true; })) {
+    auto &statistics = byType[*entry.type];
+    statistics.type = *entry.type;
+    statistics.count += 1;
+    statistics.bytes += *entry.bytes;
+  }
+
+  std::vector<TypeStatistics> result;
+  result.reserve(byType.size());
+  for (auto &[type, statistics] : byType)
+    result.push_back(std::move(statistics));
+  return result;
+}
+
+std::vector<LiveHandle> olderThan(int64_t milliseconds) {
+  auto threshold = now() - milliseconds;
+  std::vector<LiveHandle> result;
+  for (auto &[handle, entry] : describedEntries([threshold](auto &entry) {
+         return entry.createdAt <= threshold;
+       }))
+    result.push_back(LiveHandle{.handle = handle,
+                                .type = *entry.type,
+                                .site = entry.site,
+                                .createdAt = entry.createdAt,
+                                .bytes = *entry.bytes});
+
+  std::sort(result.begin(), result.end(), [](auto &a, auto &b) {
+    return a.createdAt != b.createdAt ? a.createdAt < b.createdAt
+                                      : a.handle < b.handle;
+  });
+  return result;
+}
+
+void releaseOwner(const void *owner) {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  auto scopes = scopesByOwner.find(owner);
+  if (scopes == scopesByOwner.end())
+    return;
+  for (auto &scope : scopes->second)
+    for (auto handle : scope.handles)
+      entries.at(handle).scope = 0;
+  scopesByOwner.erase(scopes);
+}
+
+ScopeOwner::ScopeOwner(const void *owner) : previous(currentOwner) {
+  currentOwner = owner;
+}
+
+ScopeOwner::~ScopeOwner() { currentOwner = previous; }
+
+Site::Site(const char *site) : previous(currentSite) { currentSite = site; }
+
+Site::~Site() { currentSite = previous; }
+
+} // namespace anoncredsHandleRegistry
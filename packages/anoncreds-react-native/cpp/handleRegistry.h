@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "include/libanoncreds.h"
+
+// Registry of the object handles that are alive on the native side.
+//
+// Every handle returned by a binding is recorded with the binding that created
+// it and the time it was created, and removed again when it is freed through
+// `objectFree`. Type names and approximate sizes (the length of the JSON
+// representation) are only looked up when a report is requested, and cached,
+// so recording a handle costs a map insertion.
+//
+// Handles can also be grouped into scopes. While a scope is open, every handle
+// that is recorded is added to the innermost one, and closing the scope hands
+// all of them back to be freed together. Every runtime the module is installed
+// into has its own stack of scopes, selected with `ScopeOwner` for the
+// duration of a call, so a scope opened in one runtime never collects the
+// handles created by another. Handles themselves are process-global and can be
+// passed between runtimes.
+namespace anoncredsHandleRegistry {
+
+struct TypeStatistics {
+  std::string type;
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+};
+
+struct LiveHandle {
+  ObjectHandle handle;
+  std::string type;
+  // Name of the binding that created the handle
+  const char *site;
+  // Unix time in milliseconds
+  int64_t createdAt;
+  uint64_t bytes;
+};
+
+// Records `handle` as created by the binding that is currently called. Handles
+// that are not `scoped` are not added to the open scope.
+void track(ObjectHandle handle, bool scoped = true);
+
+// Removes `handle`, if it was recorded
+void untrack(ObjectHandle handle);
+
+// Live handles and their approximate size in bytes, per type
+std::vector<TypeStatistics> statistics();
+
+// Live handles created at least `milliseconds` ago, oldest first
+std::vector<LiveHandle> olderThan(int64_t milliseconds);
+
+// Opens a scope nested in the current one of the active owner and returns its
+// id
+uint64_t openScope();
+
+// Closes scope `id`, and any scope still open inside it, and removes their
+// handles from the registry so they can be freed by the caller. Handles in
+// `keep` are not returned, they are moved to the enclosing scope, if any.
+// Throws `std::invalid_argument` when `id` is not open for the active owner.
+std::vector<ObjectHandle> closeScope(uint64_t id,
+                                     const std::vector<ObjectHandle> &keep);
+
+// Forgets the scopes still open for `owner`, once the module that used it is
+// destroyed. Their handles stay recorded, and alive, as they may have been
+// passed to another runtime.
+void releaseOwner(const void *owner);
+
+// Makes the scopes of `owner`, one per installed module, the ones used on the
+// current thread for the lifetime of the scope
+class ScopeOwner {
+public:
+  explicit ScopeOwner(const void *owner);
+  ~ScopeOwner();
+
+  ScopeOwner(const ScopeOwner &) = delete;
+  ScopeOwner &operator=(const ScopeOwner &) = delete;
+
+private:
+  const void *previous;
+};
+
+// Makes `site` the creation site of handles recorded on the current thread for
+// the lifetime of the scope. `site` must outlive the program.
+class Site {
+public:
+  explicit Site(const char *site);
+  ~Site();
+
+  Site(const Site &) = delete;
+  Site &operator=(const Site &) = delete;
+
+private:
+  const char *previous;
+};
+
+} // namespace anoncredsHandleRegistry
@@ -0,0 +1,370 @@
+#include <cstdint>
+#include <cstdlib>
+
+#include "json.h"
+
+namespace anoncredsJson {
+
+namespace {
+
+static const int maxDepth = 128;
+
+struct Parser {
+  const char *cur;
+  const char *end;
+  std::string error;
+
+  bool fail(const char *message) {
+    if (error.empty())
+      error = message;
+    return false;
+  }
+
+  void skipWhitespace() {
+    while (cur < end &&
+           (*cur == ' ' || *cur == '\n' || *cur == '\r' || *cur == '\t'))
+      cur++;
+  }
+
+  bool literal(const char *word, size_t len) {
+    if (size_t(end - cur) < len || std::string_view(cur, len) != word)
+      return fail("Invalid literal");
+    cur += len;
+    return true;
+  }
+
+  static void appendUtf8(std::string &out, uint32_t cp) {
+    if (cp < 0x80) {
+      out += char(cp);
+    } else if (cp < 0x800) {
+      out += char(0xC0 | (cp >> 6));
+      out += char(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+      out += char(0xE0 | (cp >> 12));
+      out += char(0x80 | ((cp >> 6) & 0x3F));
+      out += char(0x80 | (cp & 0x3F));
+    } else {
+      out += char(0xF0 | (cp >> 18));
+      out += char(0x80 | ((cp >> 12) & 0x3F));
+      out += char(0x80 | ((cp >> 6) & 0x3F));
+      out += char(0x80 | (cp & 0x3F));
+    }
+  }
+
+  bool hex4(uint32_t &out) {
+    if (end - cur < 4)
+      return fail("Invalid unicode escape");
+    out = 0;
+    for (int i = 0; i < 4; i++) {
+      char c = *cur++;
+      out <<= 4;
+      if (c >= '0' && c <= '9')
+        out |= c - '0';
+      else if (c >= 'a' && c <= 'f')
+        out |= c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F')
+        out |= c - 'A' + 10;
+      else
+        return fail("Invalid unicode escape");
+    }
+    return true;
+  }
+
+  bool string(std::string &out) {
+    // Opening quote has been checked by the caller
+    cur++;
+    const char *chunk = cur;
+    while (cur < end) {
+      char c = *cur;
+      if (c == '"') {
+        out.append(chunk, cur - chunk);
+        cur++;
+        return true;
+      }
+      if (c == '\\') {
+        out.append(chunk, cur - chunk);
+        if (++cur >= end)
+          break;
+        switch (*cur++) {
+        case '"':
+          out += '"';
+          break;
+        case '\\':
+          out += '\\';
+          break;
+        case '/':
+          out += '/';
+          break;
+        case 'b':
+          out += '\b';
+          break;
+        case 'f':
+          out += '\f';
+          break;
+        case 'n':
+          out += '\n';
+          break;
+        case 'r':
+          out += '\r';
+          break;
+        case 't':
+          out += '\t';
+          break;
+        case 'u': {
+          uint32_t cp;
+          if (!hex4(cp))
+            return false;
+          if (cp >= 0xD800 && cp <= 0xDBFF && end - cur >= 6 &&
+              cur[0] == '\\' && cur[1] == 'u') {
+            cur += 2;
+            uint32_t low;
+            if (!hex4(low))
+              return false;
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+          }
+          appendUtf8(out, cp);
+          break;
+        }
+        default:
+          return fail("Invalid escape sequence");
+        }
+        chunk = cur;
+        continue;
+      }
+      if ((unsigned char)c < 0x20)
+        return fail("Control character in string");
+      cur++;
+    }
+    return fail("Unterminated string");
+  }
+
+  bool number(std::string &out) {
+    const char *start = cur;
+    if (cur < end && *cur == '-')
+      cur++;
+    const char *digits = cur;
+    while (cur < end && *cur >= '0' && *cur <= '9')
+      cur++;
+    if (cur == digits)
+      return fail("Invalid number");
+    if (cur < end && *cur == '.') {
+      cur++;
+      const char *fraction = cur;
+      while (cur < end && *cur >= '0' && *cur <= '9')
+        cur++;
+      if (cur == fraction)
+        return fail("Invalid number");
+    }
+    if (cur < end && (*cur == 'e' || *cur == 'E')) {
+      cur++;
+      if (cur < end && (*cur == '+' || *cur == '-'))
+        cur++;
+      const char *exponent = cur;
+      while (cur < end && *cur >= '0' && *cur <= '9')
+        cur++;
+      if (cur == exponent)
+        return fail("Invalid number");
+    }
+    out.assign(start, cur - start);
+    return true;
+  }
+
+  bool value(Value &out, int depth) {
+    if (depth > maxDepth)
+      return fail("Maximum nesting depth exceeded");
+
+    skipWhitespace();
+    if (cur >= end)
+      return fail("Unexpected end of input");
+
+    switch (*cur) {
+    case 'n':
+      out.type = Value::Type::Null;
+      return literal("null", 4);
+    case 't':
+      out.type = Value::Type::Bool;
+      out.boolean = true;
+      return literal("true", 4);
+    case 'f':
+      out.type = Value::Type::Bool;
+      out.boolean = false;
+      return literal("false", 5);
+    case '"':
+      out.type = Value::Type::String;
+      return string(out.text);
+    case '[': {
+      out.type = Value::Type::Array;
+      cur++;
+      skipWhitespace();
+      if (cur < end && *cur == ']') {
+        cur++;
+        return true;
+      }
+      while (true) {
+        out.items.emplace_back();
+        if (!value(out.items.back(), depth + 1))
+          return false;
+        skipWhitespace();
+        if (cur < end && *cur == ',') {
+          cur++;
+          continue;
+        }
+        if (cur < end && *cur == ']') {
+          cur++;
+          return true;
+        }
+        return fail("Expected `,` or `]`");
+      }
+    }
+    case '{': {
+      out.type = Value::Type::Object;
+      cur++;
+      skipWhitespace();
+      if (cur < end && *cur == '}') {
+        cur++;
+        return true;
+      }
+      while (true) {
+        skipWhitespace();
+        if (cur >= end || *cur != '"')
+          return fail("Expected object key");
+        out.members.emplace_back();
+        auto &member = out.members.back();
+        if (!string(member.first))
+          return false;
+        skipWhitespace();
+        if (cur >= end || *cur != ':')
+          return fail("Expected `:`");
+        cur++;
+        if (!value(member.second, depth + 1))
+          return false;
+        skipWhitespace();
+        if (cur < end && *cur == ',') {
+          cur++;
+          continue;
+        }
+        if (cur < end && *cur == '}') {
+          cur++;
+          return true;
+        }
+        return fail("Expected `,` or `}`");
+      }
+    }
+    default:
+      out.type = Value::Type::Number;
+      return number(out.text);
+    }
+  }
+};
+
+void serializeString(const std::string &s, std::string &out) {
+  static const char *hex = "0123456789abcdef";
+  out += '"';
+  for (unsigned char c : s) {
+    switch (c) {
+    case '"':
+      out += "\\\"";
+      break;
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    case '\r':
+      out += "\\r";
+      break;
+    case '\t':
+      out += "\\t";
+      break;
+    case '\b':
+      out += "\\b";
+      break;
+    case '\f':
+      out += "\\f";
+      break;
+    default:
+      if (c < 0x20) {
+        out += "\\u00";
+        out += hex[c >> 4];
+        out += hex[c & 0xF];
+      } else {
+        out += char(c);
+      }
+    }
+  }
+  out += '"';
+}
+
+} // namespace
+
+const Value *Value::get(std::string_view key) const {
+  if (type != Type::Object)
+    return nullptr;
+  for (auto &member : members) {
+    if (member.first == key)
+      return &member.second;
+  }
+  return nullptr;
+}
+
+double Value::asNumber() const {
+  if (type != Type::Number)
+    return 0;
+  return std::strtod(text.c_str(), nullptr);
+}
+
+bool parse(const char *data, size_t len, Value &out, std::string *error) {
+  Parser parser{data, data + len, {}};
+  out = Value();
+
+  bool ok = parser.value(out, 0);
+  if (ok) {
+    parser.skipWhitespace();
+    if (parser.cur != parser.end)
+      ok = parser.fail("Unexpected trailing characters");
+  }
+
+  if (!ok && error != nullptr)
+    *error = parser.error;
+  return ok;
+}
+
+void serialize(const Value &value, std::string &out) {
+  switch (value.type) {
+  case Value::Type::Null:
+    out += "null";
+    break;
+  case Value::Type::Bool:
+    out += value.boolean ? "true" : "false";
+    break;
+  case Value::Type::Number:
+    out += value.text;
+    break;
+  case Value::Type::String:
+    serializeString(value.text, out);
+    break;
+  case Value::Type::Array:
+    out += '[';
+    for (size_t i = 0; i < value.items.size(); i++) {
+      if (i > 0)
+        out += ',';
+      serialize(value.items[i], out);
+    }
+    out += ']';
+    break;
+  case Value::Type::Object:
+    out += '{';
+    for (size_t i = 0; i < value.members.size(); i++) {
+      if (i > 0)
+        out += ',';
+      serializeString(value.members[i].first, out);
+      out += ':';
+      serialize(value.members[i].second, out);
+    }
+    out += '}';
+    break;
+  }
+}
+
+} // namespace anoncredsJson
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Minimal JSON document model used by the native tooling that has to inspect
+// anoncreds JSON without going through a JS runtime.
+//
+// Numbers are kept as their literal text so the big decimal integers used
+// throughout anoncreds objects survive a parse / serialize round trip.
+namespace anoncredsJson {
+
+class Value {
+public:
+  enum class Type { Null, Bool, Number, String, Array, Object };
+
+  Type type = Type::Null;
+  bool boolean = false;
+  // Unescaped string contents, or the literal text of a number
+  std::string text;
+  std::vector<Value> items;
+  std::vector<std::pair<std::string, Value>> members;
+
+  bool isNull() const { return type == Type::Null; }
+  bool isBool() const { return type == Type::Bool; }
+  bool isNumber() const { return type == Type::Number; }
+  bool isString() const { return type == Type::String; }
+  bool isArray() const { return type == Type::Array; }
+  bool isObject() const { return type == Type::Object; }
+
+  // Returns the member with the given key, or nullptr when this is not an
+  // object or the key does not exist
+  const Value *get(std::string_view key) const;
+
+  double asNumber() const;
+};
+
+// Parses `len` bytes of JSON into `out`. Returns false and fills `error` (when
+// supplied) if the input is not a single valid JSON value.
+bool parse(const char *data, size_t len, Value &out,
+           std::string *error = nullptr);
+
+// Appends the compact JSON representation of `value` to `out`
+void serialize(const Value &value, std::string &out);
+
+} // namespace anoncredsJson
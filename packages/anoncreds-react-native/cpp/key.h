@@ -0,0 +1,17 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace anoncredsBinding {
+
+// String literal usable as a template argument
+template <size_t N> struct Key {
+  char value[N];
+
+  constexpr Key(const char (&s)[N]) { std::copy_n(s, N, value); }
+
+  constexpr bool empty() const { return N == 1; }
+};
+
+} // namespace anoncredsBinding
@@ -0,0 +1,72 @@
+#include "library.h"
+
+#ifdef ANONCREDS_LAZY_LOAD
+
+#include <dlfcn.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace anoncredsLibrary {
+
+namespace {
+
+using Publish = void (*)(void *);
+
+std::vector<std::pair<const char *, Publish>> &functions() {
+  static std::vector<std::pair<const char *, Publish>> functions;
+  return functions;
+}
+
+std::mutex loadMutex;
+std::atomic<bool> loaded = false;
+
+} // namespace
+
+void reserve(const char *name, Publish publish) {
+  functions().emplace_back(name, publish);
+}
+
+bool isLoaded() { return loaded.load(std::memory_order_acquire); }
+
+void load() {
+  if (isLoaded())
+    return;
+
+  std::lock_guard<std::mutex> lock(loadMutex);
+  if (isLoaded())
+    return;
+
+  // The handle is never closed, the functions stay in use until the process
+  // exits
+  auto library = dlopen(ANONCREDS_LIBRARY_NAME, RTLD_NOW | RTLD_LOCAL);
+  if (library == nullptr)
+    throw std::runtime_error(std::string("Could not load ") +
+                             ANONCREDS_LIBRARY_NAME + ": " + dlerror());
+
+  // Resolve everything before publishing any pointer, so a library that is
+  // missing a function is rejected as a whole
+  std::vector<void *> symbols;
+  symbols.reserve(functions().size());
+  for (auto &[name, publish] : functions()) {
+    auto symbol = dlsym(library, name);
+    if (symbol == nullptr) {
+      dlclose(library);
+      throw std::runtime_error(std::string(ANONCREDS_LIBRARY_NAME) +
+                               " does not export " + name);
+    }
+    symbols.push_back(symbol);
+  }
+
+  for (size_t i = 0; i < symbols.size(); i++)
+    functions()[i].second(symbols[i]);
+
+  loaded.store(true, std::memory_order_release);
+}
+
+} // namespace anoncredsLibrary
+
+#endif
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <stdexcept>
+
+#include "include/libanoncreds.h"
+#include "key.h"
+
+// Access to the functions of libanoncreds.
+//
+// Native code calls libanoncreds through `anoncredsLibrary::anoncreds_*`
+// rather than the C functions directly. By default these are the C functions
+// and libanoncreds is linked into the module as usual.
+//
+// When built with `ANONCREDS_LAZY_LOAD`, the module is not linked against
+// libanoncreds at all. Every `anoncredsLibrary::anoncreds_*` is a trampoline
+// through a function pointer instead, and `load()` opens the library and
+// resolves all of them on the first binding call. Launches that never use
+// anoncreds then never map or relocate the library.
+namespace anoncredsLibrary {
+
+#ifndef ANONCREDS_LIBRARY_NAME
+#define ANONCREDS_LIBRARY_NAME "libanoncreds.so"
+#endif
+
+#ifdef ANONCREDS_LAZY_LOAD
+
+// Opens libanoncreds and resolves all of its functions, once. Throws
+// `std::runtime_error` when the library or one of the functions can not be
+// found, a later call will try again.
+void load();
+
+// Whether `load()` has succeeded
+bool isLoaded();
+
+// Reserves a function to be resolved by `load()`, which passes its symbol to
+// `publish`. Called during static initialisation, `name` must outlive the
+// program.
+void reserve(const char *name, void (*publish)(void *symbol));
+
+template <typename F, anoncredsBinding::Key name> struct LazyFunction;
+
+template <typename R, typename... A, anoncredsBinding::Key name>
+struct LazyFunction<R(A...), name> {
+  // Published with release by `load()` on one thread and read with acquire on
+  // the others
+  static inline std::atomic<R (*)(A...)> pointer = nullptr;
+
+  static void publish(void *symbol) {
+    pointer.store(reinterpret_cast<R (*)(A...)>(symbol),
+                  std::memory_order_release);
+  }
+
+  static inline const bool reserved = (reserve(name.value, publish), true);
+
+  static R call(A... arguments) {
+    (void)reserved;
+    auto function = pointer.load(std::memory_order_acquire);
+    if (function == nullptr) {
+      load();
+      function = pointer.load(std::memory_order_acquire);
+    }
+    return function(arguments...);
+  }
+};
+
+// `decltype` does not odr-use the C function, so nothing references the symbol
+#define ANONCREDS_FUNCTION(name)                                               \
+  inline constexpr auto name = &LazyFunction<decltype(::name), #name>::call;
+
+#else
+
+inline void load() {}
+
+inline bool isLoaded() { return true; }
+
+#define ANONCREDS_FUNCTION(name) inline constexpr auto name = &::name;
+
+#endif
+
+} // namespace anoncredsLibrary
+
+#include "generatedLibrary.h"
+
+#undef ANONCREDS_FUNCTION
@@ -0,0 +1,349 @@
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "objectBuilder.h"
+
+namespace anoncredsObjectBuilder {
+
+namespace {
+
+static const int maxDepth = 128;
+
+// Integers of up to this many digits are exact doubles and skip `strtod`
+static const size_t exactDigits = 15;
+
+// Thrown for a `"__proto__"` key. `setProperty` would set the prototype
+// instead of an own property, so the whole input goes to `JSON.parse`.
+struct ProtoKey {};
+
+struct Builder {
+  jsi::Runtime &rt;
+  const char *cur;
+  const char *end;
+
+  // Elements of the arrays being read, innermost last
+  std::vector<jsi::Value> elements;
+  // `PropNameID`s of the keys without escapes, which point into the input
+  std::unordered_map<std::string_view, jsi::PropNameID> keys;
+  // Unescaped contents of the last string with escapes
+  std::string scratch;
+
+  [[noreturn]] void fail(const char *message) {
+    throw std::invalid_argument(std::string("Invalid JSON: ") + message);
+  }
+
+  void skipWhitespace() {
+    while (cur < end &&
+           (*cur == ' ' || *cur == '\n' || *cur == '\r' || *cur == '\t'))
+      cur++;
+  }
+
+  void literal(const char *word, size_t len) {
+    if (size_t(end - cur) < len || std::string_view(cur, len) != word)
+      fail("Invalid literal");
+    cur += len;
+  }
+
+  static void appendUtf8(std::string &out, uint32_t cp) {
+    if (cp < 0x80) {
+      out += char(cp);
+    } else if (cp < 0x800) {
+      out += char(0xC0 | (cp >> 6));
+      out += char(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+      out += char(0xE0 | (cp >> 12));
+      out += char(0x80 | ((cp >> 6) & 0x3F));
+      out += char(0x80 | (cp & 0x3F));
+    } else {
+      out += char(0xF0 | (cp >> 18));
+      out += char(0x80 | ((cp >> 12) & 0x3F));
+      out += char(0x80 | ((cp >> 6) & 0x3F));
+      out += char(0x80 | (cp & 0x3F));
+    }
+  }
+
+  uint32_t hex4() {
+    if (end - cur < 4)
+      fail("Invalid unicode escape");
+    uint32_t out = 0;
+    for (int i = 0; i < 4; i++) {
+      char c = *cur++;
+      out <<= 4;
+      if (c >= '0' && c <= '9')
+        out |= c - '0';
+      else if (c >= 'a' && c <= 'f')
+        out |= c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F')
+        out |= c - 'A' + 10;
+      else
+        fail("Invalid unicode escape");
+    }
+    return out;
+  }
+
+  // Reads a string, the opening quote checked by the caller. Returns its
+  // contents in the input when it has no escapes, or in `scratch` otherwise.
+  std::string_view string(bool &escaped) {
+    const char *start = ++cur;
+    while (cur < end && *cur != '"' && *cur != '\\') {
+      if ((unsigned char)*cur < 0x20)
+        fail("Control character in string");
+      cur++;
+    }
+    if (cur >= end)
+      fail("Unterminated string");
+    escaped = *cur == '\\';
+    if (!escaped)
+      return std::string_view(start, size_t(cur++ - start));
+
+    scratch.assign(start, size_t(cur - start));
+    const char *chunk = cur;
+    while (cur < end) {
+      char c = *cur;
+      if (c == '"') {
+        scratch.append(chunk, size_t(cur - chunk));
+        cur++;
+        return scratch;
+      }
+      if (c == '\\') {
+        scratch.append(chunk, size_t(cur - chunk));
+        if (++cur >= end)
+          break;
+        switch (*cur++) {
+        case '"':
+          scratch += '"';
+          break;
+        case '\\':
+          scratch += '\\';
+          break;
+        case '/':
+          scratch += '/';
+          break;
+        case 'b':
+          scratch += '\b';
+          break;
+        case 'f':
+          scratch += '\f';
+          break;
+        case 'n':
+          scratch += '\n';
+          break;
+        case 'r':
+          scratch += '\r';
+          break;
+        case 't':
+          scratch += '\t';
+          break;
+        case 'u': {
+          // A surrogate must be a high one followed by a low one, a lone
+          // surrogate has no UTF-8 encoding
+          auto cp = hex4();
+          if (cp >= 0xDC00 && cp <= 0xDFFF)
+            fail("Lone low surrogate");
+          if (cp >= 0xD800 && cp <= 0xDBFF) {
+            if (end - cur < 6 || cur[0] != '\\' || cur[1] != 'u')
+              fail("Lone high surrogate");
+            cur += 2;
+            auto low = hex4();
+            if (low < 0xDC00 || low > 0xDFFF)
+              fail("Invalid low surrogate");
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+          }
+          appendUtf8(scratch, cp);
+          break;
+        }
+        default:
+          fail("Invalid escape sequence");
+        }
+        chunk = cur;
+        continue;
+      }
+      if ((unsigned char)c < 0x20)
+        fail("Control character in string");
+      cur++;
+    }
+    fail("Unterminated string");
+  }
+
+  double number() {
+    const char *start = cur;
+    auto negative = cur < end && *cur == '-';
+    if (negative)
+      cur++;
+    const char *digits = cur;
+    uint64_t integer = 0;
+    while (cur < end && *cur >= '0' && *cur <= '9')
+      integer = integer * 10 + uint64_t(*cur++ - '0');
+    if (cur == digits || (*digits == '0' && cur - digits > 1))
+      fail("Invalid number");
+    auto exact = size_t(cur - digits) <= exactDigits;
+
+    if (cur < end && *cur == '.') {
+      exact = false;
+      const char *fraction = ++cur;
+      while (cur < end && *cur >= '0' && *cur <= '9')
+        cur++;
+      if (cur == fraction)
+        fail("Invalid number");
+    }
+    if (cur < end && (*cur == 'e' || *cur == 'E')) {
+      exact = false;
+      if (++cur < end && (*cur == '+' || *cur == '-'))
+        cur++;
+      const char *exponent = cur;
+      while (cur < end && *cur >= '0' && *cur <= '9')
+        cur++;
+      if (cur == exponent)
+        fail("Invalid number");
+    }
+
+    if (exact)
+      return negative ? -double(integer) : double(integer);
+    scratch.assign(start, size_t(cur - start));
+    return std::strtod(scratch.c_str(), nullptr);
+  }
+
+  // Reads a key. Keys with escapes are rare enough not to be cached, their
+  // `PropNameID` is created in `escapedKey`, which must outlive the result.
+  const jsi::PropNameID &key(std::optional<jsi::PropNameID> &escapedKey) {
+    bool escaped;
+    auto text = string(escaped);
+    if (text == "__proto__")
+      throw ProtoKey();
+    if (escaped)
+      return escapedKey.emplace(jsi::PropNameID::forUtf8(
+          rt, (const uint8_t *)text.data(), text.size()));
+
+    auto it = keys.find(text);
+    if (it == keys.end())
+      it = keys
+               .emplace(text, jsi::PropNameID::forUtf8(
+                                  rt, (const uint8_t *)text.data(),
+                                  text.size()))
+               .first;
+    return it->second;
+  }
+
+  jsi::Value value(int depth) {
+    if (depth > maxDepth)
+      fail("Maximum nesting depth exceeded");
+
+    skipWhitespace();
+    if (cur >= end)
+      fail("Unexpected end of input");
+
+    switch (*cur) {
+    case 'n':
+      literal("null", 4);
+      return jsi::Value::null();
+    case 't':
+      literal("true", 4);
+      return jsi::Value(true);
+    case 'f':
+      literal("false", 5);
+      return jsi::Value(false);
+    case '"': {
+      bool escaped;
+      auto text = string(escaped);
+      return jsi::String::createFromUtf8(rt, (const uint8_t *)text.data(),
+                                         text.size());
+    }
+    case '[':
+      return array(depth);
+    case '{':
+      return object(depth);
+    default:
+      return jsi::Value(number());
+    }
+  }
+
+  jsi::Value array(int depth) {
+    cur++;
+    auto base = elements.size();
+    skipWhitespace();
+    if (cur < end && *cur == ']') {
+      cur++;
+    } else {
+      while (true) {
+        elements.push_back(value(depth + 1));
+        skipWhitespace();
+        if (cur < end && *cur == ',') {
+          cur++;
+          continue;
+        }
+        if (cur < end && *cur == ']') {
+          cur++;
+          break;
+        }
+        fail("Expected `,` or `]`");
+      }
+    }
+
+    auto length = elements.size() - base;
+    auto out = jsi::Array(rt, length);
+    for (size_t i = 0; i < length; i++)
+      out.setValueAtIndex(rt, i, std::move(elements[base + i]));
+    elements.resize(base);
+    return out;
+  }
+
+  jsi::Value object(int depth) {
+    cur++;
+    auto out = jsi::Object(rt);
+    skipWhitespace();
+    if (cur < end && *cur == '}') {
+      cur++;
+      return out;
+    }
+    while (true) {
+      skipWhitespace();
+      if (cur >= end || *cur != '"')
+        fail("Expected object key");
+      std::optional<jsi::PropNameID> escapedKey;
+      auto &name = key(escapedKey);
+      skipWhitespace();
+      if (cur >= end || *cur != ':')
+        fail("Expected `:`");
+      cur++;
+      out.setProperty(rt, name, value(depth + 1));
+      skipWhitespace();
+      if (cur < end && *cur == ',') {
+        cur++;
+        continue;
+      }
+      if (cur < end && *cur == '}') {
+        cur++;
+        return out;
+      }
+      fail("Expected `,` or `}`");
+    }
+  }
+};
+
+} // namespace
+
+jsi::Value build(jsi::Runtime &rt, const char *data, size_t len) {
+  Builder builder{rt, data, data + len, {}, {}, {}};
+  try {
+    auto out = builder.value(0);
+    builder.skipWhitespace();
+    if (builder.cur != builder.end)
+      builder.fail("Unexpected trailing characters");
+    return out;
+  } catch (const ProtoKey &) {
+  }
+
+  auto parse = rt.global()
+                   .getPropertyAsObject(rt, "JSON")
+                   .getPropertyAsFunction(rt, "parse");
+  return parse.call(
+      rt, jsi::String::createFromUtf8(rt, (const uint8_t *)data, len));
+}
+
+} // namespace anoncredsObjectBuilder
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <cstddef>
+
+using namespace facebook;
+
+// Builds JS values straight from the JSON of an anoncreds object, for
+// `getObject`.
+//
+// The JSON is read once, in place, and every value is created in the runtime
+// as soon as it is read: there is no JS string of the whole object for
+// `JSON.parse` to read again, and no intermediate document in between.
+// Strings without escapes are created from the input bytes, and the
+// `PropNameID` of every distinct key is created once per object, which
+// matters for the many repeated keys of credentials and proofs.
+//
+// The result is the value `JSON.parse` gives for the same JSON: numbers are
+// doubles, and the big integers anoncreds writes as decimal strings stay
+// strings. An object with a `"__proto__"` key, which `JSON.parse` makes an own
+// property, is left to `JSON.parse`. Unlike `JSON.parse`, lone surrogate
+// escapes are rejected, as they have no UTF-8 encoding.
+namespace anoncredsObjectBuilder {
+
+// Builds the value of the `len` bytes of JSON at `data`. Throws
+// `std::invalid_argument` when they are not a single valid JSON value.
+jsi::Value build(jsi::Runtime &rt, const char *data, size_t len);
+
+} // namespace anoncredsObjectBuilder
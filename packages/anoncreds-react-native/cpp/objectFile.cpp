@@ -0,0 +1,137 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include "library.h"
+#include "objectFile.h"
+
+namespace anoncredsObjectFile {
+
+namespace {
+
+[[noreturn]] void fail(const char *action, const std::string &path) {
+  throw std::runtime_error(std::string("Unable to ") + action +
+                           " file: " + path + " (" + std::strerror(errno) +
+                           ")");
+}
+
+// Closes a file descriptor when it goes out of scope
+class Descriptor {
+public:
+  explicit Descriptor(int fd) : fd(fd) {}
+  ~Descriptor() {
+    if (fd >= 0)
+      ::close(fd);
+  }
+
+  Descriptor(const Descriptor &) = delete;
+  Descriptor &operator=(const Descriptor &) = delete;
+
+  operator int() const { return fd; }
+
+  // Closes the descriptor, reporting errors of the last writes
+  bool close() {
+    auto result = ::close(fd);
+    fd = -1;
+    return result == 0;
+  }
+
+private:
+  int fd;
+};
+
+bool writeAll(int fd, const uint8_t *data, size_t length) {
+  while (length > 0) {
+    auto written = ::write(fd, data, length);
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written <= 0)
+      return false;
+    data += written;
+    length -= size_t(written);
+  }
+  return true;
+}
+
+} // namespace
+
+MappedFile::MappedFile(const std::string &path) {
+  Descriptor fd(::open(path.c_str(), O_RDONLY));
+  if (fd < 0)
+    fail("open", path);
+
+  struct stat status;
+  if (::fstat(fd, &status) != 0)
+    fail("read", path);
+
+  // An empty file can not be mapped
+  length = size_t(status.st_size);
+  if (length == 0)
+    return;
+
+  auto data = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED)
+    fail("map", path);
+  bytes = (const uint8_t *)data;
+}
+
+MappedFile::~MappedFile() {
+  if (bytes != nullptr)
+    ::munmap((void *)bytes, length);
+}
+
+void writeFile(const std::string &path,
+               const std::vector<std::pair<const uint8_t *, size_t>> &parts) {
+  auto temporary = path + ".tmp";
+  Descriptor fd(::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600));
+  if (fd < 0)
+    fail("open", temporary);
+
+  auto written = true;
+  for (auto &[data, length] : parts)
+    written = written && writeAll(fd, data, length);
+  if (!written || ::fsync(fd) != 0 || !fd.close()) {
+    auto error = errno;
+    ::unlink(temporary.c_str());
+    errno = error;
+    fail("write", temporary);
+  }
+  if (::rename(temporary.c_str(), path.c_str()) != 0) {
+    auto error = errno;
+    ::unlink(temporary.c_str());
+    errno = error;
+    fail("replace", path);
+  }
+}
+
+ErrorCode exportJson(ObjectHandle handle, const std::string &path) {
+  ByteBuffer json{};
+  auto code = anoncredsLibrary::anoncreds_object_get_json(handle, &json);
+  if (code != ErrorCode::Success)
+    return code;
+
+  try {
+    writeFile(path, {{json.data, size_t(json.len)}});
+  } catch (...) {
+    anoncredsLibrary::anoncreds_buffer_free(json);
+    throw;
+  }
+  anoncredsLibrary::anoncreds_buffer_free(json);
+  return ErrorCode::Success;
+}
+
+ErrorCode importJson(ErrorCode (*parse)(ByteBuffer, ObjectHandle *),
+                     const std::string &path, ObjectHandle *handle) {
+  MappedFile file(path);
+  // The parser reports an empty file as invalid JSON
+  return parse(
+      ByteBuffer{.len = int64_t(file.size()), .data = (uint8_t *)file.data()},
+      handle);
+}
+
+} // namespace anoncredsObjectFile
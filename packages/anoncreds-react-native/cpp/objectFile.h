@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "include/libanoncreds.h"
+
+// Reads and writes the JSON of objects straight between libanoncreds and a
+// file, so large objects such as revocation status lists never have to be
+// copied into a JS string to be persisted.
+//
+// Failing to open, map or write a file throws `std::runtime_error`, errors of
+// libanoncreds are returned as usual.
+namespace anoncredsObjectFile {
+
+// A file mapped read-only into memory, unmapped when destroyed
+class MappedFile {
+public:
+  explicit MappedFile(const std::string &path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  // nullptr for an empty file
+  const uint8_t *data() const { return bytes; }
+  size_t size() const { return length; }
+
+private:
+  const uint8_t *bytes = nullptr;
+  size_t length = 0;
+};
+
+// Appends `value` to `out` as a little endian integer
+template <typename T> void append(std::string &out, T value) {
+  for (size_t i = 0; i < sizeof(T); i++)
+    out += char((uint64_t(value) >> (8 * i)) & 0xFF);
+}
+
+// Reads the little endian integers and bytes of a mapped file, bounds
+// checked. Reading past the end throws that the file is not a valid `what`.
+class Reader {
+public:
+  Reader(const MappedFile &file, const std::string &path, const char *what)
+      : cur(file.data()), end(file.data() + file.size()), path(path),
+        what(what) {}
+
+  template <typename T> T read() {
+    auto bytes = take(sizeof(T));
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); i++)
+      value |= uint64_t(bytes[i]) << (8 * i);
+    return T(value);
+  }
+
+  const uint8_t *take(size_t length) {
+    if (size_t(end - cur) < length)
+      invalid();
+    auto bytes = cur;
+    cur += length;
+    return bytes;
+  }
+
+  bool atEnd() const { return cur == end; }
+
+  [[noreturn]] void invalid() const {
+    throw std::runtime_error(std::string("Not a valid ") + what + ": " + path);
+  }
+
+private:
+  const uint8_t *cur;
+  const uint8_t *end;
+  const std::string &path;
+  const char *what;
+};
+
+// Writes `parts` one after the other to `path`. The file is written next to
+// `path` and renamed over it once complete, so `path` never holds a partial
+// file.
+void writeFile(const std::string &path,
+               const std::vector<std::pair<const uint8_t *, size_t>> &parts);
+
+// Writes the JSON of `handle` to `path`, as `writeFile` does
+ErrorCode exportJson(ObjectHandle handle, const std::string &path);
+
+// Parses the JSON in `path` with `parse`, reading it through a memory map
+ErrorCode importJson(ErrorCode (*parse)(ByteBuffer, ObjectHandle *),
+                     const std::string &path, ObjectHandle *handle);
+
+} // namespace anoncredsObjectFile
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <iterator>
+
+#include "library.h"
+#include "parsers.h"
+
+namespace anoncredsParsers {
+
+namespace {
+
+const Parser parsers[] = {
+    {"credential", "credentialFromJson", "Credential",
+     anoncredsLibrary::anoncreds_credential_from_json},
+    {"credentialDefinition", "credentialDefinitionFromJson",
+     "CredentialDefinition",
+     anoncredsLibrary::anoncreds_credential_definition_from_json},
+    {"credentialDefinitionPrivate", "credentialDefinitionPrivateFromJson",
+     "CredentialDefinitionPrivate",
+     anoncredsLibrary::anoncreds_credential_definition_private_from_json},
+    {"credentialOffer", "credentialOfferFromJson", "CredentialOffer",
+     anoncredsLibrary::anoncreds_credential_offer_from_json},
+    {"credentialRequest", "credentialRequestFromJson", "CredentialRequest",
+     anoncredsLibrary::anoncreds_credential_request_from_json},
+    {"credentialRequestMetadata", "credentialRequestMetadataFromJson",
+     "CredentialRequestMetadata",
+     anoncredsLibrary::anoncreds_credential_request_metadata_from_json},
+    {"keyCorrectnessProof", "keyCorrectnessProofFromJson",
+     "CredentialKeyCorrectnessProof",
+     anoncredsLibrary::anoncreds_key_correctness_proof_from_json},
+    {"presentation", "presentationFromJson", "Presentation",
+     anoncredsLibrary::anoncreds_presentation_from_json},
+    {"presentationRequest", "presentationRequestFromJson",
+     "PresentationRequest",
+     anoncredsLibrary::anoncreds_presentation_request_from_json},
+    {"revocationRegistry", "revocationRegistryFromJson", "RevocationRegistry",
+     anoncredsLibrary::anoncreds_revocation_registry_from_json},
+    {"revocationRegistryDefinition", "revocationRegistryDefinitionFromJson",
+     "RevocationRegistryDefinition",
+     anoncredsLibrary::anoncreds_revocation_registry_definition_from_json},
+    {"revocationRegistryDefinitionPrivate",
+     "revocationRegistryDefinitionPrivateFromJson",
+     "RevocationRegistryDefinitionPrivate",
+     anoncredsLibrary::
+         anoncreds_revocation_registry_definition_private_from_json},
+    {"revocationState", "revocationStateFromJson",
+     "CredentialRevocationState",
+     anoncredsLibrary::anoncreds_revocation_state_from_json},
+    {"revocationStatusList", "revocationStatusListFromJson",
+     "RevocationStatusList",
+     anoncredsLibrary::anoncreds_revocation_status_list_from_json},
+    {"schema", "schemaFromJson", "Schema",
+     anoncredsLibrary::anoncreds_schema_from_json},
+    {"w3cCredential", "w3cCredentialFromJson", "W3CCredential",
+     anoncredsLibrary::anoncreds_w3c_credential_from_json},
+    {"w3cPresentation", "w3cPresentationFromJson", "W3CPresentation",
+     anoncredsLibrary::anoncreds_w3c_presentation_from_json},
+};
+
+template <typename Field>
+const Parser *findBy(Field field, std::string_view value) {
+  auto parser = std::find_if(
+      std::begin(parsers), std::end(parsers),
+      [&](const Parser &parser) { return parser.*field == value; });
+  return parser == std::end(parsers) ? nullptr : parser;
+}
+
+} // namespace
+
+const Parser *find(std::string_view type) { return findBy(&Parser::type, type); }
+
+const Parser *findByTypeName(std::string_view typeName) {
+  return findBy(&Parser::typeName, typeName);
+}
+
+} // namespace anoncredsParsers
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string_view>
+
+#include "include/libanoncreds.h"
+
+// The `*_from_json` functions of libanoncreds, for the bindings that parse
+// objects of a type chosen at runtime
+namespace anoncredsParsers {
+
+struct Parser {
+  // Name of the binding that calls `parse` without the `FromJson` suffix
+  const char *type;
+  const char *binding;
+  // Returned by `anoncreds_object_get_type_name` for the objects it parses
+  const char *typeName;
+  ErrorCode (*parse)(ByteBuffer, ObjectHandle *);
+};
+
+// The parser for `type`, or nullptr
+const Parser *find(std::string_view type);
+
+// The parser for objects of `typeName`, or nullptr
+const Parser *findByTypeName(std::string_view typeName);
+
+} // namespace anoncredsParsers
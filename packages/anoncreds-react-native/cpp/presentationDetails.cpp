@@ -0,0 +1,104 @@
+#include <charconv>
+#include <string_view>
+
+#include "json.h"
+#include "library.h"
+#include "presentationDetails.h"
+#include "projection.h"
+
+namespace anoncredsPresentationDetails {
+
+namespace {
+
+using anoncredsJson::Value;
+
+const Value none;
+
+const Value &member(const Value &value, std::string_view key) {
+  auto found = value.get(key);
+  return found ? *found : none;
+}
+
+std::optional<std::string> string(const Value &value) {
+  if (!value.isString())
+    return std::nullopt;
+  return value.text;
+}
+
+// The raw values of `{ name: { raw, encoded } }`
+Values raw(const Value &values) {
+  Values out;
+  for (auto &[name, value] : values.members)
+    if (auto text = string(member(value, "raw")))
+      out.emplace_back(name, std::move(*text));
+  return out;
+}
+
+bool parse(std::string_view json, Value &out) {
+  return json.data() == nullptr ||
+         anoncredsJson::parse(json.data(), json.size(), out);
+}
+
+} // namespace
+
+ErrorCode read(ObjectHandle presentation, Details &details) {
+  static const auto projection =
+      anoncredsProjection::compile({"/requested_proof", "/identifiers"});
+
+  ByteBuffer json{};
+  auto code = anoncredsLibrary::anoncreds_object_get_json(presentation, &json);
+  if (code != ErrorCode::Success)
+    return code;
+  std::vector<std::string_view> selected;
+  Value requestedProof, identifiers;
+  auto parsed = anoncredsProjection::evaluate(
+                    *projection, {(const char *)json.data, size_t(json.len)},
+                    selected) &&
+                parse(selected[0], requestedProof) &&
+                parse(selected[1], identifiers);
+  anoncredsLibrary::anoncreds_buffer_free(json);
+  if (!parsed)
+    return ErrorCode::Unexpected;
+
+  details.revealedAttributes.clear();
+  for (auto &[referent, value] :
+       member(requestedProof, "revealed_attrs").members)
+    if (auto text = string(member(value, "raw")))
+      details.revealedAttributes.emplace_back(referent, std::move(*text));
+
+  details.revealedAttributeGroups.clear();
+  for (auto &[referent, group] :
+       member(requestedProof, "revealed_attr_groups").members)
+    details.revealedAttributeGroups.emplace_back(
+        referent, raw(member(group, "values")));
+
+  details.selfAttestedAttributes.clear();
+  for (auto &[referent, value] :
+       member(requestedProof, "self_attested_attrs").members)
+    if (auto text = string(value))
+      details.selfAttestedAttributes.emplace_back(referent, std::move(*text));
+
+  details.predicates.clear();
+  for (auto &[referent, value] : member(requestedProof, "predicates").members)
+    details.predicates.push_back(referent);
+
+  details.identifiers.clear();
+  for (auto &item : identifiers.items) {
+    Identifier identifier{
+        .schemaId = string(member(item, "schema_id")).value_or(""),
+        .credentialDefinitionId =
+            string(member(item, "cred_def_id")).value_or(""),
+        .revocationRegistryId = string(member(item, "rev_reg_id")),
+        .timestamp = std::nullopt};
+    auto &timestamp = member(item, "timestamp");
+    int64_t seconds = 0;
+    auto end = timestamp.text.data() + timestamp.text.size();
+    if (timestamp.isNumber() &&
+        std::from_chars(timestamp.text.data(), end, seconds).ptr == end)
+      identifier.timestamp = seconds;
+    details.identifiers.push_back(std::move(identifier));
+  }
+  return ErrorCode::Success;
+}
+
+} // namespace anoncredsPresentationDetails
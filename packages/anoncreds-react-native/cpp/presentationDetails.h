@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "include/libanoncreds.h"
+
+// What a verified presentation discloses, for `verifyPresentationWithDetails`.
+//
+// Only `requested_proof` and `identifiers` are read from the JSON of the
+// presentation, the proofs themselves are skipped. Values are the raw values
+// of the attributes, in the order of the presentation.
+namespace anoncredsPresentationDetails {
+
+using Values = std::vector<std::pair<std::string, std::string>>;
+
+struct Identifier {
+  std::string schemaId;
+  std::string credentialDefinitionId;
+  std::optional<std::string> revocationRegistryId;
+  std::optional<int64_t> timestamp;
+};
+
+struct Details {
+  // By referent
+  Values revealedAttributes;
+  std::vector<std::pair<std::string, Values>> revealedAttributeGroups;
+  Values selfAttestedAttributes;
+  // Referents of the predicates
+  std::vector<std::string> predicates;
+  std::vector<Identifier> identifiers;
+};
+
+// Reads the details of the legacy presentation `presentation`
+ErrorCode read(ObjectHandle presentation, Details &details);
+
+} // namespace anoncredsPresentationDetails
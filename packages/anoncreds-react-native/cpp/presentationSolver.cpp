@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <string_view>
+
+#include "credentialStore.h"
+#include "json.h"
+#include "library.h"
+#include "presentationSolver.h"
+
+namespace anoncredsPresentationSolver {
+
+namespace {
+
+using anoncredsCredentialStore::Slots;
+
+// A requested attribute or predicate with the credentials that can answer it
+struct Referent {
+  std::string name;
+  bool isPredicate;
+  Slots candidates;
+};
+
+std::optional<int64_t> integer(std::string_view text) {
+  int64_t value = 0;
+  auto end = text.data() + text.size();
+  auto [ptr, ec] = std::from_chars(text.data(), end, value);
+  if (ec != std::errc() || ptr != end)
+    return std::nullopt;
+  return value;
+}
+
+// Whether `value` satisfies the predicate `type` of `threshold`, nullopt for
+// an unknown type
+std::optional<bool> satisfies(int64_t value, const std::string &type,
+                              int64_t threshold) {
+  if (type == ">=" || type == "GE")
+    return value >= threshold;
+  if (type == ">" || type == "GT")
+    return value > threshold;
+  if (type == "<=" || type == "LE")
+    return value <= threshold;
+  if (type == "<" || type == "LT")
+    return value < threshold;
+  return std::nullopt;
+}
+
+template <typename Keep> Slots filter(const Slots &slots, Keep keep) {
+  Slots out;
+  std::copy_if(slots.begin(), slots.end(), std::back_inserter(out), keep);
+  return out;
+}
+
+std::string join(const std::vector<std::string> &names) {
+  std::string out;
+  for (auto &name : names)
+    out += (out.empty() ? "`" : ", `") + name + "`";
+  return out;
+}
+
+// Narrows the candidates of a referent check by check, recording the check
+// that left none
+class Candidates {
+public:
+  Candidates(Slots slots, std::string reason) {
+    narrow(std::move(slots), std::move(reason));
+  }
+
+  void narrow(Slots slots, std::string reason) {
+    if (failed())
+      return;
+    current = std::move(slots);
+    if (current.empty())
+      failure = std::move(reason);
+  }
+
+  bool failed() const { return failure.has_value(); }
+  const Slots &slots() const { return current; }
+  const std::string &reason() const { return *failure; }
+
+private:
+  Slots current;
+  std::optional<std::string> failure;
+};
+
+} // namespace
+
+ErrorCode solve(ObjectHandle presentationRequest,
+                const std::vector<FfiCredentialEntry> &credentials,
+                Solution &solution) {
+  ByteBuffer json{};
+  auto code =
+      anoncredsLibrary::anoncreds_object_get_json(presentationRequest, &json);
+  if (code != ErrorCode::Success)
+    return code;
+  anoncredsJson::Value request;
+  auto parsed =
+      anoncredsJson::parse((const char *)json.data, size_t(json.len), request);
+  anoncredsLibrary::anoncreds_buffer_free(json);
+  if (!parsed)
+    return ErrorCode::Unexpected;
+
+  // Slot `i` of the index is entry `i` of `credentials`
+  anoncredsCredentialStore::Index index;
+  for (size_t i = 0; i < credentials.size(); i++) {
+    anoncredsCredentialStore::Index::Record record{.id = std::to_string(i),
+                                                   .tags = {}};
+    code = anoncredsCredentialStore::readTags(credentials[i].credential,
+                                              record.tags);
+    if (code != ErrorCode::Success)
+      return code;
+    index.insert(std::move(record));
+  }
+
+  static const anoncredsJson::Value none;
+  auto globalNonRevoked = request.get("non_revoked");
+  auto revocable = [&](const anoncredsJson::Value &requested) {
+    auto nonRevoked = requested.get("non_revoked");
+    if (nonRevoked == nullptr || nonRevoked->isNull())
+      nonRevoked = globalNonRevoked;
+    return nonRevoked != nullptr && !nonRevoked->isNull();
+  };
+  // Credentials that can prove they were not revoked, or can not be revoked
+  auto provablyNotRevoked = [&](uint32_t slot) {
+    return index.tag(slot, "rev_reg_id") == nullptr ||
+           (credentials[slot].rev_state != 0 &&
+            credentials[slot].timestamp >= 0);
+  };
+
+  std::vector<Referent> referents;
+  auto add = [&](const std::string &name, bool isPredicate,
+                 const Candidates &candidates) {
+    if (candidates.failed())
+      solution.unsatisfied.push_back(
+          Unsatisfied{.referent = name,
+                      .isPredicate = isPredicate,
+                      .reason = candidates.reason()});
+    else
+      referents.push_back(Referent{.name = name,
+                                   .isPredicate = isPredicate,
+                                   .candidates = candidates.slots()});
+  };
+
+  auto attributes = request.get("requested_attributes");
+  for (auto &[name, requested] :
+       attributes ? attributes->members : none.members) {
+    std::vector<std::string> names;
+    if (auto single = requested.get("name"); single && single->isString())
+      names.push_back(single->text);
+    if (auto group = requested.get("names"); group && group->isArray())
+      for (auto &item : group->items)
+        if (item.isString())
+          names.push_back(item.text);
+    auto restrictions = requested.get("restrictions");
+    restrictions = restrictions ? restrictions : &none;
+
+    Candidates candidates(index.match(*restrictions, {}),
+                          "No credential matches the restrictions");
+    candidates.narrow(index.match(*restrictions, names),
+                      "No credential that matches the restrictions has " +
+                          join(names));
+    if (revocable(requested))
+      candidates.narrow(
+          filter(candidates.slots(), provablyNotRevoked),
+          "No credential that matches has a revocation state and timestamp "
+          "for the non-revoked interval");
+    add(name, false, candidates);
+  }
+
+  auto predicates = request.get("requested_predicates");
+  for (auto &[name, requested] :
+       predicates ? predicates->members : none.members) {
+    auto attribute = requested.get("name");
+    auto type = requested.get("p_type");
+    auto value = requested.get("p_value");
+    auto threshold = value && value->isNumber() ? integer(value->text)
+                                                : std::nullopt;
+    if (!attribute || !attribute->isString() || !type || !type->isString() ||
+        !threshold || !satisfies(0, type->text, 0).has_value()) {
+      solution.unsatisfied.push_back(
+          Unsatisfied{.referent = name,
+                      .isPredicate = true,
+                      .reason = "The predicate is not valid"});
+      continue;
+    }
+    auto restrictions = requested.get("restrictions");
+    restrictions = restrictions ? restrictions : &none;
+
+    auto tag =
+        "attr::" + anoncredsCredentialStore::attributeName(attribute->text) +
+        "::value";
+    Candidates candidates(index.match(*restrictions, {}),
+                          "No credential matches the restrictions");
+    candidates.narrow(index.match(*restrictions, {attribute->text}),
+                      "No credential that matches the restrictions has `" +
+                          attribute->text + "`");
+    candidates.narrow(
+        filter(candidates.slots(),
+               [&](uint32_t slot) {
+                 auto raw = index.tag(slot, tag);
+                 auto number = raw ? integer(*raw) : std::nullopt;
+                 return number &&
+                        *satisfies(*number, type->text, *threshold);
+               }),
+        "No credential that matches the restrictions has `" +
+            attribute->text + "` " + type->text + " " + value->text);
+    if (revocable(requested))
+      candidates.narrow(
+          filter(candidates.slots(), provablyNotRevoked),
+          "No credential that matches has a revocation state and timestamp "
+          "for the non-revoked interval");
+    add(name, true, candidates);
+  }
+
+  // Greedy cover: the credential that answers most of the open referents,
+  // the first one on a tie
+  std::vector<uint32_t> chosen;
+  std::vector<bool> answered(referents.size(), false);
+  for (auto open = referents.size(); open > 0;) {
+    std::map<uint32_t, size_t> counts;
+    for (size_t i = 0; i < referents.size(); i++)
+      if (!answered[i])
+        for (auto slot : referents[i].candidates)
+          counts[slot]++;
+    auto best = std::max_element(
+        counts.begin(), counts.end(),
+        [](auto &a, auto &b) { return a.second < b.second; });
+    chosen.push_back(best->first);
+    for (size_t i = 0; i < referents.size(); i++)
+      if (!answered[i] &&
+          std::binary_search(referents[i].candidates.begin(),
+                             referents[i].candidates.end(), best->first)) {
+        answered[i] = true;
+        open--;
+      }
+  }
+
+  // Drops credentials that are not needed once the others are chosen
+  auto canAnswer = [&](const Referent &referent,
+                       const std::vector<uint32_t> &slots) {
+    return std::any_of(slots.begin(), slots.end(), [&](uint32_t slot) {
+      return std::binary_search(referent.candidates.begin(),
+                                referent.candidates.end(), slot);
+    });
+  };
+  for (size_t i = chosen.size(); i-- > 0;) {
+    auto others = chosen;
+    others.erase(others.begin() + i);
+    if (std::all_of(referents.begin(), referents.end(),
+                    [&](const Referent &r) { return canAnswer(r, others); }))
+      chosen = std::move(others);
+  }
+
+  std::sort(chosen.begin(), chosen.end());
+  for (auto slot : chosen)
+    solution.credentials.push_back(credentials[slot]);
+  for (auto &referent : referents) {
+    auto entry =
+        std::find_if(chosen.begin(), chosen.end(), [&](uint32_t slot) {
+          return std::binary_search(referent.candidates.begin(),
+                                    referent.candidates.end(), slot);
+        });
+    solution.credentialsProve.push_back(
+        Prove{.entryIndex = size_t(entry - chosen.begin()),
+              .referent = referent.name,
+              .isPredicate = referent.isPredicate,
+              .reveal = !referent.isPredicate});
+  }
+  return ErrorCode::Success;
+}
+
+} // namespace anoncredsPresentationSolver
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "include/libanoncreds.h"
+
+// Chooses the credentials that answer a presentation request, before any
+// proof is created.
+//
+// Every requested attribute and predicate is matched against the tags of the
+// credentials, see `anoncredsCredentialStore`, against the values of
+// predicates and, when the request asks for a non-revoked interval, against
+// the revocation states passed with revocable credentials. The credentials are
+// then chosen greedily, the one that answers most of the open referents first,
+// and credentials whose referents are all answered by others are dropped.
+namespace anoncredsPresentationSolver {
+
+struct Prove {
+  size_t entryIndex;
+  std::string referent;
+  bool isPredicate;
+  bool reveal;
+};
+
+// A referent that none of the credentials can answer, with the first check
+// that ruled out the last candidates
+struct Unsatisfied {
+  std::string referent;
+  bool isPredicate;
+  std::string reason;
+};
+
+// The arguments `credentials` and `credentialsProve` of
+// `anoncreds_create_presentation`, for the referents that can be answered
+struct Solution {
+  std::vector<FfiCredentialEntry> credentials;
+  std::vector<Prove> credentialsProve;
+  std::vector<Unsatisfied> unsatisfied;
+};
+
+// Answers `presentationRequest` with the entries of `credentials`
+ErrorCode solve(ObjectHandle presentationRequest,
+                const std::vector<FfiCredentialEntry> &credentials,
+                Solution &solution);
+
+} // namespace anoncredsPresentationSolver
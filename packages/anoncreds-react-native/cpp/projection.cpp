@@ -0,0 +1,323 @@
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "json.h"
+#include "projection.h"
+
+namespace anoncredsProjection {
+
+// A step of the compiled paths, with the paths that end at it
+struct Node {
+  std::map<std::string, Node, std::less<>> children;
+  std::vector<size_t> outputs;
+};
+
+struct Projection {
+  Node root;
+  size_t paths;
+};
+
+namespace {
+
+static const int maxDepth = 128;
+
+// Compiled projections kept before the cache is emptied
+static const size_t maxCached = 256;
+
+std::mutex cacheMutex;
+std::unordered_map<std::string, std::shared_ptr<const Projection>> cache;
+
+[[noreturn]] void invalid(const std::string &path, const char *reason) {
+  throw std::invalid_argument("Invalid path `" + path + "`: " + reason);
+}
+
+// Splits a JSON pointer into its unescaped reference tokens
+std::vector<std::string> pointer(const std::string &path) {
+  std::vector<std::string> segments;
+  for (size_t i = 0; i < path.size(); i++) {
+    if (path[i] == '/') {
+      segments.emplace_back();
+      continue;
+    }
+    if (path[i] != '~') {
+      segments.back() += path[i];
+      continue;
+    }
+    if (i + 1 < path.size() && path[i + 1] == '0')
+      segments.back() += '~';
+    else if (i + 1 < path.size() && path[i + 1] == '1')
+      segments.back() += '/';
+    else
+      invalid(path, "`~` must be followed by `0` or `1`");
+    i++;
+  }
+  return segments;
+}
+
+// Splits a dotted path, `$.a[0]["b.c"]`, into its keys and indices
+std::vector<std::string> dotted(const std::string &path) {
+  std::vector<std::string> segments;
+  auto name = [&](size_t begin) {
+    auto end = path.find_first_of(".[", begin);
+    end = end == std::string::npos ? path.size() : end;
+    if (end == begin)
+      invalid(path, "expected a name");
+    segments.emplace_back(path.substr(begin, end - begin));
+    return end;
+  };
+
+  // `$` or a bare first name, as in `a.b`
+  size_t i = 0;
+  if (path[0] == '$')
+    i = 1;
+  else if (path[0] != '.' && path[0] != '[')
+    i = name(0);
+  while (i < path.size()) {
+    if (path[i] == '.') {
+      i = name(i + 1);
+      continue;
+    }
+    // `[`
+    if (++i >= path.size())
+      invalid(path, "unterminated `[`");
+    if (path[i] == '"' || path[i] == '\'') {
+      auto quote = path[i++];
+      std::string key;
+      while (i < path.size() && path[i] != quote) {
+        if (path[i] == '\\' && i + 1 < path.size())
+          i++;
+        key += path[i++];
+      }
+      if (i + 1 >= path.size() || path[i + 1] != ']')
+        invalid(path, "unterminated `[`");
+      segments.push_back(std::move(key));
+      i += 2;
+      continue;
+    }
+    auto end = path.find(']', i);
+    if (end == std::string::npos)
+      invalid(path, "unterminated `[`");
+    if (end == i || path.find_first_not_of("0123456789", i) != end)
+      invalid(path, "expected an index or a quoted key in `[]`");
+    segments.emplace_back(path.substr(i, end - i));
+    i = end + 1;
+  }
+  return segments;
+}
+
+std::vector<std::string> segments(const std::string &path) {
+  if (path.empty() || path[0] == '/')
+    return pointer(path);
+  return dotted(path);
+}
+
+std::shared_ptr<const Projection>
+build(const std::vector<std::string> &paths) {
+  auto projection = std::make_shared<Projection>();
+  projection->paths = paths.size();
+  for (size_t i = 0; i < paths.size(); i++) {
+    auto *node = &projection->root;
+    for (auto &segment : segments(paths[i]))
+      node = &node->children[segment];
+    node->outputs.push_back(i);
+  }
+  return projection;
+}
+
+// Walks JSON along the nodes of a projection, recording the values of the
+// nodes with outputs and skipping everything else
+struct Scanner {
+  const char *cur;
+  const char *end;
+  std::vector<std::string_view> &values;
+  // Unescaped key, for the rare keys with escapes
+  std::string scratch;
+
+  void skipWhitespace() {
+    while (cur < end &&
+           (*cur == ' ' || *cur == '\n' || *cur == '\r' || *cur == '\t'))
+      cur++;
+  }
+
+  bool skipString() {
+    // Opening quote has been checked by the caller
+    for (cur++; cur < end; cur++) {
+      if (*cur == '\\')
+        cur++;
+      else if (*cur == '"') {
+        cur++;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool key(std::string_view &out) {
+    auto start = cur;
+    if (!skipString())
+      return false;
+    out = std::string_view(start + 1, size_t(cur - start - 2));
+    if (out.find('\\') == std::string_view::npos)
+      return true;
+
+    anoncredsJson::Value decoded;
+    if (!anoncredsJson::parse(start, size_t(cur - start), decoded))
+      return false;
+    scratch = std::move(decoded.text);
+    out = scratch;
+    return true;
+  }
+
+  bool skipValue() {
+    if (cur >= end)
+      return false;
+    if (*cur == '"')
+      return skipString();
+    if (*cur != '{' && *cur != '[') {
+      auto start = cur;
+      while (cur < end && *cur != ',' && *cur != ']' && *cur != '}' &&
+             *cur != ' ' && *cur != '\n' && *cur != '\r' && *cur != '\t')
+        cur++;
+      return cur != start;
+    }
+
+    size_t depth = 0;
+    while (cur < end) {
+      switch (*cur) {
+      case '"':
+        if (!skipString())
+          return false;
+        continue;
+      case '{':
+      case '[':
+        depth++;
+        break;
+      case '}':
+      case ']':
+        if (--depth == 0) {
+          cur++;
+          return true;
+        }
+        break;
+      }
+      cur++;
+    }
+    return false;
+  }
+
+  const Node *child(const Node &node, std::string_view key) {
+    auto it = node.children.find(key);
+    return it == node.children.end() ? nullptr : &it->second;
+  }
+
+  bool scan(const Node &node, int depth) {
+    if (depth > maxDepth)
+      return false;
+    skipWhitespace();
+    auto start = cur;
+
+    bool ok;
+    if (node.children.empty() || cur >= end)
+      ok = skipValue();
+    else if (*cur == '{')
+      ok = members(node, depth);
+    else if (*cur == '[')
+      ok = elements(node, depth);
+    else
+      ok = skipValue();
+    if (!ok)
+      return false;
+
+    for (auto output : node.outputs)
+      values[output] = std::string_view(start, size_t(cur - start));
+    return true;
+  }
+
+  bool members(const Node &node, int depth) {
+    cur++;
+    skipWhitespace();
+    if (cur < end && *cur == '}') {
+      cur++;
+      return true;
+    }
+    while (true) {
+      skipWhitespace();
+      std::string_view name;
+      if (cur >= end || *cur != '"' || !key(name))
+        return false;
+      skipWhitespace();
+      if (cur >= end || *cur != ':')
+        return false;
+      cur++;
+      auto next = child(node, name);
+      if (next ? !scan(*next, depth + 1)
+               : (skipWhitespace(), !skipValue()))
+        return false;
+      skipWhitespace();
+      if (cur < end && *cur == ',') {
+        cur++;
+        continue;
+      }
+      return cur < end && *cur++ == '}';
+    }
+  }
+
+  bool elements(const Node &node, int depth) {
+    cur++;
+    skipWhitespace();
+    if (cur < end && *cur == ']') {
+      cur++;
+      return true;
+    }
+    for (size_t index = 0;; index++) {
+      auto next = child(node, std::to_string(index));
+      if (next ? !scan(*next, depth + 1)
+               : (skipWhitespace(), !skipValue()))
+        return false;
+      skipWhitespace();
+      if (cur < end && *cur == ',') {
+        cur++;
+        continue;
+      }
+      return cur < end && *cur++ == ']';
+    }
+  }
+};
+
+} // namespace
+
+std::shared_ptr<const Projection>
+compile(const std::vector<std::string> &paths) {
+  // Length prefixed, so that no two lists of paths share a key
+  std::string key;
+  for (auto &path : paths)
+    key += std::to_string(path.size()) + ':' + path;
+
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto cached = cache.find(key);
+    if (cached != cache.end())
+      return cached->second;
+  }
+
+  auto projection = build(paths);
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  if (cache.size() >= maxCached)
+    cache.clear();
+  cache.emplace(std::move(key), projection);
+  return projection;
+}
+
+bool evaluate(const Projection &projection, std::string_view json,
+              std::vector<std::string_view> &values) {
+  values.assign(projection.paths, std::string_view());
+  Scanner scanner{json.data(), json.data() + json.size(), values, {}};
+  if (!scanner.scan(projection.root, 0))
+    return false;
+  scanner.skipWhitespace();
+  return scanner.cur == scanner.end;
+}
+
+} // namespace anoncredsProjection
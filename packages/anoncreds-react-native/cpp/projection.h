@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Reads selected values out of the JSON of an object, for `project`.
+//
+// A path is either a JSON pointer, `/identifiers/0/schema_id`, or a dotted
+// path, `$.identifiers[0].schema_id` or `requested_proof.revealed_attrs`, in
+// which keys that are not plain names are written `["key"]`. The empty
+// pointer and `$` select the whole object.
+//
+// The paths of a projection are compiled into one tree and all of them are
+// evaluated in a single pass over the JSON: members that no path leads into
+// are skipped without being decoded, and a selected value is returned as the
+// range of JSON it spans. Compiled projections are cached by their list of
+// paths, so repeating a projection only scans the JSON.
+namespace anoncredsProjection {
+
+struct Projection;
+
+// The projection of `paths`, compiled on first use. Throws
+// `std::invalid_argument` naming the first path that is not valid.
+std::shared_ptr<const Projection>
+compile(const std::vector<std::string> &paths);
+
+// Sets `values` to the JSON of the value of every path in `json`, in the order
+// of the paths, or to a null `string_view` for paths that select nothing.
+// Returns false when `json` is not valid JSON.
+bool evaluate(const Projection &projection, std::string_view json,
+              std::vector<std::string_view> &values);
+
+} // namespace anoncredsProjection
@@ -0,0 +1,44 @@
+#include "propNameRegistry.h"
+
+namespace anoncredsPropNames {
+
+namespace {
+
+std::vector<const char *> &names() {
+  static std::vector<const char *> names;
+  return names;
+}
+
+thread_local Registry *activeRegistry = nullptr;
+
+} // namespace
+
+Registry::Registry(jsi::Runtime &rt) {
+  ids.reserve(names().size());
+  for (auto name : names()) {
+    ids.emplace_back(jsi::PropNameID::forAscii(rt, name));
+  }
+}
+
+size_t Registry::reserve(const char *name) {
+  names().push_back(name);
+  return names().size() - 1;
+}
+
+const jsi::PropNameID &Registry::get(jsi::Runtime &rt, size_t slot) {
+  if (slot >= ids.size())
+    ids.resize(slot + 1);
+  if (!ids[slot])
+    ids[slot].emplace(jsi::PropNameID::forAscii(rt, names()[slot]));
+  return *ids[slot];
+}
+
+Registry *Registry::active() { return activeRegistry; }
+
+Registry::Scope::Scope(Registry &registry) : previous(activeRegistry) {
+  activeRegistry = &registry;
+}
+
+Registry::Scope::~Scope() { activeRegistry = previous; }
+
+} // namespace anoncredsPropNames
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+#include <optional>
+#include <vector>
+
+using namespace facebook;
+
+// Pre-created `jsi::PropNameID`s for the option keys of the bindings.
+//
+// Every key used by a binding reserves a slot when the library is loaded. Each
+// runtime the turbo module is installed into owns one registry holding the
+// `PropNameID` of every slot, so decoding an option no longer creates a
+// `PropNameID` from a C string on every call.
+namespace anoncredsPropNames {
+
+class Registry {
+public:
+  // Creates the `PropNameID`s of all slots reserved so far
+  explicit Registry(jsi::Runtime &rt);
+
+  // Reserves a slot for `name`. Called during static initialisation, `name`
+  // must outlive the program.
+  static size_t reserve(const char *name);
+
+  // `PropNameID` of `slot`, created on first use if it was reserved after the
+  // registry
+  const jsi::PropNameID &get(jsi::Runtime &rt, size_t slot);
+
+  // Registry of the runtime that is currently calling into a binding, or
+  // `nullptr` outside of a call
+  static Registry *active();
+
+  // Makes `registry` the active registry of the current thread for the lifetime
+  // of the scope
+  class Scope {
+  public:
+    explicit Scope(Registry &registry);
+    ~Scope();
+
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+  private:
+    Registry *previous;
+  };
+
+private:
+  std::vector<std::optional<jsi::PropNameID>> ids;
+};
+
+} // namespace anoncredsPropNames
@@ -0,0 +1,294 @@
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "scheduler.h"
+
+namespace anoncredsScheduler {
+
+namespace {
+
+static const size_t defaultMaxQueued = 64;
+
+// Workers are kept below the number of cores, so that the JS threads are not
+// starved by proofs running in the background
+static const unsigned maxWorkers = 4;
+
+struct Entry {
+  uint64_t id;
+  Priority priority;
+  Clock::time_point submitted;
+  std::optional<Clock::time_point> deadline;
+  std::shared_ptr<std::atomic<bool>> canceled;
+  std::function<void(Outcome, const std::atomic<bool> &)> run;
+};
+
+struct Running {
+  Priority priority;
+  std::shared_ptr<std::atomic<bool>> canceled;
+};
+
+struct Counters {
+  uint64_t submitted = 0;
+  uint64_t rejected = 0;
+  uint64_t expired = 0;
+  uint64_t canceled = 0;
+  uint64_t failed = 0;
+  uint64_t completed = 0;
+  uint64_t started = 0;
+  double totalWaitMs = 0;
+  double maxWaitMs = 0;
+};
+
+struct State {
+  std::mutex mutex;
+  // Signalled when a job is queued, for the workers
+  std::condition_variable queuedJob;
+  // Signalled when a job with a deadline is queued, for the reaper
+  std::condition_variable queuedDeadline;
+  // By `Priority`, oldest first
+  std::array<std::deque<Entry>, priorities> queues;
+  std::unordered_map<uint64_t, Running> running;
+  std::array<Counters, priorities> counters;
+  size_t queued = 0;
+  size_t maxQueued = defaultMaxQueued;
+  size_t workers = 0;
+  uint64_t nextId = 1;
+};
+
+// Never destroyed, as the threads that use it are never joined
+State &state() {
+  static auto *state = new State();
+  return *state;
+}
+
+Counters &counters(State &state, Priority priority) {
+  return state.counters[size_t(priority)];
+}
+
+// Removes the queued jobs whose deadline is before `now`. Called with the
+// mutex held.
+std::vector<Entry> takeExpired(State &state, Clock::time_point now) {
+  std::vector<Entry> expired;
+  if (state.queued == 0)
+    return expired;
+  for (auto &queue : state.queues) {
+    for (auto entry = queue.begin(); entry != queue.end();) {
+      if (!entry->deadline || *entry->deadline > now) {
+        ++entry;
+        continue;
+      }
+      counters(state, entry->priority).expired++;
+      expired.push_back(std::move(*entry));
+      entry = queue.erase(entry);
+      state.queued--;
+    }
+  }
+  return expired;
+}
+
+// Hands dropped jobs back to their owners. Called without the mutex, as they
+// may submit or cancel jobs. A job that throws is already counted as dropped.
+void drop(std::vector<Entry> &entries, Outcome outcome) {
+  for (auto &entry : entries) {
+    try {
+      entry.run(outcome, *entry.canceled);
+    } catch (...) {
+    }
+  }
+}
+
+std::optional<Clock::time_point> nextDeadline(State &state) {
+  std::optional<Clock::time_point> next;
+  for (auto &queue : state.queues)
+    for (auto &entry : queue)
+      if (entry.deadline && (!next || *entry.deadline < *next))
+        next = entry.deadline;
+  return next;
+}
+
+void work() {
+  auto &state = anoncredsScheduler::state();
+  while (true) {
+    std::vector<Entry> expired;
+    std::optional<Entry> entry;
+    {
+      std::unique_lock<std::mutex> lock(state.mutex);
+      state.queuedJob.wait(lock, [&] { return state.queued > 0; });
+      auto now = Clock::now();
+      expired = takeExpired(state, now);
+      for (auto &queue : state.queues) {
+        if (queue.empty())
+          continue;
+        entry.emplace(std::move(queue.front()));
+        queue.pop_front();
+        state.queued--;
+        break;
+      }
+
+      if (entry) {
+        auto &counters = anoncredsScheduler::counters(state, entry->priority);
+        auto wait = std::chrono::duration<double, std::milli>(
+                        now - entry->submitted)
+                        .count();
+        counters.started++;
+        counters.totalWaitMs += wait;
+        counters.maxWaitMs = std::max(counters.maxWaitMs, wait);
+        state.running.emplace(entry->id,
+                              Running{entry->priority, entry->canceled});
+      }
+    }
+
+    drop(expired, Outcome::Expired);
+    if (!entry)
+      continue;
+    auto failed = false;
+    try {
+      entry->run(Outcome::Started, *entry->canceled);
+    } catch (...) {
+      failed = true;
+    }
+
+    // A job canceled while it ran is already counted as canceled
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.running.erase(entry->id);
+    auto &counters = anoncredsScheduler::counters(state, entry->priority);
+    if (entry->canceled->load())
+      continue;
+    if (failed)
+      counters.failed++;
+    else
+      counters.completed++;
+  }
+}
+
+// Drops queued jobs once their deadline passes, also while every worker is
+// busy
+void reap() {
+  auto &state = anoncredsScheduler::state();
+  while (true) {
+    std::vector<Entry> expired;
+    {
+      std::unique_lock<std::mutex> lock(state.mutex);
+      auto next = nextDeadline(state);
+      if (next)
+        state.queuedDeadline.wait_until(lock, *next);
+      else
+        state.queuedDeadline.wait(lock);
+      expired = takeExpired(state, Clock::now());
+    }
+    drop(expired, Outcome::Expired);
+  }
+}
+
+// Starts the workers and the reaper. Called with the mutex held.
+void start(State &state) {
+  auto cores = std::thread::hardware_concurrency();
+  state.workers = std::clamp(cores > 1 ? cores - 1 : 1, 1u, maxWorkers);
+  for (size_t i = 0; i < state.workers; i++)
+    std::thread(work).detach();
+  std::thread(reap).detach();
+}
+
+} // namespace
+
+uint64_t submit(Job job) {
+  auto &state = anoncredsScheduler::state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  auto &counters = anoncredsScheduler::counters(state, job.priority);
+  if (state.queued >= state.maxQueued) {
+    counters.rejected++;
+    return 0;
+  }
+  if (state.workers == 0)
+    start(state);
+
+  auto id = state.nextId++;
+  auto hasDeadline = job.deadline.has_value();
+  state.queues[size_t(job.priority)].push_back(
+      Entry{.id = id,
+            .priority = job.priority,
+            .submitted = Clock::now(),
+            .deadline = job.deadline,
+            .canceled = std::make_shared<std::atomic<bool>>(false),
+            .run = std::move(job.run)});
+  state.queued++;
+  counters.submitted++;
+
+  state.queuedJob.notify_one();
+  if (hasDeadline)
+    state.queuedDeadline.notify_one();
+  return id;
+}
+
+bool cancel(uint64_t id) {
+  auto &state = anoncredsScheduler::state();
+  std::vector<Entry> canceled;
+  {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for (auto &queue : state.queues) {
+      auto entry = std::find_if(queue.begin(), queue.end(),
+                                [id](auto &entry) { return entry.id == id; });
+      if (entry == queue.end())
+        continue;
+      counters(state, entry->priority).canceled++;
+      canceled.push_back(std::move(*entry));
+      queue.erase(entry);
+      state.queued--;
+      break;
+    }
+
+    if (canceled.empty()) {
+      auto running = state.running.find(id);
+      if (running == state.running.end())
+        return false;
+      if (!running->second.canceled->exchange(true))
+        counters(state, running->second.priority).canceled++;
+      return true;
+    }
+  }
+
+  drop(canceled, Outcome::Canceled);
+  return true;
+}
+
+void setMaxQueued(size_t maxQueued) {
+  auto &state = anoncredsScheduler::state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+  state.maxQueued = maxQueued;
+}
+
+Metrics metrics(bool reset) {
+  auto &state = anoncredsScheduler::state();
+  std::lock_guard<std::mutex> lock(state.mutex);
+
+  Metrics metrics;
+  metrics.running = state.running.size();
+  metrics.workers = state.workers;
+  metrics.maxQueued = state.maxQueued;
+  for (size_t i = 0; i < priorities; i++) {
+    auto &counters = state.counters[i];
+    metrics.classes[i] = ClassMetrics{
+        .queued = state.queues[i].size(),
+        .submitted = counters.submitted,
+        .rejected = counters.rejected,
+        .expired = counters.expired,
+        .canceled = counters.canceled,
+        .failed = counters.failed,
+        .completed = counters.completed,
+        .averageWaitMs = counters.started > 0
+                             ? counters.totalWaitMs / double(counters.started)
+                             : 0,
+        .maxWaitMs = counters.maxWaitMs};
+    if (reset)
+      counters = Counters{};
+  }
+  return metrics;
+}
+
+} // namespace anoncredsScheduler
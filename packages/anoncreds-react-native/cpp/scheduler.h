@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+// Runs the jobs started by the bindings, such as `execute` with a callback, on
+// a fixed pool of worker threads shared by every runtime.
+//
+// Queued jobs start in the order of their priority class, and of submission
+// within a class, so a job the user is waiting for never queues behind
+// background work. A job with a deadline that has not started by then is
+// dropped. A job can be canceled by its id: a queued job is dropped, a running
+// one sees its cancellation flag set and can stop early. The queue is bounded
+// and `submit` rejects jobs once it is full.
+namespace anoncredsScheduler {
+
+using Clock = std::chrono::steady_clock;
+
+enum class Priority {
+  UserBlocking,
+  Normal,
+  Background,
+};
+
+constexpr size_t priorities = 3;
+
+// How a job is handed back to its owner
+enum class Outcome {
+  Started,
+  Canceled,
+  Expired,
+};
+
+struct Job {
+  Priority priority = Priority::Normal;
+  // Dropped when it has not started by then
+  std::optional<Clock::time_point> deadline;
+  // Called once: on a worker thread with `Outcome::Started` and the flag that
+  // is set when the job is canceled while it runs, or on the thread that drops
+  // the job with the reason it was dropped
+  std::function<void(Outcome outcome, const std::atomic<bool> &canceled)> run;
+};
+
+// Every job that is not queued or running ends up in exactly one of
+// `rejected`, `expired`, `canceled`, `failed` and `completed`
+struct ClassMetrics {
+  // Jobs waiting in the queue
+  size_t queued = 0;
+  uint64_t submitted = 0;
+  // Not queued as the queue was full
+  uint64_t rejected = 0;
+  // Dropped as their deadline passed
+  uint64_t expired = 0;
+  // Canceled while queued or running
+  uint64_t canceled = 0;
+  // Threw while running
+  uint64_t failed = 0;
+  uint64_t completed = 0;
+  // Time from submission to start of the jobs that started
+  double averageWaitMs = 0;
+  double maxWaitMs = 0;
+};
+
+struct Metrics {
+  // By `Priority`
+  std::array<ClassMetrics, priorities> classes;
+  size_t running = 0;
+  size_t workers = 0;
+  size_t maxQueued = 0;
+};
+
+// Queues `job` and returns its id, or 0 when the queue is full
+uint64_t submit(Job job);
+
+// Cancels job `id`. Returns false when it is neither queued nor running.
+bool cancel(uint64_t id);
+
+// Limits the number of queued jobs, over all classes. Jobs already queued are
+// kept.
+void setMaxQueued(size_t maxQueued);
+
+// Current queue depths and the counters since the last reset
+Metrics metrics(bool reset = false);
+
+} // namespace anoncredsScheduler
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include "handleRegistry.h"
+#include "library.h"
+#include "objectFile.h"
+#include "parsers.h"
+#include "snapshot.h"
+
+// File layout, integers are little endian:
+//
+//   "ACSN" version:u8
+//   typeCount:u32 { length:u16 name:bytes }
+//   objectCount:u32 { type:u16 offset:u64 length:u64 }
+//   JSON of the objects, at `offset` from the start of the file
+namespace anoncredsSnapshot {
+
+namespace {
+
+const char magic[] = "ACSN";
+const uint8_t version = 1;
+
+using anoncredsObjectFile::append;
+
+struct Snapshot {
+  explicit Snapshot(const std::string &path) : file(path) {}
+
+  anoncredsObjectFile::MappedFile file;
+};
+
+struct Entry {
+  // Released once the object is parsed, the file is unmapped with the last
+  std::shared_ptr<Snapshot> snapshot;
+  const anoncredsParsers::Parser *parser;
+  size_t offset;
+  size_t length;
+  ObjectHandle object = 0;
+};
+
+std::mutex snapshotMutex;
+std::unordered_map<ObjectHandle, Entry> entries;
+ObjectHandle nextHandle = firstRestoredHandle;
+
+// The outputs of libanoncreds gathered for a snapshot, freed with it
+struct Outputs {
+  std::vector<const char *> typeNames;
+  std::vector<ByteBuffer> bodies;
+
+  ~Outputs() {
+    for (auto typeName : typeNames)
+      anoncredsLibrary::anoncreds_string_free((char *)typeName);
+    for (auto &body : bodies)
+      anoncredsLibrary::anoncreds_buffer_free(body);
+  }
+};
+
+} // namespace
+
+ErrorCode write(const std::vector<ObjectHandle> &handles,
+                const std::string &path) {
+  Outputs outputs;
+  for (auto handle : handles) {
+    const char *typeName = nullptr;
+    auto code =
+        anoncredsLibrary::anoncreds_object_get_type_name(handle, &typeName);
+    if (code != ErrorCode::Success)
+      return code;
+    outputs.typeNames.push_back(typeName);
+
+    if (anoncredsParsers::findByTypeName(typeName) == nullptr)
+      throw std::runtime_error(std::string("Objects of type ") + typeName +
+                               " can not be restored from a snapshot");
+
+    ByteBuffer body{};
+    code = anoncredsLibrary::anoncreds_object_get_json(handle, &body);
+    if (code != ErrorCode::Success)
+      return code;
+    outputs.bodies.push_back(body);
+  }
+
+  std::vector<std::string_view> types;
+  std::vector<uint16_t> typeIndices;
+  for (auto typeName : outputs.typeNames) {
+    auto type = std::find(types.begin(), types.end(), typeName);
+    typeIndices.push_back(uint16_t(type - types.begin()));
+    if (type == types.end())
+      types.push_back(typeName);
+  }
+
+  std::string index(magic, 4);
+  append<uint8_t>(index, version);
+  append<uint32_t>(index, types.size());
+  for (auto type : types) {
+    append<uint16_t>(index, type.size());
+    index += type;
+  }
+  append<uint32_t>(index, handles.size());
+
+  // Entries are fixed size, so the offset of the first body is known
+  uint64_t offset = index.size() + handles.size() * (2 + 8 + 8);
+  for (size_t i = 0; i < handles.size(); i++) {
+    append<uint16_t>(index, typeIndices[i]);
+    append<uint64_t>(index, offset);
+    append<uint64_t>(index, outputs.bodies[i].len);
+    offset += outputs.bodies[i].len;
+  }
+
+  std::vector<std::pair<const uint8_t *, size_t>> parts{
+      {(const uint8_t *)index.data(), index.size()}};
+  for (auto &body : outputs.bodies)
+    parts.emplace_back(body.data, size_t(body.len));
+  anoncredsObjectFile::writeFile(path, parts);
+  return ErrorCode::Success;
+}
+
+std::vector<ObjectHandle> restore(const std::string &path) {
+  auto snapshot = std::make_shared<Snapshot>(path);
+  auto &file = snapshot->file;
+  anoncredsObjectFile::Reader reader(file, path, "snapshot");
+
+  if (std::memcmp(reader.take(4), magic, 4) != 0 ||
+      reader.read<uint8_t>() != version)
+    reader.invalid();
+
+  std::vector<const anoncredsParsers::Parser *> parsers;
+  for (auto count = reader.read<uint32_t>(); count > 0; count--) {
+    auto length = reader.read<uint16_t>();
+    auto name = reader.take(length);
+    auto parser = anoncredsParsers::findByTypeName(
+        std::string_view((const char *)name, length));
+    if (parser == nullptr)
+      reader.invalid();
+    parsers.push_back(parser);
+  }
+
+  std::vector<Entry> restored;
+  for (auto count = reader.read<uint32_t>(); count > 0; count--) {
+    auto type = reader.read<uint16_t>();
+    auto offset = reader.read<uint64_t>();
+    auto length = reader.read<uint64_t>();
+    if (type >= parsers.size() || offset > file.size() ||
+        length > file.size() - offset)
+      reader.invalid();
+    restored.push_back(Entry{.snapshot = snapshot,
+                             .parser = parsers[type],
+                             .offset = size_t(offset),
+                             .length = size_t(length)});
+  }
+
+  std::lock_guard<std::mutex> lock(snapshotMutex);
+  std::vector<ObjectHandle> handles;
+  for (auto &entry : restored) {
+    handles.push_back(nextHandle);
+    entries.emplace(nextHandle++, std::move(entry));
+  }
+  return handles;
+}
+
+ErrorCode resolve(ObjectHandle handle, ObjectHandle *object) {
+  std::lock_guard<std::mutex> lock(snapshotMutex);
+  auto entry = entries.find(handle);
+  if (entry == entries.end()) {
+    *object = handle;
+    return ErrorCode::Success;
+  }
+  if (entry->second.object != 0) {
+    *object = entry->second.object;
+    return ErrorCode::Success;
+  }
+
+  auto &restored = entry->second;
+  auto code = restored.parser->parse(
+      ByteBuffer{.len = int64_t(restored.length),
+                 .data = (uint8_t *)restored.snapshot->file.data() +
+                         restored.offset},
+      object);
+  if (code != ErrorCode::Success)
+    return code;
+
+  restored.object = *object;
+  restored.snapshot.reset();
+  // Used from now on, the object must not be freed with a scope it happens to
+  // be first used in
+  anoncredsHandleRegistry::Site site(restored.parser->binding);
+  anoncredsHandleRegistry::track(*object, false);
+  return ErrorCode::Success;
+}
+
+ObjectHandle release(ObjectHandle handle) {
+  std::lock_guard<std::mutex> lock(snapshotMutex);
+  auto entry = entries.find(handle);
+  if (entry == entries.end())
+    return 0;
+  auto object = entry->second.object;
+  entries.erase(entry);
+  return object;
+}
+
+} // namespace anoncredsSnapshot
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "include/libanoncreds.h"
+
+// Snapshots of objects, for warm starts.
+//
+// A snapshot is one file holding the JSON of a set of objects with an index of
+// their types and offsets. Restoring it only maps the file and reads the
+// index. Every object gets a restored handle right away but is only parsed
+// when a binding first uses that handle, so objects that are never used
+// during a session are never parsed.
+//
+// Restored handles are numbers from `firstRestoredHandle` up, which
+// libanoncreds never hands out, and stay valid after their object is parsed.
+// Failing to open, map or write a file, or a file that is not a snapshot,
+// throws `std::runtime_error`. Errors of libanoncreds are returned as usual.
+namespace anoncredsSnapshot {
+
+// Above the handles of libanoncreds, and below 2^53 so JS numbers hold them
+// exactly
+static const ObjectHandle firstRestoredHandle = ObjectHandle(1) << 52;
+
+inline bool isRestored(ObjectHandle handle) {
+  return handle >= firstRestoredHandle && handle < 2 * firstRestoredHandle;
+}
+
+// Writes the objects `handles` to a snapshot at `path`
+ErrorCode write(const std::vector<ObjectHandle> &handles,
+                const std::string &path);
+
+// Maps the snapshot at `path` and returns the restored handles of its
+// objects, in the order they were written
+std::vector<ObjectHandle> restore(const std::string &path);
+
+// Sets `object` to the object restored `handle` stands for, parsing it on
+// first use. Handles that are not restored handles are returned as is.
+ErrorCode resolve(ObjectHandle handle, ObjectHandle *object);
+
+// Forgets the restored `handle` and returns the object it was parsed into, to
+// be freed by the caller, or 0 when it was never used
+ObjectHandle release(ObjectHandle handle);
+
+} // namespace anoncredsSnapshot
@@ -1,19 +1,21 @@
+#include <algorithm>
 #include <vector>
 
+#include "HostObject.h"
+#include "library.h"
+#include "snapshot.h"
 #include "turboModuleUtility.h"
 
 namespace anoncredsTurboModuleUtility {
 
 using byteVector = std::vector<uint8_t>;
 
-std::shared_ptr<react::CallInvoker> invoker;
-
 void registerTurboModule(jsi::Runtime &rt,
                          std::shared_ptr<react::CallInvoker> jsCallInvoker) {
-  // Setting the callInvoker for async code
-  invoker = jsCallInvoker;
-  // Create a TurboModuleRustHostObject
-  auto instance = std::make_shared<AnoncredsTurboModuleHostObject>(rt);
+  // Create a TurboModuleRustHostObject, which keeps the callInvoker of this
+  // runtime for async code
+  auto instance = std::make_shared<AnoncredsTurboModuleHostObject>(
+      rt, std::move(jsCallInvoker));
   // Create a JS equivalent object of the instance
   jsi::Object jsInstance = jsi::Object::createFromHostObject(rt, instance);
   // Register the object on global
@@ -24,48 +26,85 @@ void assertValueIsObject(jsi::Runtime &rt, const jsi::Value *val) {
   val->asObject(rt);
 }
 
-template <>
-jsi::Value createReturnValue(jsi::Runtime &rt, ErrorCode code,
-                             nullptr_t value) {
-  auto object = jsi::Object(rt);
-
-  if (code == ErrorCode::Success) {
-    object.setProperty(rt, "value", jsi::Value::null());
+namespace {
+
+// Global property holding the error constructor set by `setErrorConstructor`
+const char errorConstructorName[] = "_anoncredsErrorConstructor";
+
+thread_local ReturnConvention activeConvention;
+thread_local const std::shared_ptr<react::CallInvoker> *currentInvoker =
+    nullptr;
+
+// The libanoncreds error `json` of a call that failed with `code`, as thrown
+// to JS
+jsi::JSError toJSError(jsi::Runtime &rt, ErrorCode code, const char *json) {
+  jsi::Value error;
+  if (json != nullptr) {
+    auto parse = rt.global()
+                     .getPropertyAsObject(rt, "JSON")
+                     .getPropertyAsFunction(rt, "parse");
+    error = parse.call(rt, jsi::String::createFromUtf8(rt, json));
+  } else {
+    auto object = jsi::Object(rt);
+    object.setProperty(rt, "code", int(code));
+    object.setProperty(rt, "message", "Unknown error");
+    error = std::move(object);
   }
 
-  object.setProperty(rt, "errorCode", int(code));
+  auto constructor = rt.global().getProperty(rt, errorConstructorName);
+  if (constructor.isObject() && constructor.getObject(rt).isFunction(rt))
+    error = constructor.getObject(rt).getFunction(rt).callAsConstructor(rt,
+                                                                        error);
+  return jsi::JSError(rt, std::move(error));
+}
 
-  return object;
+// The error of the call that just failed with `code`, as thrown to JS
+jsi::JSError currentError(jsi::Runtime &rt, ErrorCode code) {
+  const char *json = nullptr;
+  anoncredsLibrary::anoncreds_get_current_error(&json);
+  auto error = toJSError(rt, code, json);
+  if (json != nullptr)
+    anoncredsLibrary::anoncreds_string_free((char *)json);
+  return error;
 }
 
-template <>
-jsi::Value createReturnValue(jsi::Runtime &rt, ErrorCode code,
-                             const char **value) {
-  auto object = jsi::Object(rt);
+} // namespace
 
-  if (code == ErrorCode::Success) {
-    auto isNullptr = value == nullptr || *value == nullptr;
-    auto valueWithoutNullptr = isNullptr
-                                   ? jsi::Value::null()
-                                   : jsi::String::createFromAscii(rt, *value);
-    object.setProperty(rt, "value", valueWithoutNullptr);
+void setErrorConstructor(jsi::Runtime &rt, const jsi::Value &constructor) {
+  rt.global().setProperty(rt, errorConstructorName, constructor);
+}
 
-    if (!isNullptr) anoncreds_string_free((char *)*value);
-  }
+ReturnConventionScope::ReturnConventionScope(ReturnConvention convention)
+    : previous(activeConvention) {
+  activeConvention = convention;
+}
 
-  object.setProperty(rt, "errorCode", int(code));
+ReturnConventionScope::~ReturnConventionScope() { activeConvention = previous; }
 
-  return object;
+const ReturnConvention &ReturnConvention::active() { return activeConvention; }
+
+InvokerScope::InvokerScope(const std::shared_ptr<react::CallInvoker> &invoker)
+    : previous(currentInvoker) {
+  currentInvoker = &invoker;
 }
 
-template <>
-jsi::Value createReturnValue(jsi::Runtime &rt, ErrorCode code, int8_t *value) {
+InvokerScope::~InvokerScope() { currentInvoker = previous; }
+
+std::shared_ptr<react::CallInvoker> activeInvoker() {
+  return currentInvoker ? *currentInvoker : nullptr;
+}
+
+jsi::Value returnValue(jsi::Runtime &rt, ErrorCode code, jsi::Value value) {
+  if (activeConvention.throwing) {
+    if (code != ErrorCode::Success)
+      throw currentError(rt, code);
+    return value;
+  }
+
   auto object = jsi::Object(rt);
 
   if (code == ErrorCode::Success) {
-    auto valueWithoutNullptr =
-        value == nullptr ? jsi::Value::null() : jsi::Value(rt, int(*value));
-    object.setProperty(rt, "value", valueWithoutNullptr);
+    object.setProperty(rt, "value", value);
   }
 
   object.setProperty(rt, "errorCode", int(code));
@@ -73,112 +112,113 @@ jsi::Value createReturnValue(jsi::Runtime &rt, ErrorCode code, int8_t *value) {
   return object;
 }
 
-template <>
-jsi::Value createReturnValue(jsi::Runtime &rt, ErrorCode code,
-                             ObjectHandle *value) {
-  auto object = jsi::Object(rt);
+jsi::Value returnError(jsi::Runtime &rt, ErrorCode code,
+                       const std::string &json) {
+  if (activeConvention.throwing)
+    throw toJSError(rt, code, json.empty() ? nullptr : json.c_str());
+  return returnValue(rt, code, jsi::Value::undefined());
+}
 
-  if (code == ErrorCode::Success) {
-    auto valueWithoutNullptr =
-        value == nullptr ? jsi::Value::null() : jsi::Value(rt, int(*value));
-    object.setProperty(rt, "value", valueWithoutNullptr);
-  }
+ObjectHandle restoredObject(jsi::Runtime &rt, ObjectHandle handle) {
+  ObjectHandle object;
+  auto code = anoncredsSnapshot::resolve(handle, &object);
+  if (code != ErrorCode::Success)
+    throw currentError(rt, code);
+  return object;
+}
 
-  object.setProperty(rt, "errorCode", int(code));
+jsi::Value fromReturnObject(jsi::Runtime &rt, jsi::Value result) {
+  if (!activeConvention.throwing || !result.isObject())
+    return result;
 
-  return object;
+  auto object = result.getObject(rt);
+  auto code = object.getProperty(rt, "errorCode");
+  if (!code.isNumber())
+    return result;
+
+  return returnValue(rt, ErrorCode(code.getNumber()),
+                     object.getProperty(rt, "value"));
 }
 
 template <>
 jsi::Value createReturnValue(jsi::Runtime &rt, ErrorCode code,
-                             ByteBuffer *value) {
-  auto object = jsi::Object(rt);
+                             nullptr_t value) {
+  return returnValue(rt, code, jsi::Value::null());
+}
 
-  if (code == ErrorCode::Success) {
-    auto valueWithoutNullptr =
-        value == nullptr
-            ? jsi::Value::null()
-            : jsi::String::createFromUtf8(rt, value->data, value->len);
-    object.setProperty(rt, "value", valueWithoutNullptr);
+template <>
+jsi::Value createReturnValue(jsi::Runtime &rt, ErrorCode code,
+                             const char **value) {
+  if (code != ErrorCode::Success)
+    return returnValue(rt, code, jsi::Value::undefined());
 
-    if (value != nullptr) anoncreds_buffer_free(*value);
-  }
+  auto isNullptr = value == nullptr || *value == nullptr;
+  auto valueWithoutNullptr = isNullptr
+                                 ? jsi::Value::null()
+                                 : jsi::String::createFromAscii(rt, *value);
 
-  object.setProperty(rt, "errorCode", int(code));
+  if (!isNullptr) anoncredsLibrary::anoncreds_string_free((char *)*value);
 
-  return object;
+  return returnValue(rt, code, std::move(valueWithoutNullptr));
 }
 
 template <>
-jsi::Value createReturnValue(jsi::Runtime &rt, ErrorCode code,
-                             anoncreds::CredentialDefinitionReturn *value) {
-  auto object = jsi::Object(rt);
-
-  if (code == ErrorCode::Success) {
-    if (value == nullptr) {
-      object.setProperty(rt, "value", jsi::Value::null());
-    } else {
-      auto objectValue = jsi::Object(rt);
-      objectValue.setProperty(rt, "credentialDefinition",
-                              int(value->credentialDefinition));
-      objectValue.setProperty(rt, "credentialDefinitionPrivate",
-                              int(value->credentialDefinitionPrivate));
-      objectValue.setProperty(rt, "keyCorrectnessProof",
-                              int(value->keyCorrectnessProof));
-      object.setProperty(rt, "value", objectValue);
-    }
-  }
+jsi::Value createReturnValue(jsi::Runtime &rt, ErrorCode code, int8_t *value) {
+  if (code != ErrorCode::Success)
+    return returnValue(rt, code, jsi::Value::undefined());
 
-  object.setProperty(rt, "errorCode", int(code));
+  auto valueWithoutNullptr =
+      value == nullptr ? jsi::Value::null() : jsi::Value(rt, int(*value));
 
-  return object;
+  return returnValue(rt, code, std::move(valueWithoutNullptr));
 }
 
 template <>
 jsi::Value createReturnValue(jsi::Runtime &rt, ErrorCode code,
-                             anoncreds::CredentialRequestReturn *value) {
-  auto object = jsi::Object(rt);
+                             ObjectHandle *value) {
+  if (code != ErrorCode::Success)
+    return returnValue(rt, code, jsi::Value::undefined());
 
-  if (code == ErrorCode::Success) {
-    if (value == nullptr) {
-      object.setProperty(rt, "value", jsi::Value::null());
-    } else {
-      auto objectValue = jsi::Object(rt);
-      objectValue.setProperty(rt, "credentialRequest",
-                              int(value->credentialRequest));
-      objectValue.setProperty(rt, "credentialRequestMetadata",
-                              int(value->credentialRequestMetadata));
-      object.setProperty(rt, "value", objectValue);
-    }
-  }
+  auto valueWithoutNullptr =
+      value == nullptr ? jsi::Value::null() : jsi::Value(rt, int(*value));
 
-  object.setProperty(rt, "errorCode", int(code));
+  return returnValue(rt, code, std::move(valueWithoutNullptr));
+}
 
-  return object;
+// Copied into an `ArrayBuffer` created through its JS constructor, which works
+// with every version of JSI
+template <>
+jsi::Value createReturnValue(jsi::Runtime &rt, ErrorCode code,
+                             byteVector *value) {
+  if (code != ErrorCode::Success)
+    return returnValue(rt, code, jsi::Value::undefined());
+  if (value == nullptr)
+    return returnValue(rt, code, jsi::Value::null());
+
+  auto buffer = rt.global()
+                    .getPropertyAsFunction(rt, "ArrayBuffer")
+                    .callAsConstructor(rt, double(value->size()))
+                    .getObject(rt);
+  std::copy(value->begin(), value->end(),
+            buffer.getArrayBuffer(rt).data(rt));
+
+  return returnValue(rt, code, std::move(buffer));
 }
 
 template <>
-jsi::Value
-createReturnValue(jsi::Runtime &rt, ErrorCode code,
-                  anoncreds::RevocationRegistryDefinitionReturn *value) {
-  auto object = jsi::Object(rt);
+jsi::Value createReturnValue(jsi::Runtime &rt, ErrorCode code,
+                             ByteBuffer *value) {
+  if (code != ErrorCode::Success)
+    return returnValue(rt, code, jsi::Value::undefined());
 
-  if (code == ErrorCode::Success) {
-    if (value == nullptr) {
-      object.setProperty(rt, "value", jsi::Value::null());
-    } else {
-      auto objectValue = jsi::Object(rt);
-      objectValue.setProperty(rt, "revocationRegistryDefinition",
-                              int(value->revocationRegistryDefinition));
-      objectValue.setProperty(rt, "revocationRegistryDefinitionPrivate",
-                              int(value->revocationRegistryDefinitionPrivate));
-      object.setProperty(rt, "value", objectValue);
-    }
-  }
+  auto valueWithoutNullptr =
+      value == nullptr
+          ? jsi::Value::null()
+          : jsi::String::createFromUtf8(rt, value->data, value->len);
 
-  object.setProperty(rt, "errorCode", int(code));
+  if (value != nullptr) anoncredsLibrary::anoncreds_buffer_free(*value);
 
-  return object;
+  return returnValue(rt, code, std::move(valueWithoutNullptr));
 }
 
 template <>
@@ -252,33 +292,6 @@ int32_t jsiToValue(jsi::Runtime &rt, jsi::Object &options, const char *name,
   throw jsi::JSError(rt, errorPrefix + name + errorInfix + "number");
 };
 
-template <>
-std::vector<int32_t>
-jsiToValue<std::vector<int32_t>>(jsi::Runtime &rt, jsi::Object &options,
-                                 const char *name, bool optional) {
-  jsi::Value value = options.getProperty(rt, name);
-
-  if (value.isObject() && value.asObject(rt).isArray(rt)) {
-    std::vector<int32_t> vec = {};
-    jsi::Array arr = value.asObject(rt).asArray(rt);
-    size_t length = arr.length(rt);
-    for (int i = 0; i < length; i++) {
-      jsi::Value element = arr.getValueAtIndex(rt, i);
-      if (element.isNumber()) {
-        vec.push_back(element.asNumber());
-      } else {
-        throw jsi::JSError(rt, errorPrefix + name + errorInfix + "number");
-      }
-    }
-    return vec;
-  }
-
-  if (optional)
-    return {};
-
-  throw jsi::JSError(rt, errorPrefix + name + errorInfix + "Array<number>");
-}
-
 template <>
 ObjectHandle jsiToValue(jsi::Runtime &rt, jsi::Object &options,
                         const char *name, bool optional) {
@@ -293,345 +306,39 @@ ObjectHandle jsiToValue(jsi::Runtime &rt, jsi::Object &options,
                      errorPrefix + name + errorInfix + "ObjectHandle.handle");
 };
 
-template <>
-FfiCredentialEntry jsiToValue(jsi::Runtime &rt, jsi::Object &options,
-                              const char *name, bool optional) {
-  jsi::Value value = options.getProperty(rt, name);
-  if ((value.isNull() || value.isUndefined()) && optional)
-    return FfiCredentialEntry{};
-
-  if (value.isObject()) {
-    jsi::Object valueAsObject = value.asObject(rt);
-    auto credential = jsiToValue<ObjectHandle>(rt, valueAsObject, "credential");
-    auto timestamp = jsiToValue<int32_t>(rt, valueAsObject, "timestamp", true);
-    auto revocationState =
-        jsiToValue<ObjectHandle>(rt, valueAsObject, "revocationState", true);
-
-    return FfiCredentialEntry{.credential = credential,
-                              .timestamp = timestamp,
-                              .rev_state = revocationState};
-  }
-
-  throw jsi::JSError(rt, errorPrefix + name + errorInfix + "CredentialEntry");
-};
-
-template <>
-FfiCredentialProve jsiToValue(jsi::Runtime &rt, jsi::Object &options,
-                              const char *name, bool optional) {
-  jsi::Value value = options.getProperty(rt, name);
-  if ((value.isNull() || value.isUndefined()) && optional)
-    return FfiCredentialProve{};
-
-  if (value.isObject()) {
-    jsi::Object valueAsObject = value.asObject(rt);
-    auto entryIndex = jsiToValue<int64_t>(rt, valueAsObject, "entryIndex");
-    auto referent = jsiToValue<std::string>(rt, valueAsObject, "referent");
-    auto isPredicate = jsiToValue<int8_t>(rt, valueAsObject, "isPredicate");
-    auto reveal = jsiToValue<int8_t>(rt, valueAsObject, "reveal");
-
-    return FfiCredentialProve{.entry_idx = entryIndex,
-                              .is_predicate = isPredicate,
-                              .referent = referent.c_str(),
-                              .reveal = reveal};
-  }
-
-  throw jsi::JSError(rt, errorPrefix + name + errorInfix + "CredentialProve");
-};
-
-template <>
-FfiList_FfiCredentialEntry
-jsiToValue<FfiList_FfiCredentialEntry>(jsi::Runtime &rt, jsi::Object &options,
-                                       const char *name, bool optional) {
-  jsi::Value value = options.getProperty(rt, name);
-
-  if (value.isObject() && value.asObject(rt).isArray(rt)) {
-    auto arr = value.asObject(rt).asArray(rt);
-    auto len = arr.length(rt);
-
-    auto credentialEntry = new FfiCredentialEntry[arrayMaxSize];
-
-    // TODO: error Handling
-    for (int i = 0; i < len; i++) {
-      auto element = arr.getValueAtIndex(rt, i);
-      auto valueAsObject = element.asObject(rt);
+std::optional<ByteSpan> bytesOf(jsi::Runtime &rt, const jsi::Value &value) {
+  if (!value.isObject())
+    return std::nullopt;
 
-      auto credential =
-          jsiToValue<ObjectHandle>(rt, valueAsObject, "credential");
-      auto timestamp =
-          jsiToValue<int32_t>(rt, valueAsObject, "timestamp", true);
-      auto revocationState =
-          jsiToValue<ObjectHandle>(rt, valueAsObject, "revocationState", true);
-
-      credentialEntry[i] = *new FfiCredentialEntry[sizeof(FfiCredentialEntry)];
-      credentialEntry[i] = FfiCredentialEntry{.credential = credential,
-                                              .timestamp = timestamp,
-                                              .rev_state = revocationState};
-    }
-
-    return FfiList_FfiCredentialEntry{.count = len, .data = credentialEntry};
+  auto object = value.getObject(rt);
+  if (object.isArrayBuffer(rt)) {
+    auto buffer = object.getArrayBuffer(rt);
+    return ByteSpan{.data = buffer.data(rt), .size = buffer.size(rt)};
   }
 
-  if (optional)
-    return FfiList_FfiCredentialEntry{};
-
-  throw jsi::JSError(rt, errorPrefix + name + errorInfix + "Array<number>");
-}
-
-template <>
-FfiList_FfiCredentialProve
-jsiToValue<FfiList_FfiCredentialProve>(jsi::Runtime &rt, jsi::Object &options,
-                                       const char *name, bool optional) {
-  jsi::Value value = options.getProperty(rt, name);
-
-  if (value.isObject() && value.asObject(rt).isArray(rt)) {
-    auto arr = value.asObject(rt).asArray(rt);
-    auto len = arr.length(rt);
-
-    auto credentialProve = new FfiCredentialProve[len];
-
-    // TODO: error Handling
-    for (int i = 0; i < len; i++) {
-      auto element = arr.getValueAtIndex(rt, i);
-      auto valueAsObject = element.asObject(rt);
-
-      auto entryIndex = jsiToValue<int64_t>(rt, valueAsObject, "entryIndex");
-      auto referent = jsiToValue<std::string>(rt, valueAsObject, "referent");
-      auto isPredicate = jsiToValue<int8_t>(rt, valueAsObject, "isPredicate");
-      auto reveal = jsiToValue<int8_t>(rt, valueAsObject, "reveal");
-
-      char *ffiStr = new char[referent.length() + 1];
-      std::copy(referent.begin(), referent.end(), ffiStr);
-      ffiStr[referent.length()] = '\0';
-
-      credentialProve[i] = *new FfiCredentialProve[sizeof(FfiCredentialProve)];
-      credentialProve[i] = FfiCredentialProve{.entry_idx = entryIndex,
-                                              .is_predicate = isPredicate,
-                                              .referent = ffiStr,
-                                              .reveal = reveal};
-    }
-    return FfiList_FfiCredentialProve{.count = len, .data = credentialProve};
+  auto view = object.getProperty(rt, "buffer");
+  auto offset = object.getProperty(rt, "byteOffset");
+  auto length = object.getProperty(rt, "byteLength");
+  if (view.isObject() && view.getObject(rt).isArrayBuffer(rt) &&
+      offset.isNumber() && length.isNumber()) {
+    auto buffer = view.getObject(rt).getArrayBuffer(rt);
+    if (offset.getNumber() + length.getNumber() <= buffer.size(rt))
+      return ByteSpan{.data = buffer.data(rt) + size_t(offset.getNumber()),
+                      .size = size_t(length.getNumber())};
   }
-
-  if (optional)
-    return FfiList_FfiCredentialProve{};
-
-  throw jsi::JSError(rt, errorPrefix + name + errorInfix + "Array<number>");
+  return std::nullopt;
 }
 
 template <>
-FfiList_ObjectHandle
-jsiToValue<FfiList_ObjectHandle>(jsi::Runtime &rt, jsi::Object &options,
-                                 const char *name, bool optional) {
-  jsi::Value value = options.getProperty(rt, name);
-
-  if (value.isObject() && value.asObject(rt).isArray(rt)) {
-    auto arr = value.asObject(rt).asArray(rt);
-    auto len = arr.length(rt);
-
-    auto objectHandle = new ObjectHandle[arrayMaxSize];
-
-    // TODO: error Handling
-    for (int i = 0; i < len; i++) {
-      auto element = arr.getValueAtIndex(rt, i);
-      auto valueAsNumber = element.asNumber();
-
-      objectHandle[i] = *new size_t[sizeof(valueAsNumber)];
-      objectHandle[i] = size_t(valueAsNumber);
-    }
-    return FfiList_ObjectHandle{.count = len, .data = objectHandle};
-  }
-
-  if (optional)
-    return FfiList_ObjectHandle{};
-
-  throw jsi::JSError(rt, errorPrefix + name + errorInfix + "Array<number>");
-}
-
-template <>
-FfiList_FfiStr jsiToValue<FfiList_FfiStr>(jsi::Runtime &rt,
-                                          jsi::Object &options,
-                                          const char *name, bool optional) {
-  jsi::Value value = options.getProperty(rt, name);
-
-  if (value.isObject() && value.asObject(rt).isArray(rt)) {
-    auto arr = value.asObject(rt).asArray(rt);
-    auto len = arr.length(rt);
-
-    if (len == 0) {
-      return FfiList_FfiStr{};
-    }
-    char **ffiStr = new char *[len];
-
-    for (int i = 0; i < len; i++) {
-      // TODO: check if string first
-      jsi::Value element = arr.getValueAtIndex(rt, i);
-      std::string s = element.asString(rt).utf8(rt);
-      ffiStr[i] = new char[s.length() + 1];
-      std::copy(s.begin(), s.end(), ffiStr[i]);
-      ffiStr[i][s.length()] = '\0';
-    }
-
-    return FfiList_FfiStr{.count = len, .data = ffiStr};
-  }
-
-  if (optional) {
-    return FfiList_FfiStr{};
-  }
-
-  throw jsi::JSError(rt, errorPrefix + name + errorInfix + "Array<string>");
-}
-
-template <>
-FfiList_i32 jsiToValue<FfiList_i32>(jsi::Runtime &rt, jsi::Object &options,
-                                    const char *name, bool optional) {
-  jsi::Value value = options.getProperty(rt, name);
-
-  if (value.isObject() && value.asObject(rt).isArray(rt)) {
-    auto arr = value.asObject(rt).asArray(rt);
-    auto len = arr.length(rt);
-
-    auto num = new int32_t[arrayMaxSize];
-
-    // TODO: error Handling
-    for (int i = 0; i < len; i++) {
-      auto element = arr.getValueAtIndex(rt, i);
-      auto valueAsNumber = element.asNumber();
-
-      num[i] = *new int32_t[sizeof(valueAsNumber)];
-      num[i] = int32_t(valueAsNumber);
-    }
-
-    return FfiList_i32{.count = len, .data = num};
-  }
-
-  if (optional)
-    return FfiList_i32{};
-
-  throw jsi::JSError(rt, errorPrefix + name + errorInfix + "Array<number>");
-}
-
-template <>
-FfiCredRevInfo jsiToValue(jsi::Runtime &rt, jsi::Object &options,
-                          const char *name, bool optional) {
-  jsi::Value value = options.getProperty(rt, name);
-  if ((value.isNull() || value.isUndefined()) && optional)
-    return FfiCredRevInfo{};
-
-  if (value.isObject()) {
-    jsi::Object valueAsObject = value.asObject(rt);
-    auto registryDefinition =
-        jsiToValue<ObjectHandle>(rt, valueAsObject, "registryDefinition");
-    auto registryDefinitionPrivate = jsiToValue<ObjectHandle>(
-        rt, valueAsObject, "registryDefinitionPrivate");
-    auto registryIndex =
-        jsiToValue<int64_t>(rt, valueAsObject, "registryIndex");
-
-    return FfiCredRevInfo{.reg_def = registryDefinition,
-                          .reg_def_private = registryDefinitionPrivate,
-                          .reg_idx = registryIndex};
-  }
-
-  throw jsi::JSError(rt, errorPrefix + name + errorInfix +
-                             "CredentialRevocationConfig");
-};
-
-template <>
-FfiNonrevokedIntervalOverride jsiToValue(jsi::Runtime &rt, jsi::Object &options,
-                                         const char *name, bool optional) {
+ByteSpan jsiToValue(jsi::Runtime &rt, jsi::Object &options, const char *name,
+                    bool optional) {
   jsi::Value value = options.getProperty(rt, name);
   if ((value.isNull() || value.isUndefined()) && optional)
-    return FfiNonrevokedIntervalOverride{};
-
-  if (value.isObject()) {
-    jsi::Object valueAsObject = value.asObject(rt);
-    auto requestedFromTimestamp =
-        jsiToValue<int32_t>(rt, valueAsObject, "requestedFromTimestamp");
-    auto overrideRevocationStatusListTimestamp = jsiToValue<int32_t>(
-        rt, valueAsObject, "overrideRevocationStatusListTimestamp");
-    auto revocationRegistryDefinitionId = jsiToValue<std::string>(
-        rt, valueAsObject, "revocationRegistryDefinitionId");
-
-    return FfiNonrevokedIntervalOverride{
-        .rev_reg_def_id = revocationRegistryDefinitionId.c_str(),
-        .requested_from_ts = requestedFromTimestamp,
-        .override_rev_status_list_ts = overrideRevocationStatusListTimestamp};
-  }
+    return ByteSpan{};
 
-  throw jsi::JSError(rt, errorPrefix + name + errorInfix +
-                             "NonrevokedIntervalOverride");
+  if (auto bytes = bytesOf(rt, value))
+    return *bytes;
+  throw jsi::JSError(rt, errorPrefix + name + errorInfix + "ArrayBuffer");
 };
 
-template <>
-FfiList_FfiNonrevokedIntervalOverride
-jsiToValue<FfiList_FfiNonrevokedIntervalOverride>(jsi::Runtime &rt,
-                                                  jsi::Object &options,
-                                                  const char *name,
-                                                  bool optional) {
-  jsi::Value value = options.getProperty(rt, name);
-
-  if (value.isObject() && value.asObject(rt).isArray(rt)) {
-    auto arr = value.asObject(rt).asArray(rt);
-    auto len = arr.length(rt);
-
-    auto nonRevokedInterValOverrides =
-        new FfiNonrevokedIntervalOverride[arrayMaxSize];
-
-    // TODO: error Handling
-    for (int i = 0; i < len; i++) {
-      auto element = arr.getValueAtIndex(rt, i);
-      auto valueAsObject = element.asObject(rt);
-
-      auto requestedFromTimestamp =
-          jsiToValue<int32_t>(rt, valueAsObject, "requestedFromTimestamp");
-      auto overrideRevocationStatusListTimestamp = jsiToValue<int32_t>(
-          rt, valueAsObject, "overrideRevocationStatusListTimestamp");
-      auto revocationRegistryDefinitionId = jsiToValue<std::string>(
-          rt, valueAsObject, "revocationRegistryDefinitionId");
-
-      nonRevokedInterValOverrides[i] =
-          *new FfiNonrevokedIntervalOverride[sizeof(
-              FfiNonrevokedIntervalOverride)];
-      nonRevokedInterValOverrides[i] = FfiNonrevokedIntervalOverride{
-          .rev_reg_def_id = revocationRegistryDefinitionId.c_str(),
-          .requested_from_ts = requestedFromTimestamp,
-          .override_rev_status_list_ts = overrideRevocationStatusListTimestamp};
-    }
-
-    return FfiList_FfiNonrevokedIntervalOverride{
-        .count = len, .data = nonRevokedInterValOverrides};
-  }
-
-  if (optional)
-    return FfiList_FfiNonrevokedIntervalOverride{};
-
-  throw jsi::JSError(rt, errorPrefix + name + errorInfix +
-                             "Array<NonRevokedIntervalOverride>");
-}
-
-template <>
-ByteBuffer jsiToValue<ByteBuffer>(jsi::Runtime &rt, jsi::Object &options,
-                                  const char *name, bool optional) {
-  ByteBuffer buffer;
-  
-  if (optional && !options.hasProperty(rt, name)) {
-    buffer.data = nullptr;
-    buffer.len = 0;
-    return buffer;
-  }
-
-  auto value = options.getProperty(rt, name);
-  if (value.isString()) {
-    std::string str = value.asString(rt).utf8(rt);
-    size_t len = str.size();
-    uint8_t *c = new uint8_t[len + 1];
-    std::copy(str.begin(), str.end(), c);
-    c[len] = '\0';
-    buffer.data = c;
-    buffer.len = len;
-    return buffer;
-  }
-
-  throw jsi::JSError(rt, errorPrefix + name + errorInfix + "string");
-}
-
 } // namespace anoncredsTurboModuleUtility
@@ -3,13 +3,16 @@
 #include <ReactCommon/CallInvoker.h>
 #include <jsi/jsi.h>
 
-#include "HostObject.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include "include/libanoncreds.h"
 
 using namespace facebook;
 
 namespace anoncredsTurboModuleUtility {
-static const int32_t arrayMaxSize = 255;
 static const std::string errorPrefix = "Value `";
 static const std::string errorInfix = "` is not of type ";
 
@@ -21,19 +24,62 @@ struct State {
   State(jsi::Function *cb_) : cb(std::move(*cb_)) {}
 };
 
-// Install the Turbomodule
+// Installs the Turbomodule as `_anoncreds` on the global object of `rt`.
+//
+// It can be installed into any number of runtimes, such as a worklet runtime
+// or a second Hermes instance running on a background thread, and each gets
+// its own module. `jsCallInvoker` schedules work on the thread of `rt` and is
+// only needed by calls that take a callback, it can be null for runtimes that
+// have none. Object handles are process-global and can be passed from one
+// runtime to another.
 void registerTurboModule(jsi::Runtime &rt,
                          std::shared_ptr<react::CallInvoker> jsCallInvoker);
 
+// Call invoker of the runtime that is currently calling into a binding, null
+// outside of a call or when its module was installed without one
+std::shared_ptr<react::CallInvoker> activeInvoker();
+
+// Makes `invoker` the active call invoker of the current thread for the
+// lifetime of the scope. `invoker` must outlive the scope.
+class InvokerScope {
+public:
+  explicit InvokerScope(const std::shared_ptr<react::CallInvoker> &invoker);
+  ~InvokerScope();
+
+  InvokerScope(const InvokerScope &) = delete;
+  InvokerScope &operator=(const InvokerScope &) = delete;
+
+private:
+  const std::shared_ptr<react::CallInvoker> *previous;
+};
+
 // Asserts that a jsi::Value is an object and can be safely transformed
 void assertValueIsObject(jsi::Runtime &rt, const jsi::Value *val);
 
+// Bytes of an `ArrayBuffer` or of a view on one, such as a `Uint8Array`,
+// decoded by `jsiToValue`. They point into the buffer, which stays alive while
+// the options object it was read from is.
+struct ByteSpan {
+  const uint8_t *data = nullptr;
+  size_t size = 0;
+};
+
+// Bytes of `value` when it is an `ArrayBuffer` or a view on one
+std::optional<ByteSpan> bytesOf(jsi::Runtime &rt, const jsi::Value &value);
+
 // Converts jsi values to regular cpp values
 template <typename T>
 T jsiToValue(jsi::Runtime &rt, jsi::Object &options, const char *name,
              bool optional = false);
 
-// Instantiate a return object for JS side.
+// The object that a handle restored from a snapshot stands for, parsed on first
+// use. Other handles are returned as is. Throws the libanoncreds error when the
+// object can not be parsed.
+ObjectHandle restoredObject(jsi::Runtime &rt, ObjectHandle handle);
+
+// How bindings hand their result back to JS.
+//
+// By default a return object is created:
 // ```typescript
 // type ReturnObject = {
 //   errorCode: number
@@ -44,6 +90,49 @@ T jsiToValue(jsi::Runtime &rt, jsi::Object &options, const char *name,
 // Value will be defined if there is no error.
 // Value will be `null` if there is no value to return
 // Value will be undefined if there is an error, e.g. error code != 0
+//
+// With the throwing convention the value is returned as is, and a failed call
+// throws the libanoncreds error, `{ code, message, extra? }`, passed through
+// the error constructor of the runtime when it is set. The error is read right
+// after the call, so JS does not need to call `getCurrentError`.
+struct ReturnConvention {
+  bool throwing = false;
+
+  static const ReturnConvention &active();
+};
+
+// Makes `constructor` the error constructor of `rt`, or removes it when it is
+// undefined. It is kept on the global object rather than natively, so the
+// runtime owns it and releases it when it is torn down.
+void setErrorConstructor(jsi::Runtime &rt, const jsi::Value &constructor);
+
+// Makes `convention` the one used on the current thread for the lifetime of
+// the scope
+class ReturnConventionScope {
+public:
+  explicit ReturnConventionScope(ReturnConvention convention);
+  ~ReturnConventionScope();
+
+  ReturnConventionScope(const ReturnConventionScope &) = delete;
+  ReturnConventionScope &operator=(const ReturnConventionScope &) = delete;
+
+private:
+  ReturnConvention previous;
+};
+
+// Returns `value`, or reports `code`, following the active convention
+jsi::Value returnValue(jsi::Runtime &rt, ErrorCode code, jsi::Value value);
+
+// Reports a failed call with `code` and the libanoncreds error `json`, read
+// earlier, following the active convention
+jsi::Value returnError(jsi::Runtime &rt, ErrorCode code,
+                       const std::string &json);
+
+// Converts a return object into the active convention, for results that were
+// created under the default one
+jsi::Value fromReturnObject(jsi::Runtime &rt, jsi::Value result);
+
+// Converts the output of a call and returns it following the active convention
 template <typename T>
 jsi::Value createReturnValue(jsi::Runtime &rt, ErrorCode code, T out);
 
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <thread>
+
+#include "workerPool.h"
+
+namespace anoncredsWorkerPool {
+
+namespace {
+
+// A call of `parallelFor`, shared with the workers that help with it
+struct Loop {
+  const std::function<void(size_t)> *work = nullptr;
+  size_t count = 0;
+  std::atomic<size_t> next = 0;
+
+  std::mutex mutex;
+  // Signalled when the last helping worker leaves a closed loop
+  std::condition_variable left;
+  size_t helping = 0;
+  // Set once the caller ran out of items. Workers that pick the loop up later
+  // leave it right away, as `work` may be gone by then.
+  bool closed = false;
+  std::exception_ptr error;
+};
+
+struct Pool {
+  std::mutex mutex;
+  std::condition_variable queued;
+  // A loop for every worker asked to help with it
+  std::deque<std::shared_ptr<Loop>> loops;
+  size_t workers = 0;
+  bool started = false;
+};
+
+// Never destroyed, as the threads that use it are never joined
+Pool &pool() {
+  static auto *pool = new Pool();
+  return *pool;
+}
+
+// Runs items of `loop` until none are left
+void drain(Loop &loop) {
+  for (auto i = loop.next++; i < loop.count; i = loop.next++) {
+    try {
+      (*loop.work)(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(loop.mutex);
+      if (!loop.error)
+        loop.error = std::current_exception();
+      loop.next = loop.count;
+    }
+  }
+}
+
+void help(Loop &loop) {
+  {
+    std::lock_guard<std::mutex> lock(loop.mutex);
+    if (loop.closed)
+      return;
+    loop.helping++;
+  }
+  drain(loop);
+
+  std::lock_guard<std::mutex> lock(loop.mutex);
+  if (--loop.helping == 0 && loop.closed)
+    loop.left.notify_one();
+}
+
+void work() {
+  auto &pool = anoncredsWorkerPool::pool();
+  while (true) {
+    std::shared_ptr<Loop> loop;
+    {
+      std::unique_lock<std::mutex> lock(pool.mutex);
+      pool.queued.wait(lock, [&] { return !pool.loops.empty(); });
+      loop = std::move(pool.loops.front());
+      pool.loops.pop_front();
+    }
+    help(*loop);
+  }
+}
+
+// Starts a worker per core next to the calling thread. When a thread can not
+// be started the pool makes do with the workers it has. Called with the mutex
+// held.
+void start(Pool &pool) {
+  pool.started = true;
+  auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+  for (unsigned i = 1; i < cores; i++) {
+    try {
+      std::thread(work).detach();
+    } catch (const std::system_error &) {
+      break;
+    }
+    pool.workers++;
+  }
+}
+
+} // namespace
+
+void parallelFor(size_t count, const std::function<void(size_t)> &work) {
+  if (count == 0)
+    return;
+
+  auto loop = std::make_shared<Loop>();
+  loop->work = &work;
+  loop->count = count;
+
+  {
+    auto &pool = anoncredsWorkerPool::pool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    if (!pool.started)
+      start(pool);
+    // The calling thread takes one of the items
+    auto helpers = std::min(pool.workers, count - 1);
+    try {
+      for (size_t i = 0; i < helpers; i++)
+        pool.loops.push_back(loop);
+    } catch (const std::bad_alloc &) {
+    }
+    pool.queued.notify_all();
+  }
+
+  drain(*loop);
+
+  std::unique_lock<std::mutex> lock(loop->mutex);
+  loop->closed = true;
+  loop->left.wait(lock, [&] { return loop->helping == 0; });
+  if (loop->error)
+    std::rethrow_exception(loop->error);
+}
+
+} // namespace anoncredsWorkerPool
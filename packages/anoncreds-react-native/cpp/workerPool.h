@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+// Runs the parallel loops of the module, such as the parsing of
+// `batchFromJson` and the bulk encoder of `encodeAttributes`, on one pool of
+// worker threads shared by every runtime.
+//
+// The workers are started on first use, one per core next to the calling
+// thread, and live as long as the process, so a loop does not pay for
+// creating threads. The calling thread works through the loop as well, and
+// never waits for a worker that has not picked the loop up yet, so loops can
+// run from several threads at once, or from inside another loop.
+namespace anoncredsWorkerPool {
+
+// Calls `work(i)` for every `i` below `count` and returns once every call
+// returned. When a call throws, the items that did not start yet are skipped
+// and the first exception is rethrown.
+void parallelFor(size_t count, const std::function<void(size_t)> &work);
+
+} // namespace anoncredsWorkerPool
@@ -1,21 +1,152 @@
-import type { NativeCredentialProve, NativeNonRevokedIntervalOverride } from '@hyperledger/anoncreds-shared'
+import type {
+  AnoncredsErrorObject,
+  JsonObject,
+  NativeCredentialProve,
+  NativeNonRevokedIntervalOverride,
+} from '@hyperledger/anoncreds-shared'
 import type { ReturnObject } from './serialize'
 
 // Alias for _Handle.handle
 type Handle = number
 
+// Positional forms of the native structs, in FFI field order
+export type CredentialEntryTuple = [credential: Handle, timestamp: number, revocationState: Handle]
+export type CredentialProveTuple = [entryIndex: number, referent: string, isPredicate: boolean, reveal: boolean]
+export type NonRevokedIntervalOverrideTuple = [
+  revocationRegistryDefinitionId: string,
+  requestedFromTimestamp: number,
+  overrideRevocationStatusListTimestamp: number,
+]
+
+export type LiveHandleStatistics = {
+  count: number
+  // Approximate, the length of the JSON representations
+  bytes: number
+}
+
+export type LiveHandle = {
+  handle: Handle
+  type: string
+  // Binding that created the handle
+  site: string
+  // Unix time in milliseconds
+  createdAt: number
+  bytes: number
+}
+
+// What `receiveCredential` indexes a credential by. The ids are `null` when the credential does not have them, and
+// `values` holds the raw value of every credential attribute by name.
+export type ReceivedCredentialAttributes = {
+  schema_id: string | null
+  cred_def_id: string | null
+  rev_reg_id: string | null
+  rev_reg_index: string | null
+  values: Record<string, string>
+}
+
+// A requested attribute or predicate that none of the credentials passed to `solvePresentation` can answer
+export type UnsatisfiedReferent = {
+  referent: string
+  isPredicate: boolean
+  reason: string
+}
+
+// What a presentation verified by `verifyPresentationWithDetails` discloses, by referent. Only `verified` is set
+// when the presentation does not verify.
+export type PresentationDetails = {
+  verified: boolean
+  revealedAttributes?: Record<string, string>
+  revealedAttributeGroups?: Record<string, Record<string, string>>
+  selfAttestedAttributes?: Record<string, string>
+  predicates?: string[]
+  identifiers?: Array<{
+    schemaId: string
+    credentialDefinitionId: string
+    revocationRegistryId: string | null
+    timestamp: number | null
+  }>
+}
+
+// Attributes `names` of every object of `objectHandles`, read by the bulk getters
+export type AttributesOptions = { objectHandles: number[]; names: string[] }
+
+// An array per attribute name with the value of every object, `null` when it is not set
+export type AttributeColumns = Record<string, Array<string | null>>
+
+// Handle returned by the command at index `slot` of a command buffer, or its
+// output named `output` for bindings that return several handles
+export type CommandReference = { slot: number; output?: string }
+
+// Binding name with its arguments, as an options object or positionally
+export type Command = [binding: string, args: unknown[] | Record<string, unknown>]
+
+// Priority class of a job run by the native scheduler, such as `execute` with a callback
+export type JobPriority = 'userBlocking' | 'normal' | 'background'
+
+export type JobClassMetrics = {
+  queued: number
+  submitted: number
+  rejected: number
+  expired: number
+  canceled: number
+  failed: number
+  completed: number
+  averageWaitMs: number
+  maxWaitMs: number
+}
+
+export type SchedulerMetrics = {
+  classes: Record<JobPriority, JobClassMetrics>
+  running: number
+  workers: number
+  maxQueued: number
+}
+
+// Objects that can be parsed by `batchFromJson`, `importFromFile` and `fromCbor`, named after their `*FromJson` binding
+export type BatchFromJsonType =
+  | 'credential'
+  | 'credentialDefinition'
+  | 'credentialDefinitionPrivate'
+  | 'credentialOffer'
+  | 'credentialRequest'
+  | 'credentialRequestMetadata'
+  | 'keyCorrectnessProof'
+  | 'presentation'
+  | 'presentationRequest'
+  | 'revocationRegistry'
+  | 'revocationRegistryDefinition'
+  | 'revocationRegistryDefinitionPrivate'
+  | 'revocationState'
+  | 'revocationStatusList'
+  | 'schema'
+  | 'w3cCredential'
+  | 'w3cPresentation'
+
+// Every binding accepts either an options object or its arguments
+// positionally, in the order of the FFI parameters. Only the positional forms
+// used by `ReactNativeAnoncreds` are typed.
+//
+// Bindings return a `ReturnObject` by default. After
+// `setReturnConvention({ throwing: 1 })` they return its `value` as is and
+// throw the error of a failed call, through `errorConstructor` when it is set.
+// `ReactNativeAnoncreds` always sets the throwing convention, so the bindings
+// are typed by the value they return under it.
+
+// The value a binding returns under the throwing convention
+export type Returns<T> = T
+
 export type NativeBindings = {
   version(options: Record<never, never>): string
   getCurrentError(options: Record<never, never>): string
 
-  setDefaultLogger(options: Record<never, never>): ReturnObject<null>
-  generateNonce(options: Record<never, never>): ReturnObject<string>
+  setDefaultLogger(options: Record<never, never>): Returns<null>
+  generateNonce(options: Record<never, never>): Returns<string>
   createSchema(options: {
     name: string
     version: string
     issuerId: string
     attributeNames: string[]
-  }): ReturnObject<Handle>
+  }): Returns<Handle>
 
   createRevocationStatusList(options: {
     credentialDefinition: Handle
@@ -25,7 +156,7 @@ export type NativeBindings = {
     issuerId: string
     timestamp?: number
     issuanceByDefault: number
-  }): ReturnObject<Handle>
+  }): Returns<Handle>
 
   updateRevocationStatusList(options: {
     credentialDefinition: Handle
@@ -35,12 +166,12 @@ export type NativeBindings = {
     issued?: number[]
     revoked?: number[]
     timestamp?: number
-  }): ReturnObject<Handle>
+  }): Returns<Handle>
 
   updateRevocationStatusListTimestampOnly(options: {
     timestamp: number
     currentRevocationStatusList: Handle
-  }): ReturnObject<Handle>
+  }): Returns<Handle>
 
   createCredentialDefinition(options: {
     schemaId: string
@@ -49,7 +180,7 @@ export type NativeBindings = {
     tag: string
     signatureType: string
     supportRevocation: number
-  }): ReturnObject<{ credentialDefinition: Handle; credentialDefinitionPrivate: Handle; keyCorrectnessProof: Handle }>
+  }): Returns<{ credentialDefinition: Handle; credentialDefinitionPrivate: Handle; keyCorrectnessProof: Handle }>
 
   createCredential(options: {
     credentialDefinition: number
@@ -65,21 +196,21 @@ export type NativeBindings = {
       revocationRegistryDefinitionPrivate: number
       revocationStatusList?: number
     }
-  }): ReturnObject<Handle>
-  encodeCredentialAttributes(options: { attributeRawValues: string[] }): ReturnObject<string>
+  }): Returns<Handle>
+  encodeCredentialAttributes(options: { attributeRawValues: string[] }): Returns<string>
   processCredential(options: {
     credential: number
     credentialRequestMetadata: number
     linkSecret: string
     credentialDefinition: number
     revocationRegistryDefinition?: number
-  }): ReturnObject<Handle>
+  }): Returns<Handle>
 
   createCredentialOffer(options: {
     schemaId: string
     credentialDefinitionId: string
     keyCorrectnessProof: number
-  }): ReturnObject<Handle>
+  }): Returns<Handle>
 
   createCredentialRequest(options: {
     entropy?: string
@@ -88,9 +219,9 @@ export type NativeBindings = {
     linkSecret: string
     linkSecretId: string
     credentialOffer: number
-  }): ReturnObject<{ credentialRequest: Handle; credentialRequestMetadata: Handle }>
+  }): Returns<{ credentialRequest: Handle; credentialRequestMetadata: Handle }>
 
-  createLinkSecret(options: Record<never, never>): ReturnObject<string>
+  createLinkSecret(options: Record<never, never>): Returns<string>
 
   createPresentation(options: {
     presentationRequest: number
@@ -103,7 +234,19 @@ export type NativeBindings = {
     schemas: number[]
     credentialDefinitionIds: string[]
     credentialDefinitions: number[]
-  }): ReturnObject<Handle>
+  }): Returns<Handle>
+  createPresentation(
+    presentationRequest: Handle,
+    credentials: CredentialEntryTuple[],
+    credentialsProve: CredentialProveTuple[],
+    selfAttestNames: string[],
+    selfAttestValues: string[],
+    linkSecret: string,
+    schemas: Handle[],
+    schemaIds: string[],
+    credentialDefinitions: Handle[],
+    credentialDefinitionIds: string[]
+  ): Returns<Handle>
 
   verifyPresentation(options: {
     presentation: number
@@ -116,7 +259,19 @@ export type NativeBindings = {
     revocationRegistryDefinitionIds?: string[]
     revocationStatusLists?: number[]
     nonRevokedIntervalOverrides?: NativeNonRevokedIntervalOverride[]
-  }): ReturnObject<number>
+  }): Returns<number>
+  verifyPresentation(
+    presentation: Handle,
+    presentationRequest: Handle,
+    schemas: Handle[],
+    schemaIds: string[],
+    credentialDefinitions: Handle[],
+    credentialDefinitionIds: string[],
+    revocationRegistryDefinitions?: Handle[],
+    revocationRegistryDefinitionIds?: string[],
+    revocationStatusLists?: Handle[],
+    nonRevokedIntervalOverrides?: NonRevokedIntervalOverrideTuple[]
+  ): Returns<number>
 
   createRevocationRegistryDefinition(options: {
     credentialDefinition: number
@@ -126,11 +281,9 @@ export type NativeBindings = {
     revocationRegistryType: string
     maximumCredentialNumber: number
     tailsDirectoryPath?: string
-  }): ReturnObject<{
-    registryDefinition: Handle
-    registryDefinitionPrivate: Handle
-    registryEntry: Handle
-    registryInitDelta: Handle
+  }): Returns<{
+    revocationRegistryDefinition: Handle
+    revocationRegistryDefinitionPrivate: Handle
   }>
 
   createOrUpdateRevocationState(options: {
@@ -140,51 +293,201 @@ export type NativeBindings = {
     tailsPath: string
     oldRevocationState?: number
     oldRevocationStatusList?: number
-  }): ReturnObject<Handle>
+  }): Returns<Handle>
+
+  presentationRequestFromJson(options: { json: string }): Returns<Handle>
+
+  schemaGetAttribute(options: { objectHandle: number; name: string }): Returns<string>
+
+  revocationRegistryDefinitionGetAttribute(options: { objectHandle: number; name: string }): Returns<string>
+
+  credentialGetAttribute(options: { objectHandle: number; name: string }): Returns<string>
+
+  credentialGetAttributes(options: AttributesOptions): Returns<AttributeColumns>
+
+  w3cCredentialProofGetAttributes(options: AttributesOptions): Returns<AttributeColumns>
+
+  revocationRegistryDefinitionGetAttributes(options: AttributesOptions): Returns<AttributeColumns>
+
+  getJson(options: { objectHandle: number }): Returns<string>
+
+  getObject(options: { objectHandle: number }): Returns<JsonObject>
+
+  project(options: { objectHandle: number; paths: string[] }): Returns<unknown[]>
+
+  getTypeName(options: { objectHandle: number }): Returns<string>
+
+  objectFree(options: { objectHandle: number }): Returns<never>
+
+  startRecording(options: { path: string }): Returns<null>
+
+  stopRecording(options: Record<never, never>): Returns<null>
+
+  setReturnConvention(options: {
+    throwing: number
+    errorConstructor?: new (error: AnoncredsErrorObject) => Error
+  }): ReturnObject<null>
+
+  getLiveHandleStatistics(options: Record<never, never>): Returns<Record<string, LiveHandleStatistics>>
+
+  getLiveHandles(options: { olderThan?: number }): Returns<LiveHandle[]>
+
+  beginScope(options: Record<never, never>): Returns<number>
+
+  endScope(options: { scope: number; keep?: number[] }): Returns<null>
+
+  issueCredentialFromJson(options: {
+    credentialDefinition: number
+    credentialDefinitionPrivate: number
+    credentialOffer: string
+    credentialRequest: string
+    attributeNames: string[]
+    attributeRawValues: string[]
+    attributeEncodedValues?: string[]
+    revocationConfiguration?: {
+      registryIndex: number
+      revocationRegistryDefinition: number
+      revocationRegistryDefinitionPrivate: number
+      revocationStatusList?: number
+    }
+  }): Returns<string>
+
+  issueW3cCredentialFromJson(options: {
+    credentialDefinition: number
+    credentialDefinitionPrivate: number
+    credentialOffer: string
+    credentialRequest: string
+    attributeNames: string[]
+    attributeRawValues: string[]
+    revocationConfiguration?: {
+      registryIndex: number
+      revocationRegistryDefinition: number
+      revocationRegistryDefinitionPrivate: number
+      revocationStatusList?: number
+    }
+    w3cVersion?: string
+  }): Returns<string>
+
+  encodeAttributes(options: {
+    values: string[] | ArrayBuffer | ArrayBufferView
+  }): Returns<string[] | ArrayBuffer>
+
+  batchFromJson(options: {
+    entries: Array<[type: BatchFromJsonType, json: string]>
+  }): Returns<{ handles: Array<Handle | null>; errorCodes: number[] }>
+
+  exportToFile(options: { objectHandle: number; path: string }): Returns<null>
+
+  importFromFile(options: { type: BatchFromJsonType; path: string }): Returns<Handle>
+
+  toCbor(options: { objectHandle: number }): Returns<ArrayBuffer>
+
+  fromCbor(options: { type: BatchFromJsonType; bytes: ArrayBuffer | ArrayBufferView }): Returns<Handle>
 
-  presentationRequestFromJson(options: { json: string }): ReturnObject<Handle>
+  snapshot(options: { objectHandles: number[]; path: string }): Returns<null>
 
-  schemaGetAttribute(options: { objectHandle: number; name: string }): ReturnObject<string>
+  restore(options: { path: string }): Returns<Handle[]>
 
-  revocationRegistryDefinitionGetAttribute(options: { objectHandle: number; name: string }): ReturnObject<string>
+  receiveCredential(options: {
+    credential: string
+    credentialRequestMetadata: string
+    linkSecret: string
+    credentialDefinition: string | number
+    revocationRegistryDefinition?: string | number
+  }): Returns<{ credential: string; attributes: ReceivedCredentialAttributes }>
+
+  solvePresentation(options: {
+    presentationRequest: number
+    credentials: CredentialEntryTuple[]
+  }): Returns<{
+    credentials: CredentialEntryTuple[]
+    credentialsProve: CredentialProveTuple[]
+    unsatisfied: UnsatisfiedReferent[]
+  }>
 
-  credentialGetAttribute(options: { objectHandle: number; name: string }): ReturnObject<string>
+  credentialStoreAdd(options: { id: string; credential: number; tags?: Record<string, string> }): Returns<null>
 
-  getJson(options: { objectHandle: number }): ReturnObject<string>
+  credentialStoreRemove(options: { id: string }): Returns<boolean>
 
-  getTypeName(options: { objectHandle: number }): ReturnObject<string>
+  credentialStoreQuery(options: { restrictions: string; attributes?: string[] }): Returns<string[]>
 
-  objectFree(options: { objectHandle: number }): ReturnObject<never>
+  credentialStoreSave(options: { path: string }): Returns<null>
 
-  credentialDefinitionGetAttribute(options: { objectHandle: number; name: string }): ReturnObject<string>
+  credentialStoreLoad(options: { path: string }): Returns<number>
 
-  revocationRegistryDefinitionFromJson(options: { json: string }): ReturnObject<Handle>
+  credentialStoreClear(options: Record<never, never>): Returns<null>
 
-  revocationRegistryFromJson(options: { json: string }): ReturnObject<Handle>
+  verifyPresentationFromJson(options: {
+    presentation: string
+    presentationRequest: string
+    schemas: Record<string, string | number>
+    credentialDefinitions: Record<string, string | number>
+    revocationRegistryDefinitions?: Record<string, string | number>
+    revocationStatusLists?: Array<string | number>
+    nonRevokedIntervalOverrides?: NonRevokedIntervalOverrideTuple[]
+    w3c?: number
+  }): Returns<number>
 
-  revocationStatusListFromJson(options: { json: string }): ReturnObject<Handle>
+  verifyPresentationWithDetails(options: {
+    presentation: number
+    presentationRequest: number
+    schemas: number[]
+    schemaIds: string[]
+    credentialDefinitions: number[]
+    credentialDefinitionIds: string[]
+    revocationRegistryDefinitions?: number[]
+    revocationRegistryDefinitionIds?: string[]
+    revocationStatusLists?: number[]
+    nonRevokedIntervalOverrides?: NonRevokedIntervalOverrideTuple[]
+  }): Returns<PresentationDetails>
 
-  presentationFromJson(options: { json: string }): ReturnObject<Handle>
+  clearDefinitionCache(options: Record<never, never>): Returns<null>
 
-  credentialOfferFromJson(options: { json: string }): ReturnObject<Handle>
+  execute(options: { commands: Command[]; outputs?: number[] }): Returns<unknown[]>
+  // Queued on the native scheduler, returns the id of the job
+  execute(options: {
+    commands: Command[]
+    outputs?: number[]
+    priority?: JobPriority
+    deadline?: number
+    callback: (error: Error | null, results?: unknown[]) => void
+  }): Returns<number>
 
-  schemaFromJson(options: { json: string }): ReturnObject<Handle>
+  cancelJob(options: { job: number }): Returns<boolean>
 
-  credentialRequestFromJson(options: { json: string }): ReturnObject<Handle>
+  configureScheduler(options: { maxQueued: number }): Returns<null>
 
-  credentialRequestMetadataFromJson(options: { json: string }): ReturnObject<Handle>
+  getSchedulerMetrics(options: { reset?: number }): Returns<SchedulerMetrics>
 
-  credentialFromJson(options: { json: string }): ReturnObject<Handle>
+  credentialDefinitionGetAttribute(options: { objectHandle: number; name: string }): Returns<string>
 
-  revocationRegistryDefinitionPrivateFromJson(options: { json: string }): ReturnObject<Handle>
+  revocationRegistryDefinitionFromJson(options: { json: string }): Returns<Handle>
 
-  revocationStateFromJson(options: { json: string }): ReturnObject<Handle>
+  revocationRegistryFromJson(options: { json: string }): Returns<Handle>
 
-  credentialDefinitionFromJson(options: { json: string }): ReturnObject<Handle>
+  revocationStatusListFromJson(options: { json: string }): Returns<Handle>
 
-  credentialDefinitionPrivateFromJson(options: { json: string }): ReturnObject<Handle>
+  presentationFromJson(options: { json: string }): Returns<Handle>
 
-  keyCorrectnessProofFromJson(options: { json: string }): ReturnObject<Handle>
+  credentialOfferFromJson(options: { json: string }): Returns<Handle>
+
+  schemaFromJson(options: { json: string }): Returns<Handle>
+
+  credentialRequestFromJson(options: { json: string }): Returns<Handle>
+
+  credentialRequestMetadataFromJson(options: { json: string }): Returns<Handle>
+
+  credentialFromJson(options: { json: string }): Returns<Handle>
+
+  revocationRegistryDefinitionPrivateFromJson(options: { json: string }): Returns<Handle>
+
+  revocationStateFromJson(options: { json: string }): Returns<Handle>
+
+  credentialDefinitionFromJson(options: { json: string }): Returns<Handle>
+
+  credentialDefinitionPrivateFromJson(options: { json: string }): Returns<Handle>
+
+  keyCorrectnessProofFromJson(options: { json: string }): Returns<Handle>
 
   createW3cCredential(options: {
     credentialDefinition: number
@@ -200,7 +503,7 @@ export type NativeBindings = {
       revocationStatusList?: number
     }
     w3cVersion?: string
-  }): ReturnObject<Handle>
+  }): Returns<Handle>
 
   processW3cCredential(options: {
     credential: number
@@ -208,15 +511,15 @@ export type NativeBindings = {
     linkSecret: string
     credentialDefinition: number
     revocationRegistryDefinition?: number
-  }): ReturnObject<Handle>
+  }): Returns<Handle>
 
-  w3cCredentialGetIntegrityProofDetails(options: { objectHandle: number }): ReturnObject<Handle>
+  w3cCredentialGetIntegrityProofDetails(options: { objectHandle: number }): Returns<Handle>
 
-  w3cCredentialProofGetAttribute(options: { objectHandle: number; name: string }): ReturnObject<string>
+  w3cCredentialProofGetAttribute(options: { objectHandle: number; name: string }): Returns<string>
 
-  credentialToW3c(options: { objectHandle: number; issuerId: string; w3cVersion?: string }): ReturnObject<Handle>
+  credentialToW3c(options: { objectHandle: number; issuerId: string; w3cVersion?: string }): Returns<Handle>
 
-  credentialFromW3c(options: { objectHandle: number }): ReturnObject<Handle>
+  credentialFromW3c(options: { objectHandle: number }): Returns<Handle>
 
   createW3cPresentation(options: {
     presentationRequest: number
@@ -228,7 +531,18 @@ export type NativeBindings = {
     credentialDefinitionIds: string[]
     credentialDefinitions: number[]
     w3cVersion?: string
-  }): ReturnObject<Handle>
+  }): Returns<Handle>
+  createW3cPresentation(
+    presentationRequest: Handle,
+    credentials: CredentialEntryTuple[],
+    credentialsProve: CredentialProveTuple[],
+    linkSecret: string,
+    schemas: Handle[],
+    schemaIds: string[],
+    credentialDefinitions: Handle[],
+    credentialDefinitionIds: string[],
+    w3cVersion?: string
+  ): Returns<Handle>
 
   verifyW3cPresentation(options: {
     presentation: number
@@ -241,9 +555,21 @@ export type NativeBindings = {
     revocationRegistryDefinitionIds?: string[]
     revocationStatusLists?: number[]
     nonRevokedIntervalOverrides?: NativeNonRevokedIntervalOverride[]
-  }): ReturnObject<number>
-
-  w3cCredentialFromJson(options: { json: string }): ReturnObject<Handle>
-
-  w3cPresentationFromJson(options: { json: string }): ReturnObject<Handle>
+  }): Returns<number>
+  verifyW3cPresentation(
+    presentation: Handle,
+    presentationRequest: Handle,
+    schemas: Handle[],
+    schemaIds: string[],
+    credentialDefinitions: Handle[],
+    credentialDefinitionIds: string[],
+    revocationRegistryDefinitions?: Handle[],
+    revocationRegistryDefinitionIds?: string[],
+    revocationStatusLists?: Handle[],
+    nonRevokedIntervalOverrides?: NonRevokedIntervalOverrideTuple[]
+  ): Returns<number>
+
+  w3cCredentialFromJson(options: { json: string }): Returns<Handle>
+
+  w3cPresentationFromJson(options: { json: string }): Returns<Handle>
 }
@@ -1,31 +1,79 @@
 import type {
   Anoncreds,
-  AnoncredsErrorObject,
+  JsonObject,
   NativeCredentialEntry,
   NativeCredentialProve,
   NativeCredentialRevocationConfig,
   NativeNonRevokedIntervalOverride,
 } from '@hyperledger/anoncreds-shared'
-import type { NativeBindings } from './NativeBindings'
-import type { ReturnObject } from './serialize'
+import type {
+  AttributeColumns,
+  BatchFromJsonType,
+  Command,
+  CredentialEntryTuple,
+  CredentialProveTuple,
+  JobPriority,
+  LiveHandle,
+  LiveHandleStatistics,
+  NativeBindings,
+  NonRevokedIntervalOverrideTuple,
+  PresentationDetails,
+  ReceivedCredentialAttributes,
+  SchedulerMetrics,
+  UnsatisfiedReferent,
+} from './NativeBindings'
 
 import { AnoncredsError, ObjectHandle } from '@hyperledger/anoncreds-shared'
 
-import { serializeArguments } from './serialize'
+import { serializeArguments, serializeCommands } from './serialize'
 
 export class ReactNativeAnoncreds implements Anoncreds {
   private readonly anoncreds: NativeBindings
 
   public constructor(bindings: NativeBindings) {
     this.anoncreds = bindings
+    // Failed calls throw an `AnoncredsError` created natively, with the error read right after the call, so a
+    // call does not allocate a return object and an error does not need a second call to `getCurrentError`
+    this.anoncreds.setReturnConvention({ throwing: 1, errorConstructor: AnoncredsError })
   }
 
-  private handleError<T>({ errorCode, value }: ReturnObject<T>): T {
-    if (errorCode !== 0) {
-      throw new AnoncredsError(JSON.parse(this.getCurrentError()) as AnoncredsErrorObject)
-    }
+  private revocationConfiguration(configuration?: NativeCredentialRevocationConfig) {
+    return configuration
+      ? {
+          registryIndex: configuration.registryIndex,
+          revocationRegistryDefinition: configuration.revocationRegistryDefinition.handle,
+          revocationRegistryDefinitionPrivate: configuration.revocationRegistryDefinitionPrivate.handle,
+          revocationStatusList: configuration.revocationStatusList.handle,
+        }
+      : undefined
+  }
 
-    return value as T
+  private credentialEntryTuples(credentials: NativeCredentialEntry[]): CredentialEntryTuple[] {
+    return credentials.map((value) => [
+      value.credential.handle,
+      value.timestamp ?? -1,
+      value.revocationState?.handle ?? 0,
+    ])
+  }
+
+  private credentialProveTuples(credentialsProve: NativeCredentialProve[]): CredentialProveTuple[] {
+    return credentialsProve.map((value) => [value.entryIndex, value.referent, value.isPredicate, value.reveal])
+  }
+
+  private nonRevokedIntervalOverrideTuples(
+    overrides?: NativeNonRevokedIntervalOverride[]
+  ): NonRevokedIntervalOverrideTuple[] | undefined {
+    return overrides?.map((value) => [
+      value.revocationRegistryDefinitionId,
+      value.requestedFromTimestamp,
+      value.overrideRevocationStatusListTimestamp,
+    ])
+  }
+
+  private definitions(definitions: Record<string, string | ObjectHandle>): Record<string, string | number> {
+    return Object.fromEntries(
+      Object.entries(definitions).map(([id, value]) => [id, typeof value === 'string' ? value : value.handle])
+    )
   }
 
   public createRevocationStatusList(options: {
@@ -37,8 +85,8 @@ export class ReactNativeAnoncreds implements Anoncreds {
     timestamp?: number
     issuanceByDefault: boolean
   }): ObjectHandle {
-    const handle = this.handleError(
-      this.anoncreds.createRevocationStatusList(serializeArguments({ ...options, timestamp: options.timestamp ?? -1 }))
+    const handle = this.anoncreds.createRevocationStatusList(
+      serializeArguments({ ...options, timestamp: options.timestamp ?? -1 })
     )
     return new ObjectHandle(handle)
   }
@@ -47,7 +95,7 @@ export class ReactNativeAnoncreds implements Anoncreds {
     timestamp: number
     currentRevocationStatusList: ObjectHandle
   }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.updateRevocationStatusListTimestampOnly(serializeArguments(options)))
+    const handle = this.anoncreds.updateRevocationStatusListTimestampOnly(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
@@ -60,7 +108,7 @@ export class ReactNativeAnoncreds implements Anoncreds {
     revoked?: number[]
     timestamp?: number
   }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.updateRevocationStatusList(serializeArguments(options)))
+    const handle = this.anoncreds.updateRevocationStatusList(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
@@ -77,7 +125,7 @@ export class ReactNativeAnoncreds implements Anoncreds {
   }
 
   public generateNonce(): string {
-    return this.handleError(this.anoncreds.generateNonce({}))
+    return this.anoncreds.generateNonce({})
   }
 
   public createSchema(options: {
@@ -86,7 +134,7 @@ export class ReactNativeAnoncreds implements Anoncreds {
     attributeNames: string[]
     issuerId: string
   }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.createSchema(serializeArguments(options)))
+    const handle = this.anoncreds.createSchema(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
@@ -102,9 +150,8 @@ export class ReactNativeAnoncreds implements Anoncreds {
     credentialDefinitionPrivate: ObjectHandle
     keyCorrectnessProof: ObjectHandle
   } {
-    const { keyCorrectnessProof, credentialDefinition, credentialDefinitionPrivate } = this.handleError(
+    const { keyCorrectnessProof, credentialDefinition, credentialDefinitionPrivate } =
       this.anoncreds.createCredentialDefinition(serializeArguments(options))
-    )
 
     return {
       credentialDefinitionPrivate: new ObjectHandle(credentialDefinitionPrivate),
@@ -128,33 +175,31 @@ export class ReactNativeAnoncreds implements Anoncreds {
       ? Object.values(options.attributeEncodedValues)
       : undefined
 
-    const credential = this.handleError(
+    // eslint-disable-next-line @typescript-eslint/ban-ts-comment, @typescript-eslint/prefer-ts-expect-error
+    // @ts-ignore
+    const credential = this.anoncreds.createCredential({
       // eslint-disable-next-line @typescript-eslint/ban-ts-comment, @typescript-eslint/prefer-ts-expect-error
       // @ts-ignore
-      this.anoncreds.createCredential({
-        // eslint-disable-next-line @typescript-eslint/ban-ts-comment, @typescript-eslint/prefer-ts-expect-error
-        // @ts-ignore
-        ...serializeArguments(options),
-        attributeRawValues,
-        attributeEncodedValues,
-        attributeNames,
-        revocationConfiguration: options.revocationConfiguration
-          ? {
-              registryIndex: options.revocationConfiguration.registryIndex,
-              revocationRegistryDefinition: options.revocationConfiguration.revocationRegistryDefinition.handle,
-              revocationRegistryDefinitionPrivate:
-                options.revocationConfiguration.revocationRegistryDefinitionPrivate.handle,
-              revocationStatusList: options.revocationConfiguration.revocationStatusList.handle,
-            }
-          : undefined,
-      })
-    )
+      ...serializeArguments(options),
+      attributeRawValues,
+      attributeEncodedValues,
+      attributeNames,
+      revocationConfiguration: options.revocationConfiguration
+        ? {
+            registryIndex: options.revocationConfiguration.registryIndex,
+            revocationRegistryDefinition: options.revocationConfiguration.revocationRegistryDefinition.handle,
+            revocationRegistryDefinitionPrivate:
+              options.revocationConfiguration.revocationRegistryDefinitionPrivate.handle,
+            revocationStatusList: options.revocationConfiguration.revocationStatusList.handle,
+          }
+        : undefined,
+    })
 
     return new ObjectHandle(credential)
   }
 
   public encodeCredentialAttributes(options: { attributeRawValues: string[] }): string[] {
-    const s = this.handleError(this.anoncreds.encodeCredentialAttributes(serializeArguments(options)))
+    const s = this.anoncreds.encodeCredentialAttributes(serializeArguments(options))
     return s.split(',')
   }
 
@@ -165,7 +210,7 @@ export class ReactNativeAnoncreds implements Anoncreds {
     credentialDefinition: ObjectHandle
     revocationRegistryDefinition?: ObjectHandle
   }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.processCredential(serializeArguments(options)))
+    const handle = this.anoncreds.processCredential(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
@@ -174,7 +219,7 @@ export class ReactNativeAnoncreds implements Anoncreds {
     credentialDefinitionId: string
     keyCorrectnessProof: ObjectHandle
   }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.createCredentialOffer(serializeArguments(options)))
+    const handle = this.anoncreds.createCredentialOffer(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
@@ -186,8 +231,8 @@ export class ReactNativeAnoncreds implements Anoncreds {
     linkSecretId: string
     credentialOffer: ObjectHandle
   }): { credentialRequest: ObjectHandle; credentialRequestMetadata: ObjectHandle } {
-    const { credentialRequest, credentialRequestMetadata } = this.handleError(
-      this.anoncreds.createCredentialRequest(serializeArguments(options))
+    const { credentialRequest, credentialRequestMetadata } = this.anoncreds.createCredentialRequest(
+      serializeArguments(options)
     )
 
     return {
@@ -197,7 +242,7 @@ export class ReactNativeAnoncreds implements Anoncreds {
   }
 
   public createLinkSecret(): string {
-    return this.handleError(this.anoncreds.createLinkSecret({}))
+    return this.anoncreds.createLinkSecret({})
   }
 
   public createPresentation(options: {
@@ -216,25 +261,18 @@ export class ReactNativeAnoncreds implements Anoncreds {
     const credentialDefinitionKeys = Object.keys(options.credentialDefinitions)
     const credentialDefinitionValues = Object.values(options.credentialDefinitions).map((o) => o.handle)
 
-    const credentialEntries = options.credentials.map((value) => ({
-      credential: value.credential.handle,
-      timestamp: value.timestamp ?? -1,
-      revocationState: value.revocationState?.handle ?? 0,
-    }))
-
-    const handle = this.handleError(
-      this.anoncreds.createPresentation({
-        presentationRequest: options.presentationRequest.handle,
-        linkSecret: options.linkSecret,
-        credentialsProve: options.credentialsProve,
-        selfAttestNames,
-        selfAttestValues,
-        credentials: credentialEntries,
-        schemas: schemaValues,
-        schemaIds: schemaKeys,
-        credentialDefinitions: credentialDefinitionValues,
-        credentialDefinitionIds: credentialDefinitionKeys,
-      })
+    // Hot path, passed positionally to skip the property lookups on the native side
+    const handle = this.anoncreds.createPresentation(
+      options.presentationRequest.handle,
+      this.credentialEntryTuples(options.credentials),
+      this.credentialProveTuples(options.credentialsProve),
+      selfAttestNames,
+      selfAttestValues,
+      options.linkSecret,
+      schemaValues,
+      schemaKeys,
+      credentialDefinitionValues,
+      credentialDefinitionKeys
     )
     return new ObjectHandle(handle)
   }
@@ -251,7 +289,20 @@ export class ReactNativeAnoncreds implements Anoncreds {
     revocationStatusLists?: ObjectHandle[]
     nonRevokedIntervalOverrides?: NativeNonRevokedIntervalOverride[]
   }): boolean {
-    return Boolean(this.handleError(this.anoncreds.verifyPresentation(serializeArguments(options))))
+    return Boolean(
+      this.anoncreds.verifyPresentation(
+        options.presentation.handle,
+        options.presentationRequest.handle,
+        options.schemas.map((o) => o.handle),
+        options.schemaIds,
+        options.credentialDefinitions.map((o) => o.handle),
+        options.credentialDefinitionIds,
+        options.revocationRegistryDefinitions?.map((o) => o.handle),
+        options.revocationRegistryDefinitionIds,
+        options.revocationStatusLists?.map((o) => o.handle),
+        this.nonRevokedIntervalOverrideTuples(options.nonRevokedIntervalOverrides)
+      )
+    )
   }
 
   public createRevocationRegistryDefinition(options: {
@@ -266,13 +317,12 @@ export class ReactNativeAnoncreds implements Anoncreds {
     revocationRegistryDefinition: ObjectHandle
     revocationRegistryDefinitionPrivate: ObjectHandle
   } {
-    const { registryDefinition, registryDefinitionPrivate } = this.handleError(
+    const { revocationRegistryDefinition, revocationRegistryDefinitionPrivate } =
       this.anoncreds.createRevocationRegistryDefinition(serializeArguments(options))
-    )
 
     return {
-      revocationRegistryDefinitionPrivate: new ObjectHandle(registryDefinitionPrivate),
-      revocationRegistryDefinition: new ObjectHandle(registryDefinition),
+      revocationRegistryDefinitionPrivate: new ObjectHandle(revocationRegistryDefinitionPrivate),
+      revocationRegistryDefinition: new ObjectHandle(revocationRegistryDefinition),
     }
   }
 
@@ -284,112 +334,584 @@ export class ReactNativeAnoncreds implements Anoncreds {
     oldRevocationState?: ObjectHandle
     oldRevocationStatusList?: ObjectHandle
   }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.createOrUpdateRevocationState(serializeArguments(options)))
+    const handle = this.anoncreds.createOrUpdateRevocationState(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public presentationRequestFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.presentationRequestFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.presentationRequestFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public schemaGetAttribute(options: { objectHandle: ObjectHandle; name: string }): string {
-    return this.handleError(this.anoncreds.schemaGetAttribute(serializeArguments(options)))
+    return this.anoncreds.schemaGetAttribute(serializeArguments(options))
   }
 
   public revocationRegistryDefinitionGetAttribute(options: { objectHandle: ObjectHandle; name: string }): string {
-    return this.handleError(this.anoncreds.revocationRegistryDefinitionGetAttribute(serializeArguments(options)))
+    return this.anoncreds.revocationRegistryDefinitionGetAttribute(serializeArguments(options))
   }
 
   public credentialGetAttribute(options: { objectHandle: ObjectHandle; name: string }): string {
-    return this.handleError(this.anoncreds.credentialGetAttribute(serializeArguments(options)))
+    return this.anoncreds.credentialGetAttribute(serializeArguments(options))
+  }
+
+  /**
+   * Read the attributes `names` of every credential in one native call. Returns an array per name with the value of
+   * every credential, in the order of `objectHandles`, or `null` where it is not set.
+   */
+  public credentialGetAttributes(options: { objectHandles: ObjectHandle[]; names: string[] }): AttributeColumns {
+    return this.anoncreds.credentialGetAttributes({
+      objectHandles: options.objectHandles.map((o) => o.handle),
+      names: options.names,
+    })
+  }
+
+  /**
+   * Read the attributes `names` of the proof of every W3C credential in one native call, as
+   * `credentialGetAttributes` does.
+   */
+  public w3cCredentialProofGetAttributes(options: {
+    objectHandles: ObjectHandle[]
+    names: string[]
+  }): AttributeColumns {
+    return this.anoncreds.w3cCredentialProofGetAttributes({
+      objectHandles: options.objectHandles.map((o) => o.handle),
+      names: options.names,
+    })
+  }
+
+  /**
+   * Read the attributes `names` of every revocation registry definition in one native call, as
+   * `credentialGetAttributes` does.
+   */
+  public revocationRegistryDefinitionGetAttributes(options: {
+    objectHandles: ObjectHandle[]
+    names: string[]
+  }): AttributeColumns {
+    return this.anoncreds.revocationRegistryDefinitionGetAttributes({
+      objectHandles: options.objectHandles.map((o) => o.handle),
+      names: options.names,
+    })
   }
 
   public getJson(options: { objectHandle: ObjectHandle }): string {
-    return this.handleError(this.anoncreds.getJson(serializeArguments(options)))
+    return this.anoncreds.getJson(serializeArguments(options))
+  }
+
+  /**
+   * The JSON of an object as a JS value, built natively from the JSON of `libanoncreds`. Gives the same value as
+   * `JSON.parse(getJson(options))` without creating the JSON string in JS.
+   */
+  public getObject(options: { objectHandle: ObjectHandle }): JsonObject {
+    return this.anoncreds.getObject({ objectHandle: options.objectHandle.handle })
+  }
+
+  /**
+   * Read the values at `paths` of the JSON of an object, without reading the rest of it into JS. A path is a JSON
+   * pointer, `/identifiers/0/schema_id`, or a dotted path, `identifiers[0].schema_id`. Returns a value per path, in
+   * order, `undefined` for paths that select nothing.
+   */
+  public project(options: { objectHandle: ObjectHandle; paths: string[] }): unknown[] {
+    return this.anoncreds.project({ objectHandle: options.objectHandle.handle, paths: options.paths })
   }
 
   public getTypeName(options: { objectHandle: ObjectHandle }): string {
-    return this.handleError(this.anoncreds.getTypeName(serializeArguments(options)))
+    return this.anoncreds.getTypeName(serializeArguments(options))
   }
 
   public objectFree(options: { objectHandle: ObjectHandle }): void {
-    this.handleError(this.anoncreds.objectFree(serializeArguments(options)))
+    this.anoncreds.objectFree(serializeArguments(options))
+  }
+
+  /**
+   * Start recording every binding call, with its arguments, result and timing, to a trace file at `path`.
+   * The trace can be replayed against a desktop build of anoncreds with the tool in `tools/replay`.
+   */
+  public startRecording(options: { path: string }): void {
+    this.anoncreds.startRecording(options)
+  }
+
+  public stopRecording(): void {
+    this.anoncreds.stopRecording({})
+  }
+
+  /**
+   * Number and approximate size in bytes of the objects that are alive on the native side, by type name.
+   * Objects are alive from the binding that created them until they are freed.
+   */
+  public getLiveHandleStatistics(): Record<string, LiveHandleStatistics> {
+    return this.anoncreds.getLiveHandleStatistics({})
+  }
+
+  /**
+   * Objects that are alive on the native side and were created at least `olderThan` milliseconds ago, oldest first.
+   * Useful to find handles that are never freed.
+   */
+  public getLiveHandles(options: { olderThan?: number } = {}): LiveHandle[] {
+    return this.anoncreds.getLiveHandles(options)
+  }
+
+  /**
+   * Open a handle scope. Every object created until the matching `endScope` is recorded in it, and freed by
+   * `endScope` in a single native call. Scopes nest, `beginScope` returns the id to pass to `endScope`.
+   */
+  public beginScope(): number {
+    return this.anoncreds.beginScope({})
+  }
+
+  /**
+   * Free every object created since `beginScope` returned `scope`, except the ones in `keep`, which move to the
+   * enclosing scope, if any. Scopes opened inside `scope` that were not ended are ended as well.
+   */
+  public endScope(options: { scope: number; keep?: ObjectHandle[] }): void {
+    this.anoncreds.endScope(serializeArguments(options))
+  }
+
+  /**
+   * Issue a credential from the JSON of a credential offer and request in one native call and return the credential
+   * JSON. The offer, request and credential objects are only created, and freed, on the native side.
+   */
+  public issueCredentialFromJson(options: {
+    credentialDefinition: ObjectHandle
+    credentialDefinitionPrivate: ObjectHandle
+    credentialOffer: string
+    credentialRequest: string
+    attributeRawValues: Record<string, string>
+    attributeEncodedValues?: Record<string, string>
+    revocationConfiguration?: NativeCredentialRevocationConfig
+  }): string {
+    return this.anoncreds.issueCredentialFromJson({
+      credentialDefinition: options.credentialDefinition.handle,
+      credentialDefinitionPrivate: options.credentialDefinitionPrivate.handle,
+      credentialOffer: options.credentialOffer,
+      credentialRequest: options.credentialRequest,
+      attributeNames: Object.keys(options.attributeRawValues),
+      attributeRawValues: Object.values(options.attributeRawValues),
+      attributeEncodedValues: options.attributeEncodedValues
+        ? Object.values(options.attributeEncodedValues)
+        : undefined,
+      revocationConfiguration: this.revocationConfiguration(options.revocationConfiguration),
+    })
+  }
+
+  /**
+   * Like `issueCredentialFromJson`, for a W3C credential.
+   */
+  public issueW3cCredentialFromJson(options: {
+    credentialDefinition: ObjectHandle
+    credentialDefinitionPrivate: ObjectHandle
+    credentialOffer: string
+    credentialRequest: string
+    attributeRawValues: Record<string, string>
+    revocationConfiguration?: NativeCredentialRevocationConfig
+    w3cVersion?: string
+  }): string {
+    return this.anoncreds.issueW3cCredentialFromJson({
+      credentialDefinition: options.credentialDefinition.handle,
+      credentialDefinitionPrivate: options.credentialDefinitionPrivate.handle,
+      credentialOffer: options.credentialOffer,
+      credentialRequest: options.credentialRequest,
+      attributeNames: Object.keys(options.attributeRawValues),
+      attributeRawValues: Object.values(options.attributeRawValues),
+      revocationConfiguration: this.revocationConfiguration(options.revocationConfiguration),
+      w3cVersion: options.w3cVersion,
+    })
+  }
+
+  /**
+   * Encode raw attribute values as `encodeCredentialAttributes` does, natively and spread over worker threads. Values
+   * passed as an array of strings are returned as one. Values passed packed, every value as its UTF-8 length in four
+   * little endian bytes followed by its UTF-8 bytes, are returned packed the same way.
+   */
+  public encodeAttributes(options: { values: string[] }): string[]
+  public encodeAttributes(options: { values: ArrayBuffer | ArrayBufferView }): ArrayBuffer
+  public encodeAttributes(options: { values: string[] | ArrayBuffer | ArrayBufferView }): string[] | ArrayBuffer {
+    return this.anoncreds.encodeAttributes(options)
+  }
+
+  /**
+   * Parse many objects from JSON in one native call, spread over worker threads. Returns the objects in the order of
+   * `entries`, with `null` for the entries that could not be parsed and the error code of every entry.
+   */
+  public batchFromJson(entries: Array<{ type: BatchFromJsonType; json: string }>): {
+    objects: Array<ObjectHandle | null>
+    errorCodes: number[]
+  } {
+    const { handles, errorCodes } = this.anoncreds.batchFromJson({
+      entries: entries.map(({ type, json }) => [type, json]),
+    })
+    return { objects: handles.map((handle) => (handle === null ? null : new ObjectHandle(handle))), errorCodes }
+  }
+
+  /**
+   * Write the JSON of an object to the file at `path`, without creating a JS string. The file is replaced once the
+   * JSON is completely written.
+   */
+  public exportToFile(options: { objectHandle: ObjectHandle; path: string }): void {
+    this.anoncreds.exportToFile({ objectHandle: options.objectHandle.handle, path: options.path })
+  }
+
+  /**
+   * Parse an object of `type` from the JSON in the file at `path`, without creating a JS string.
+   */
+  public importFromFile(options: { type: BatchFromJsonType; path: string }): ObjectHandle {
+    return new ObjectHandle(this.anoncreds.importFromFile(options))
+  }
+
+  /**
+   * Encode an object in a compact binary form for storage. The JSON of the object is encoded as CBOR with its big
+   * integers as bytes, and is restored unchanged by `fromCbor`.
+   */
+  public toCbor(options: { objectHandle: ObjectHandle }): ArrayBuffer {
+    return this.anoncreds.toCbor({ objectHandle: options.objectHandle.handle })
+  }
+
+  /**
+   * Load an object of `type` encoded by `toCbor`.
+   */
+  public fromCbor(options: { type: BatchFromJsonType; bytes: ArrayBuffer | ArrayBufferView }): ObjectHandle {
+    return new ObjectHandle(this.anoncreds.fromCbor(options))
+  }
+
+  /**
+   * Write the objects to a snapshot at `path`, to be restored by `restore` on a later start. The file is replaced once
+   * the snapshot is completely written.
+   */
+  public snapshot(options: { objectHandles: ObjectHandle[]; path: string }): void {
+    this.anoncreds.snapshot({ objectHandles: options.objectHandles.map((o) => o.handle), path: options.path })
+  }
+
+  /**
+   * Restore the objects of the snapshot at `path`, in the order they were written. Only the index of the snapshot is
+   * read, every object is parsed when it is first used.
+   */
+  public restore(options: { path: string }): ObjectHandle[] {
+    return this.anoncreds.restore(options).map((handle) => new ObjectHandle(handle))
+  }
+
+  /**
+   * Process a credential received as JSON in one native call. Returns the processed credential as JSON with the
+   * attributes to index it by: `schema_id`, `cred_def_id`, `rev_reg_id`, `rev_reg_index`, and the raw value of every
+   * credential attribute under `values`. Definitions passed as JSON are cached on the native side under the ids of the
+   * credential.
+   */
+  public receiveCredential(options: {
+    credential: string
+    credentialRequestMetadata: string
+    linkSecret: string
+    credentialDefinition: string | ObjectHandle
+    revocationRegistryDefinition?: string | ObjectHandle
+  }): { credential: string; attributes: ReceivedCredentialAttributes } {
+    const { credentialDefinition, revocationRegistryDefinition } = options
+    return this.anoncreds.receiveCredential({
+      credential: options.credential,
+      credentialRequestMetadata: options.credentialRequestMetadata,
+      linkSecret: options.linkSecret,
+      credentialDefinition:
+        typeof credentialDefinition === 'string' ? credentialDefinition : credentialDefinition.handle,
+      revocationRegistryDefinition:
+        typeof revocationRegistryDefinition === 'object'
+          ? revocationRegistryDefinition.handle
+          : revocationRegistryDefinition,
+    })
+  }
+
+  /**
+   * Choose the credentials that answer `presentationRequest`, as the `credentials` and `credentialsProve` of
+   * `createPresentation`. Restrictions, predicate values and revocation states are checked without creating a proof.
+   * Referents that none of the credentials can answer are returned in `unsatisfied` with the reason, and left out of
+   * `credentialsProve`.
+   */
+  public solvePresentation(options: { presentationRequest: ObjectHandle; credentials: NativeCredentialEntry[] }): {
+    credentials: NativeCredentialEntry[]
+    credentialsProve: NativeCredentialProve[]
+    unsatisfied: UnsatisfiedReferent[]
+  } {
+    const { credentials, credentialsProve, unsatisfied } = this.anoncreds.solvePresentation({
+      presentationRequest: options.presentationRequest.handle,
+      credentials: this.credentialEntryTuples(options.credentials),
+    })
+    return {
+      credentials: credentials.map(([credential, timestamp, revocationState]) => ({
+        credential: new ObjectHandle(credential),
+        timestamp: timestamp === -1 ? undefined : timestamp,
+        revocationState: revocationState === 0 ? undefined : new ObjectHandle(revocationState),
+      })),
+      credentialsProve: credentialsProve.map(([entryIndex, referent, isPredicate, reveal]) => ({
+        entryIndex,
+        referent,
+        isPredicate,
+        reveal,
+      })),
+      unsatisfied,
+    }
+  }
+
+  /**
+   * Index a credential in the native credential store under `id`, replacing an earlier credential with that id. The
+   * credential is indexed by the tags a presentation request can restrict, `tags` are added to or replace them.
+   */
+  public credentialStoreAdd(options: { id: string; credential: ObjectHandle; tags?: Record<string, string> }): void {
+    this.anoncreds.credentialStoreAdd({ id: options.id, credential: options.credential.handle, tags: options.tags })
+  }
+
+  /**
+   * Remove the credential `id` from the credential store. Returns whether it was indexed.
+   */
+  public credentialStoreRemove(options: { id: string }): boolean {
+    return this.anoncreds.credentialStoreRemove(options)
+  }
+
+  /**
+   * Ids of the credentials in the credential store that match `restrictions`, the `restrictions` of a requested
+   * attribute or predicate, and have every attribute in `attributes`.
+   */
+  public credentialStoreQuery(options: { restrictions?: unknown; attributes?: string[] }): string[] {
+    return this.anoncreds.credentialStoreQuery({
+      restrictions: JSON.stringify(options.restrictions ?? null),
+      attributes: options.attributes,
+    })
+  }
+
+  /**
+   * Write the credential store to the file at `path`.
+   */
+  public credentialStoreSave(options: { path: string }): void {
+    this.anoncreds.credentialStoreSave(options)
+  }
+
+  /**
+   * Replace the credential store with the one saved at `path`. Returns the number of credentials loaded.
+   */
+  public credentialStoreLoad(options: { path: string }): number {
+    return this.anoncreds.credentialStoreLoad(options)
+  }
+
+  /**
+   * Remove every credential from the credential store.
+   */
+  public credentialStoreClear(): void {
+    this.anoncreds.credentialStoreClear({})
+  }
+
+  /**
+   * Verify a presentation given as JSON in one native call. Schemas and definitions are passed by id, as JSON or as
+   * objects. Those passed as JSON are parsed once and cached on the native side, see `clearDefinitionCache`.
+   */
+  public verifyPresentationFromJson(options: {
+    presentation: string
+    presentationRequest: string
+    schemas: Record<string, string | ObjectHandle>
+    credentialDefinitions: Record<string, string | ObjectHandle>
+    revocationRegistryDefinitions?: Record<string, string | ObjectHandle>
+    revocationStatusLists?: Array<string | ObjectHandle>
+    nonRevokedIntervalOverrides?: NativeNonRevokedIntervalOverride[]
+    w3c?: boolean
+  }): boolean {
+    return Boolean(
+      this.anoncreds.verifyPresentationFromJson({
+        presentation: options.presentation,
+        presentationRequest: options.presentationRequest,
+        schemas: this.definitions(options.schemas),
+        credentialDefinitions: this.definitions(options.credentialDefinitions),
+        revocationRegistryDefinitions: options.revocationRegistryDefinitions
+          ? this.definitions(options.revocationRegistryDefinitions)
+          : undefined,
+        revocationStatusLists: options.revocationStatusLists?.map((o) => (typeof o === 'string' ? o : o.handle)),
+        nonRevokedIntervalOverrides: this.nonRevokedIntervalOverrideTuples(options.nonRevokedIntervalOverrides),
+        w3c: options.w3c ? 1 : 0,
+      })
+    )
+  }
+
+  /**
+   * Verify a presentation like `verifyPresentation` and, when it verifies, return what it discloses: the raw values
+   * of the revealed and self-attested attributes by referent, the referents of the predicates and the identifiers of
+   * the credentials. These are read natively, so the presentation does not need to be read into JS afterwards.
+   */
+  public verifyPresentationWithDetails(options: {
+    presentation: ObjectHandle
+    presentationRequest: ObjectHandle
+    schemas: ObjectHandle[]
+    schemaIds: string[]
+    credentialDefinitions: ObjectHandle[]
+    credentialDefinitionIds: string[]
+    revocationRegistryDefinitions?: ObjectHandle[]
+    revocationRegistryDefinitionIds?: string[]
+    revocationStatusLists?: ObjectHandle[]
+    nonRevokedIntervalOverrides?: NativeNonRevokedIntervalOverride[]
+  }): PresentationDetails {
+    return this.anoncreds.verifyPresentationWithDetails({
+      presentation: options.presentation.handle,
+      presentationRequest: options.presentationRequest.handle,
+      schemas: options.schemas.map((o) => o.handle),
+      schemaIds: options.schemaIds,
+      credentialDefinitions: options.credentialDefinitions.map((o) => o.handle),
+      credentialDefinitionIds: options.credentialDefinitionIds,
+      revocationRegistryDefinitions: options.revocationRegistryDefinitions?.map((o) => o.handle),
+      revocationRegistryDefinitionIds: options.revocationRegistryDefinitionIds,
+      revocationStatusLists: options.revocationStatusLists?.map((o) => o.handle),
+      nonRevokedIntervalOverrides: this.nonRevokedIntervalOverrideTuples(options.nonRevokedIntervalOverrides),
+    })
+  }
+
+  /**
+   * Free the schemas and definitions cached by `verifyPresentationFromJson`.
+   */
+  public clearDefinitionCache(): void {
+    this.anoncreds.clearDefinitionCache({})
+  }
+
+  /**
+   * Run `commands` in one native call and return the results of the commands at the indices in `outputs`, by
+   * default only the last one. A command is a binding name with its arguments, as an options object or positionally.
+   * A handle returned by an earlier command is passed as `{ slot, output? }`. Handles are returned as numbers, and
+   * every object created by the commands that is not returned is freed.
+   */
+  public execute(commands: Command[], options: { outputs?: number[] } = {}): unknown[] {
+    return this.anoncreds.execute({ commands: serializeCommands(commands), outputs: options.outputs })
+  }
+
+  /**
+   * Like `execute`, with the commands run on a worker thread of the native scheduler. Jobs start in the order of
+   * their `priority`, `'normal'` by default. A job that has not started `deadline` milliseconds after it was queued is
+   * dropped, and `signal` cancels it, dropping it from the queue or stopping it before its next command. Both reject
+   * with an `Error` whose `reason` is `'expired'` or `'canceled'`. Rejects right away when the queue is full.
+   */
+  public executeAsync(
+    commands: Command[],
+    options: { outputs?: number[]; priority?: JobPriority; deadline?: number; signal?: AbortSignal } = {}
+  ): Promise<unknown[]> {
+    return new Promise((resolve, reject) => {
+      const { signal } = options
+      const cancel = () => this.anoncreds.cancelJob({ job })
+      const job = this.anoncreds.execute({
+        commands: serializeCommands(commands),
+        outputs: options.outputs,
+        priority: options.priority,
+        deadline: options.deadline,
+        callback: (error, results) => {
+          signal?.removeEventListener('abort', cancel)
+          if (error) reject(error)
+          else resolve(results as unknown[])
+        },
+      })
+      if (signal?.aborted) cancel()
+      else signal?.addEventListener('abort', cancel)
+    })
+  }
+
+  /**
+   * Cancel job `job` of the native scheduler, as returned by `execute` with a callback. Returns false when it already
+   * ended.
+   */
+  public cancelJob(job: number): boolean {
+    return this.anoncreds.cancelJob({ job })
+  }
+
+  /**
+   * Limit the number of jobs queued on the native scheduler, 64 by default. Jobs submitted while the queue is full
+   * are rejected.
+   */
+  public configureScheduler(options: { maxQueued: number }): void {
+    this.anoncreds.configureScheduler(options)
+  }
+
+  /**
+   * Queue depths of the native scheduler, and counters and wait times per priority class since the last `reset`.
+   */
+  public getSchedulerMetrics(options: { reset?: boolean } = {}): SchedulerMetrics {
+    return this.anoncreds.getSchedulerMetrics({ reset: Number(options.reset ?? false) })
+  }
+
+  /**
+   * Run `callback` inside a handle scope, which is ended when `callback` returns or throws. Objects that must
+   * outlive the scope are passed to `keep`.
+   */
+  public withScope<T>(callback: (keep: (handle: ObjectHandle) => ObjectHandle) => T): T {
+    const scope = this.beginScope()
+    const kept: ObjectHandle[] = []
+    try {
+      return callback((handle) => {
+        kept.push(handle)
+        return handle
+      })
+    } finally {
+      this.endScope({ scope, keep: kept })
+    }
   }
 
   public credentialDefinitionGetAttribute(options: { objectHandle: ObjectHandle; name: string }): string {
-    return this.handleError(this.anoncreds.credentialDefinitionGetAttribute(serializeArguments(options)))
+    return this.anoncreds.credentialDefinitionGetAttribute(serializeArguments(options))
   }
 
   public revocationRegistryDefinitionFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.revocationRegistryDefinitionFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.revocationRegistryDefinitionFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public revocationRegistryFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.revocationRegistryFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.revocationRegistryFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public revocationStatusListFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.revocationStatusListFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.revocationStatusListFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public presentationFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.presentationFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.presentationFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public credentialOfferFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.credentialOfferFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.credentialOfferFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public schemaFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.schemaFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.schemaFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public credentialRequestFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.credentialRequestFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.credentialRequestFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public credentialRequestMetadataFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.credentialRequestMetadataFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.credentialRequestMetadataFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public credentialFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.credentialFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.credentialFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public revocationRegistryDefinitionPrivateFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(
-      this.anoncreds.revocationRegistryDefinitionPrivateFromJson(serializeArguments(options))
-    )
+    const handle = this.anoncreds.revocationRegistryDefinitionPrivateFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public revocationStateFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.revocationStateFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.revocationStateFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public credentialDefinitionFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.credentialDefinitionFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.credentialDefinitionFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public credentialDefinitionPrivateFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.credentialDefinitionPrivateFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.credentialDefinitionPrivateFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public keyCorrectnessProofFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.keyCorrectnessProofFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.keyCorrectnessProofFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
@@ -405,23 +927,21 @@ export class ReactNativeAnoncreds implements Anoncreds {
     const attributeNames = Object.keys(options.attributeRawValues)
     const attributeRawValues = Object.values(options.attributeRawValues)
 
-    const credential = this.handleError(
-      this.anoncreds.createW3cCredential({
-        ...serializeArguments(options),
-        attributeRawValues,
-        attributeNames,
-        revocationConfiguration: options.revocationConfiguration
-          ? {
-              registryIndex: options.revocationConfiguration.registryIndex,
-              revocationRegistryDefinition: options.revocationConfiguration.revocationRegistryDefinition.handle,
-              revocationRegistryDefinitionPrivate:
-                options.revocationConfiguration.revocationRegistryDefinitionPrivate.handle,
-              revocationStatusList: options.revocationConfiguration.revocationStatusList.handle,
-            }
-          : undefined,
-        w3cVersion: options.w3cVersion,
-      })
-    )
+    const credential = this.anoncreds.createW3cCredential({
+      ...serializeArguments(options),
+      attributeRawValues,
+      attributeNames,
+      revocationConfiguration: options.revocationConfiguration
+        ? {
+            registryIndex: options.revocationConfiguration.registryIndex,
+            revocationRegistryDefinition: options.revocationConfiguration.revocationRegistryDefinition.handle,
+            revocationRegistryDefinitionPrivate:
+              options.revocationConfiguration.revocationRegistryDefinitionPrivate.handle,
+            revocationStatusList: options.revocationConfiguration.revocationStatusList.handle,
+          }
+        : undefined,
+      w3cVersion: options.w3cVersion,
+    })
 
     return new ObjectHandle(credential)
   }
@@ -433,7 +953,7 @@ export class ReactNativeAnoncreds implements Anoncreds {
     credentialDefinition: ObjectHandle
     revocationRegistryDefinition?: ObjectHandle
   }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.processW3cCredential(serializeArguments(options)))
+    const handle = this.anoncreds.processW3cCredential(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
@@ -451,24 +971,16 @@ export class ReactNativeAnoncreds implements Anoncreds {
     const credentialDefinitionKeys = Object.keys(options.credentialDefinitions)
     const credentialDefinitionValues = Object.values(options.credentialDefinitions).map((o) => o.handle)
 
-    const credentialEntries = options.credentials.map((value) => ({
-      credential: value.credential.handle,
-      timestamp: value.timestamp ?? -1,
-      revocationState: value.revocationState?.handle ?? 0,
-    }))
-
-    const handle = this.handleError(
-      this.anoncreds.createW3cPresentation({
-        presentationRequest: options.presentationRequest.handle,
-        linkSecret: options.linkSecret,
-        credentialsProve: options.credentialsProve,
-        credentials: credentialEntries,
-        schemas: schemaValues,
-        schemaIds: schemaKeys,
-        credentialDefinitions: credentialDefinitionValues,
-        credentialDefinitionIds: credentialDefinitionKeys,
-        w3cVersion: options.w3cVersion,
-      })
+    const handle = this.anoncreds.createW3cPresentation(
+      options.presentationRequest.handle,
+      this.credentialEntryTuples(options.credentials),
+      this.credentialProveTuples(options.credentialsProve),
+      options.linkSecret,
+      schemaValues,
+      schemaKeys,
+      credentialDefinitionValues,
+      credentialDefinitionKeys,
+      options.w3cVersion
     )
     return new ObjectHandle(handle)
   }
@@ -485,35 +997,48 @@ export class ReactNativeAnoncreds implements Anoncreds {
     revocationStatusLists?: ObjectHandle[]
     nonRevokedIntervalOverrides?: NativeNonRevokedIntervalOverride[]
   }): boolean {
-    return Boolean(this.handleError(this.anoncreds.verifyW3cPresentation(serializeArguments(options))))
+    return Boolean(
+      this.anoncreds.verifyW3cPresentation(
+        options.presentation.handle,
+        options.presentationRequest.handle,
+        options.schemas.map((o) => o.handle),
+        options.schemaIds,
+        options.credentialDefinitions.map((o) => o.handle),
+        options.credentialDefinitionIds,
+        options.revocationRegistryDefinitions?.map((o) => o.handle),
+        options.revocationRegistryDefinitionIds,
+        options.revocationStatusLists?.map((o) => o.handle),
+        this.nonRevokedIntervalOverrideTuples(options.nonRevokedIntervalOverrides)
+      )
+    )
   }
 
   public w3cCredentialGetIntegrityProofDetails(options: { objectHandle: ObjectHandle }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.w3cCredentialGetIntegrityProofDetails(serializeArguments(options)))
+    const handle = this.anoncreds.w3cCredentialGetIntegrityProofDetails(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public w3cCredentialProofGetAttribute(options: { objectHandle: ObjectHandle; name: string }): string {
-    return this.handleError(this.anoncreds.w3cCredentialProofGetAttribute(serializeArguments(options)))
+    return this.anoncreds.w3cCredentialProofGetAttribute(serializeArguments(options))
   }
 
   public w3cPresentationFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.w3cPresentationFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.w3cPresentationFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public w3cCredentialFromJson(options: { json: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.w3cCredentialFromJson(serializeArguments(options)))
+    const handle = this.anoncreds.w3cCredentialFromJson(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public credentialToW3c(options: { objectHandle: ObjectHandle; issuerId: string; w3cVersion?: string }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.credentialToW3c(serializeArguments(options)))
+    const handle = this.anoncreds.credentialToW3c(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 
   public credentialFromW3c(options: { objectHandle: ObjectHandle }): ObjectHandle {
-    const handle = this.handleError(this.anoncreds.credentialFromW3c(serializeArguments(options)))
+    const handle = this.anoncreds.credentialFromW3c(serializeArguments(options))
     return new ObjectHandle(handle)
   }
 }
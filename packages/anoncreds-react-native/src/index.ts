@@ -4,5 +4,18 @@ import { ReactNativeAnoncreds } from './ReactNativeAnoncreds'
 import { register } from './register'
 
 export * from '@hyperledger/anoncreds-shared'
+export { ReactNativeAnoncreds } from './ReactNativeAnoncreds'
+export type {
+  BatchFromJsonType,
+  Command,
+  CommandReference,
+  JobClassMetrics,
+  JobPriority,
+  LiveHandle,
+  LiveHandleStatistics,
+  PresentationDetails,
+  ReceivedCredentialAttributes,
+  SchedulerMetrics,
+} from './NativeBindings'
 
 registerAnoncreds({ lib: new ReactNativeAnoncreds(register()) })
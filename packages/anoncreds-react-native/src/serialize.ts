@@ -1,3 +1,5 @@
+import type { Command } from './NativeBindings'
+
 import { ObjectHandle } from '@hyperledger/anoncreds-shared'
 
 export type ReturnObject<T = unknown> = {
@@ -75,4 +77,10 @@ const serializeArguments = <T extends Record<string, Argument> = Record<string,
   return retVal as SerializedOptions<T>
 }
 
-export { serializeArguments }
+const serializeCommands = (commands: Command[]): Command[] =>
+  commands.map(([binding, args]) => [
+    binding,
+    Array.isArray(args) ? args.map((arg) => serialize(arg as Argument)) : serializeArguments(args as Record<string, Argument>),
+  ])
+
+export { serializeArguments, serializeCommands }
@@ -0,0 +1,187 @@
+// Checks the bulk attribute encoder of `encodeAttributes` (see
+// `cpp/attributeEncoder.h`) against `anoncreds_encode_credential_attributes`,
+// then compares the time both take to encode the same values.
+//
+// Usage: anoncreds-attribute-encoder-check [--count <n>] [--seed <n>]
+//
+// The values checked are edge cases of the integer rule and of SHA-256
+// padding, followed by `count` random values: integers in and out of the
+// 32-bit range, and strings of up to 300 bytes, some of them not ASCII.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "attributeEncoder.h"
+#include "include/libanoncreds.h"
+
+namespace {
+
+// Values encoded per call of `anoncreds_encode_credential_attributes`
+constexpr size_t batch = 1000;
+
+std::vector<std::string> edgeCases() {
+  std::vector<std::string> values = {
+      "",          "0",           "-0",         "+0",          "+5",
+      "-",         "+",           "--1",        "007",         "-007",
+      " 1",        "1 ",          "1.0",        "1e3",         "0x10",
+      "2147483647", "2147483648", "-2147483648", "-2147483649",
+      "+2147483647", "99999999999999999999", "101 Wilson Lane", "SLC",
+      "h\xc3\xa9llo", "\xe2\x82\xac", ",", "a,b"};
+  // Around the lengths where SHA-256 needs another padding block
+  for (size_t length : {55, 56, 57, 63, 64, 65, 119, 120, 1000})
+    values.push_back(std::string(length, 'a'));
+  return values;
+}
+
+std::vector<std::string> randomValues(size_t count, unsigned seed) {
+  static const char alphabet[] = "abcdefghijklmnopqrstuvwxyz0123456789 -+,.";
+  std::mt19937_64 random(seed);
+  std::vector<std::string> values;
+  values.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    switch (random() % 4) {
+    case 0:
+      values.push_back(std::to_string(int64_t(random() % (1ull << 34)) -
+                                      (int64_t(1) << 33)));
+      break;
+    case 1:
+      values.push_back(std::to_string(int32_t(random())));
+      break;
+    default: {
+      std::string value(random() % 300, ' ');
+      for (auto &c : value)
+        c = random() % 50 == 0 ? char(0x80 + random() % 64)
+                               : alphabet[random() % (sizeof(alphabet) - 1)];
+      values.push_back(value);
+    }
+    }
+  }
+  return values;
+}
+
+// Encodes `values` with libanoncreds, splitting its comma separated output
+bool encodeWithLibrary(const std::vector<std::string> &values,
+                       std::vector<std::string> &encoded) {
+  for (size_t begin = 0; begin < values.size(); begin += batch) {
+    auto end = std::min(values.size(), begin + batch);
+    std::vector<FfiStr> pointers;
+    for (auto i = begin; i < end; i++)
+      pointers.push_back(values[i].c_str());
+
+    const char *result = nullptr;
+    if (anoncreds_encode_credential_attributes(
+            FfiStrList{.count = pointers.size(), .data = pointers.data()},
+            &result) != ErrorCode::Success)
+      return false;
+    for (auto cur = result;; cur++) {
+      auto comma = strchr(cur, ',');
+      encoded.emplace_back(cur, comma ? size_t(comma - cur) : strlen(cur));
+      if (comma == nullptr)
+        break;
+      cur = comma;
+    }
+    anoncreds_string_free((char *)result);
+  }
+  return encoded.size() == values.size();
+}
+
+std::vector<uint8_t> pack(const std::vector<std::string> &values) {
+  std::vector<uint8_t> packed;
+  for (auto &value : values) {
+    for (int b = 0; b < 4; b++)
+      packed.push_back(uint8_t(value.size() >> (8 * b)));
+    packed.insert(packed.end(), value.begin(), value.end());
+  }
+  return packed;
+}
+
+std::vector<std::string> unpack(const std::vector<uint8_t> &packed) {
+  std::vector<std::string> values;
+  for (size_t offset = 0; offset + 4 <= packed.size();) {
+    auto length = uint32_t(packed[offset]) | uint32_t(packed[offset + 1]) << 8 |
+                  uint32_t(packed[offset + 2]) << 16 |
+                  uint32_t(packed[offset + 3]) << 24;
+    offset += 4;
+    values.emplace_back((const char *)&packed[offset], length);
+    offset += length;
+  }
+  return values;
+}
+
+template <typename F> double milliseconds(F f) {
+  auto begin = std::chrono::steady_clock::now();
+  f();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+void usage() {
+  fprintf(stderr, "Usage: anoncreds-attribute-encoder-check [--count <n>] "
+                  "[--seed <n>]\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  long count = 1000000;
+  unsigned seed = 1;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+      count = atol(argv[++i]);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = unsigned(atol(argv[++i]));
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (count < 0) {
+    usage();
+    return 2;
+  }
+
+  auto values = edgeCases();
+  auto random = randomValues(size_t(count), seed);
+  values.insert(values.end(), random.begin(), random.end());
+  auto packed = pack(values);
+
+  std::vector<std::string> expected;
+  std::vector<uint8_t> output;
+  auto library =
+      milliseconds([&] { encodeWithLibrary(values, expected); });
+  auto bulk = milliseconds([&] {
+    anoncredsAttributeEncoder::encodePacked(packed.data(), packed.size(),
+                                            output);
+  });
+  if (expected.size() != values.size()) {
+    fprintf(stderr, "libanoncreds failed to encode the values\n");
+    return 1;
+  }
+
+  auto encoded = unpack(output);
+  size_t mismatches = 0;
+  for (size_t i = 0; i < values.size(); i++) {
+    auto actual = i < encoded.size() ? encoded[i] : "<missing>";
+    if (actual == expected[i])
+      continue;
+    if (mismatches++ < 10)
+      fprintf(stderr, "\"%s\": expected %s, got %s\n", values[i].c_str(),
+              expected[i].c_str(), actual.c_str());
+  }
+  if (mismatches > 0 || encoded.size() != values.size()) {
+    fprintf(stderr, "%zu of %zu values encoded differently\n", mismatches,
+            values.size());
+    return 1;
+  }
+
+  printf("%zu values encoded as libanoncreds does\n\n", values.size());
+  printf("%-36s %12.1f ms\n", "anoncreds_encode_credential_attributes",
+         library);
+  printf("%-36s %12.1f ms\n", "encodePacked", bulk);
+  return 0;
+}
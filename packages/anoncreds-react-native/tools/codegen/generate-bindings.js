@@ -0,0 +1,169 @@
+// Generates `cpp/generatedBindings.h` from the declarations in
+// `cpp/include/libanoncreds.h` and the annotations in `bindings.json`, and
+// `cpp/generatedLibrary.h` with the list of all libanoncreds functions.
+//
+// Usage: node tools/codegen/generate-bindings.js [--check]
+//
+// The annotations map the FFI parameters of every binding onto the keys of the
+// JS options object. Parameters without an annotation fall back to `defaults`,
+// output parameters only need a key when a function has more than one.
+
+const fs = require('fs')
+const path = require('path')
+
+const root = path.join(__dirname, '../..')
+const headerPath = path.join(root, 'cpp/include/libanoncreds.h')
+const annotationsPath = path.join(__dirname, 'bindings.json')
+const bindingsPath = path.join(root, 'cpp/generatedBindings.h')
+const libraryPath = path.join(root, 'cpp/generatedLibrary.h')
+
+const inputKinds = {
+  FfiStr: (a) => (a.optional ? `OptionalStr<"${a.key}">` : `Str<"${a.key}">`),
+  ObjectHandle: (a) => `Handle<${templateArguments(a)}>`,
+  int8_t: (a) => `I8<${templateArguments(a)}>`,
+  int32_t: (a) => `I32<${templateArguments(a)}>`,
+  int64_t: (a) => `I64<${templateArguments(a)}>`,
+  ByteBuffer: (a) => `Json<"${a.key}">`,
+  FfiStrList: (a) => `StrList<${templateArguments(a)}>`,
+  FfiList_FfiStr: (a) => `StrList<${templateArguments(a)}>`,
+  FfiList_ObjectHandle: (a) => `HandleList<${templateArguments(a)}>`,
+  FfiList_i32: (a) => `I32List<${templateArguments(a)}>`,
+  FfiList_FfiCredentialEntry: (a) => `CredentialEntryList<${templateArguments(a)}>`,
+  FfiList_FfiCredentialProve: (a) => `CredentialProveList<${templateArguments(a)}>`,
+  FfiList_FfiNonrevokedIntervalOverride: (a) => `NonRevokedIntervalOverrideList<${templateArguments(a)}>`,
+  'const FfiCredRevInfo *': (a) => `CredRevInfo<"${a.key}">`,
+}
+
+const outputTypes = {
+  'ObjectHandle *': 'ObjectHandle',
+  'const char **': 'const char *',
+  'ByteBuffer *': 'ByteBuffer',
+  'int8_t *': 'int8_t',
+}
+
+const templateArguments = ({ key, optional, fallback }) => {
+  const args = [`"${key}"`]
+  if (optional || fallback !== undefined) args.push(String(Boolean(optional)))
+  if (fallback !== undefined) args.push(String(fallback))
+  return args.join(', ')
+}
+
+const parseHeader = (source) => {
+  const functions = new Map()
+  const declaration = /^ErrorCode\s+(anoncreds_\w+)\(([^)]*)\);/gm
+  for (const [, name, parameterList] of source.matchAll(declaration)) {
+    const parameters = parameterList
+      .split(',')
+      .map((p) => p.replace(/\s+/g, ' ').replace(/\bstruct /g, '').trim())
+      .filter((p) => p !== 'void')
+      .map((p) => {
+        const match = p.match(/^(.*?)\s*(\w+)$/)
+        const type = match[1].replace(/\s*(\*+)$/, ' $1')
+        return { type, name: match[2] }
+      })
+    functions.set(name, parameters)
+  }
+  return functions
+}
+
+const normalizeAnnotation = (annotation) => (typeof annotation === 'string' ? { key: annotation } : annotation)
+
+const generateBinding = (bindingName, binding, functions, defaults) => {
+  const parameters = functions.get(binding.function)
+  if (!parameters) throw new Error(`${bindingName}: ${binding.function} is not declared in libanoncreds.h`)
+
+  const annotations = binding.arguments ?? {}
+  const outputs = binding.outputs ?? {}
+  const outputCount = parameters.filter((p) => outputTypes[p.type]).length
+
+  for (const name of [...Object.keys(annotations), ...Object.keys(outputs)]) {
+    if (!parameters.some((p) => p.name === name)) {
+      throw new Error(`${bindingName}: ${binding.function} has no parameter ${name}`)
+    }
+  }
+
+  const kinds = parameters.map((parameter) => {
+    const outputType = outputTypes[parameter.type]
+    if (outputType) {
+      const key = outputs[parameter.name]
+      if (outputCount > 1 && !key) throw new Error(`${bindingName}: output ${parameter.name} needs a key`)
+      return key ? `Out<${outputType}, "${key}">` : `Out<${outputType}>`
+    }
+
+    const kind = inputKinds[parameter.type]
+    if (!kind) throw new Error(`${bindingName}: unsupported parameter type ${parameter.type}`)
+
+    const annotation = annotations[parameter.name] ?? defaults[parameter.name]
+    if (!annotation) throw new Error(`${bindingName}: parameter ${parameter.name} is not annotated`)
+
+    return kind(normalizeAnnotation(annotation))
+  })
+
+  const prefix = `using ${bindingName} = Binding<`
+  const indent = ' '.repeat(prefix.length)
+  return `${prefix}${[`anoncredsLibrary::${binding.function}`, ...kinds].join(`,\n${indent}`)}>;`
+}
+
+// Names of all functions exported by libanoncreds, including the ones that do
+// not return an `ErrorCode`
+const parseFunctionNames = (source) => [...source.matchAll(/^[A-Za-z][\w ]*?\**\s*(anoncreds_\w+)\(/gm)].map((m) => m[1])
+
+const generateBindings = (header) => {
+  const functions = parseHeader(header)
+  const { defaults, bindings } = JSON.parse(fs.readFileSync(annotationsPath, 'utf8'))
+  const names = Object.keys(bindings)
+
+  return `// Generated by tools/codegen/generate-bindings.js from include/libanoncreds.h
+// and tools/codegen/bindings.json. Do not edit by hand.
+
+#pragma once
+
+#include "binding.h"
+#include "include/libanoncreds.h"
+#include "library.h"
+
+namespace anoncreds {
+
+using namespace anoncredsBinding;
+
+${names.map((name) => generateBinding(name, bindings[name], functions, defaults)).join('\n\n')}
+
+inline constexpr BindingEntry generatedBindings[] = {
+${names.map((name) => `    entry<"${name}", ${name}>(),`).join('\n')}
+};
+
+} // namespace anoncreds
+`
+}
+
+const generateLibrary = (header) => `// Generated by tools/codegen/generate-bindings.js from include/libanoncreds.h.
+// Do not edit by hand, included by library.h.
+
+namespace anoncredsLibrary {
+
+${parseFunctionNames(header)
+  .map((name) => `ANONCREDS_FUNCTION(${name})`)
+  .join('\n')}
+
+} // namespace anoncredsLibrary
+`
+
+const header = fs.readFileSync(headerPath, 'utf8')
+const outputs = [
+  [bindingsPath, generateBindings(header)],
+  [libraryPath, generateLibrary(header)],
+]
+
+if (process.argv.includes('--check')) {
+  for (const [outputPath, output] of outputs) {
+    const current = fs.existsSync(outputPath) ? fs.readFileSync(outputPath, 'utf8') : ''
+    if (current !== output) {
+      console.error(`${path.relative(root, outputPath)} is out of date, run \`pnpm generate:bindings\``)
+      process.exit(1)
+    }
+  }
+} else {
+  for (const [outputPath, output] of outputs) {
+    fs.writeFileSync(outputPath, output)
+  }
+}
@@ -0,0 +1,468 @@
+// Runs the module in two Hermes runtimes at once, each on its own thread with
+// its own call invoker, as a worklet or background runtime does next to the
+// UI runtime.
+//
+// Usage: anoncreds-multi-runtime-check [--iterations <n>]
+//
+// Checks that:
+// - both runtimes can call bindings concurrently, and that their handle scopes
+//   and `execute` callbacks stay separate
+// - a handle created in one runtime can be read and freed in the other
+// - a runtime installed without a call invoker rejects callbacks, and still
+//   runs everything else
+// - `getObject` gives the value of `JSON.parse(getJson())`
+// - an error thrown by an `execute` callback goes to `ErrorUtils.reportError`
+
+#include <hermes/hermes.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "turboModuleUtility.h"
+
+namespace {
+
+using Task = std::function<void(jsi::Runtime &)>;
+
+const char *script = R"(
+function check(condition, message) {
+  if (!condition) throw new Error(tag + ': ' + message)
+}
+
+function schema(name) {
+  return _anoncreds.createSchema({
+    name,
+    version: '1.0',
+    issuerId: 'did:example:' + tag,
+    attributeNames: ['name', 'age'],
+  })
+}
+
+function nameOf(handle) {
+  return JSON.parse(_anoncreds.getJson({ objectHandle: handle })).name
+}
+
+function free(handle) {
+  _anoncreds.objectFree({ objectHandle: handle })
+}
+
+function isFreed(handle) {
+  try {
+    _anoncreds.getJson({ objectHandle: handle })
+    return false
+  } catch (error) {
+    return true
+  }
+}
+
+// Creates and frees schemas in nested scopes. Were the scopes shared with the
+// other runtime, closing one here would free the handles of a scope it has
+// open at the same time.
+function work(iterations) {
+  for (let i = 0; i < iterations; i++) {
+    const outer = _anoncreds.beginScope({})
+    const temporary = schema(tag + '-temporary-' + i)
+    const inner = _anoncreds.beginScope({})
+    const kept = schema(tag + '-kept-' + i)
+    _anoncreds.endScope({ scope: inner, keep: [kept] })
+    check(nameOf(temporary) === tag + '-temporary-' + i, 'temporary schema changed')
+    check(nameOf(kept) === tag + '-kept-' + i, 'kept schema changed')
+    _anoncreds.endScope({ scope: outer, keep: [kept] })
+    check(isFreed(temporary), 'scope did not free its schema')
+    check(nameOf(kept) === tag + '-kept-' + i, 'kept schema was freed')
+    free(kept)
+  }
+}
+
+// A presentation request with escapes, non-ASCII strings and a `__proto__` key
+const requestJson =
+  '{"nonce":"1234567890",' +
+  '"name":"quote \\" backslash \\\\ control \\u0001 \\u00e9 \\ud83d\\ude00",' +
+  '"version":"0.1",' +
+  '"requested_attributes":{"__proto__":{"name":"name"},"constructor":{"names":["name","age"]}},' +
+  '"requested_predicates":{"predicate":{"name":"age","p_type":">=","p_value":18}},' +
+  '"non_revoked":{"from":13,"to":200}}'
+
+function sameObject(handle, type) {
+  const expected = JSON.stringify(JSON.parse(_anoncreds.getJson({ objectHandle: handle })))
+  const object = _anoncreds.getObject({ objectHandle: handle })
+  check(JSON.stringify(object) === expected, type + ' differs from JSON.parse')
+  return object
+}
+
+// `getObject` must give the value `JSON.parse` gives for the same JSON
+function parity() {
+  const schemaHandle = schema(tag + '-parity')
+  const { credentialDefinition, credentialDefinitionPrivate, keyCorrectnessProof } =
+    _anoncreds.createCredentialDefinition({
+      schemaId: 'mock:uri',
+      schema: schemaHandle,
+      issuerId: 'mock:uri',
+      tag: 'TAG',
+      signatureType: 'CL',
+      supportRevocation: 0,
+    })
+  const request = _anoncreds.presentationRequestFromJson({ json: requestJson })
+
+  sameObject(schemaHandle, 'schema')
+  sameObject(credentialDefinition, 'credential definition')
+  sameObject(credentialDefinitionPrivate, 'credential definition private')
+  sameObject(keyCorrectnessProof, 'key correctness proof')
+  const attributes = sameObject(request, 'presentation request').requested_attributes
+  check(Object.getPrototypeOf(attributes) === Object.prototype, '__proto__ key set the prototype')
+  check(Object.prototype.hasOwnProperty.call(attributes, '__proto__'), '__proto__ key is not an own property')
+
+  for (const handle of [schemaHandle, credentialDefinition, credentialDefinitionPrivate, keyCorrectnessProof, request])
+    free(handle)
+}
+
+// Runs command buffers on worker threads, their callbacks must come back to
+// this runtime
+var pending = 0
+var completed = 0
+function workAsync(count) {
+  for (let i = 0; i < count; i++) {
+    const name = tag + '-async-' + i
+    pending++
+    _anoncreds.execute({
+      commands: [
+        ['createSchema', [name, '1.0', 'did:example:' + tag, ['name']]],
+        ['getJson', [{ slot: 0 }]],
+      ],
+      callback: (error, results) => {
+        pending--
+        check(error === null, 'execute failed')
+        check(JSON.parse(results[0]).name === name, 'execute returned another schema')
+        completed++
+      },
+    })
+  }
+}
+
+// Stands in for the `ErrorUtils` of React Native
+var reported = []
+var ErrorUtils = { reportError: (error) => reported.push(error) }
+
+function throwInCallback() {
+  pending++
+  _anoncreds.execute({
+    commands: [['createSchema', [tag + '-throwing', '1.0', 'did:example:' + tag, ['name']]]],
+    callback: () => {
+      pending--
+      throw new Error('thrown by the callback')
+    },
+  })
+}
+)";
+
+// A JS thread, which owns a Hermes runtime and runs the tasks posted to it in
+// order
+class JsThread {
+public:
+  explicit JsThread(const char *tag)
+      : tag(tag), thread([this] { loop(); }) {}
+
+  ~JsThread() {
+    post(nullptr);
+    thread.join();
+  }
+
+  void post(Task task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      tasks.push_back(std::move(task));
+    }
+    wake.notify_one();
+  }
+
+  // Runs `task` on the thread and waits for it, rethrowing its errors
+  template <typename T> T run(std::function<T(jsi::Runtime &)> task) {
+    auto promise = std::make_shared<std::promise<T>>();
+    auto future = promise->get_future();
+    post([task, promise](jsi::Runtime &rt) {
+      try {
+        if constexpr (std::is_void_v<T>) {
+          task(rt);
+          promise->set_value();
+        } else {
+          promise->set_value(task(rt));
+        }
+      } catch (...) {
+        promise->set_exception(std::current_exception());
+      }
+    });
+    return future.get();
+  }
+
+  // Errors thrown by tasks that nobody waited for, such as callbacks
+  size_t failures() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return failed;
+  }
+
+  const char *tag;
+
+private:
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::deque<Task> tasks;
+  size_t failed = 0;
+  std::thread thread;
+
+  void loop() {
+    auto runtime = facebook::hermes::makeHermesRuntime();
+    runtime->global().setProperty(*runtime, "tag",
+                                  jsi::String::createFromAscii(*runtime, tag));
+    runtime->evaluateJavaScript(std::make_shared<jsi::StringBuffer>(script),
+                                "check.js");
+
+    while (true) {
+      Task task;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait(lock, [this] { return !tasks.empty(); });
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      }
+      if (!task)
+        break;
+      try {
+        task(*runtime);
+      } catch (const jsi::JSIException &e) {
+        fprintf(stderr, "%s: %s\n", tag, e.what());
+        std::lock_guard<std::mutex> lock(mutex);
+        failed++;
+      }
+    }
+  }
+};
+
+// Schedules work on a `JsThread`, counting the calls
+class Invoker : public react::CallInvoker {
+public:
+  explicit Invoker(JsThread &thread) : thread(thread) {}
+
+  void invokeAsync(react::CallFunc &&func) noexcept override {
+    calls++;
+    thread.post(std::move(func));
+  }
+
+  void invokeSync(react::CallFunc &&func) override {
+    thread.run<void>(std::move(func));
+  }
+
+  std::atomic<size_t> calls = 0;
+
+private:
+  JsThread &thread;
+};
+
+void install(JsThread &thread, std::shared_ptr<Invoker> invoker) {
+  thread.run<void>([invoker](jsi::Runtime &rt) {
+    anoncredsTurboModuleUtility::registerTurboModule(rt, invoker);
+    auto convention = jsi::Object(rt);
+    convention.setProperty(rt, "throwing", 1);
+    rt.global()
+        .getPropertyAsObject(rt, "_anoncreds")
+        .getPropertyAsFunction(rt, "setReturnConvention")
+        .call(rt, convention);
+  });
+}
+
+// Calls the global function `name` of `rt`
+jsi::Value callGlobal(jsi::Runtime &rt, const char *name, jsi::Value argument) {
+  return rt.global().getPropertyAsFunction(rt, name).call(rt,
+                                                           std::move(argument));
+}
+
+int global(JsThread &thread, const char *name) {
+  return thread.run<int>([name](jsi::Runtime &rt) {
+    return int(rt.global().getProperty(rt, name).getNumber());
+  });
+}
+
+void usage() {
+  fprintf(stderr, "Usage: anoncreds-multi-runtime-check [--iterations <n>]\n");
+}
+
+// Each runtime works through its own schemas at the same time, with command
+// buffers completing in the background
+bool concurrent(JsThread &ui, Invoker &uiInvoker, JsThread &background,
+                Invoker &backgroundInvoker, int iterations) {
+  auto work = [iterations](JsThread &thread) {
+    return std::async(std::launch::async, [&thread, iterations] {
+      thread.run<void>([iterations](jsi::Runtime &rt) {
+        callGlobal(rt, "workAsync", iterations);
+        callGlobal(rt, "work", iterations);
+      });
+    });
+  };
+  auto uiWork = work(ui);
+  auto backgroundWork = work(background);
+  try {
+    uiWork.get();
+    backgroundWork.get();
+  } catch (const jsi::JSIException &e) {
+    fprintf(stderr, "%s\n", e.what());
+    return false;
+  }
+
+  while (global(ui, "pending") > 0 || global(background, "pending") > 0)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  auto ok = true;
+  using Runtime = std::pair<JsThread *, Invoker *>;
+  for (auto [thread, invoker] :
+       {Runtime{&ui, &uiInvoker}, Runtime{&background, &backgroundInvoker}}) {
+    auto completed = global(*thread, "completed");
+    if (completed != iterations || invoker->calls != size_t(iterations)) {
+      fprintf(stderr,
+              "%s: %d of %d callbacks completed, %zu scheduled on its thread\n",
+              thread->tag, completed, iterations, invoker->calls.load());
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+// A handle created in one runtime is read and freed in the other
+bool shared(JsThread &ui, JsThread &background) {
+  try {
+    auto handle = ui.run<double>([](jsi::Runtime &rt) {
+      auto name = jsi::String::createFromAscii(rt, "shared");
+      return callGlobal(rt, "schema", std::move(name)).getNumber();
+    });
+    auto name = background.run<std::string>([handle](jsi::Runtime &rt) {
+      auto name = callGlobal(rt, "nameOf", handle).getString(rt).utf8(rt);
+      callGlobal(rt, "free", handle);
+      return name;
+    });
+    auto freed = ui.run<bool>([handle](jsi::Runtime &rt) {
+      return callGlobal(rt, "isFreed", handle).getBool();
+    });
+    if (name != "shared" || !freed) {
+      fprintf(stderr, "shared handle: read `%s`, %s\n", name.c_str(),
+              freed ? "freed" : "not freed");
+      return false;
+    }
+  } catch (const jsi::JSIException &e) {
+    fprintf(stderr, "shared handle: %s\n", e.what());
+    return false;
+  }
+  return true;
+}
+
+// `getObject` against `JSON.parse`, for objects of several types
+bool parity(JsThread &thread) {
+  try {
+    thread.run<void>([](jsi::Runtime &rt) {
+      rt.global().getPropertyAsFunction(rt, "parity").call(rt);
+    });
+  } catch (const jsi::JSIException &e) {
+    fprintf(stderr, "parity: %s\n", e.what());
+    return false;
+  }
+  return true;
+}
+
+// An error thrown by a callback is reported, instead of escaping the call
+// invoker
+bool callbackError(JsThread &thread) {
+  try {
+    thread.run<void>([](jsi::Runtime &rt) {
+      rt.global().getPropertyAsFunction(rt, "throwInCallback").call(rt);
+    });
+  } catch (const jsi::JSIException &e) {
+    fprintf(stderr, "callback error: %s\n", e.what());
+    return false;
+  }
+  while (global(thread, "pending") > 0)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  auto message = thread.run<std::string>([](jsi::Runtime &rt) {
+    auto reported = rt.global().getPropertyAsObject(rt, "reported").asArray(rt);
+    if (reported.size(rt) != 1)
+      return std::to_string(reported.size(rt)) + " errors reported";
+    return reported.getValueAtIndex(rt, 0)
+        .asObject(rt)
+        .getProperty(rt, "message")
+        .toString(rt)
+        .utf8(rt);
+  });
+  if (message != "thrown by the callback") {
+    fprintf(stderr, "callback error: %s\n", message.c_str());
+    return false;
+  }
+  return true;
+}
+
+// A runtime without a call invoker, like a worklet runtime
+bool withoutInvoker() {
+  JsThread worklet("worklet");
+  install(worklet, nullptr);
+  return worklet.run<bool>([](jsi::Runtime &rt) {
+    try {
+      callGlobal(rt, "workAsync", 1);
+      fprintf(stderr, "worklet: callback accepted without a call invoker\n");
+      return false;
+    } catch (const jsi::JSError &) {
+    }
+    try {
+      callGlobal(rt, "work", 1);
+    } catch (const jsi::JSIException &e) {
+      fprintf(stderr, "%s\n", e.what());
+      return false;
+    }
+    return true;
+  });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  int iterations = 200;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+      iterations = atoi(argv[++i]);
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (iterations <= 0) {
+    usage();
+    return 2;
+  }
+
+  JsThread ui("ui");
+  JsThread background("background");
+  auto uiInvoker = std::make_shared<Invoker>(ui);
+  auto backgroundInvoker = std::make_shared<Invoker>(background);
+  install(ui, uiInvoker);
+  install(background, backgroundInvoker);
+
+  auto ok = concurrent(ui, *uiInvoker, background, *backgroundInvoker,
+                       iterations);
+  ok = shared(ui, background) && ok;
+  ok = withoutInvoker() && ok;
+  ok = parity(ui) && ok;
+  ok = callbackError(ui) && ok;
+  ok = ui.failures() == 0 && background.failures() == 0 && ok;
+
+  if (!ok)
+    return 1;
+  printf("%d iterations in 2 runtimes, handles shared between them\n",
+         iterations);
+  return 0;
+}
@@ -0,0 +1,801 @@
+// Replays a trace written by the call recorder (`cpp/callRecorder.h`) against
+// a `libanoncreds` build and reports how the latency of every binding changed.
+//
+// Usage: anoncreds-replay <trace> [--iterations <n>] [--verbose]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "include/libanoncreds.h"
+#include "json.h"
+
+namespace {
+
+using anoncredsJson::Value;
+
+struct TraceRecord {
+  uint8_t flags;
+  std::string name;
+  std::string arguments;
+  std::string result;
+  uint64_t start;
+  uint64_t duration;
+};
+
+struct Trace {
+  uint64_t startedAt = 0;
+  std::string library;
+  std::vector<TraceRecord> records;
+};
+
+// Thrown when a call refers to a handle that was created before the
+// recording started, so it can not be replayed
+struct MissingHandle : std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+
+class TraceReader {
+public:
+  explicit TraceReader(const std::string &bytes) : bytes(bytes) {}
+
+  Trace read() {
+    Trace trace;
+    if (bytes.compare(0, 4, "ACTR") != 0)
+      throw std::runtime_error("Not an anoncreds trace file");
+    pos = 4;
+    auto version = byte();
+    if (version != 1)
+      throw std::runtime_error("Unsupported trace version " +
+                               std::to_string(version));
+    for (int i = 0; i < 8; i++) {
+      trace.startedAt |= uint64_t(byte()) << (8 * i);
+    }
+    trace.library = string();
+
+    while (pos < bytes.size()) {
+      TraceRecord record;
+      record.flags = byte();
+      record.name = string();
+      record.arguments = string();
+      record.result = string();
+      record.start = varint();
+      record.duration = varint();
+      trace.records.push_back(std::move(record));
+    }
+    return trace;
+  }
+
+private:
+  const std::string &bytes;
+  size_t pos = 0;
+
+  uint8_t byte() {
+    if (pos >= bytes.size())
+      throw std::runtime_error("Truncated trace file");
+    return uint8_t(bytes[pos++]);
+  }
+
+  uint64_t varint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      auto b = byte();
+      value |= uint64_t(b & 0x7F) << shift;
+      if ((b & 0x80) == 0)
+        return value;
+    }
+    throw std::runtime_error("Invalid varint in trace file");
+  }
+
+  std::string string() {
+    auto len = varint();
+    if (len > bytes.size() - pos)
+      throw std::runtime_error("Truncated trace file");
+    auto s = bytes.substr(pos, len);
+    pos += len;
+    return s;
+  }
+};
+
+// Maps handles seen in the trace onto the handles created while replaying
+using HandleMap = std::unordered_map<uint64_t, ObjectHandle>;
+
+// Written by the recorder in place of every link secret
+const std::string_view redacted = "[redacted]";
+
+// Stands in for the redacted link secrets of a trace, created once by `main`
+std::string replayLinkSecret;
+
+// Decodes the recorded options object of a call into FFI arguments. All
+// storage is owned here and stays valid until the call returns.
+class Arguments {
+public:
+  // `fields` lists the keys of a struct in FFI field order, for structs that
+  // were passed as an array instead of an object
+  Arguments(const Value &options, HandleMap &handles,
+            std::vector<const char *> fields = {})
+      : options(options), handles(handles), fields(std::move(fields)) {}
+
+  const Value *get(const char *key) const {
+    if (!options.isArray())
+      return options.get(key);
+    for (size_t i = 0; i < fields.size() && i < options.items.size(); i++) {
+      if (std::string_view(fields[i]) == key)
+        return &options.items[i];
+    }
+    return nullptr;
+  }
+
+  FfiStr str(const char *key, bool nullIfEmpty = false) {
+    auto value = get(key);
+    if (value == nullptr || !value->isString())
+      return nullIfEmpty ? nullptr : "";
+    if (nullIfEmpty && value->text.empty())
+      return nullptr;
+    return value->text.c_str();
+  }
+
+  // A link secret, replaced by `replayLinkSecret` when it was redacted
+  FfiStr secret(const char *key) {
+    auto value = get(key);
+    if (value != nullptr && value->isString() && value->text == redacted)
+      return replayLinkSecret.c_str();
+    return str(key);
+  }
+
+  int64_t number(const char *key, int64_t fallback = 0) {
+    auto value = get(key);
+    if (value == nullptr || value->isNull())
+      return fallback;
+    if (value->isBool())
+      return value->boolean ? 1 : 0;
+    return int64_t(value->asNumber());
+  }
+
+  ObjectHandle handle(const Value *value) {
+    if (value == nullptr || !value->isNumber())
+      return 0;
+    auto recorded = uint64_t(value->asNumber());
+    if (recorded == 0)
+      return 0;
+    auto it = handles.find(recorded);
+    if (it == handles.end())
+      throw MissingHandle("handle " + std::to_string(recorded));
+    return it->second;
+  }
+
+  ObjectHandle handle(const char *key) { return handle(get(key)); }
+
+  ByteBuffer buffer(const char *key) {
+    auto value = get(key);
+    if (value == nullptr || !value->isString())
+      return ByteBuffer{0, nullptr};
+    return ByteBuffer{int64_t(value->text.size()),
+                      (uint8_t *)value->text.data()};
+  }
+
+  FfiStrList strList(const char *key) {
+    auto value = get(key);
+    if (value == nullptr || !value->isArray() || value->items.empty())
+      return FfiStrList{};
+    auto &list = strLists.emplace_back();
+    for (auto &item : value->items) {
+      list.push_back(item.text.c_str());
+    }
+    return FfiStrList{list.size(), list.data()};
+  }
+
+  FfiList_ObjectHandle handleList(const char *key) {
+    auto value = get(key);
+    if (value == nullptr || !value->isArray())
+      return FfiList_ObjectHandle{};
+    auto &list = handleLists.emplace_back();
+    for (auto &item : value->items) {
+      list.push_back(handle(&item));
+    }
+    return FfiList_ObjectHandle{list.size(), list.data()};
+  }
+
+  FfiList_i32 i32List(const char *key) {
+    auto value = get(key);
+    if (value == nullptr || !value->isArray())
+      return FfiList_i32{};
+    auto &list = i32Lists.emplace_back();
+    for (auto &item : value->items) {
+      list.push_back(int32_t(item.asNumber()));
+    }
+    return FfiList_i32{list.size(), list.data()};
+  }
+
+  FfiList_FfiCredentialEntry credentialEntries(const char *key) {
+    auto value = get(key);
+    if (value == nullptr || !value->isArray())
+      return FfiList_FfiCredentialEntry{};
+    auto &list = credentialEntryLists.emplace_back();
+    for (auto &item : value->items) {
+      Arguments entry(item, handles,
+                      {"credential", "timestamp", "revocationState"});
+      list.push_back(FfiCredentialEntry{
+          entry.handle("credential"), int32_t(entry.number("timestamp", -1)),
+          entry.handle("revocationState")});
+    }
+    return FfiList_FfiCredentialEntry{list.size(), list.data()};
+  }
+
+  FfiList_FfiCredentialProve credentialsProve(const char *key) {
+    auto value = get(key);
+    if (value == nullptr || !value->isArray())
+      return FfiList_FfiCredentialProve{};
+    auto &list = credentialProveLists.emplace_back();
+    for (auto &item : value->items) {
+      Arguments prove(item, handles,
+                      {"entryIndex", "referent", "isPredicate", "reveal"});
+      list.push_back(FfiCredentialProve{
+          prove.number("entryIndex"), prove.str("referent"),
+          int8_t(prove.number("isPredicate")),
+          int8_t(prove.number("reveal"))});
+    }
+    return FfiList_FfiCredentialProve{list.size(), list.data()};
+  }
+
+  FfiList_FfiNonrevokedIntervalOverride intervalOverrides(const char *key) {
+    auto value = get(key);
+    if (value == nullptr || !value->isArray())
+      return FfiList_FfiNonrevokedIntervalOverride{};
+    auto &list = overrideLists.emplace_back();
+    for (auto &item : value->items) {
+      Arguments entry(item, handles,
+                      {"revocationRegistryDefinitionId",
+                       "requestedFromTimestamp",
+                       "overrideRevocationStatusListTimestamp"});
+      list.push_back(FfiNonrevokedIntervalOverride{
+          entry.str("revocationRegistryDefinitionId"),
+          int32_t(entry.number("requestedFromTimestamp")),
+          int32_t(entry.number("overrideRevocationStatusListTimestamp"))});
+    }
+    return FfiList_FfiNonrevokedIntervalOverride{list.size(), list.data()};
+  }
+
+  const FfiCredRevInfo *revocation(const char *key) {
+    auto value = get(key);
+    if (value == nullptr || !value->isObject())
+      return nullptr;
+    Arguments config(*value, handles,
+                     {"revocationRegistryDefinition",
+                      "revocationRegistryDefinitionPrivate",
+                      "revocationStatusList", "registryIndex"});
+    revocationInfo = FfiCredRevInfo{
+        config.handle("revocationRegistryDefinition"),
+        config.handle("revocationRegistryDefinitionPrivate"),
+        config.handle("revocationStatusList"),
+        config.number("registryIndex")};
+    return &revocationInfo;
+  }
+
+private:
+  const Value &options;
+  HandleMap &handles;
+  std::vector<const char *> fields;
+  std::deque<std::vector<FfiStr>> strLists;
+  std::deque<std::vector<ObjectHandle>> handleLists;
+  std::deque<std::vector<int32_t>> i32Lists;
+  std::deque<std::vector<FfiCredentialEntry>> credentialEntryLists;
+  std::deque<std::vector<FfiCredentialProve>> credentialProveLists;
+  std::deque<std::vector<FfiNonrevokedIntervalOverride>> overrideLists;
+  FfiCredRevInfo revocationInfo{};
+};
+
+// Handles created by a replayed call, keyed by the property they were
+// returned under. An empty key means the handle is the return value itself.
+using Outputs = std::vector<std::pair<const char *, ObjectHandle>>;
+
+using Replayer = std::function<ErrorCode(Arguments &, Outputs &)>;
+
+ErrorCode freeString(ErrorCode code, const char *out) {
+  if (code == ErrorCode::Success && out != nullptr)
+    anoncreds_string_free((char *)out);
+  return code;
+}
+
+template <typename F> Replayer returnsHandle(F call) {
+  return [call](Arguments &args, Outputs &outputs) {
+    ObjectHandle out = 0;
+    auto code = call(args, &out);
+    outputs.emplace_back("", out);
+    return code;
+  };
+}
+
+template <typename F> Replayer returnsString(F call) {
+  return [call](Arguments &args, Outputs &) {
+    const char *out = nullptr;
+    return freeString(call(args, &out), out);
+  };
+}
+
+template <ErrorCode (*parse)(ByteBuffer, ObjectHandle *)>
+Replayer fromJson() {
+  return returnsHandle([](Arguments &args, ObjectHandle *out) {
+    return parse(args.buffer("json"), out);
+  });
+}
+
+std::map<std::string, Replayer> replayers() {
+  std::map<std::string, Replayer> r;
+
+  r["getJson"] = [](Arguments &args, Outputs &) {
+    ByteBuffer out{0, nullptr};
+    auto code = anoncreds_object_get_json(args.handle("objectHandle"), &out);
+    if (code == ErrorCode::Success)
+      anoncreds_buffer_free(out);
+    return code;
+  };
+  r["getTypeName"] = returnsString([](Arguments &args, const char **out) {
+    return anoncreds_object_get_type_name(args.handle("objectHandle"), out);
+  });
+  r["generateNonce"] = returnsString(
+      [](Arguments &, const char **out) { return anoncreds_generate_nonce(out); });
+  r["createLinkSecret"] = returnsString([](Arguments &, const char **out) {
+    return anoncreds_create_link_secret(out);
+  });
+
+  r["schemaFromJson"] = fromJson<anoncreds_schema_from_json>();
+  r["credentialDefinitionFromJson"] =
+      fromJson<anoncreds_credential_definition_from_json>();
+  r["credentialDefinitionPrivateFromJson"] =
+      fromJson<anoncreds_credential_definition_private_from_json>();
+  r["keyCorrectnessProofFromJson"] =
+      fromJson<anoncreds_key_correctness_proof_from_json>();
+  r["credentialOfferFromJson"] =
+      fromJson<anoncreds_credential_offer_from_json>();
+  r["credentialRequestFromJson"] =
+      fromJson<anoncreds_credential_request_from_json>();
+  r["credentialRequestMetadataFromJson"] =
+      fromJson<anoncreds_credential_request_metadata_from_json>();
+  r["credentialFromJson"] = fromJson<anoncreds_credential_from_json>();
+  r["presentationFromJson"] = fromJson<anoncreds_presentation_from_json>();
+  r["presentationRequestFromJson"] =
+      fromJson<anoncreds_presentation_request_from_json>();
+  r["revocationRegistryDefinitionFromJson"] =
+      fromJson<anoncreds_revocation_registry_definition_from_json>();
+  r["revocationRegistryDefinitionPrivateFromJson"] =
+      fromJson<anoncreds_revocation_registry_definition_private_from_json>();
+  r["revocationRegistryFromJson"] =
+      fromJson<anoncreds_revocation_registry_from_json>();
+  r["revocationStatusListFromJson"] =
+      fromJson<anoncreds_revocation_status_list_from_json>();
+  r["revocationStateFromJson"] =
+      fromJson<anoncreds_revocation_state_from_json>();
+  r["w3cCredentialFromJson"] = fromJson<anoncreds_w3c_credential_from_json>();
+  r["w3cPresentationFromJson"] =
+      fromJson<anoncreds_w3c_presentation_from_json>();
+
+  r["createSchema"] = returnsHandle([](Arguments &args, ObjectHandle *out) {
+    return anoncreds_create_schema(args.str("name"), args.str("version"),
+                                   args.str("issuerId"),
+                                   args.strList("attributeNames"), out);
+  });
+  r["createCredentialDefinition"] = [](Arguments &args, Outputs &outputs) {
+    ObjectHandle credentialDefinition = 0, credentialDefinitionPrivate = 0,
+                 keyCorrectnessProof = 0;
+    auto code = anoncreds_create_credential_definition(
+        args.str("schemaId"), args.handle("schema"), args.str("tag"),
+        args.str("issuerId"), args.str("signatureType"),
+        int8_t(args.number("supportRevocation")), &credentialDefinition,
+        &credentialDefinitionPrivate, &keyCorrectnessProof);
+    outputs.emplace_back("credentialDefinition", credentialDefinition);
+    outputs.emplace_back("credentialDefinitionPrivate",
+                         credentialDefinitionPrivate);
+    outputs.emplace_back("keyCorrectnessProof", keyCorrectnessProof);
+    return code;
+  };
+  r["createCredentialOffer"] =
+      returnsHandle([](Arguments &args, ObjectHandle *out) {
+        return anoncreds_create_credential_offer(
+            args.str("schemaId"), args.str("credentialDefinitionId"),
+            args.handle("keyCorrectnessProof"), out);
+      });
+  r["createCredentialRequest"] = [](Arguments &args, Outputs &outputs) {
+    ObjectHandle credentialRequest = 0, credentialRequestMetadata = 0;
+    auto code = anoncreds_create_credential_request(
+        args.str("entropy", true), args.str("proverDid", true),
+        args.handle("credentialDefinition"), args.secret("linkSecret"),
+        args.str("linkSecretId"), args.handle("credentialOffer"),
+        &credentialRequest, &credentialRequestMetadata);
+    outputs.emplace_back("credentialRequest", credentialRequest);
+    outputs.emplace_back("credentialRequestMetadata",
+                         credentialRequestMetadata);
+    return code;
+  };
+  r["createCredential"] = returnsHandle([](Arguments &args, ObjectHandle *out) {
+    return anoncreds_create_credential(
+        args.handle("credentialDefinition"),
+        args.handle("credentialDefinitionPrivate"),
+        args.handle("credentialOffer"), args.handle("credentialRequest"),
+        args.strList("attributeNames"), args.strList("attributeRawValues"),
+        args.strList("attributeEncodedValues"),
+        args.revocation("revocationConfiguration"), out);
+  });
+  r["createW3cCredential"] =
+      returnsHandle([](Arguments &args, ObjectHandle *out) {
+        return anoncreds_create_w3c_credential(
+            args.handle("credentialDefinition"),
+            args.handle("credentialDefinitionPrivate"),
+            args.handle("credentialOffer"), args.handle("credentialRequest"),
+            args.strList("attributeNames"),
+            args.strList("attributeRawValues"),
+            args.revocation("revocationConfiguration"),
+            args.str("w3cVersion", true), out);
+      });
+  r["processCredential"] =
+      returnsHandle([](Arguments &args, ObjectHandle *out) {
+        return anoncreds_process_credential(
+            args.handle("credential"), args.handle("credentialRequestMetadata"),
+            args.secret("linkSecret"), args.handle("credentialDefinition"),
+            args.handle("revocationRegistryDefinition"), out);
+      });
+  r["processW3cCredential"] =
+      returnsHandle([](Arguments &args, ObjectHandle *out) {
+        return anoncreds_process_w3c_credential(
+            args.handle("credential"), args.handle("credentialRequestMetadata"),
+            args.secret("linkSecret"), args.handle("credentialDefinition"),
+            args.handle("revocationRegistryDefinition"), out);
+      });
+  r["credentialToW3c"] = returnsHandle([](Arguments &args, ObjectHandle *out) {
+    return anoncreds_credential_to_w3c(args.handle("objectHandle"),
+                                       args.str("issuerId"),
+                                       args.str("w3cVersion", true), out);
+  });
+  r["credentialFromW3c"] =
+      returnsHandle([](Arguments &args, ObjectHandle *out) {
+        return anoncreds_credential_from_w3c(args.handle("objectHandle"), out);
+      });
+  r["credentialGetAttribute"] =
+      returnsString([](Arguments &args, const char **out) {
+        return anoncreds_credential_get_attribute(args.handle("objectHandle"),
+                                                  args.str("name"), out);
+      });
+  r["w3cCredentialProofGetAttribute"] =
+      returnsString([](Arguments &args, const char **out) {
+        return anoncreds_w3c_credential_proof_get_attribute(
+            args.handle("objectHandle"), args.str("name"), out);
+      });
+  r["w3cCredentialGetIntegrityProofDetails"] =
+      returnsHandle([](Arguments &args, ObjectHandle *out) {
+        return anoncreds_w3c_credential_get_integrity_proof_details(
+            args.handle("objectHandle"), out);
+      });
+  r["encodeCredentialAttributes"] =
+      returnsString([](Arguments &args, const char **out) {
+        return anoncreds_encode_credential_attributes(
+            args.strList("attributeRawValues"), out);
+      });
+
+  r["createPresentation"] =
+      returnsHandle([](Arguments &args, ObjectHandle *out) {
+        return anoncreds_create_presentation(
+            args.handle("presentationRequest"),
+            args.credentialEntries("credentials"),
+            args.credentialsProve("credentialsProve"),
+            args.strList("selfAttestNames"), args.strList("selfAttestValues"),
+            args.secret("linkSecret"), args.handleList("schemas"),
+            args.strList("schemaIds"), args.handleList("credentialDefinitions"),
+            args.strList("credentialDefinitionIds"), out);
+      });
+  r["createW3cPresentation"] =
+      returnsHandle([](Arguments &args, ObjectHandle *out) {
+        return anoncreds_create_w3c_presentation(
+            args.handle("presentationRequest"),
+            args.credentialEntries("credentials"),
+            args.credentialsProve("credentialsProve"), args.secret("linkSecret"),
+            args.handleList("schemas"), args.strList("schemaIds"),
+            args.handleList("credentialDefinitions"),
+            args.strList("credentialDefinitionIds"),
+            args.str("w3cVersion", true), out);
+      });
+
+  auto verify = [](auto ffi) {
+    return [ffi](Arguments &args, Outputs &) {
+      int8_t out = 0;
+      return ffi(args.handle("presentation"),
+                 args.handle("presentationRequest"),
+                 args.handleList("schemas"), args.strList("schemaIds"),
+                 args.handleList("credentialDefinitions"),
+                 args.strList("credentialDefinitionIds"),
+                 args.handleList("revocationRegistryDefinitions"),
+                 args.strList("revocationRegistryDefinitionIds"),
+                 args.handleList("revocationStatusLists"),
+                 args.intervalOverrides("nonRevokedIntervalOverrides"), &out);
+    };
+  };
+  r["verifyPresentation"] = verify(anoncreds_verify_presentation);
+  r["verifyW3cPresentation"] = verify(anoncreds_verify_w3c_presentation);
+
+  r["createRevocationRegistryDefinition"] = [](Arguments &args,
+                                               Outputs &outputs) {
+    ObjectHandle registryDefinition = 0, registryDefinitionPrivate = 0;
+    auto code = anoncreds_create_revocation_registry_def(
+        args.handle("credentialDefinition"),
+        args.str("credentialDefinitionId"), args.str("issuerId"),
+        args.str("tag"), args.str("revocationRegistryType"),
+        args.number("maximumCredentialNumber"),
+        args.str("tailsDirectoryPath", true), &registryDefinition,
+        &registryDefinitionPrivate);
+    outputs.emplace_back("revocationRegistryDefinition", registryDefinition);
+    outputs.emplace_back("revocationRegistryDefinitionPrivate",
+                         registryDefinitionPrivate);
+    return code;
+  };
+  r["createRevocationStatusList"] =
+      returnsHandle([](Arguments &args, ObjectHandle *out) {
+        return anoncreds_create_revocation_status_list(
+            args.handle("credentialDefinition"),
+            args.str("revocationRegistryDefinitionId"),
+            args.handle("revocationRegistryDefinition"),
+            args.handle("revocationRegistryDefinitionPrivate"),
+            args.str("issuerId"), int8_t(args.number("issuanceByDefault")),
+            args.number("timestamp", -1), out);
+      });
+  r["updateRevocationStatusList"] =
+      returnsHandle([](Arguments &args, ObjectHandle *out) {
+        return anoncreds_update_revocation_status_list(
+            args.handle("credentialDefinition"),
+            args.handle("revocationRegistryDefinition"),
+            args.handle("revocationRegistryDefinitionPrivate"),
+            args.handle("currentRevocationStatusList"),
+            args.i32List("issued"), args.i32List("revoked"),
+            args.number("timestamp", -1), out);
+      });
+  r["updateRevocationStatusListTimestampOnly"] =
+      returnsHandle([](Arguments &args, ObjectHandle *out) {
+        return anoncreds_update_revocation_status_list_timestamp_only(
+            args.number("timestamp"),
+            args.handle("currentRevocationStatusList"), out);
+      });
+  r["createOrUpdateRevocationState"] =
+      returnsHandle([](Arguments &args, ObjectHandle *out) {
+        return anoncreds_create_or_update_revocation_state(
+            args.handle("revocationRegistryDefinition"),
+            args.handle("revocationStatusList"),
+            args.number("revocationRegistryIndex"), args.str("tailsPath"),
+            args.handle("oldRevocationState"),
+            args.handle("oldRevocationStatusList"), out);
+      });
+  r["revocationRegistryDefinitionGetAttribute"] =
+      returnsString([](Arguments &args, const char **out) {
+        return anoncreds_revocation_registry_definition_get_attribute(
+            args.handle("objectHandle"), args.str("name"), out);
+      });
+
+  return r;
+}
+
+// Bindings that do not touch anoncreds objects and are left out of the report
+const std::set<std::string> ignoredBindings = {
+    "version", "getCurrentError", "setDefaultLogger", "startRecording",
+    "stopRecording"};
+
+struct BindingStatistics {
+  uint64_t calls = 0;
+  uint64_t recordedNs = 0;
+  uint64_t replayedNs = 0;
+  uint64_t errorMismatches = 0;
+};
+
+struct Options {
+  std::string tracePath;
+  int iterations = 1;
+  bool verbose = false;
+};
+
+void usage() {
+  fprintf(stderr,
+          "Usage: anoncreds-replay <trace> [--iterations <n>] [--verbose]\n");
+}
+
+bool parseOptions(int argc, char **argv, Options &options) {
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+      options.iterations = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--verbose") == 0) {
+      options.verbose = true;
+    } else if (argv[i][0] != '-' && options.tracePath.empty()) {
+      options.tracePath = argv[i];
+    } else {
+      return false;
+    }
+  }
+  return !options.tracePath.empty();
+}
+
+double toMicroseconds(uint64_t ns) { return double(ns) / 1000.0; }
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    usage();
+    return 2;
+  }
+
+  std::ifstream file(options.tracePath, std::ios::binary);
+  if (!file) {
+    fprintf(stderr, "Unable to open %s\n", options.tracePath.c_str());
+    return 1;
+  }
+  std::string bytes((std::istreambuf_iterator<char>(file)),
+                    std::istreambuf_iterator<char>());
+
+  Trace trace;
+  try {
+    trace = TraceReader(bytes).read();
+  } catch (const std::exception &e) {
+    fprintf(stderr, "%s: %s\n", options.tracePath.c_str(), e.what());
+    return 1;
+  }
+
+  printf("Trace recorded with anoncreds %s, replaying with anoncreds %s\n",
+         trace.library.c_str(), anoncreds_version());
+  printf("%zu calls, %d iteration(s)\n\n", trace.records.size(),
+         options.iterations);
+
+  const char *linkSecret = nullptr;
+  if (anoncreds_create_link_secret(&linkSecret) != ErrorCode::Success) {
+    fprintf(stderr, "Unable to create a link secret\n");
+    return 1;
+  }
+  replayLinkSecret = linkSecret;
+  anoncreds_string_free((char *)linkSecret);
+
+  auto table = replayers();
+  std::map<std::string, BindingStatistics> statistics;
+  std::map<std::string, uint64_t> skipped;
+  std::map<std::string, uint64_t> unsupported;
+
+  for (int iteration = 0; iteration < options.iterations; iteration++) {
+    HandleMap handles;
+
+    for (size_t i = 0; i < trace.records.size(); i++) {
+      auto &record = trace.records[i];
+      if (ignoredBindings.count(record.name))
+        continue;
+      // Bindings of the native module that are not a single libanoncreds
+      // call, such as `fromCbor` and `encodeAttributes` whose bytes are
+      // recorded as base64, or `execute` whose commands are recorded without
+      // their arguments
+      if (record.name != "objectFree" && table.count(record.name) == 0) {
+        unsupported[record.name]++;
+        continue;
+      }
+      if (record.flags & 1) {
+        skipped[record.name]++;
+        continue;
+      }
+
+      Value arguments, result;
+      if (!anoncredsJson::parse(record.arguments.data(),
+                                record.arguments.size(), arguments) ||
+          !anoncredsJson::parse(record.result.data(), record.result.size(),
+                                result)) {
+        skipped[record.name]++;
+        continue;
+      }
+
+      // Frees are replayed to keep the handle table the same size as in the
+      // recorded session, but are not interesting to time
+      if (record.name == "objectFree") {
+        auto recorded = arguments.get("objectHandle");
+        if (recorded != nullptr && recorded->isNumber()) {
+          auto it = handles.find(uint64_t(recorded->asNumber()));
+          if (it != handles.end()) {
+            anoncreds_object_free(it->second);
+            handles.erase(it);
+          }
+        }
+        continue;
+      }
+
+      auto replayer = table.find(record.name);
+
+      Outputs outputs;
+      ErrorCode code;
+      uint64_t elapsed;
+      try {
+        Arguments args(arguments, handles);
+        auto begin = std::chrono::steady_clock::now();
+        code = replayer->second(args, outputs);
+        auto end = std::chrono::steady_clock::now();
+        elapsed =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin)
+                .count();
+      } catch (const MissingHandle &) {
+        skipped[record.name]++;
+        continue;
+      }
+
+      auto recordedCode = result.get("errorCode");
+      auto recordedValue = result.get("value");
+      bool mismatch = recordedCode != nullptr &&
+                      uint64_t(recordedCode->asNumber()) != uint64_t(code);
+
+      if (code == ErrorCode::Success && recordedValue != nullptr) {
+        for (auto &[key, handle] : outputs) {
+          auto recorded = key[0] == '\0' ? recordedValue
+                                         : recordedValue->get(key);
+          if (recorded != nullptr && recorded->isNumber())
+            handles[uint64_t(recorded->asNumber())] = handle;
+          else
+            anoncreds_object_free(handle);
+        }
+      }
+
+      auto &stats = statistics[record.name];
+      stats.calls++;
+      stats.recordedNs += record.duration;
+      stats.replayedNs += elapsed;
+      if (mismatch)
+        stats.errorMismatches++;
+
+      if (options.verbose) {
+        printf("#%-6zu %-44s recorded %10.1fus  replayed %10.1fus%s\n", i,
+               record.name.c_str(), toMicroseconds(record.duration),
+               toMicroseconds(elapsed),
+               mismatch ? "  (error code differs)" : "");
+      }
+    }
+
+    for (auto &[recorded, handle] : handles) {
+      anoncreds_object_free(handle);
+    }
+  }
+
+  if (options.verbose)
+    printf("\n");
+
+  printf("%-44s %8s %14s %14s %9s\n", "binding", "calls", "recorded (us)",
+         "replayed (us)", "delta");
+  uint64_t totalRecorded = 0, totalReplayed = 0;
+  for (auto &[name, stats] : statistics) {
+    auto recordedMean = toMicroseconds(stats.recordedNs) / stats.calls;
+    auto replayedMean = toMicroseconds(stats.replayedNs) / stats.calls;
+    auto delta = recordedMean > 0
+                     ? (replayedMean - recordedMean) / recordedMean * 100.0
+                     : 0.0;
+    printf("%-44s %8llu %14.1f %14.1f %+8.1f%%", name.c_str(),
+           (unsigned long long)stats.calls, recordedMean, replayedMean, delta);
+    if (stats.errorMismatches > 0)
+      printf("  %llu error code mismatch(es)",
+             (unsigned long long)stats.errorMismatches);
+    printf("\n");
+    totalRecorded += stats.recordedNs;
+    totalReplayed += stats.replayedNs;
+  }
+
+  printf("\nTotal: recorded %.1fms, replayed %.1fms\n",
+         toMicroseconds(totalRecorded) / 1000.0 / options.iterations,
+         toMicroseconds(totalReplayed) / 1000.0 / options.iterations);
+
+  for (auto &[name, count] : skipped) {
+    printf("Skipped %llu call(s) to %s\n", (unsigned long long)count,
+           name.c_str());
+  }
+  for (auto &[name, count] : unsupported) {
+    printf("Unsupported: %llu call(s) to %s, which can not be replayed\n",
+           (unsigned long long)count, name.c_str());
+  }
+
+  return 0;
+}
@@ -0,0 +1,25 @@
+// Stand-in for an app launch, built once linked against libanoncreds and once
+// with `ANONCREDS_LAZY_LOAD`. It signals that it is interactive as soon as
+// `main` runs, after the dynamic loader mapped and relocated everything it was
+// linked against, which is the part of the startup the lazy mode changes.
+//
+// Usage: startup-app [--first-call]
+//
+// With `--first-call` the app makes its first libanoncreds call before
+// signalling, to show what the deferred loading costs once it happens.
+
+#include <cstring>
+
+#include "library.h"
+
+int main(int argc, char **argv) {
+  if (argc > 1 && strcmp(argv[1], "--first-call") == 0) {
+    try {
+      anoncredsLibrary::load();
+    } catch (const std::runtime_error &) {
+      return 1;
+    }
+    anoncredsLibrary::anoncreds_version();
+  }
+  return 0;
+}
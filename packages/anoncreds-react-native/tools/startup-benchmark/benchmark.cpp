@@ -0,0 +1,118 @@
+// Compares the startup of an app linked against libanoncreds with one that
+// loads it lazily (`ANONCREDS_LAZY_LOAD`, see `cpp/library.h`).
+//
+// Usage: anoncreds-startup-benchmark <eager-app> <lazy-app> [--runs <n>]
+//
+// Every run spawns a fresh process and measures the wall time until it exits,
+// once without and once with a first libanoncreds call. Runs of both apps are
+// interleaved and the first run of each is discarded, so all of them are warm
+// starts with the library in the page cache.
+
+#include <spawn.h>
+#include <sys/wait.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+extern char **environ;
+
+namespace {
+
+struct Variant {
+  const char *label;
+  const char *path;
+  bool firstCall;
+  std::vector<double> milliseconds;
+};
+
+// Wall time of a single launch, negative when it failed
+double launch(const Variant &variant) {
+  std::vector<char *> argv{const_cast<char *>(variant.path)};
+  if (variant.firstCall)
+    argv.push_back(const_cast<char *>("--first-call"));
+  argv.push_back(nullptr);
+
+  auto begin = std::chrono::steady_clock::now();
+  pid_t pid;
+  if (posix_spawn(&pid, variant.path, nullptr, nullptr, argv.data(),
+                  environ) != 0)
+    return -1;
+  int status;
+  if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) ||
+      WEXITSTATUS(status) != 0)
+    return -1;
+  auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+double percentile(std::vector<double> values, double p) {
+  std::sort(values.begin(), values.end());
+  auto index = size_t(p * (values.size() - 1));
+  return values[index];
+}
+
+void usage() {
+  fprintf(stderr,
+          "Usage: anoncreds-startup-benchmark <eager-app> <lazy-app> "
+          "[--runs <n>]\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    usage();
+    return 2;
+  }
+
+  int runs = 200;
+  for (int i = 3; i < argc; i++) {
+    if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+      runs = atoi(argv[++i]);
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (runs < 1) {
+    usage();
+    return 2;
+  }
+
+  std::vector<Variant> variants{
+      {"eager", argv[1], false, {}},
+      {"lazy", argv[2], false, {}},
+      {"eager, first call", argv[1], true, {}},
+      {"lazy, first call", argv[2], true, {}},
+  };
+
+  for (int run = 0; run <= runs; run++) {
+    for (auto &variant : variants) {
+      auto milliseconds = launch(variant);
+      if (milliseconds < 0) {
+        fprintf(stderr, "%s: launch failed\n", variant.path);
+        return 1;
+      }
+      if (run > 0)
+        variant.milliseconds.push_back(milliseconds);
+    }
+  }
+
+  printf("%d warm launches per variant, time until the process exited\n\n",
+         runs);
+  printf("%-20s %10s %10s %10s\n", "", "p50 (ms)", "p90 (ms)", "min (ms)");
+  for (auto &variant : variants) {
+    printf("%-20s %10.3f %10.3f %10.3f\n", variant.label,
+           percentile(variant.milliseconds, 0.5),
+           percentile(variant.milliseconds, 0.9),
+           percentile(variant.milliseconds, 0));
+  }
+
+  return 0;
+}
@@ -0,0 +1,174 @@
+// Compares objects stored as JSON with the CBOR form of `toCbor` (see
+// `cpp/cbor.h`): the stored size, and the time to load an object from either
+// form, as `fromJson` and `fromCbor` do.
+//
+// Usage: anoncreds-storage-benchmark <directory> [--runs <n>]
+//
+// The directory holds one object per file, named after the type `fromCbor`
+// takes, e.g. `credential.json` or `revocationStatusList.json`, as written by
+// `exportToFile`. Every object is first checked to survive the round trip
+// through CBOR unchanged.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cbor.h"
+#include "include/libanoncreds.h"
+#include "json.h"
+
+namespace {
+
+struct Type {
+  const char *name;
+  ErrorCode (*parse)(ByteBuffer, ObjectHandle *);
+};
+
+const Type types[] = {
+    {"credential", anoncreds_credential_from_json},
+    {"credentialDefinition", anoncreds_credential_definition_from_json},
+    {"credentialDefinitionPrivate",
+     anoncreds_credential_definition_private_from_json},
+    {"credentialOffer", anoncreds_credential_offer_from_json},
+    {"credentialRequest", anoncreds_credential_request_from_json},
+    {"credentialRequestMetadata",
+     anoncreds_credential_request_metadata_from_json},
+    {"keyCorrectnessProof", anoncreds_key_correctness_proof_from_json},
+    {"presentation", anoncreds_presentation_from_json},
+    {"presentationRequest", anoncreds_presentation_request_from_json},
+    {"revocationRegistry", anoncreds_revocation_registry_from_json},
+    {"revocationRegistryDefinition",
+     anoncreds_revocation_registry_definition_from_json},
+    {"revocationRegistryDefinitionPrivate",
+     anoncreds_revocation_registry_definition_private_from_json},
+    {"revocationState", anoncreds_revocation_state_from_json},
+    {"revocationStatusList", anoncreds_revocation_status_list_from_json},
+    {"schema", anoncreds_schema_from_json},
+    {"w3cCredential", anoncreds_w3c_credential_from_json},
+    {"w3cPresentation", anoncreds_w3c_presentation_from_json},
+};
+
+ByteBuffer bytes(const std::string &value) {
+  return ByteBuffer{.len = int64_t(value.size()),
+                    .data = (uint8_t *)value.data()};
+}
+
+// Median wall time of `runs` calls of `f`, in microseconds
+template <typename F> double median(int runs, F f) {
+  std::vector<double> times;
+  for (int run = 0; run < runs; run++) {
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    times.push_back(std::chrono::duration<double, std::micro>(end - begin)
+                        .count());
+  }
+  std::sort(times.begin(), times.end());
+  return times[times.size() / 2];
+}
+
+void usage() {
+  fprintf(stderr,
+          "Usage: anoncreds-storage-benchmark <directory> [--runs <n>]\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    usage();
+    return 2;
+  }
+
+  int runs = 100;
+  for (int i = 2; i < argc; i++) {
+    if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+      runs = atoi(argv[++i]);
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (runs < 1) {
+    usage();
+    return 2;
+  }
+
+  printf("Median of %d loads per object\n\n", runs);
+  printf("%-36s %10s %10s %6s %12s %12s %12s\n", "", "JSON (B)", "CBOR (B)",
+         "size", "JSON (us)", "CBOR (us)", "decode (us)");
+
+  size_t totalJson = 0, totalCbor = 0;
+  for (auto &type : types) {
+    auto path = std::filesystem::path(argv[1]) /
+                (std::string(type.name) + ".json");
+    if (!std::filesystem::exists(path))
+      continue;
+
+    std::stringstream file;
+    file << std::ifstream(path, std::ios::binary).rdbuf();
+
+    // Stored as anoncreds writes it
+    ObjectHandle handle;
+    ByteBuffer written;
+    if (type.parse(bytes(file.str()), &handle) != ErrorCode::Success ||
+        anoncreds_object_get_json(handle, &written) != ErrorCode::Success) {
+      fprintf(stderr, "%s: not a valid %s\n", path.c_str(), type.name);
+      return 1;
+    }
+    anoncreds_object_free(handle);
+    std::string json((const char *)written.data, written.len);
+    anoncreds_buffer_free(written);
+
+    anoncredsJson::Value document, decoded;
+    std::vector<uint8_t> cbor;
+    std::string roundTrip;
+    anoncredsJson::parse(json.data(), json.size(), document);
+    anoncredsCbor::encode(document, cbor);
+    anoncredsCbor::decode(cbor.data(), cbor.size(), decoded);
+    anoncredsJson::serialize(decoded, roundTrip);
+    if (roundTrip != json) {
+      fprintf(stderr, "%s: the CBOR round trip changed the object\n",
+              path.c_str());
+      return 1;
+    }
+
+    auto fromJson = median(runs, [&] {
+      type.parse(bytes(json), &handle);
+      anoncreds_object_free(handle);
+    });
+    auto fromCbor = median(runs, [&] {
+      anoncredsJson::Value value;
+      std::string text;
+      anoncredsCbor::decode(cbor.data(), cbor.size(), value);
+      anoncredsJson::serialize(value, text);
+      type.parse(bytes(text), &handle);
+      anoncreds_object_free(handle);
+    });
+    auto decode = median(runs, [&] {
+      anoncredsJson::Value value;
+      anoncredsCbor::decode(cbor.data(), cbor.size(), value);
+    });
+
+    printf("%-36s %10zu %10zu %5.0f%% %12.1f %12.1f %12.1f\n", type.name,
+           json.size(), cbor.size(), 100.0 * cbor.size() / json.size(),
+           fromJson, fromCbor, decode);
+    totalJson += json.size();
+    totalCbor += cbor.size();
+  }
+
+  if (totalJson == 0) {
+    fprintf(stderr, "%s: no objects found\n", argv[1]);
+    return 1;
+  }
+  printf("\n%-36s %10zu %10zu %5.0f%%\n", "total", totalJson, totalCbor,
+         100.0 * totalCbor / totalJson);
+  return 0;
+}
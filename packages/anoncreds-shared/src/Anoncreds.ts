@@ -2,6 +2,7 @@
 // This will make sure that when wrapping both methods to shared functionality
 
 import type { ObjectHandle } from './ObjectHandle'
+import type { JsonObject } from './types'
 
 export type NativeCredentialEntry = {
   credential: ObjectHandle
@@ -201,6 +202,9 @@ export type Anoncreds = {
 
   getJson(options: { objectHandle: ObjectHandle }): string
 
+  // Optional: the value of `JSON.parse(getJson(options))`, built without the intermediate string
+  getObject?(options: { objectHandle: ObjectHandle }): JsonObject
+
   getTypeName(options: { objectHandle: ObjectHandle }): string
 
   objectFree(options: { objectHandle: ObjectHandle }): void
@@ -10,7 +10,8 @@ export class AnoncredsObject {
     this.handle = new ObjectHandle(handle)
   }
 
-  public toJson() {
+  public toJson(): JsonObject {
+    if (anoncreds.getObject) return anoncreds.getObject({ objectHandle: this.handle })
     return JSON.parse(anoncreds.getJson({ objectHandle: this.handle })) as JsonObject
   }
 }